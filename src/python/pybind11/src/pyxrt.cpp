@@ -81,7 +81,8 @@ PYBIND11_MODULE(pyxrt, m) {
         .value("pcie_info", xrt::info::device::pcie_info)
         .value("host", xrt::info::device::host)
         .value("dynamic_regions", xrt::info::device::dynamic_regions)
-        .value("vmr", xrt::info::device::vmr);
+        .value("vmr", xrt::info::device::vmr)
+        .value("command_stats", xrt::info::device::command_stats);
 
     py::enum_<xrt::message::level>(m, "xrt_msg_level", "XRT log msgs level")
         .value("emergency", xrt::message::level::emergency)
@@ -182,6 +183,8 @@ PYBIND11_MODULE(pyxrt, m) {
                                  return d.get_info<xrt::info::device::dynamic_regions>();
                              case xrt::info::device::vmr:
                                  return d.get_info<xrt::info::device::vmr>();
+                             case xrt::info::device::command_stats:
+                                 return d.get_info<xrt::info::device::command_stats>();
                              default:
                                  return std::string("NA");
                              }
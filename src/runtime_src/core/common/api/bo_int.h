@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2024-2026 Advanced Micro Devices, Inc. All rights reserved.
 //
 #ifndef _XRT_COMMON_BO_INT_H_
 #define _XRT_COMMON_BO_INT_H_
@@ -11,6 +11,7 @@
 #include "core/common/shim/hwctx_handle.h"
 
 #include <map>
+#include <vector>
 
 namespace xrt_core::bo_int {
 
@@ -21,6 +22,16 @@ get_buffer_handle(const xrt::bo& bo);
 size_t
 get_offset(const xrt::bo& bo);
 
+// sync() - Sync several ranges of a buffer with one request
+//
+// Ranges are relative to the buffer as for xrt::bo::sync().  The
+// shim syncs all ranges with one transfer where supported, which
+// saves a request per range when syncing many small scattered
+// ranges.
+XRT_CORE_COMMON_EXPORT
+void
+sync(const xrt::bo& bo, xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges);
+
 // enum for different buffer use flags
 // This is for internal use only
 enum class use_type {
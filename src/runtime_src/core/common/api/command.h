@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2020-2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef xrt_core_command_h_
 #define xrt_core_command_h_
 
@@ -66,6 +66,17 @@ public:
   virtual void
   notify(ert_cmd_state) const = 0;
 
+  /**
+   * notify_start() - command is handed to the driver for execution
+   *
+   * Called before a command that was held by host side queueing,
+   * such as submission coalescing, is submitted to the driver.  Not
+   * called for commands submitted to the driver when started.
+   */
+  virtual void
+  notify_start() const
+  {}
+
   // get_hwctx_handle() - get submission hw context of command buffer
   //
   // The submission hw context is the hardware context used for
@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as core_common
+#define XRT_API_SOURCE         // in same dll as API sources
+#include "command_stats.h"
+
+#include "core/common/config_reader.h"
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+namespace bpt = boost::property_tree;
+
+using counts_type = std::array<uint64_t, xrt_core::command_stats::histogram::num_buckets>;
+
+inline void
+update_min(std::atomic<uint64_t>& min, uint64_t value)
+{
+  auto current = min.load(std::memory_order_relaxed);
+  while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    ;
+}
+
+inline void
+update_max(std::atomic<uint64_t>& max, uint64_t value)
+{
+  auto current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    ;
+}
+
+// Percentile of a snapshot of histogram buckets
+static uint64_t
+percentile(const counts_type& counts, uint64_t total, uint64_t max, double pct)
+{
+  if (!total)
+    return 0;
+
+  auto rank = static_cast<uint64_t>(std::ceil(pct / 100.0 * static_cast<double>(total)));
+  rank = std::clamp<uint64_t>(rank, 1, total);
+
+  uint64_t sum = 0;
+  for (size_t idx = 0; idx < counts.size(); ++idx) {
+    sum += counts[idx];
+    if (sum >= rank)
+      return std::min(xrt_core::command_stats::histogram::bucket_upper(idx), max);
+  }
+  return max;
+}
+
+using entry_map = std::map<std::pair<std::string, int>, std::unique_ptr<xrt_core::command_stats::entry>>;
+
+static void
+merge_entries(entry_map& dst, const entry_map& src)
+{
+  for (const auto& [key, ent] : src) {
+    auto& dent = dst[key];
+    if (!dent)
+      dent = std::make_unique<xrt_core::command_stats::entry>();
+    dent->merge(*ent);
+  }
+}
+
+static bpt::ptree
+to_ptree(const entry_map& entries)
+{
+  auto scale = xrt_core::command_stats::ns_per_tick();
+  bpt::ptree pt_entries;
+  for (const auto& [key, ent] : entries) {
+    bpt::ptree pt;
+    pt.put("kernel", key.first);
+    pt.put("cu_index", key.second == xrt_core::command_stats::table::any_cu ? "any" : std::to_string(key.second));
+    pt.put("count", ent->total_ns.get_count() + ent->wait_total_ns.get_count());
+    pt.put("errors", ent->errors.load(std::memory_order_relaxed));
+    pt.put("inflight", ent->inflight.load(std::memory_order_relaxed));
+    pt.add_child("queue_ns", ent->queue_ns.to_ptree(scale));
+    pt.add_child("exec_ns", ent->exec_ns.to_ptree(scale));
+    pt.add_child("total_ns", ent->total_ns.to_ptree(scale));
+    pt.add_child("wait_total_ns", ent->wait_total_ns.to_ptree(scale));
+    pt.add_child("depth", ent->depth.to_ptree());
+    pt_entries.push_back(std::make_pair("", pt));
+  }
+  return pt_entries;
+}
+
+// struct calibration - ticks and nanoseconds at a common point in time
+struct calibration
+{
+  uint64_t ticks = xrt_core::command_stats::now_ticks();
+  uint64_t ns = xrt_core::command_stats::now_ns();
+};
+
+// Taken when the first table is created, ticks are converted using
+// the time elapsed since
+static const calibration&
+get_anchor()
+{
+  static calibration anchor;
+  return anchor;
+}
+
+} // namespace
+
+namespace xrt_core::command_stats {
+
+double
+ns_per_tick()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  // At least 1ms since the anchor bounds the calibration error of the
+  // nanosecond clock to one part in a million
+  constexpr uint64_t min_interval_ns = 1000000;
+  const auto& anchor = get_anchor();
+  calibration now;
+  while (now.ns - anchor.ns < min_interval_ns || now.ticks <= anchor.ticks)
+    now = calibration{};
+  return static_cast<double>(now.ns - anchor.ns) / static_cast<double>(now.ticks - anchor.ticks);
+#else
+  return 1.0;
+#endif
+}
+
+// class registry - tables of all devices
+//
+// Tables register on construction and merge their entries into the
+// retired entries of their device on destruction.
+class registry
+{
+  struct device_record
+  {
+    std::vector<const table*> live;
+    entry_map retired;
+  };
+
+  std::mutex m_mutex;
+  std::map<unsigned int, device_record> m_devices;
+
+  // Write statistics of all devices at exit if requested in xrt.ini
+  struct dump_at_exit
+  {
+    ~dump_at_exit()
+    {
+      static auto file = xrt_core::config::get_command_stats_file();
+      if (file.empty())
+        return;
+
+      try {
+        bpt::ptree pt_devices;
+        for (auto device_id : instance().get_device_ids()) {
+          bpt::ptree pt;
+          pt.put("device_id", device_id);
+          pt.add_child("command_stats", instance().get_device_stats(device_id));
+          pt_devices.push_back(std::make_pair("", pt));
+        }
+
+        bpt::ptree pt_root;
+        pt_root.add_child("devices", pt_devices);
+        std::ofstream ofs(file);
+        bpt::write_json(ofs, pt_root);
+      }
+      catch (const std::exception& ex) {
+        std::cerr << "Failed to dump command stats to '" << file << "': " << ex.what() << std::endl;
+      }
+    }
+  };
+
+public:
+  // The registry is never destructed because tables of static or
+  // leaked objects can outlive static destruction
+  static registry&
+  instance()
+  {
+    static auto reg = new registry;
+    static dump_at_exit dumper;
+    return *reg;
+  }
+
+  void
+  add(const table* tbl)
+  {
+    std::lock_guard lk(m_mutex);
+    m_devices[tbl->get_device_id()].live.push_back(tbl);
+  }
+
+  void
+  retire(const table* tbl)
+  {
+    std::lock_guard lk(m_mutex);
+    auto& rec = m_devices[tbl->get_device_id()];
+    rec.live.erase(std::remove(rec.live.begin(), rec.live.end(), tbl), rec.live.end());
+
+    std::lock_guard tlk(tbl->m_mutex);
+    merge_entries(rec.retired, tbl->m_entries);
+  }
+
+  std::vector<unsigned int>
+  get_device_ids()
+  {
+    std::lock_guard lk(m_mutex);
+    std::vector<unsigned int> ids;
+    for (const auto& [id, rec] : m_devices)
+      ids.push_back(id);
+    return ids;
+  }
+
+  bpt::ptree
+  get_device_stats(unsigned int device_id)
+  {
+    entry_map entries;
+    std::lock_guard lk(m_mutex);
+    auto itr = m_devices.find(device_id);
+    if (itr == m_devices.end())
+      return bpt::ptree{};
+
+    merge_entries(entries, itr->second.retired);
+    for (auto tbl : itr->second.live) {
+      std::lock_guard tlk(tbl->m_mutex);
+      merge_entries(entries, tbl->m_entries);
+    }
+    return ::to_ptree(entries);
+  }
+};
+
+size_t
+histogram::
+bucket_index(uint64_t value)
+{
+  if (value < 2 * sub_buckets)
+    return static_cast<size_t>(value);
+
+  // Most significant bit, at least sub_bits + 1
+  unsigned int msb = 0;
+  for (unsigned int shift = 32; shift; shift >>= 1) {
+    if (value >> (msb + shift))
+      msb += shift;
+  }
+
+  auto shift = msb - sub_bits;
+  return static_cast<size_t>((msb - sub_bits + 1) * sub_buckets + ((value >> shift) & (sub_buckets - 1)));
+}
+
+uint64_t
+histogram::
+bucket_upper(size_t idx)
+{
+  if (idx < 2 * sub_buckets)
+    return idx;
+
+  auto msb = idx / sub_buckets + sub_bits - 1;
+  auto shift = msb - sub_bits;
+  auto low = (sub_buckets + idx % sub_buckets) << shift;
+  return low + ((1ull << shift) - 1);
+}
+
+void
+histogram::
+record(uint64_t value)
+{
+  m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+  update_min(m_min, value);
+  update_max(m_max, value);
+}
+
+uint64_t
+histogram::
+get_count() const
+{
+  uint64_t total = 0;
+  for (const auto& bucket : m_buckets)
+    total += bucket.load(std::memory_order_relaxed);
+  return total;
+}
+
+void
+histogram::
+merge(const histogram& other)
+{
+  if (!other.get_count())
+    return;
+
+  for (size_t idx = 0; idx < num_buckets; ++idx) {
+    if (auto count = other.m_buckets[idx].load(std::memory_order_relaxed))
+      m_buckets[idx].fetch_add(count, std::memory_order_relaxed);
+  }
+  m_sum.fetch_add(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  update_min(m_min, other.m_min.load(std::memory_order_relaxed));
+  update_max(m_max, other.m_max.load(std::memory_order_relaxed));
+}
+
+uint64_t
+histogram::
+get_percentile(double pct) const
+{
+  counts_type counts;
+  uint64_t total = 0;
+  for (size_t idx = 0; idx < num_buckets; ++idx)
+    total += counts[idx] = m_buckets[idx].load(std::memory_order_relaxed);
+
+  return percentile(counts, total, m_max.load(std::memory_order_relaxed), pct);
+}
+
+boost::property_tree::ptree
+histogram::
+to_ptree(double scale) const
+{
+  // Percentiles are computed from one snapshot of the buckets, which
+  // may be updated concurrently
+  counts_type counts;
+  uint64_t total = 0;
+  for (size_t idx = 0; idx < num_buckets; ++idx)
+    total += counts[idx] = m_buckets[idx].load(std::memory_order_relaxed);
+
+  auto max = m_max.load(std::memory_order_relaxed);
+  auto sum = m_sum.load(std::memory_order_relaxed);
+
+  auto scaled = [scale](uint64_t value) {
+    return static_cast<uint64_t>(static_cast<double>(value) * scale);
+  };
+
+  bpt::ptree pt;
+  pt.put("count", total);
+  pt.put("min", scaled(total ? m_min.load(std::memory_order_relaxed) : 0));
+  pt.put("max", scaled(max));
+  pt.put("mean", scaled(total ? sum / total : 0));
+  pt.put("p50", scaled(percentile(counts, total, max, 50.0)));
+  pt.put("p99", scaled(percentile(counts, total, max, 99.0)));
+  pt.put("p999", scaled(percentile(counts, total, max, 99.9)));
+  return pt;
+}
+
+void
+entry::
+completed(uint64_t submit, uint64_t start, uint64_t complete, bool error, bool wait_observed)
+{
+  if (!start || start < submit)
+    start = submit;
+  else
+    queue_ns.record(start - submit);
+  if (complete < start)
+    complete = start;
+
+  if (wait_observed)
+    wait_total_ns.record(complete - submit);
+  else {
+    exec_ns.record(complete - start);
+    total_ns.record(complete - submit);
+  }
+  if (error)
+    errors.fetch_add(1, std::memory_order_relaxed);
+  inflight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void
+entry::
+merge(const entry& other)
+{
+  queue_ns.merge(other.queue_ns);
+  exec_ns.merge(other.exec_ns);
+  total_ns.merge(other.total_ns);
+  wait_total_ns.merge(other.wait_total_ns);
+  depth.merge(other.depth);
+  errors.fetch_add(other.errors.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  inflight.fetch_add(other.inflight.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+table::
+table(unsigned int device_id)
+  : m_device_id(device_id)
+{
+  get_anchor();
+  registry::instance().add(this);
+}
+
+table::
+~table()
+{
+  registry::instance().retire(this);
+}
+
+entry*
+table::
+get_entry(const std::string& kernel, int cuidx)
+{
+  std::lock_guard lk(m_mutex);
+  auto& ent = m_entries[{kernel, cuidx}];
+  if (!ent)
+    ent = std::make_unique<entry>();
+  return ent.get();
+}
+
+boost::property_tree::ptree
+table::
+to_ptree() const
+{
+  std::lock_guard lk(m_mutex);
+  return ::to_ptree(m_entries);
+}
+
+std::unique_ptr<table>
+create_table(unsigned int device_id)
+{
+  static auto enabled = xrt_core::config::get_command_stats();
+  if (!enabled)
+    return nullptr;
+
+  return std::make_unique<table>(device_id);
+}
+
+boost::property_tree::ptree
+device_stats(unsigned int device_id)
+{
+  return registry::instance().get_device_stats(device_id);
+}
+
+} // xrt_core::command_stats
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_COMMON_API_COMMAND_STATS_H
+#define XRT_COMMON_API_COMMAND_STATS_H
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#if defined(_M_X64)
+# include <intrin.h>
+#elif defined(__x86_64__)
+# include <x86intrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////
+// namespace xrt_core::command_stats
+//
+// Always on latency statistics of kernel commands, kept per hardware
+// context and keyed by kernel name and compute unit index.
+//
+// A kernel command records up to three time stamps on the host:
+//  - submit: the application started the run
+//  - start: the command was handed to the driver after being held
+//    by submission coalescing, otherwise start is submit
+//  - complete: the host observed completion of the command
+//
+// Completion of a managed command (a run with callbacks) is observed
+// by the monitor thread as the command completes.  Completion of an
+// unmanaged command is only observed when the application waits for
+// or polls the command, so it is recorded separately as wait-observed
+// and includes any time before the application waited.
+//
+// Latencies and the number of commands in flight at submit are
+// recorded in lock-free log-linear histograms, which can be queried
+// while commands execute:
+//
+//  xrt::device::get_info<xrt::info::device::command_stats>()
+//  xrt::hw_context::get_info<xrt::info::hw_context::command_stats>()
+//
+// Statistics of all devices are written as json when the application
+// exits if a file is specified in xrt.ini
+//
+// % cat xrt.ini
+// [Runtime]
+// command_stats_file = command_stats.json
+//
+// Time stamps are ticks of the time stamp counter where available,
+// which are converted to nanoseconds when statistics are reported.
+// Recording costs two counter reads per command and is disabled with
+// Runtime.command_stats = false
+////////////////////////////////////////////////////////////////
+namespace xrt_core::command_stats {
+
+// Nanoseconds since an arbitrary epoch
+inline uint64_t
+now_ns()
+{
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+// Ticks since an arbitrary epoch, used for command time stamps.  The
+// time stamp counter is read without a system call and is several
+// times cheaper than steady_clock.  Other architectures use
+// nanoseconds.
+inline uint64_t
+now_ticks()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return now_ns();
+#endif
+}
+
+// Nanoseconds per tick of now_ticks(), calibrated against
+// steady_clock over the lifetime of the statistics
+double
+ns_per_tick();
+
+// class histogram - lock-free log-linear histogram
+//
+// Values below 2^(sub_bits+1) have a bucket each, larger values are
+// bucketed with sub_bits of precision per power of two, which bounds
+// the relative error of a reported percentile to 1/2^sub_bits.  The
+// full 64-bit range is covered in 976 buckets.
+//
+// Recording is wait-free for the buckets and sum, min and max
+// use compare exchange that only loops when racing with a new
+// extreme value.
+class histogram
+{
+public:
+  static constexpr unsigned int sub_bits = 4;
+  static constexpr uint64_t sub_buckets = 1ull << sub_bits;
+  static constexpr size_t num_buckets = (64 - sub_bits + 1) * sub_buckets;
+
+  // Bucket of a value
+  static size_t
+  bucket_index(uint64_t value);
+
+  // Highest value that falls in a bucket
+  static uint64_t
+  bucket_upper(size_t idx);
+
+  void
+  record(uint64_t value);
+
+  // Add the recorded values of other histogram to this histogram
+  void
+  merge(const histogram& other);
+
+  // Sum of buckets, recording does not maintain a separate count
+  uint64_t
+  get_count() const;
+
+  // Value at or below which pct percent of recorded values fall,
+  // reported as the highest value of the bucket, capped by the max
+  // recorded value.  Returns 0 if nothing is recorded.
+  uint64_t
+  get_percentile(double pct) const;
+
+  // count, min, max, mean, p50, p99, p999, values are multiplied
+  // by scale, for example to convert ticks to nanoseconds
+  boost::property_tree::ptree
+  to_ptree(double scale = 1.0) const;
+
+private:
+  std::array<std::atomic<uint64_t>, num_buckets> m_buckets {};
+  std::atomic<uint64_t> m_sum {0};
+  std::atomic<uint64_t> m_min {UINT64_MAX};
+  std::atomic<uint64_t> m_max {0};
+};
+
+// struct entry - statistics of commands of one kernel on one compute unit
+//
+// Latencies are recorded in ticks of now_ticks() and reported in
+// nanoseconds.
+struct entry
+{
+  histogram queue_ns;             // submit to start, commands held by coalescing
+  histogram exec_ns;              // start to complete, managed commands
+  histogram total_ns;             // submit to complete, managed commands
+  histogram wait_total_ns;        // submit to wait-observed complete, unmanaged commands
+  histogram depth;                // commands in flight at submit, including submitted
+  std::atomic<uint64_t> errors {0};   // commands completed in other state than completed
+  std::atomic<uint64_t> inflight {0}; // commands submitted but not completed
+
+  // Command is submitted for execution
+  void
+  submitted()
+  {
+    depth.record(inflight.fetch_add(1, std::memory_order_relaxed) + 1);
+  }
+
+  // Command completed, time stamps are ticks of now_ticks().  A start
+  // time stamp of 0 means the command was
+  // handed to the driver when submitted.  Completion observed by a
+  // waiting application has no execution time, only the total time.
+  void
+  completed(uint64_t submit, uint64_t start, uint64_t complete, bool error, bool wait_observed);
+
+  // Command did not start or was destructed before completion
+  void
+  abandoned()
+  {
+    inflight.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void
+  merge(const entry& other);
+};
+
+// class table - statistics of a hardware context
+//
+// Entries are created on first use and live as long as the table, a
+// command refers to its entry without locking.  When the table is
+// destructed its entries are merged into the statistics of the
+// device so that the device reports all contexts it has had.
+class table
+{
+public:
+  // Compute unit index of a command that may execute on any of
+  // multiple compute units of the kernel
+  static constexpr int any_cu = -1;
+
+  explicit
+  table(unsigned int device_id);
+
+  ~table();
+
+  table(const table&) = delete;
+  table(table&&) = delete;
+  table& operator=(const table&) = delete;
+  table& operator=(table&&) = delete;
+
+  // Get or create the entry of a kernel and compute unit
+  entry*
+  get_entry(const std::string& kernel, int cuidx);
+
+  unsigned int
+  get_device_id() const
+  {
+    return m_device_id;
+  }
+
+  // Array of entries
+  boost::property_tree::ptree
+  to_ptree() const;
+
+private:
+  friend class registry;
+  using key_type = std::pair<std::string, int>;
+
+  unsigned int m_device_id;
+  mutable std::mutex m_mutex;
+  std::map<key_type, std::unique_ptr<entry>> m_entries;
+};
+
+// Create statistics of a new hardware context.  Returns nullptr
+// if statistics are disabled.
+std::unique_ptr<table>
+create_table(unsigned int device_id);
+
+// Statistics of all hardware contexts of a device, current and
+// destructed, as an array of entries
+boost::property_tree::ptree
+device_stats(unsigned int device_id);
+
+} // xrt_core::command_stats
+
+#endif
@@ -5,6 +5,7 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #include "elf_patcher.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <stdexcept>
@@ -27,6 +28,72 @@ get_ddr_aie_addr_offset()
   return ddr_aie_addr_offset;
 }
 
+void
+dirty_ranges::
+add(size_t offset, size_t size)
+{
+  auto begin = offset & ~(granularity - 1);
+  auto end = (offset + size + granularity - 1) & ~(granularity - 1);
+
+  // Patch locations are mostly in increasing order, extend last
+  // range if possible
+  if (!m_ranges.empty()) {
+    auto& last = m_ranges.back();
+    if (begin >= last.first && begin <= last.second) {
+      last.second = std::max(last.second, end);
+      return;
+    }
+    if (begin < last.first)
+      m_sorted = false;
+  }
+
+  m_ranges.emplace_back(begin, end);
+}
+
+void
+dirty_ranges::
+merge()
+{
+  if (m_ranges.empty())
+    return;
+
+  std::sort(m_ranges.begin(), m_ranges.end());
+  size_t out = 0;
+  for (size_t idx = 1; idx < m_ranges.size(); ++idx) {
+    if (m_ranges[idx].first <= m_ranges[out].second)
+      m_ranges[out].second = std::max(m_ranges[out].second, m_ranges[idx].second);
+    else
+      m_ranges[++out] = m_ranges[idx];
+  }
+  m_ranges.resize(out + 1);
+  m_sorted = true;
+}
+
+const std::vector<std::pair<size_t, size_t>>&
+dirty_ranges::
+get()
+{
+  if (!m_sorted)
+    merge();
+  return m_ranges;
+}
+
+void
+dirty_ranges::
+sync(xrt::bo& bo)
+{
+  if (m_ranges.empty())
+    return;
+
+  auto bo_size = bo.size();
+  for (const auto& [begin, end] : get()) {
+    // Cache line aligned end may exceed buffer size
+    auto size = std::min(end, bo_size) - begin;
+    bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, size, begin);
+  }
+  clear();
+}
+
 // patcher_config constructor - stores static configuration from ELF
 patcher_config::
 patcher_config(symbol_type type, std::vector<patch_config> configs, buf_type t)
@@ -155,14 +222,11 @@ patch_ctrl57_aie4(uint32_t* bd_data_ptr, uint64_t patch)
   bd_data_ptr[1] = (bd_data_ptr[1] & 0xFE000000) | ((base_address >> 32) & 0x1FFFFFF);     // NOLINT
 }
 
+template <typename PatchFunction>
 void
 symbol_patcher::
-patch_symbol(xrt::bo bo, uint64_t value, bool first)
+patch_locations(uint8_t* base, size_t sync_size, dirty_ranges* ranges, PatchFunction&& patch)
 {
-  if (!m_config)
-    throw std::runtime_error("symbol_patcher: config not set");
-
-  auto base = reinterpret_cast<uint8_t*>(bo.map());
   const auto& configs = m_config->m_patch_configs;
 
   // Ensure runtime state is properly sized
@@ -174,7 +238,7 @@ patch_symbol(xrt::bo bo, uint64_t value, bool first)
     auto& state = m_states[i];
 
     auto offset = config.offset_to_patch_buffer;
-    auto bd_data_ptr = reinterpret_cast<uint32_t*>(base + offset);
+    auto bd_data_ptr = reinterpret_cast<uint32_t*>(base + offset); // NOLINT
 
     if (!state.dirty) {
       // first time patching cache bd ptr values using bd ptrs array in patch state
@@ -186,87 +250,103 @@ patch_symbol(xrt::bo bo, uint64_t value, bool first)
       std::copy(state.bd_data_ptrs.begin(), state.bd_data_ptrs.end(), bd_data_ptr);
     }
 
-    // lambda for calling sync bo
-    // We only sync the words that are patched not the entire bo
-    auto sync = [&](size_t size) {
-      bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
-    };
+    if (patch(bd_data_ptr, config) && ranges)
+      ranges->add(offset, sync_size);
+  }
+}
 
-    switch (m_config->m_symbol_type) {
-    case symbol_type::address_64:
-      // value is a 64bit address
-      patch64(bd_data_ptr, value);
-      if (!first) {
-        // sync 64 bits patched
-        sync(sizeof(uint64_t));
-      }
-      break;
-    case symbol_type::scalar_32bit_kind:
-      // value is a register value
-      if (config.mask) {
-        patch32(bd_data_ptr, value, config.mask);
-        if (!first) {
-          // sync 32 bits patched
-          sync(sizeof(uint32_t));
-        }
-      }
-      break;
-    case symbol_type::shim_dma_base_addr_symbol_kind:
-      // value is a bo address
-      patch57(bd_data_ptr, value + config.offset_to_base_bo_addr);
-      if (!first) {
-        // sync all the words (max_bd_words)
-        sync(sizeof(uint32_t) * max_bd_words);
-      }
-      break;
-    case symbol_type::shim_dma_aie4_base_addr_symbol_kind:
-      // value is a bo address
-      patch57_aie4(bd_data_ptr, value + config.offset_to_base_bo_addr);
-      if (!first) {
-        // sync 64 bits or 2 words
-        sync(sizeof(uint64_t));
-      }
-      break;
-    case symbol_type::control_packet_57:
-      // value is a bo address
-      patch_ctrl57(bd_data_ptr, value + config.offset_to_base_bo_addr);
-      if (!first) {
-        // Data in this case is written till 3rd offset of bd_data_ptr
-        // so syncing 4 words
-        sync(4 * sizeof(uint32_t));    // NOLINT
-      }
-      break;
-    case symbol_type::control_packet_48:
-      // value is a bo address
-      patch_ctrl48(bd_data_ptr, value + config.offset_to_base_bo_addr);
-      if (!first) {
-        // Data in this case is written till 3rd offset of bd_data_ptr
-        // so syncing 4 words
-        sync(4 * sizeof(uint32_t));    // NOLINT
-      }
-      break;
-    case symbol_type::shim_dma_48:
-      // value is a bo address
-      patch_shim48(bd_data_ptr, value + config.offset_to_base_bo_addr);
-      if (!first) {
-        // syncing 3 words
-        sync(3 * sizeof(uint32_t));    // NOLINT
-      }
-      break;
-    case symbol_type::control_packet_57_aie4:
-      // value is a bo address
-      patch_ctrl57_aie4(bd_data_ptr, value + config.offset_to_base_bo_addr);
-      if (!first) {
-        // syncing 3 words
-        sync(3 * sizeof(uint32_t));    // NOLINT
-      }
-      break;
-    default:
-      throw std::runtime_error("Unsupported symbol type");
-    }
+void
+symbol_patcher::
+patch_symbol(uint8_t* base, uint64_t value, dirty_ranges* ranges)
+{
+  if (!m_config)
+    throw std::runtime_error("symbol_patcher: config not set");
+
+  // The symbol type is the same for all locations, dispatch once
+  // and patch all locations with a loop specific to the symbol type.
+  // The number of bytes recorded as dirty per location is the number
+  // of words written by the patching function.
+  switch (m_config->m_symbol_type) {
+  case symbol_type::address_64:
+    // value is a 64bit address
+    patch_locations(base, sizeof(uint64_t), ranges, [value] (uint32_t* bd, const patch_config&) {
+      patch64(bd, value);
+      return true;
+    });
+    break;
+  case symbol_type::scalar_32bit_kind:
+    // value is a register value
+    patch_locations(base, sizeof(uint32_t), ranges, [value] (uint32_t* bd, const patch_config& cfg) {
+      if (!cfg.mask)
+        return false;
+      patch32(bd, value, cfg.mask);
+      return true;
+    });
+    break;
+  case symbol_type::shim_dma_base_addr_symbol_kind:
+    // value is a bo address, all bd words
+    patch_locations(base, sizeof(uint32_t) * max_bd_words, ranges, [value] (uint32_t* bd, const patch_config& cfg) {
+      patch57(bd, value + cfg.offset_to_base_bo_addr);
+      return true;
+    });
+    break;
+  case symbol_type::shim_dma_aie4_base_addr_symbol_kind:
+    // value is a bo address, 2 words
+    patch_locations(base, sizeof(uint64_t), ranges, [value] (uint32_t* bd, const patch_config& cfg) {
+      patch57_aie4(bd, value + cfg.offset_to_base_bo_addr);
+      return true;
+    });
+    break;
+  case symbol_type::control_packet_57:
+    // value is a bo address, data is written till 3rd offset of bd
+    patch_locations(base, 4 * sizeof(uint32_t), ranges, [value] (uint32_t* bd, const patch_config& cfg) { // NOLINT
+      patch_ctrl57(bd, value + cfg.offset_to_base_bo_addr);
+      return true;
+    });
+    break;
+  case symbol_type::control_packet_48:
+    // value is a bo address, data is written till 3rd offset of bd
+    patch_locations(base, 4 * sizeof(uint32_t), ranges, [value] (uint32_t* bd, const patch_config& cfg) { // NOLINT
+      patch_ctrl48(bd, value + cfg.offset_to_base_bo_addr);
+      return true;
+    });
+    break;
+  case symbol_type::shim_dma_48:
+    // value is a bo address, 3 words
+    patch_locations(base, 3 * sizeof(uint32_t), ranges, [value] (uint32_t* bd, const patch_config& cfg) { // NOLINT
+      patch_shim48(bd, value + cfg.offset_to_base_bo_addr);
+      return true;
+    });
+    break;
+  case symbol_type::control_packet_57_aie4:
+    // value is a bo address, 3 words
+    patch_locations(base, 3 * sizeof(uint32_t), ranges, [value] (uint32_t* bd, const patch_config& cfg) { // NOLINT
+      patch_ctrl57_aie4(bd, value + cfg.offset_to_base_bo_addr);
+      return true;
+    });
+    break;
+  default:
+    throw std::runtime_error("Unsupported symbol type");
   }
 }
 
+void
+symbol_patcher::
+patch_symbol(xrt::bo bo, uint64_t value, bool first, dirty_ranges& ranges)
+{
+  // First patch is followed by a full sync of the buffer
+  patch_symbol(reinterpret_cast<uint8_t*>(bo.map()), value, first ? nullptr : &ranges);
+}
+
+void
+symbol_patcher::
+patch_symbol(xrt::bo bo, uint64_t value, bool first)
+{
+  dirty_ranges ranges;
+  patch_symbol(bo, value, first, ranges);
+  ranges.sync(bo);
+}
+
 void
 symbol_patcher::
 patch_symbol_raw(uint8_t* base, uint64_t value, const patcher_config& config)
@@ -7,10 +7,12 @@
 #include "xrt/xrt_bo.h"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // This file contains the patching logic related to xrt::elf
@@ -98,6 +100,50 @@ struct patch_state {
   std::array<uint32_t, max_bd_words> bd_data_ptrs = {}; // array to store bd ptrs original values
 };
 
+// class dirty_ranges - byte ranges of a buffer modified by patching
+//
+// Ranges are tracked at cache line granularity.  Overlapping and
+// adjacent ranges are merged such that a patched buffer is synced
+// with as few sync calls as possible rather than one call per patch
+// location.
+class dirty_ranges
+{
+  static constexpr size_t granularity = 64;
+
+  // [begin, end[ ranges, sorted and merged when m_sorted is true
+  std::vector<std::pair<size_t, size_t>> m_ranges;
+  bool m_sorted = true;
+
+  void
+  merge();
+
+public:
+  // Record that 'size' bytes at 'offset' have been modified
+  void
+  add(size_t offset, size_t size);
+
+  bool
+  empty() const
+  {
+    return m_ranges.empty();
+  }
+
+  void
+  clear()
+  {
+    m_ranges.clear();
+    m_sorted = true;
+  }
+
+  // Get merged ranges
+  const std::vector<std::pair<size_t, size_t>>&
+  get();
+
+  // Sync dirty ranges of buffer to device and clear ranges
+  void
+  sync(xrt::bo& bo);
+};
+
 // struct patcher_config - static configuration for a patcher
 //
 // Stored in elf_impl, shared across module_run instances (read-only)
@@ -130,10 +176,22 @@ struct symbol_patcher
   // Constructor - takes pointer to shared config, initializes state
   explicit symbol_patcher(const patcher_config* config);
 
-  // Function to patch a symbol in the buffer.
+  // Function to patch a symbol in the buffer.  Unless this is the
+  // first patch, the patched ranges of the buffer are synced.
   void
   patch_symbol(xrt::bo bo, uint64_t value, bool first);
 
+  // Function to patch a symbol in the buffer.  Unless this is the
+  // first patch, the patched ranges are recorded in 'ranges' for
+  // the caller to sync along with other patches of the buffer.
+  void
+  patch_symbol(xrt::bo bo, uint64_t value, bool first, dirty_ranges& ranges);
+
+  // Function to patch a symbol in a host buffer, optionally
+  // recording the patched ranges.
+  void
+  patch_symbol(uint8_t* base, uint64_t value, dirty_ranges* ranges);
+
   // static method for patching raw buffers passed by shim tests
   // where the caller handles sync themselves
   // It patches directly using config without maintaining state.
@@ -141,6 +199,13 @@ struct symbol_patcher
   patch_symbol_raw(uint8_t* base, uint64_t value, const patcher_config& config);
 
 private:
+  // Patch all locations of the symbol using the patching function
+  // of the symbol type.  'sync_size' is the number of bytes written
+  // at each location.
+  template <typename PatchFunction>
+  void
+  patch_locations(uint8_t* base, size_t sync_size, dirty_ranges* ranges, PatchFunction&& patch);
+
   // Different patching functions for different symbol types.
   static void
   patch64(uint32_t* data_to_patch, uint64_t addr);
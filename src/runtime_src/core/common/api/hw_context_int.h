@@ -4,12 +4,20 @@
 #define XRT_COMMON_API_HW_CONTEXT_INT_H
 
 #include "core/common/config.h"
+#include "core/common/api/hw_queue.h"
 
 // This file defines implementation extensions to the XRT XCLBIN APIs.
 #include "core/include/xrt/xrt_hw_context.h"
 #include "core/include/xrt/experimental/xrt_module.h"
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <string>
+
+namespace xrt_core::command_stats {
+class table;
+}
 
 // Provide access to xrt::xclbin data that is not directly exposed
 // to end users via xrt::xclbin.   These functions are used by
@@ -89,6 +97,48 @@ XRT_CORE_COMMON_EXPORT
 std::map<std::string, xrt::elf>
 get_elf_map(const xrt::hw_context& hwctx);
 
+// Get a buffer object with immutable content shared by users of the
+// hw context.  The 'key' identifies the content.  If no buffer is
+// currently shared for 'key', then 'create' is called to create and
+// fill a new buffer.  The buffer is released when last user releases
+// its reference.
+xrt::bo
+get_shared_bo(const xrt::hw_context& hwctx, const std::string& key, const std::function<xrt::bo()>& create);
+
+// Coalesce independent command submissions to the hw queue of this
+// context into chained commands.  Starts within 'window' of the first
+// pending start, or until 'max_cmds' starts are pending, are submitted
+// as one command.  A window of 0 disables coalescing.  Overrides
+// Runtime.submit_coalesce_window_us and Runtime.submit_coalesce_max
+// for the queue, which lives as long as kernels or runs of the
+// context use it.
+//
+// Coalescing is supported by shim hw queues, which execute chained
+// commands.  Throws if the context has no shim hw queue, the legacy
+// kds drivers don't execute chained commands.
+XRT_CORE_COMMON_EXPORT
+void
+set_submit_coalescing(const xrt::hw_context& hwctx, std::chrono::microseconds window, size_t max_cmds);
+
+// Select how threads wait for completion of commands executed in this
+// context.  Hybrid waiting polls command state for 'spin_time' before
+// blocking.  Overrides Runtime.hw_queue_wait_strategy and
+// Runtime.hw_queue_spin_us for this context only, other contexts on
+// the device keep their strategy also when they share a hw queue.
+XRT_CORE_COMMON_EXPORT
+void
+set_wait_strategy(const xrt::hw_context& hwctx, xrt_core::hw_queue::wait_strategy strategy,
+                  std::chrono::microseconds spin_time);
+
+// Wait policy of the context, see xrt_core::hw_queue::wait_policy
+std::shared_ptr<xrt_core::hw_queue::wait_policy>
+get_wait_policy(const xrt::hw_context& hwctx);
+
+// Get the command statistics of the hardware context.  Returns
+// nullptr if statistics are disabled.
+xrt_core::command_stats::table*
+get_command_stats(const xrt::hw_context& hwctx);
+
 }} // hw_context_int, xrt_core
 
 #endif
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2021-2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #define XRT_API_SOURCE         // in same dll as API sources
 #include "hw_queue.h"
@@ -10,8 +10,10 @@
 #include "fence_int.h"
 #include "kernel_int.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/debug.h"
 #include "core/common/device.h"
+#include "core/common/message.h"
 #include "core/common/thread.h"
 #include "core/include/xrt/detail/ert.h"
 #include "core/include/xrt_hwqueue.h"
@@ -21,12 +23,20 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
+#include <unordered_map>
 
 using namespace std::chrono_literals;
 
@@ -79,9 +89,174 @@ notify_host(xrt_core::command* cmd)
   notify_host(cmd, get_command_state(cmd));
 }
 
+// class submission_ring - bounded lock-free multi-producer single-consumer queue
+//
+// @slot: A ring entry with a sequence number that tells producers and
+//  the consumer if the slot is free or filled for a given position
+// @m_head: Next position to be claimed by a producer
+// @m_tail: Next position to be consumed by the single consumer
+//
+// Commands launched for managed execution are pushed by any number
+// of application threads and drained by the command monitor thread.
+// A producer claims a position by advancing m_head, writes the command
+// into the slot, and publishes it by updating the slot sequence.  The
+// consumer pops slots in order as long as they are published.  A push
+// to a full ring fails and must be handled by the caller.
+class submission_ring
+{
+  static constexpr size_t capacity = 4096; // must be power of 2
+  static constexpr size_t mask = capacity - 1;
+  static constexpr size_t cache_line = 64;
+
+  struct slot
+  {
+    std::atomic<size_t> seq {0};
+    xrt_core::command* cmd = nullptr;
+  };
+
+  std::unique_ptr<slot[]> m_slots;                  // NOLINT
+  alignas(cache_line) std::atomic<size_t> m_head {0};
+  alignas(cache_line) std::atomic<size_t> m_tail {0};
+
+public:
+  submission_ring()
+    : m_slots(std::make_unique<slot[]>(capacity))   // NOLINT
+  {
+    for (size_t pos = 0; pos < capacity; ++pos)
+      m_slots[pos].seq.store(pos, std::memory_order_relaxed);
+  }
+
+  // Push a command, return false if the ring is full
+  bool
+  push(xrt_core::command* cmd)
+  {
+    auto pos = m_head.load(std::memory_order_relaxed);
+    while (true) {
+      auto& s = m_slots[pos & mask];
+      auto seq = s.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          s.cmd = cmd;
+          s.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = m_head.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Pop next published command, must be called by the consumer only.
+  // Returns nullptr if there is nothing to pop.
+  xrt_core::command*
+  pop()
+  {
+    auto pos = m_tail.load(std::memory_order_relaxed);
+    auto& s = m_slots[pos & mask];
+    if (s.seq.load(std::memory_order_acquire) != pos + 1)
+      return nullptr;
+    auto cmd = s.cmd;
+    s.seq.store(pos + capacity, std::memory_order_release);
+    m_tail.store(pos + 1, std::memory_order_relaxed);
+    return cmd;
+  }
+
+  // True if no position has been claimed beyond what is consumed.  A
+  // claimed but not yet published slot makes the ring non empty.
+  bool
+  empty() const
+  {
+    return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_relaxed);
+  }
+};
+
+// class running_set - commands monitored for completion
+//
+// @m_order: Running commands in launch order
+// @m_index: Position and launch count of running commands by handle
+//
+// Commands are kept in launch order and indexed by handle, so that a
+// command can be erased without a scan of the running commands.  A
+// command that is relaunched before the monitor has seen its
+// previous completion (e.g. completion was observed by polling the
+// command) is recorded once with a launch count.
+class running_set
+{
+  using order_type = std::list<xrt_core::command*>;
+
+  struct entry
+  {
+    order_type::iterator itr;
+    size_t launches = 0;
+  };
+
+  order_type m_order;
+  std::unordered_map<xrt_core::command*, entry> m_index;
+
+public:
+  bool
+  empty() const
+  {
+    return m_order.empty();
+  }
+
+  void
+  insert(xrt_core::command* cmd)
+  {
+    auto [itr, inserted] = m_index.try_emplace(cmd);
+    if (inserted)
+      itr->second.itr = m_order.insert(m_order.end(), cmd);
+    ++itr->second.launches;
+  }
+
+  // Erase one launch of a command, return false if the command
+  // is not in the set
+  bool
+  erase(xrt_core::command* cmd)
+  {
+    auto itr = m_index.find(cmd);
+    if (itr == m_index.end())
+      return false;
+
+    if (--itr->second.launches == 0) {
+      m_order.erase(itr->second.itr);
+      m_index.erase(itr);
+    }
+    return true;
+  }
+
+  // Notify and erase completed commands in launch order.  Legacy
+  // exec_wait reports only that some command completed, not which
+  // one, so the state of every running command must be checked.
+  void
+  notify_completed()
+  {
+    for (auto itr = m_order.begin(); itr != m_order.end();) {
+      auto cmd = *itr;
+      if (!completed(cmd)) {
+        ++itr;
+        continue;
+      }
+
+      m_index.erase(cmd);
+      itr = m_order.erase(itr);
+      notify_host(cmd);
+    }
+  }
+};
+
 // class command_manager - managed command executuon
 //
 // @m_qimpl: The hw queue used for command submission
+// @submitted_ring: Lock-free queue of launched commands
+// @m_mutex: Synchronize overflow and retired commands
+// @overflow_cmds: Launched commands that did not fit in submitted_ring
+// @retired_cmds: Launched commands to erase from the running set
+// @slow_path: Non zero if overflow_cmds or retired_cmds are not empty
+// @idle: Monitor thread is, or is about to be, waiting for work
 // @work_mutex: Syncrhonize monitor thread with launched commands
 // @work_cond: Kick off monitor thread when there are new commands
 // @monitor_thread: Thread for asynchronous monitoring of command execution
@@ -93,6 +268,16 @@ notify_host(xrt_core::command* cmd)
 // completion.  This is the OpenCL model but is also supported by
 // native XRT APIs.
 //
+// Launching a command is lock free in the common case.  The command
+// is pushed to a lock-free submission ring and the monitor thread is
+// signaled only if it is idle.  The overflow list, which is protected
+// by a mutex, is used only if the ring is full.
+//
+// The monitor thread keeps running commands in a set indexed by
+// command handle.  Commands that failed submission are pushed to a
+// retired list, which the monitor consumes and erases from the
+// running set by handle.
+//
 // The command manager requires submission and wait APIs to be implemented
 // by which ever object (hw queue) uses the manager.
 class command_manager
@@ -115,15 +300,60 @@ public:
   };
 
 private:
+  // Bound the monitor thread's wait for command completion such that
+  // it periodically revisits the submitted commands
+  static constexpr size_t monitor_wait_ms = 1000;
+
   executor* m_impl;
+  submission_ring submitted_ring;
+  std::mutex m_mutex;
+  command_queue_type overflow_cmds;
+  command_queue_type retired_cmds;
+  std::atomic<size_t> slow_path {0};
+  std::atomic<bool> idle {false};
   std::mutex work_mutex;
   std::condition_variable work_cond;
-  command_queue_type submitted_cmds;
   bool stop = false;
 
   // thread can be constructed only after data members are initialized
   std::thread monitor_thread;
 
+  // True if there are launched or retired commands not yet moved
+  // to the monitor
+  bool
+  pending() const
+  {
+    return !submitted_ring.empty() || slow_path.load(std::memory_order_relaxed);
+  }
+
+  // Move launched commands to the running set and erase retired
+  // commands from the running set
+  void
+  drain(running_set& running, command_queue_type& retired)
+  {
+    while (auto cmd = submitted_ring.pop())
+      running.insert(cmd);
+
+    if (slow_path.load(std::memory_order_acquire)) {
+      std::lock_guard lk(m_mutex);
+      for (auto cmd : overflow_cmds)
+        running.insert(cmd);
+      overflow_cmds.clear();
+      std::copy(retired_cmds.begin(), retired_cmds.end(), std::back_inserter(retired));
+      retired_cmds.clear();
+      slow_path.store(0, std::memory_order_relaxed);
+    }
+
+    // A retired command is erased by handle once it has been drained
+    // from the ring.  Its ring slot may be behind a slot that is not
+    // yet published, in which case the command is kept for the next
+    // drain.  The same command may have been relaunched successfully,
+    // so one launch is erased only.
+    auto end = std::remove_if(retired.begin(), retired.end(),
+                              [&running](auto cmd) { return running.erase(cmd); });
+    retired.erase(end, retired.end());
+  }
+
   // monitor_loop() - Manage running commands and notify on completion
   //
   // The monitor thread services managed command and asynchronously
@@ -134,57 +364,56 @@ private:
   void
   monitor_loop()
   {
-    std::vector<xrt_core::command*> busy_cmds;
-    std::vector<xrt_core::command*> running_cmds;
+    running_set running;
+    command_queue_type retired;
 
     while (true) {
 
-      // Larger wait synchronized with launch()
-      {
+      // Larger wait synchronized with launch().  The idle flag is
+      // set before checking for pending commands, launch() pushes
+      // before checking the flag, so either this thread sees the new
+      // command or launch() sees the flag and notifies.
+      if (running.empty()) {
         std::unique_lock<std::mutex> lk(work_mutex);
-        while (!stop && running_cmds.empty() && submitted_cmds.empty())
+        idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!stop && !pending())
           work_cond.wait(lk);
+        idle.store(false, std::memory_order_relaxed);
       }
 
       if (stop)
         return;
 
+      // Commands that failed submission are erased before the finer
+      // wait, which would otherwise block until the wait times out if
+      // no other commands are running.
+      drain(running, retired);
+      if (running.empty())
+        continue;
+
       // Finer wait
-      m_impl->wait(0);
+      m_impl->wait(monitor_wait_ms);
 
       // Drain submitted commands.  It is important that this comes
-      // after exec_wait and is synchronized with launch() that added
-      // to submitted_cmds.
+      // after exec_wait.
       //
-      // Scenario if before exec_wait is that a new command was added
-      // to submitted_cmds and exec_buf immediately after the critical
-      // section above and that the command completion happens in the
-      // exec_wait call. If submitted_cmds was drained, in for example
-      // above critical section, before the call to exec_wait it would
-      // not be in running_cmds and would not be notified of
-      // completion.
+      // Scenario if only before exec_wait is that a new command was
+      // added to submitted_ring and exec_buf immediately after the
+      // drain above and that the command completion happens in the
+      // exec_wait call. If submitted_ring was drained only before
+      // the call to exec_wait it would not be in the running set and
+      // would not be notified of completion.
       //
       // The sequence is very important.  It must be guaranteed that
       // exec_wait will never return for a command that is not yet
-      // in either running_cmds or submitted_cmds.
-      {
-        std::lock_guard<std::mutex> lk(work_mutex);
-        std::copy(submitted_cmds.begin(), submitted_cmds.end(), std::back_inserter(running_cmds));
-        submitted_cmds.clear();
-      }
-      // At this point running_cmds is guaranteed to contain the
-      // command(s) for which exec_wait returned.
+      // in either the running set or submitted_ring.  This is
+      // guaranteed by launch() publishing the command before exec_buf.
+      drain(running, retired);
 
-      // Preserve order of processing
-      for (auto cmd : running_cmds) {
-        if (completed(cmd))
-          notify_host(cmd);
-        else
-          busy_cmds.push_back(cmd);
-      }
-
-      running_cmds.swap(busy_cmds);
-      busy_cmds.clear();
+      // At this point the running set is guaranteed to contain the
+      // command(s) for which exec_wait returned.
+      running.notify_completed();
     } // while (1)
   }
 
@@ -206,6 +435,24 @@ private:
     }
   }
 
+  // Slow path of launch when submission ring is full
+  void
+  overflow(xrt_core::command* cmd)
+  {
+    std::lock_guard lk(m_mutex);
+    overflow_cmds.push_back(cmd);
+    slow_path.fetch_add(1, std::memory_order_release);
+  }
+
+  // Retire command that failed submission
+  void
+  abandon(xrt_core::command* cmd)
+  {
+    std::lock_guard lk(m_mutex);
+    retired_cmds.push_back(cmd);
+    slow_path.fetch_add(1, std::memory_order_release);
+  }
+
 public:
   // Constructor starts monitor thread
   explicit command_manager(executor* impl)
@@ -261,27 +508,28 @@ public:
     // Store command so completion can be tracked.  Make sure this is
     // done prior to exec_buf as exec_wait can otherwise be missed.
     // See detailed explanation in monitor loop.
-    {
-      std::lock_guard<std::mutex> lk(work_mutex);
-      submitted_cmds.push_back(cmd);
-    }
+    if (!submitted_ring.push(cmd))
+      overflow(cmd);
 
     // Submit the command
     try {
       m_impl->submit(cmd);
     }
     catch (...) {
-      // Remove the pending command
-      std::lock_guard<std::mutex> lk(work_mutex);
+      // Remove the pending command when monitor drains it
       assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
-      if (!submitted_cmds.empty())
-        submitted_cmds.pop_back();
+      abandon(cmd);
       throw;
     }
 
-    // This is somewhat expensive, it is better to have this after the
+    // Wake up the monitor thread only if it is idle.  This is
+    // somewhat expensive, it is better to have this after the
     // exec_buf call so that actual execution doesn't have to wait.
-    work_cond.notify_one();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lk(work_mutex);
+      work_cond.notify_one();
+    }
   }
 };
 
@@ -390,9 +638,10 @@ public:
   virtual std::cv_status
   wait(size_t timeout_ms) = 0;         // NOLINT override from base
 
-  // Wait for specified command to finish
+  // Wait for specified command to finish, polling command state
+  // first per the wait policy of the caller's hw context
   virtual std::cv_status
-  wait(const xrt_core::command* cmd, size_t timeout_ms) = 0;
+  wait(const xrt_core::command* cmd, size_t timeout_ms, const hw_queue::wait_policy& policy) = 0;
 
   // Poll for command completion
   virtual int
@@ -410,6 +659,14 @@ public:
   virtual void
   submit_signal(const xrt::fence& fence) = 0;
 
+  // Coalesce independent command submissions into chained commands.
+  // Only shim hw queues execute chained commands.
+  virtual void
+  set_coalescing(std::chrono::microseconds, size_t)
+  {
+    throw std::runtime_error("Submission coalescing is not supported for this device");
+  }
+
   // Managed start uses command manager for monitoring command
   // completion
   virtual void
@@ -428,17 +685,423 @@ public:
 
 };
 
+// class submit_coalescer - gather independent commands into chained commands
+//
+// Commands submitted within a time window of the first pending
+// command, or until a maximum number of commands are pending, are
+// chained into one ERT_CMD_CHAIN command which is submitted to the
+// hw queue with a single submit_command call.  This trades a few
+// microseconds of latency for fewer submissions when many commands
+// are submitted.  Chained commands are submitted through shim hw
+// queues only, which execute chained commands as for xrt::runlist.
+// The legacy kds drivers reject ERT_CMD_CHAIN.
+//
+// The shim tracks completion of the chained command only.  Its
+// completion is propagated to the individual commands by complete(),
+// which the queue must call before checking the state of a command
+// that was chained.  A command that is waited for or polled while its
+// chain is in flight is waited for or polled through its chain.
+//
+// Only commands that start compute units are coalesced.  The queue
+// must flush pending commands before submitting other commands to
+// preserve submission order.
+class submit_coalescer
+{
+  static constexpr size_t max_chain_size = 64;
+  static constexpr size_t max_free_execbufs = 16;
+  static constexpr size_t word_size = sizeof(uint32_t);
+  static constexpr size_t execbuf_size =
+    sizeof(ert_packet) + sizeof(ert_cmd_chain_data) + max_chain_size * sizeof(uint64_t);
+
+  using execbuf_type = std::pair<std::unique_ptr<xrt_core::buffer_handle>, ert_packet*>;
+
+  // Chained command in flight, shared with threads waiting for it
+  struct chain
+  {
+    command_queue_type cmds;
+    execbuf_type execbuf;
+  };
+
+  xrt_core::device* m_device;
+  hwqueue_handle* m_qhdl;
+  std::atomic<bool> m_enabled {false};
+  std::chrono::microseconds m_window {0};
+  size_t m_max_cmds = max_chain_size;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  std::chrono::steady_clock::time_point m_deadline;
+  command_queue_type m_pending;
+  std::vector<std::shared_ptr<chain>> m_inflight;
+  std::atomic<size_t> m_inflight_count {0};
+  std::vector<execbuf_type> m_free;
+  bool m_stop = false;
+  std::thread m_flusher;
+
+  // Statistics
+  std::atomic<uint64_t> m_chains {0};
+  uint64_t m_chained_cmds = 0;
+
+  execbuf_type
+  get_exec_buf()
+  {
+    if (!m_free.empty()) {
+      auto execbuf = std::move(m_free.back());
+      m_free.pop_back();
+      return execbuf;
+    }
+
+    auto bo = m_device->alloc_bo(execbuf_size, XCL_BO_FLAGS_EXECBUF);
+    auto pkt = static_cast<ert_packet*>(bo->map(xrt_core::buffer_handle::map_type::write));
+    return {std::move(bo), pkt};
+  }
+
+  void
+  release_exec_buf(execbuf_type&& execbuf)
+  {
+    execbuf.first->reset(); // unbind chained commands
+    if (m_free.size() < max_free_execbufs) {
+      m_free.push_back(std::move(execbuf));
+      return;
+    }
+
+    execbuf.first->unmap(execbuf.second);
+  }
+
+  // Release execbuf of a completed chain unless other threads still
+  // wait for the chain.  The last waiter releases the execbuf.
+  void
+  release_nolock(std::shared_ptr<chain>&& c)
+  {
+    if (c.use_count() == 1 && c->execbuf.first)
+      release_exec_buf(std::move(c->execbuf));
+    c.reset();
+  }
+
+  // Chain in flight with specified command
+  std::shared_ptr<chain>
+  find_chain(const xrt_core::command* cmd)
+  {
+    if (!m_inflight_count.load(std::memory_order_relaxed))
+      return nullptr;
+
+    std::lock_guard lk(m_mutex);
+    auto itr = std::find_if(m_inflight.begin(), m_inflight.end(),
+                            [cmd](const auto& c) {
+                              return std::find(c->cmds.begin(), c->cmds.end(), cmd) != c->cmds.end();
+                            });
+    return (itr != m_inflight.end()) ? *itr : nullptr;
+  }
+
+  // Chain completion is checked through the shim before the packet
+  // state is read, as for any command submitted to a hw queue.
+  bool
+  is_complete(const chain& c) const
+  {
+    volatile auto pkt = c.execbuf.second;
+    return m_qhdl->poll_command(c.execbuf.first.get()) && pkt->state >= ERT_CMD_STATE_COMPLETED;
+  }
+
+  // Propagate state of completed chain to its commands.  Commands
+  // prior to a failing command completed, commands after a failing
+  // command are aborted.
+  static void
+  propagate(const chain& c)
+  {
+    auto pkt = c.execbuf.second;
+    auto chain_state = static_cast<ert_cmd_state>(pkt->state);
+    auto error_index = (chain_state == ERT_CMD_STATE_COMPLETED)
+      ? c.cmds.size()
+      : get_ert_cmd_chain_data(pkt)->error_index;
+
+    for (size_t idx = 0; idx < c.cmds.size(); ++idx) {
+      volatile auto cmd_pkt = c.cmds[idx]->get_ert_packet();
+      if (idx < error_index)
+        cmd_pkt->state = ERT_CMD_STATE_COMPLETED;
+      else if (idx == error_index)
+        cmd_pkt->state = chain_state;
+      else
+        cmd_pkt->state = ERT_CMD_STATE_ABORT;
+    }
+  }
+
+  // Submit pending commands.  A single pending command is submitted
+  // as is, multiple commands are chained.  Submission errors are
+  // reflected in the state of the pending commands as the commands
+  // may have been started by other threads.
+  void
+  flush_nolock()
+  {
+    if (m_pending.empty())
+      return;
+
+    auto c = std::make_shared<chain>();
+    c->cmds = std::move(m_pending);
+    m_pending.clear();
+
+    for (auto cmd : c->cmds)
+      cmd->notify_start();
+
+    try {
+      if (c->cmds.size() == 1) {
+        m_qhdl->submit_command(c->cmds.front()->get_exec_bo());
+        return;
+      }
+
+      c->execbuf = get_exec_buf();
+      auto [bo, pkt] = std::make_pair(c->execbuf.first.get(), c->execbuf.second);
+      pkt->opcode = ERT_CMD_CHAIN;
+      auto chain_data = get_ert_cmd_chain_data(pkt);
+      std::memset(chain_data, 0, sizeof(*chain_data));
+      for (auto cmd : c->cmds) {
+        auto cmd_bo = cmd->get_exec_bo();
+        auto props = cmd_bo->get_properties();
+        chain_data->data[chain_data->command_count] = props.kmhdl;
+        bo->bind_at(chain_data->command_count, cmd_bo, 0, props.size);
+        ++chain_data->command_count;
+      }
+      pkt->count = (sizeof(ert_cmd_chain_data) + chain_data->command_count * sizeof(uint64_t)) / word_size;
+      pkt->state = ERT_CMD_STATE_NEW;
+
+      // Track the chain before submitting, waiters look up the
+      // chain of a command as soon as the chain is submitted.
+      m_inflight.push_back(c);
+      try {
+        m_qhdl->submit_command(bo);
+      }
+      catch (...) {
+        m_inflight.pop_back();
+        throw;
+      }
+      m_inflight_count = m_inflight.size();
+      ++m_chains;
+      m_chained_cmds += c->cmds.size();
+    }
+    catch (const std::exception& ex) {
+      for (auto cmd : c->cmds)
+        cmd->get_ert_packet()->state = ERT_CMD_STATE_ERROR;
+      if (c->execbuf.first)
+        release_exec_buf(std::move(c->execbuf));
+      xrt_core::message::send(xrt_core::message::severity_level::error, "XRT",
+                              std::string("failed to submit coalesced commands: ") + ex.what());
+    }
+  }
+
+  // Flusher thread submits pending commands when the time window
+  // of the first pending command expires.
+  void
+  flusher()
+  {
+    std::unique_lock lk(m_mutex);
+    while (!m_stop) {
+      if (m_pending.empty())
+        m_work.wait(lk);
+      else if (std::chrono::steady_clock::now() >= m_deadline)
+        flush_nolock();
+      else
+        m_work.wait_until(lk, m_deadline);
+    }
+  }
+
+public:
+  submit_coalescer(xrt_core::device* device, hwqueue_handle* qhdl)
+    : m_device(device)
+    , m_qhdl(qhdl)
+  {}
+
+  ~submit_coalescer()
+  {
+    try {
+      {
+        std::lock_guard lk(m_mutex);
+        flush_nolock();
+        m_stop = true;
+      }
+      m_work.notify_all();
+      if (m_flusher.joinable())
+        m_flusher.join();
+
+      for (auto& c : m_inflight)
+        c->execbuf.first->unmap(c->execbuf.second);
+      for (auto& execbuf : m_free)
+        execbuf.first->unmap(execbuf.second);
+
+      if (m_chains)
+        xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                                "submit coalescer: chains(%llu) commands(%llu)",
+                                static_cast<unsigned long long>(m_chains),
+                                static_cast<unsigned long long>(m_chained_cmds));
+    }
+    catch (...) {
+    }
+  }
+
+  submit_coalescer(const submit_coalescer&) = delete;
+  submit_coalescer(submit_coalescer&&) = delete;
+  submit_coalescer& operator=(const submit_coalescer&) = delete;
+  submit_coalescer& operator=(submit_coalescer&&) = delete;
+
+  // Set coalescing window and max number of commands per chain.  A
+  // window of 0 disables coalescing.
+  void
+  configure(std::chrono::microseconds window, size_t max_cmds)
+  {
+    std::lock_guard lk(m_mutex);
+    flush_nolock();
+    m_window = window;
+    m_max_cmds = std::clamp<size_t>(max_cmds, 1, max_chain_size);
+    m_enabled = (window.count() > 0 && m_max_cmds > 1);
+    if (m_enabled && !m_flusher.joinable())
+      m_flusher = xrt_core::thread(&submit_coalescer::flusher, this);
+  }
+
+  bool
+  enabled() const
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  // True if any commands have been chained, the state of a command
+  // that is not in flight must then be checked before the shim is
+  // asked about the command.
+  bool
+  used() const
+  {
+    return m_chains.load(std::memory_order_relaxed) > 0;
+  }
+
+  // Check if command can be chained with other commands
+  static bool
+  is_coalescable(const xrt_core::command* cmd)
+  {
+    switch (cmd->get_ert_packet()->opcode) {
+    case ERT_START_CU:
+    case ERT_EXEC_WRITE:
+    case ERT_START_KEY_VAL:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  void
+  submit(xrt_core::command* cmd)
+  {
+    std::lock_guard lk(m_mutex);
+    m_pending.push_back(cmd);
+    if (m_pending.size() >= m_max_cmds) {
+      flush_nolock();
+      return;
+    }
+
+    if (m_pending.size() == 1) {
+      m_deadline = std::chrono::steady_clock::now() + m_window;
+      m_work.notify_one();
+    }
+  }
+
+  // Submit all pending commands
+  void
+  flush()
+  {
+    std::lock_guard lk(m_mutex);
+    flush_nolock();
+  }
+
+  // Submit pending commands if specified command is pending.  Used
+  // to avoid waiting for the time window to expire when waiting for
+  // a command.
+  void
+  flush(const xrt_core::command* cmd)
+  {
+    std::lock_guard lk(m_mutex);
+    if (std::find(m_pending.begin(), m_pending.end(), cmd) != m_pending.end())
+      flush_nolock();
+  }
+
+  // Propagate state of completed chains to chained commands.
+  void
+  complete()
+  {
+    if (!m_inflight_count.load(std::memory_order_relaxed))
+      return;
+
+    std::lock_guard lk(m_mutex);
+    auto end = std::partition(m_inflight.begin(), m_inflight.end(),
+                              [this](const auto& c) { return !is_complete(*c); });
+    for (auto itr = end; itr != m_inflight.end(); ++itr) {
+      propagate(**itr);
+      release_nolock(std::move(*itr));
+    }
+    m_inflight.erase(end, m_inflight.end());
+    m_inflight_count = m_inflight.size();
+  }
+
+  // Wait for the chain of a command in flight.  Return std::nullopt
+  // if the command is not in flight in a chain, otherwise the status
+  // of the wait.  The state of the chain is propagated to the command
+  // when the chain completes.
+  std::optional<std::cv_status>
+  wait(const xrt_core::command* cmd, size_t timeout_ms, const hw_queue::wait_policy& policy)
+  {
+    auto c = find_chain(cmd);
+    if (!c)
+      return std::nullopt;
+
+    auto bo = c->execbuf.first.get();
+    auto status = policy.spin_wait([this, &c] { return is_complete(*c); }, timeout_ms);
+    if (!status && m_qhdl->wait_command(bo, static_cast<uint32_t>(timeout_ms)))
+      status = std::cv_status::no_timeout;
+
+    complete();
+
+    std::lock_guard lk(m_mutex);
+    release_nolock(std::move(c));
+    return status.value_or(std::cv_status::timeout);
+  }
+
+  // Poll the chain of a command in flight.  Return std::nullopt if the
+  // command is not in flight in a chain, otherwise 0 if the chain is
+  // still running.
+  std::optional<int>
+  poll(const xrt_core::command* cmd)
+  {
+    auto c = find_chain(cmd);
+    if (!c)
+      return std::nullopt;
+
+    auto running = !is_complete(*c);
+    if (!running)
+      complete();
+
+    std::lock_guard lk(m_mutex);
+    release_nolock(std::move(c));
+    return running ? 0 : 1;
+  }
+};
+
 // class qds_device - queue implementation for shim queue support
 class qds_device : public hw_queue_impl
 {
   xrt::hw_context m_hwctx;
   hwqueue_handle* m_qhdl;
+  submit_coalescer m_coalescer;
 
 public:
   qds_device(xrt::hw_context hwctx, hwqueue_handle* qhdl)
     : m_hwctx(std::move(hwctx))
     , m_qhdl(qhdl)
-  {}
+    , m_coalescer(xrt_core::hw_context_int::get_core_device_raw(m_hwctx), qhdl)
+  {
+    if (auto window = xrt_core::config::get_submit_coalesce_window_us())
+      m_coalescer.configure(std::chrono::microseconds(window), xrt_core::config::get_submit_coalesce_max());
+  }
+
+  void
+  set_coalescing(std::chrono::microseconds window, size_t max_cmds) override
+  {
+    m_coalescer.configure(window, max_cmds);
+  }
 
   // Managed start is invoked when application has added a callback
   // function for notification of command completion. This is not
@@ -462,16 +1125,37 @@ public:
   }
 
   std::cv_status
-  wait(const xrt_core::command* cmd, size_t timeout_ms) override
+  wait(const xrt_core::command* cmd, size_t timeout_ms, const hw_queue::wait_policy& policy) override
   {
     // Dispatch wait to shim hwqueue_handle rather than accessing
     // pkt state directly.  This is done to allow shim direct control
-    // over command completion and command state.
-    if (m_qhdl->wait_command(cmd->get_exec_bo(), static_cast<int>(timeout_ms)) == 0)
-      return std::cv_status::timeout;
+    // over command completion and command state.  Polling defers to
+    // the shim for command state as well.  A chained command is
+    // waited for through its chain, which is what the shim knows.
+    volatile auto pkt = cmd->get_ert_packet();
+    if (m_coalescer.enabled())
+      // Don't wait for coalescing window to expire if the command
+      // is still pending submission
+      m_coalescer.flush(cmd);
+
+    if (auto status = m_coalescer.wait(cmd, timeout_ms, policy)) {
+      if (*status == std::cv_status::timeout)
+        return std::cv_status::timeout;
+    }
+    else if (!m_coalescer.used() || pkt->state < ERT_CMD_STATE_COMPLETED) {
+      auto bo = cmd->get_exec_bo();
+      auto status = policy.spin_wait([this, bo, pkt] {
+        return m_qhdl->poll_command(bo) && pkt->state >= ERT_CMD_STATE_COMPLETED;
+      }, timeout_ms);
+
+      if (status == std::cv_status::timeout)
+        return std::cv_status::timeout;
+
+      if (!status && m_qhdl->wait_command(bo, static_cast<int>(timeout_ms)) == 0)
+        return std::cv_status::timeout;
+    }
 
     // Validate command state
-    auto pkt = cmd->get_ert_packet();
     if (pkt->state < ERT_CMD_STATE_COMPLETED)
       // unexpected state
       throw std::runtime_error("qds_device::wait() unexpected command state");
@@ -487,12 +1171,25 @@ public:
   void
   submit(xrt_core::command* cmd) override
   {
+    if (m_coalescer.enabled()) {
+      if (submit_coalescer::is_coalescable(cmd)) {
+        m_coalescer.submit(cmd);
+        return;
+      }
+
+      // preserve submission order
+      m_coalescer.flush();
+    }
+
     m_qhdl->submit_command(cmd->get_exec_bo());
   }
 
   void
   submit(xrt_core::buffer_handle* cmd) override
   {
+    if (m_coalescer.enabled())
+      m_coalescer.flush();
+
     m_qhdl->submit_command(cmd);
   }
 
@@ -506,9 +1203,23 @@ public:
 
   // Poll for command completion. Return value different from 0 indicates
   // that the command state should be checked to determine completion.
+  // A command pending submission is flushed, a caller that only polls
+  // would otherwise depend on the flusher thread.  A chained command
+  // is polled through its chain.
   int
   poll(const xrt_core::command* cmd) const override
   {
+    auto self = const_cast<qds_device*>(this); // NOLINT
+    if (m_coalescer.enabled())
+      self->m_coalescer.flush(cmd);
+
+    if (auto status = self->m_coalescer.poll(cmd))
+      return *status;
+
+    volatile auto pkt = cmd->get_ert_packet();
+    if (m_coalescer.used() && pkt->state >= ERT_CMD_STATE_COMPLETED)
+      return 1;
+
     return m_qhdl->poll_command(cmd->get_exec_bo());
   }
 
@@ -668,9 +1379,16 @@ public:
   }
 
   std::cv_status
-  wait(const xrt_core::command* cmd, size_t timeout_ms) override
+  wait(const xrt_core::command* cmd, size_t timeout_ms, const hw_queue::wait_policy& policy) override
   {
     volatile auto pkt = cmd->get_ert_packet();
+    auto status = policy.spin_wait([pkt] {
+      return pkt->state >= ERT_CMD_STATE_COMPLETED;
+    }, timeout_ms);
+
+    if (status == std::cv_status::timeout)
+      return std::cv_status::timeout;
+
     while (pkt->state < ERT_CMD_STATE_COMPLETED) {
       // return immediately on timeout
       if (exec_wait(timeout_ms) == std::cv_status::timeout)
@@ -878,14 +1596,38 @@ namespace xrt_core {
 ////////////////////////////////////////////////////////////////
 // Public APIs
 ////////////////////////////////////////////////////////////////
+std::shared_ptr<hw_queue::wait_policy>
+hw_queue::
+create_wait_policy()
+{
+  static auto strategy = [] {
+    auto str = xrt_core::config::get_hw_queue_wait_strategy();
+    if (str == "block")
+      return wait_strategy::block;
+    if (str == "spin")
+      return wait_strategy::spin;
+    if (str == "hybrid")
+      return wait_strategy::hybrid;
+
+    xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                            "Unknown hw queue wait strategy '" + str + "', using block");
+    return wait_strategy::block;
+  }();
+  static auto spin_time = std::chrono::microseconds(xrt_core::config::get_hw_queue_spin_us());
+  return std::make_shared<wait_policy>(strategy, spin_time);
+}
+
 hw_queue::
 hw_queue(const xrt::hw_context& hwctx)
   : xrt::detail::pimpl<hw_queue_impl>(get_hw_queue_impl(hwctx))
+  , m_wait_policy(xrt_core::hw_context_int::get_wait_policy(hwctx))
 {}
 
+// Commands not tied to a hw context wait per xrt.ini
 hw_queue::
 hw_queue(const xrt_core::device* device)
   : xrt::detail::pimpl<hw_queue_impl>(get_hw_queue_impl(device))
+  , m_wait_policy(create_wait_policy())
 {}
 
 void
@@ -921,7 +1663,7 @@ void
 hw_queue::
 wait(const xrt_core::command* cmd) const
 {
-  get_handle()->wait(cmd, 0);
+  get_handle()->wait(cmd, 0, *m_wait_policy);
 }
 
 int
@@ -938,6 +1680,27 @@ poll(xrt_core::buffer_handle* cmd) const
   return get_handle()->poll(cmd);
 }
 
+void
+hw_queue::
+set_coalescing(std::chrono::microseconds window, size_t max_cmds)
+{
+  get_handle()->set_coalescing(window, max_cmds);
+}
+
+void
+hw_queue::
+set_wait_strategy(wait_strategy strategy, std::chrono::microseconds spin_time)
+{
+  m_wait_policy->set(strategy, spin_time);
+}
+
+hw_queue::wait_strategy
+hw_queue::
+get_wait_strategy() const
+{
+  return m_wait_policy->get_strategy();
+}
+
 void
 hw_queue::
 submit_wait(const xrt::fence& fence)
@@ -957,7 +1720,7 @@ std::cv_status
 hw_queue::
 wait(const xrt_core::command* cmd, const std::chrono::milliseconds& timeout_ms) const
 {
-  return get_handle()->wait(cmd, timeout_ms.count());
+  return get_handle()->wait(cmd, timeout_ms.count(), *m_wait_policy);
 }
 
 std::cv_status
@@ -1,14 +1,25 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_COMMON_API_HW_QUEUE_H
 #define XRT_COMMON_API_HW_QUEUE_H
 
 #include "core/common/config.h"
 #include "xrt/detail/pimpl.h"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <memory>
+#include <optional>
+#include <thread>
 #include <vector>
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+# include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+#endif
+
 namespace xrt {
 class fence;  
 class hw_context;
@@ -29,10 +40,112 @@ class hw_queue_impl;
 class hw_queue : public xrt::detail::pimpl<hw_queue_impl>
 {
 public:
+  // How a thread waits for completion of a command
+  //  block:  wait in the driver for command completion
+  //  spin:   poll command state until completion or timeout
+  //  hybrid: poll command state for a while, then wait in driver
+  enum class wait_strategy { block, spin, hybrid };
+
+  // class wait_policy - how threads wait for completion of commands
+  //
+  // Each hw context has its own policy, initialized from
+  // Runtime.hw_queue_wait_strategy and Runtime.hw_queue_spin_us.  The
+  // policy of a context applies to commands waited for through its
+  // queues, also when the queue implementation is shared by all
+  // contexts of the device.
+  class wait_policy
+  {
+    std::atomic<wait_strategy> m_strategy;
+    std::atomic<std::chrono::microseconds::rep> m_spin_us;
+
+    // Tell the CPU that the thread is spinning, so that it does not
+    // starve a hyperthread sibling
+    static void
+    cpu_relax()
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+      _mm_pause();
+#elif defined(_M_ARM64)
+      __yield();
+#elif defined(__aarch64__) || defined(__arm__)
+      asm volatile("yield" ::: "memory");
+#endif
+    }
+
+  public:
+    wait_policy(wait_strategy strategy, std::chrono::microseconds spin_time)
+      : m_strategy(strategy)
+      , m_spin_us(spin_time.count())
+    {}
+
+    void
+    set(wait_strategy strategy, std::chrono::microseconds spin_time)
+    {
+      m_spin_us = spin_time.count();
+      m_strategy = strategy;
+    }
+
+    wait_strategy
+    get_strategy() const
+    {
+      return m_strategy.load(std::memory_order_relaxed);
+    }
+
+    std::chrono::microseconds
+    get_spin_time() const
+    {
+      return std::chrono::microseconds(m_spin_us.load(std::memory_order_relaxed));
+    }
+
+    // Poll 'completed' per the strategy before the caller blocks.
+    // Return std::nullopt if the caller must block, otherwise the
+    // status of the wait.  A spinning wait times out after
+    // 'timeout_ms', 0 implies infinite wait.
+    template <typename Predicate>
+    std::optional<std::cv_status>
+    spin_wait(Predicate completed, size_t timeout_ms) const
+    {
+      auto strategy = get_strategy();
+      if (strategy == wait_strategy::block)
+        return std::nullopt;
+
+      using clock = std::chrono::steady_clock;
+      auto deadline = clock::time_point::max();
+      if (strategy == wait_strategy::hybrid)
+        deadline = clock::now() + get_spin_time();
+      else if (timeout_ms)
+        deadline = clock::now() + std::chrono::milliseconds(timeout_ms);
+
+      // Amortize reading the clock over several polls, and give up
+      // the CPU to other threads as often as the clock is read
+      constexpr unsigned int polls_per_clock = 64;
+      for (unsigned int count = 1; !completed(); ++count) {
+        cpu_relax();
+        if (count % polls_per_clock)
+          continue;
+
+        if (clock::now() >= deadline)
+          return (strategy == wait_strategy::spin)
+            ? std::optional<std::cv_status>{std::cv_status::timeout}
+            : std::nullopt;
+
+        std::this_thread::yield();
+      }
+
+      return std::cv_status::no_timeout;
+    }
+  };
+
+  // Create a wait policy per xrt.ini for a new hw context
+  XRT_CORE_COMMON_EXPORT
+  static std::shared_ptr<wait_policy>
+  create_wait_policy();
+
   // Default queue without any implementation, use for assignment
   hw_queue() = default;
 
   // Construct from hwctx
+  XRT_CORE_COMMON_EXPORT
   explicit
   hw_queue(const xrt::hw_context& hwctx);
 
@@ -84,6 +197,28 @@ public:
   int
   poll(xrt_core::buffer_handle*) const;
 
+  // Coalesce independent command submissions into chained commands.
+  // Commands submitted within 'window' of the first pending command,
+  // or until 'max_cmds' commands are pending, are submitted as one
+  // chained command.  A window of 0 disables coalescing.  Throws if
+  // queue does not support coalescing.  Only shim hw queues execute
+  // chained commands.
+  void
+  set_coalescing(std::chrono::microseconds window, size_t max_cmds);
+
+  // Select how threads wait for completion of commands of the hw
+  // context of this queue, see wait_policy.  The 'spin_time' applies
+  // to wait_strategy::hybrid only.  Threads waiting for some command
+  // with exec_wait always block.
+  void
+  set_wait_strategy(wait_strategy strategy, std::chrono::microseconds spin_time);
+
+  // Strategy of waits for commands through this queue, which is the
+  // strategy of the hw context of the queue
+  XRT_CORE_COMMON_EXPORT
+  wait_strategy
+  get_wait_strategy() const;
+
   // Enqueue a command dependency
   void
   submit_wait(const xrt::fence& fence);
@@ -109,6 +244,10 @@ public:
   XRT_CORE_COMMON_EXPORT
   static void
   stop();
+
+private:
+  // Wait policy of the hw context, shared by queues of the context
+  std::shared_ptr<wait_policy> m_wait_policy;
 };
 
 } // namespace xrt_core
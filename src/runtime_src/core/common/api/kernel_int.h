@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2020 Xilinx, Inc
-// Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Xilinx Runtime (XRT) Experimental APIs
 
@@ -11,6 +11,7 @@
 #include "core/include/xrt/experimental/xrt_kernel.h"
 #include "core/include/xrt/experimental/xrt_xclbin.h"
 
+#include "core/common/bo_cache.h"
 #include "core/common/config.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/shim/buffer_handle.h"
@@ -87,11 +88,22 @@ get_regmap_size(const xrt::kernel& kernel);
 xrt::hw_context
 get_hw_ctx(const xrt::kernel& kernel);
 
+// Counters of the exec buffer pool used by the device on which the
+// kernel was created.  Used to size the pool (Runtime.exec_bo_cache).
+XRT_CORE_COMMON_EXPORT
+xrt_core::bo_cache_stats
+get_exec_buffer_stats(const xrt::kernel& kernel);
+
 // Allows the creation of the kernel object from a kernel_impl pointer
 // This is used for logging usage mertrics
 xrt::kernel
 create_kernel_from_implementation(const xrt::kernel_impl* kernel_impl);
 
+// Unique id of kernel implementation, distinguishes a kernel from a
+// destructed kernel at the same address.  Used for logging usage metrics
+uint32_t
+get_uid(const xrt::kernel_impl* kernel_impl);
+
 }} // kernel_int, xrt_core
 
 #endif
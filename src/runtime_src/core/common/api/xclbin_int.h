@@ -12,6 +12,7 @@
 #include "core/common/xclbin_parser.h"
 
 #include <cstring>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -68,6 +69,13 @@ XRT_CORE_COMMON_EXPORT
 std::string
 get_project_name(const xrt::xclbin& xclbin);
 
+// get_xml_index() - Index of xml meta data
+// The index is built once per xclbin, nullptr if the xclbin has
+// no xml meta data.
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<const xrt_core::xclbin::xml_index>
+get_xml_index(const xrt::xclbin& xclbin);
+
 }} // xclbin_int, xrt_core
 
 #endif
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2020-2022 Xilinx, Inc
-// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 // This file implements XRT BO APIs as declared in
 // core/include/experimental/xrt_bo.h
@@ -21,6 +21,7 @@
 #include "hw_context_int.h"
 #include "kernel_int.h"
 #include "core/common/api/bo_int.h"
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
 #include "core/common/memalign.h"
 #include "core/common/message.h"
@@ -33,10 +34,16 @@
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/shared_handle.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
+#include <exception>
+#include <future>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifdef _WIN32
@@ -112,6 +119,30 @@ send_exception_message(const std::string& msg)
   send_exception_message(msg.c_str());
 }
 
+// Copy host memory using up to Runtime.copy_through_host_threads
+// threads.  Each thread copies at least min_piece bytes so that
+// threads are used for large copies only.
+void
+parallel_memcpy(char* dst, const char* src, size_t sz)
+{
+  constexpr size_t min_piece = 1024 * 1024;
+  auto threads = std::min<size_t>(xrt_core::config::get_copy_through_host_threads(), sz / min_piece);
+  if (threads <= 1) {
+    std::memcpy(dst, src, sz);
+    return;
+  }
+
+  auto piece = (sz + threads - 1) / threads;
+  std::vector<std::future<void>> copies;
+  for (size_t offset = piece; offset < sz; offset += piece)
+    copies.push_back(std::async(std::launch::async, [=] {
+      std::memcpy(dst + offset, src + offset, std::min(piece, sz - offset));
+    }));
+  std::memcpy(dst, src, piece);
+  for (auto& copy : copies)
+    copy.get();
+}
+
 } // namespace
 
 namespace {
@@ -431,6 +462,10 @@ public:
     copy(src_import_bo.get_handle().get(), sz, src_offset, dst_offset);
   }
 
+  // Copy through host in chunks of Runtime.copy_through_host_chunk_kb.
+  // Chunks are pipelined such that chunk i+1 is synced from the source
+  // device buffer while chunk i is copied on host and chunk i-1 is
+  // synced to the destination device buffer.
   void
   copy_through_host(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset)
   {
@@ -444,13 +479,100 @@ public:
 
     // sync to src to ensure data integrity, logically const
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast) // special case
-    const_cast<bo_impl*>(src)->sync(XCL_BO_SYNC_BO_FROM_DEVICE, sz, src_offset);
+    auto src_bo = const_cast<bo_impl*>(src);
+
+    size_t chunk_size = xrt_core::config::get_copy_through_host_chunk_kb() * 1024;
+    if (!chunk_size || sz <= chunk_size) {
+      src_bo->sync(XCL_BO_SYNC_BO_FROM_DEVICE, sz, src_offset);
+      parallel_memcpy(dst_hbuf + dst_offset, src_hbuf + src_offset, sz);
+      sync(XCL_BO_SYNC_BO_TO_DEVICE, sz, dst_offset);
+      return;
+    }
+
+    // Pipeline stages wait for the previous stage to complete a chunk.
+    // An error in any stage stops all stages.
+    std::mutex mutex;
+    std::condition_variable work;
+    size_t fetched = 0;  // chunks synced from source device buffer
+    size_t copied = 0;   // chunks copied on host
+    std::exception_ptr error;
+
+    auto num_chunks = (sz + chunk_size - 1) / chunk_size;
+    auto chunk_length = [sz, chunk_size](size_t idx) { return std::min(chunk_size, sz - idx * chunk_size); };
+
+    auto wait_for = [&](const size_t& count, size_t idx) {
+      std::unique_lock lk(mutex);
+      work.wait(lk, [&] { return count > idx || error; });
+      return !error;
+    };
+    auto complete = [&](size_t& count) {
+      {
+        std::lock_guard lk(mutex);
+        ++count;
+      }
+      work.notify_all();
+    };
+    auto fail = [&] {
+      {
+        std::lock_guard lk(mutex);
+        if (!error)
+          error = std::current_exception();
+      }
+      work.notify_all();
+    };
+
+    std::thread fetcher([&] {
+      try {
+        for (size_t idx = 0; idx < num_chunks; ++idx) {
+          {
+            std::lock_guard lk(mutex);
+            if (error)
+              return;
+          }
+          src_bo->sync(XCL_BO_SYNC_BO_FROM_DEVICE, chunk_length(idx), src_offset + idx * chunk_size);
+          complete(fetched);
+        }
+      }
+      catch (...) {
+        fail();
+      }
+    });
+
+    // Stop and join the fetcher if the writer cannot be started
+    std::thread writer;
+    try {
+      writer = std::thread([&] {
+        try {
+          for (size_t idx = 0; idx < num_chunks && wait_for(copied, idx); ++idx)
+            sync(XCL_BO_SYNC_BO_TO_DEVICE, chunk_length(idx), dst_offset + idx * chunk_size);
+        }
+        catch (...) {
+          fail();
+        }
+      });
+    }
+    catch (...) {
+      fail();
+      fetcher.join();
+      throw;
+    }
+
+    try {
+      for (size_t idx = 0; idx < num_chunks && wait_for(fetched, idx); ++idx) {
+        auto offset = idx * chunk_size;
+        parallel_memcpy(dst_hbuf + dst_offset + offset, src_hbuf + src_offset + offset, chunk_length(idx));
+        complete(copied);
+      }
+    }
+    catch (...) {
+      fail();
+    }
 
-    // copy host side buffer
-    std::memcpy(dst_hbuf + dst_offset, src_hbuf + src_offset, sz);
+    fetcher.join();
+    writer.join();
 
-    // sync modified host buffer to device
-    sync(XCL_BO_SYNC_BO_TO_DEVICE, sz, dst_offset);
+    if (error)
+      std::rethrow_exception(error);
   }
 
   void
@@ -484,6 +606,15 @@ public:
     m_usage_logger->log_buffer_sync(device->get_device_id(), device.get_hwctx_handle(), sz, dir);
   }
 
+  // Sync several ranges with one request to the shim
+  virtual void
+  sync_ranges(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges)
+  {
+    handle->sync_ranges(static_cast<xrt_core::buffer_handle::direction>(dir), ranges);
+    for (const auto& r : ranges)
+      m_usage_logger->log_buffer_sync(device->get_device_id(), device.get_hwctx_handle(), r.size, dir);
+  }
+
   virtual uint64_t
   get_address() const
   {
@@ -892,6 +1023,13 @@ public:
     }
   }
 
+  void
+  sync_ranges(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges) override
+  {
+    for (const auto& r : ranges)
+      sync(dir, r.size, r.offset);
+  }
+
   void
   copy(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset) override
   {
@@ -958,6 +1096,19 @@ public:
     // sync through parent buffer, which handles nodma case also
     m_parent->sync(dir, sz, off);
   }
+
+  void
+  sync_ranges(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges) override
+  {
+    auto parent_ranges = ranges;
+    for (auto& r : parent_ranges) {
+      r.offset += m_offset;
+      if (r.offset + r.size > m_parent->get_size())
+        throw xrt_core::error(-EINVAL, "Invalid offset and size when syncing sub buffer");
+    }
+
+    m_parent->sync_ranges(dir, parent_ranges);
+  }
 };
 
 // class buffer_xbuf - Wrapper for extern managed xclBufferHandle
@@ -993,6 +1144,12 @@ public:
     throw xrt_core::error(std::errc::not_supported, "no sync of xcl managed BOs");
   }
 
+  void
+  sync_ranges(xclBOSyncDirection, const std::vector<xrt_core::buffer_handle::range>&) override
+  {
+    throw xrt_core::error(std::errc::not_supported, "no sync of xcl managed BOs");
+  }
+
   bool
   is_sub() const override
   {
@@ -1712,6 +1869,13 @@ get_offset(const xrt::bo& bo)
   return handle->get_offset();
 }
 
+void
+sync(const xrt::bo& bo, xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges)
+{
+  auto handle = bo.get_handle();
+  handle->sync_ranges(dir, ranges);
+}
+
 static xrtBufferFlags
 compose_internal_bo_flags(use_type type)
 {
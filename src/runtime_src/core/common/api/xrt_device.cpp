@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2020-2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022-2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 // This file implements XRT xclbin APIs as declared in
 // core/include/experimental/xrt_device.h
@@ -22,6 +22,7 @@
 #include "core/common/trace.h"
 #include "core/common/sysinfo.h"
 
+#include "command_stats.h"
 #include "device_int.h"
 #include "handle.h"
 #include "hw_queue.h"
@@ -188,6 +189,8 @@ get_info(const xrt_core::device* device, xrt::info::device param, const xrt::det
     return json_str(xrt_core::aie::aie_shim(device), abi);
   case xrt::info::device::aie_mem : // std::string
     return json_str(xrt_core::aie::aie_mem(device), abi);
+  case xrt::info::device::command_stats : // std::string
+    return json_str(xrt_core::command_stats::device_stats(device->get_device_id()), abi);
   case xrt::info::device::host : // std::string
     boost::property_tree::ptree pt;
     xrt_core::sysinfo::get_xrt_info(pt);
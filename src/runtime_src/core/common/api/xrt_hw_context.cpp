@@ -16,8 +16,10 @@
 #include "core/include/xrt/xrt_hw_context.h"
 #include "core/include/xrt/experimental/xrt_ext.h"
 #include "bo_int.h"
+#include "command_stats.h"
 #include "elf_int.h"
 #include "hw_context_int.h"
+#include "hw_queue.h"
 #include "xclbin_int.h"
 
 #include "core/common/device.h"
@@ -26,6 +28,8 @@
 #include "core/common/usage_metrics.h"
 #include "core/common/xdp/profile.h"
 
+#include <boost/property_tree/json_parser.hpp>
+
 #include <cstddef>
 #include <ctime>
 #include <fstream>
@@ -82,6 +86,7 @@ class hw_context_impl : public std::enable_shared_from_this<hw_context_impl>
       // tweak dump interval, size_per_uc based on experiments
       constexpr size_t size_per_uc = 2_mb;
       constexpr size_t dump_interval_ms = 50;
+      constexpr size_t max_dump_interval_ms = 1000;
       constexpr size_t metadata_size = sizeof(xrt_core::buffer_dumper::log_entry);
       constexpr size_t count_offset = 0;
       constexpr size_t count_size = 8;
@@ -117,6 +122,11 @@ class hw_context_impl : public std::enable_shared_from_this<hw_context_impl>
       config.dump_file_prefix = "uc_log_" + std::to_string(ctx_hdl->get_slotidx());
       config.dump_buffer = std::move(bo);
       config.dump_bin_format = xrt_core::config::get_uc_log_bin_format();
+      if (xrt_core::config::get_uc_log_low_overhead()) {
+        config.batch_sync = true;
+        config.mapped_output = true;
+        config.max_dump_interval_ms = max_dump_interval_ms;
+      }
 
       return std::make_unique<xrt_core::buffer_dumper>(std::move(config));
     }
@@ -158,8 +168,18 @@ class hw_context_impl : public std::enable_shared_from_this<hw_context_impl>
   // are saved to a scratchpad memory allocated specifically for that context.
   std::once_flag m_scratchpad_init_flag; // used for thread safe lazy init of scratchpad
   xrt::bo m_scratchpad_buf;
+  // Buffers with immutable content shared by module runs, e.g. PDIs.
+  // Weak references let a buffer be released when no run uses it.
+  std::map<std::string, std::weak_ptr<xrt::bo_impl>> m_shared_bos;
+  std::mutex m_shared_bos_mutex;
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
+  // Latency statistics of kernel commands executed in this context
+  std::unique_ptr<xrt_core::command_stats::table> m_command_stats =
+      xrt_core::command_stats::create_table(m_core_device->get_device_id());
+  // How threads wait for commands executed in this context
+  std::shared_ptr<xrt_core::hw_queue::wait_policy> m_wait_policy =
+      xrt_core::hw_queue::create_wait_policy();
   bool m_elf_flow = false;
 
   void
@@ -398,6 +418,18 @@ public:
     return m_usage_logger.get();
   }
 
+  xrt_core::command_stats::table*
+  get_command_stats() const
+  {
+    return m_command_stats.get();
+  }
+
+  const std::shared_ptr<xrt_core::hw_queue::wait_policy>&
+  get_wait_policy() const
+  {
+    return m_wait_policy;
+  }
+
   xrt::elf
   get_elf(const std::string& kname) const
   {
@@ -472,6 +504,27 @@ public:
     return m_scratchpad_buf;
   }
 
+  // Get or create shared buffer.  Creation is done while holding
+  // the lock such that concurrent requests create one buffer only.
+  xrt::bo
+  get_shared_bo(const std::string& key, const std::function<xrt::bo()>& create)
+  {
+    std::lock_guard lk(m_shared_bos_mutex);
+    if (auto itr = m_shared_bos.find(key); itr != m_shared_bos.end()) {
+      if (auto handle = itr->second.lock())
+        return xrt::bo{std::move(handle)};
+    }
+
+    auto bo = create();
+
+    // Prune entries for buffers that are no longer in use
+    for (auto itr = m_shared_bos.begin(); itr != m_shared_bos.end();)
+      itr = itr->second.expired() ? m_shared_bos.erase(itr) : std::next(itr);
+
+    m_shared_bos[key] = bo.get_handle();
+    return bo;
+  }
+
   void
   dump_scratchpad_mem()
   {
@@ -604,6 +657,37 @@ get_elf_map(const xrt::hw_context& hwctx)
   return hwctx.get_handle()->get_elf_map();
 }
 
+xrt::bo
+get_shared_bo(const xrt::hw_context& hwctx, const std::string& key, const std::function<xrt::bo()>& create)
+{
+  return hwctx.get_handle()->get_shared_bo(key, create);
+}
+
+void
+set_submit_coalescing(const xrt::hw_context& hwctx, std::chrono::microseconds window, size_t max_cmds)
+{
+  xrt_core::hw_queue{hwctx}.set_coalescing(window, max_cmds);
+}
+
+void
+set_wait_strategy(const xrt::hw_context& hwctx, xrt_core::hw_queue::wait_strategy strategy,
+                  std::chrono::microseconds spin_time)
+{
+  get_wait_policy(hwctx)->set(strategy, spin_time);
+}
+
+std::shared_ptr<xrt_core::hw_queue::wait_policy>
+get_wait_policy(const xrt::hw_context& hwctx)
+{
+  return hwctx.get_handle()->get_wait_policy();
+}
+
+xrt_core::command_stats::table*
+get_command_stats(const xrt::hw_context& hwctx)
+{
+  return hwctx ? hwctx.get_handle()->get_command_stats() : nullptr;
+}
+
 } // xrt_core::hw_context_int
 
 ////////////////////////////////////////////////////////////////
@@ -737,6 +821,25 @@ get_aie_coredump() const
   return get_handle()->get_aie_coredump();
 }
 
+#ifndef XRT_NO_STD_ANY
+std::any
+hw_context::
+get_info_std(info::hw_context param, const xrt::detail::abi&) const
+{
+  switch (param) {
+  case info::hw_context::command_stats : // std::string
+    if (auto stats = get_handle()->get_command_stats()) {
+      std::stringstream ss;
+      boost::property_tree::write_json(ss, stats->to_ptree());
+      return ss.str();
+    }
+    return std::string{};
+  }
+
+  throw std::runtime_error("internal error: unreachable");
+}
+#endif
+
 } // xrt
 
 ////////////////////////////////////////////////////////////////
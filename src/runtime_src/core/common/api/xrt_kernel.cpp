@@ -23,6 +23,7 @@
 
 #include "bo.h"
 #include "command.h"
+#include "command_stats.h"
 #include "context_mgr.h"
 #include "device_int.h"
 #include "elf_int.h"
@@ -353,11 +354,9 @@ cu_access_mode(xrt::hw_context::access_mode mode)
 struct device_type
 {
   std::shared_ptr<xrt_core::device> core_device;
-  xrt_core::bo_cache exec_buffer_cache;
+  xrt_core::exec_bo_pool exec_buffer_pool;
   uint32_t uid; // internal unique id for debug
 
-  static constexpr unsigned int cache_size = 128;
-
   static uint32_t
   create_uid()
   {
@@ -367,26 +366,35 @@ struct device_type
 
   explicit
   device_type(xrtDeviceHandle dhdl)
-    : core_device(xrt_core::device_int::get_core_device(dhdl))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
-    , uid(create_uid())
-  {
-    XRT_DEBUGF("device_type::device_type(%d)\n", uid);
-  }
+    : device_type(xrt_core::device_int::get_core_device(dhdl))
+  {}
 
   explicit
   device_type(std::shared_ptr<xrt_core::device> cdev)
     : core_device(std::move(cdev))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
+    , exec_buffer_pool(core_device, xrt_core::config::get_exec_bo_cache(), xrt_core::config::get_exec_bo_prefill())
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
   }
 
-  // NOLINTNEXTLINE(modernize-use-equals-default)
   ~device_type()
   {
     XRT_DEBUGF("device_type::~device_type(%d)\n", uid);
+    try {
+      auto stats = exec_buffer_pool.get_stats();
+      xrt_core::message::send(xrt_core::message::severity_level::debug, "xrt_kernel",
+                              "exec buffer cache hits(%llu) misses(%llu) steals(%llu) "
+                              "contention(%llu) releases(%llu) destroyed(%llu)",
+                              static_cast<unsigned long long>(stats.hits),
+                              static_cast<unsigned long long>(stats.misses),
+                              static_cast<unsigned long long>(stats.steals),
+                              static_cast<unsigned long long>(stats.contention),
+                              static_cast<unsigned long long>(stats.releases),
+                              static_cast<unsigned long long>(stats.destroyed));
+    }
+    catch (...) {
+    }
   }
 
   device_type(const device_type&) = delete;
@@ -395,10 +403,19 @@ struct device_type
   device_type& operator=(device_type&&) = delete;
 
   template <typename CommandType>
-  xrt_core::bo_cache::cmd_bo<CommandType>
-  create_exec_buf()
+  xrt_core::exec_bo_pool::cmd_bo<CommandType>
+  create_exec_buf(xrt_core::exec_bo_pool::size_class sc = xrt_core::exec_bo_pool::size_class::regmap)
   {
-    return exec_buffer_cache.alloc<CommandType>();
+    return exec_buffer_pool.alloc<CommandType>(sc);
+  }
+
+  // Return exec buffer allocated with create_exec_buf to the pool
+  template <typename CommandType>
+  void
+  release_exec_buf(xrt_core::exec_bo_pool::cmd_bo<CommandType>&& execbuf,
+                   xrt_core::exec_bo_pool::size_class sc = xrt_core::exec_bo_pool::size_class::regmap)
+  {
+    exec_buffer_pool.release(std::move(execbuf), sc);
   }
 
   xrt_core::device*
@@ -724,12 +741,16 @@ public:
   {
     XRT_DEBUGF("kernel_command::~kernel_command(%d)\n", m_uid);
 
+    // Command destructed while running, e.g. never waited on
+    if (m_stats && m_submit_ns)
+      m_stats->abandoned();
+
     // Notify shim that any BOs bound to this kernel command are no
     // longer used by the command.
     get_exec_bo()->reset();
 
     // This is problematic, bo_cache should return managed BOs
-    m_device->exec_buffer_cache.release(std::move(m_execbuf));
+    m_device->release_exec_buf(std::move(m_execbuf));
   }
 
   kernel_command(const kernel_command&) = delete;
@@ -740,18 +761,24 @@ public:
   void
   encode_compute_units(const std::bitset<max_cus>& cumask, size_t num_cumasks)
   {
+    // Encode one mask word at a time rather than testing each bit
+    static const std::bitset<max_cus> word_mask {std::numeric_limits<uint32_t>::max()};
     auto ecmd = get_ert_cmd<ert_packet*>();
-    std::fill(ecmd->data, ecmd->data + num_cumasks, 0);
-
-    for (size_t cu_idx = 0; cu_idx < max_cus; ++cu_idx) {
-      if (!cumask.test(cu_idx))
-        continue;
-      auto mask_idx = cu_idx / cus_per_word;
-      auto idx_in_mask = cu_idx - mask_idx * cus_per_word;
-      ecmd->data[mask_idx] |= (1 << idx_in_mask);
+    for (size_t mask_idx = 0; mask_idx < num_cumasks; ++mask_idx) {
+      auto word = (cumask >> (mask_idx * cus_per_word)) & word_mask;
+      ecmd->data[mask_idx] = static_cast<uint32_t>(word.to_ulong());
     }
   }
 
+  // Statistics entry of kernel and compute unit the command executes
+  // on.  Must not be changed while the command is running.
+  void
+  set_stats(xrt_core::command_stats::entry* stats)
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_stats = stats;
+  }
+
   // Check if this kernel_command object is in done state
   bool
   is_done() const
@@ -870,6 +897,11 @@ public:
         throw std::runtime_error("bad command state, can't launch");
       m_managed = (m_callbacks && !m_callbacks->empty());
       m_done = false;
+      if (m_stats) {
+        m_submit_ns = xrt_core::command_stats::now_ticks();
+        m_start_ns.store(0, std::memory_order_relaxed);
+        m_stats->submitted();
+      }
     }
 
     try {
@@ -883,6 +915,10 @@ public:
       // command can be retried if needed
       std::lock_guard<std::mutex> lk(m_mutex);
       m_done = true;
+      if (m_stats && m_submit_ns) {
+        m_stats->abandoned();
+        m_submit_ns = 0;
+      }
       throw;
     }
   }
@@ -949,6 +985,13 @@ public:
       : nullptr;
   }
 
+  void
+  notify_start() const override
+  {
+    if (m_stats)
+      m_start_ns.store(xrt_core::command_stats::now_ticks(), std::memory_order_relaxed);
+  }
+
   void
   notify(ert_cmd_state s) const override
   {
@@ -965,6 +1008,12 @@ public:
 
       XRT_DEBUGF("kernel_command::notify() m_uid(%d) m_state(%d)\n", m_uid, s);
       complete = m_done = true;
+      if (m_stats && m_submit_ns) {
+        auto start = m_start_ns.load(std::memory_order_relaxed);
+        m_stats->completed(m_submit_ns, start, xrt_core::command_stats::now_ticks(),
+                           s != ERT_CMD_STATE_COMPLETED, !m_managed);
+        m_submit_ns = 0;
+      }
       callbacks = (m_callbacks && !m_callbacks->empty());
     }
 
@@ -997,6 +1046,11 @@ private:
   mutable std::condition_variable m_exec_done;
 
   std::unique_ptr<callback_list> m_callbacks;
+
+  // Latency statistics, time stamps are 0 when not recorded
+  xrt_core::command_stats::entry* m_stats = nullptr;
+  mutable uint64_t m_submit_ns = 0;              // guarded by m_mutex
+  mutable std::atomic<uint64_t> m_start_ns {0};  // set by submitting thread
 };
 
 // class argument - get argument value from va_arg
@@ -1373,6 +1427,10 @@ public:
   }
 }; // buffer_cache
 
+// Device wrapper look-up, defined with the device cache below
+static std::shared_ptr<device_type>
+get_device(const std::shared_ptr<xrt_core::device>& core_device);
+
 } // namespace
 
 namespace xrt {
@@ -1887,6 +1945,12 @@ public:
     return name;
   }
 
+  uint32_t
+  get_uid() const
+  {
+    return uid;
+  }
+
   uint32_t
   get_ctrl_code_id() const
   {
@@ -2379,6 +2443,7 @@ class run_impl : public std::enable_shared_from_this<run_impl>
       xrt_core::usage_metrics::get_usage_metrics_logger();
 
   const runlist_impl* m_runlist = nullptr;// runlist that owns this run (optional)
+  bool m_dirty = true;                    // command changed since last prep_start
   std::mutex m_mutex;                     // mutex synchronization
   // Run-level dtrace ct file: stored so clone inherits it
   std::string m_dtrace_control_file;
@@ -2420,6 +2485,7 @@ public:
           "still in progress");
 
     m_dtrace_control_file = path;
+    m_dirty = true;
     if (m_module) {
       xrt_core::module_int::set_dtrace_control_file(m_module, path);
       if (m_dpu_payload)
@@ -2454,6 +2520,7 @@ public:
     , uid(create_uid())
   {
     XRT_DEBUGF("run_impl::run_impl(%d)\n" , uid);
+    cmd->set_stats(get_stats_entry());
   }
 
   // Clones a run impl, so that the clone can be executed concurrently
@@ -2481,6 +2548,7 @@ public:
                         : nullptr)
   {
     XRT_DEBUGF("run_impl::run_impl(%d)\n" , uid);
+    cmd->set_stats(get_stats_entry());
   }
 
   virtual
@@ -2576,6 +2644,7 @@ public:
     // encoded in command packet.
     ips.erase(itr,ips.end());
     encode_cumasks = true;
+    m_dirty = true;
   }
 
   const std::bitset<max_cus>&
@@ -2590,15 +2659,23 @@ public:
     return get_arg_setter()->get_arg_value(arg);
   }
 
+  // A run object that is part of a runlist can have its arguments
+  // changed in place between executions of the runlist, but not
+  // while the runlist is executing.
+  void
+  patch_check();
+
   void
   set_arg_value(const argument& arg, const arg_range<uint8_t>& value)
   {
+    patch_check();
     get_arg_setter()->set_arg_value(arg, value);
   }
 
   void
   set_arg_value(const argument& arg, const xrt::bo& bo)
   {
+    patch_check();
     get_arg_setter()->set_arg_value(arg, bo);
     cmd->bind_arg_at_index(arg.index(), bo);
 
@@ -2622,6 +2699,7 @@ public:
   void
   set_offset_value(uint32_t offset, const arg_range<uint8_t>& value)
   {
+    patch_check();
     get_arg_setter()->set_offset_value(offset, value);
   }
 
@@ -2634,6 +2712,7 @@ public:
   void
   set_arg(const argument& arg, std::va_list* args)
   {
+    patch_check();
     arg.set(get_arg_setter(), args);
   }
 
@@ -2697,9 +2776,39 @@ public:
       return;
 
     cmd->encode_compute_units(cumask, kernel->get_num_cumasks());
+    cmd->set_stats(get_stats_entry());
     encode_cumasks = false;
   }
 
+  // Statistics entry of the kernel and the compute unit this run
+  // executes on.  A run that can execute on any of multiple compute
+  // units is recorded as any compute unit of the kernel.
+  xrt_core::command_stats::entry*
+  get_stats_entry() const
+  {
+    auto stats = xrt_core::hw_context_int::get_command_stats(kernel->get_hw_context());
+    if (!stats)
+      return nullptr;
+
+    auto cuidx = xrt_core::command_stats::table::any_cu;
+    if (cumask.count() == 1) {
+      for (size_t idx = 0; idx < cumask.size(); ++idx) {
+        if (cumask.test(idx)) {
+          cuidx = static_cast<int>(idx);
+          break;
+        }
+      }
+    }
+    return stats->get_entry(kernel->get_name(), cuidx);
+  }
+
+  // Check if command has changed since last prep_start()
+  bool
+  is_dirty() const
+  {
+    return m_dirty;
+  }
+
   void
   prep_start()
   {
@@ -2709,7 +2818,16 @@ public:
       xrt_core::module_int::sync(m_module);
 
     encode_compute_units();
+    m_dirty = false;
 
+    reset_command_state();
+  }
+
+  // Restore command header and state for re-execution of an already
+  // prepared command
+  void
+  reset_command_state()
+  {
     auto pkt = cmd->get_ert_packet();
 
     // Very first start() of this run object caches the command header
@@ -2723,6 +2841,71 @@ public:
     XRT_DEBUG_CALL(debug_cmd_packet(kernel->get_name(), pkt));
   }
 
+  // Freeze the command packet for repeated starts through a run
+  // template.  The compute units are encoded and the command header
+  // is cached such that subsequent starts need not re-encode.
+  void
+  freeze()
+  {
+    if (m_runlist)
+      throw xrt_core::error("Run object belongs to a runlist and cannot be used in a run template");
+
+    encode_compute_units();
+    if (!m_header)
+      m_header = cmd->get_ert_packet()->header;
+  }
+
+  // Check if argument values are written as is at the argument
+  // offset in the command payload.  This is the case for AP_CTRL_HS
+  // and AP_CTRL_CHAIN style kernels that are not controlled through
+  // an ELF module or a mailbox.
+  bool
+  has_direct_payload() const
+  {
+    if (m_module || kernel->has_mailbox())
+      return false;
+
+    switch (kernel->get_kernel_type()) {
+    case kernel_type::pl :
+      return kernel->get_ip_control_protocol() != control_type::fa;
+    case kernel_type::dpu :
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  // Argument payload of the command packet
+  uint8_t*
+  get_payload() const
+  {
+    return reinterpret_cast<uint8_t*>(data);
+  }
+
+  // Bind a buffer argument to the command without updating payload
+  void
+  bind_arg(const argument& arg, const xrt::bo& bo)
+  {
+    cmd->bind_arg_at_index(arg.index(), bo);
+  }
+
+  // Start a command packet frozen for a run template.  The compute
+  // units and arguments are already encoded, only the module patches
+  // are synced and the command header and state are restored.
+  void
+  start_frozen()
+  {
+    if (m_runlist)
+      throw xrt_core::error("Run object belongs to a runlist and cannot be explicitly started");
+
+    if (m_module)
+      xrt_core::module_int::sync(m_module);
+
+    reset_command_state();
+    m_usage_logger->log_kernel_run_info(kernel.get(), this, ERT_CMD_STATE_NEW);
+    cmd->run();
+  }
+
   // start() - start the run object (execbuf)
   virtual void
   start()
@@ -3349,17 +3532,26 @@ class runlist_impl
   static constexpr size_t submit_size = 24;
   static constexpr size_t noidx = std::numeric_limits<size_t>::max();
   static constexpr size_t execbuf_size = sizeof(ert_packet) + sizeof(ert_cmd_chain_data) + submit_size * sizeof(uint64_t);
+  static_assert(execbuf_size <= xrt_core::exec_bo_pool::chain_size, "chained command exceeds exec buffer size");
   static constexpr size_t word_size = sizeof(uint32_t); // ert payload word size
 
   // The runlist creates its own execution buffers, which are
   // ert_packets with payload interpreted as ert_cmd_chain_data
   using cmd_type = ert_packet;
-  using execbuf_type = xrt_core::bo_cache::cmd_bo<cmd_type>;
-  xrt_core::bo_cache_t<execbuf_size> m_exec_buffer_cache;
+  using execbuf_type = xrt_core::exec_bo_pool::cmd_bo<cmd_type>;
+
+  // Exec buffers are allocated from the device's exec buffer pool
+  // shared with all run objects and runlists on the device.
+  std::shared_ptr<device_type> m_device;
 
   enum class state { idle, closed, running, error };
   mutable state m_state = state::idle;
 
+  // A recorded runlist is closed for additions.  Its chained commands
+  // are resubmitted as is on execute(), and only member runs changed
+  // since the previous execution are prepared again.
+  bool m_recorded = false;
+
   xrt::hw_context m_hwctx;
   xrt_core::hw_queue m_hwqueue;
   std::vector<xrt::run> m_runlist;
@@ -3398,13 +3590,14 @@ class runlist_impl
     return unpack(*execbuf);
   }
 
-  // Execution buffers are cached and reused within this runlist
-  // This function creates or gets an execbuf from the cache
-  // and initializes the command in prep for add chained commands.
+  // Execution buffers are cached and reused through the device's
+  // exec buffer pool. This function creates or gets an execbuf from
+  // the pool and initializes the command in prep for add chained
+  // commands.
   execbuf_type
   create_exec_buf()
   {
-    auto execbuf = m_exec_buffer_cache.alloc<cmd_type>();
+    auto execbuf = m_device->create_exec_buf<cmd_type>(xrt_core::exec_bo_pool::size_class::chain);
     auto pkt = execbuf.second;
     pkt->opcode = ERT_CMD_CHAIN;
     pkt->count = sizeof(ert_cmd_chain_data) / word_size;  // payload size in words
@@ -3434,6 +3627,23 @@ class runlist_impl
     run.get_ert_packet()->state = state;
   }
 
+  // Return all chained command execbufs to the device's pool.  Any
+  // run BOs bound to the chained commands are unbound first.  The
+  // execbufs of an executing runlist may still be in use by the
+  // device and are freed rather than handed to other commands.
+  void
+  release_exec_bufs()
+  {
+    m_submitted_cmds.clear();
+    if (!is_executing()) {
+      for (auto& execbuf : m_cmds) {
+        execbuf.first->reset();
+        m_device->release_exec_buf(std::move(execbuf), xrt_core::exec_bo_pool::size_class::chain);
+      }
+    }
+    m_cmds.clear();
+  }
+
   // Mark all runs in runlist range [start, end[ as aborted
   void
   abort_runs(size_t start, size_t end) const
@@ -3610,7 +3820,7 @@ public:
 public:
   explicit
   runlist_impl(xrt::hw_context hwctx)
-    : m_exec_buffer_cache{hwctx.get_device().get_handle(), 128}
+    : m_device{get_device(xrt_core::hw_context_int::get_core_device(hwctx))}
     , m_hwctx{std::move(hwctx)}
     , m_hwqueue{m_hwctx}
   {}
@@ -3624,6 +3834,19 @@ public:
     catch (const std::exception& ex) {
       xrt_core::send_exception_message("runlist clear_runs error: " + std::string(ex.what()));
     }
+
+    try {
+      release_exec_bufs();
+    }
+    catch (const std::exception& ex) {
+      xrt_core::send_exception_message("runlist release error: " + std::string(ex.what()));
+    }
+  }
+
+  bool
+  is_executing() const
+  {
+    return m_state == state::closed || m_state == state::running;
   }
 
   void
@@ -3632,6 +3855,9 @@ public:
     if (m_state != state::idle)
       throw xrt_core::error("runlist must be idle before adding run objects, current state: " + state_to_string(m_state));
 
+    if (m_recorded)
+      throw xrt_core::error("runlist is recorded and cannot be extended, reset() the runlist to add run objects");
+
     // Get the potentially throwing action out of the way first
     auto runidx = m_runlist.size();
     m_runlist.reserve(runidx + 1);
@@ -3678,9 +3904,15 @@ public:
     if (m_runlist.empty())
       return;
 
-    // Prep each run object
-    for (auto& run : m_runlist)
-      run.get_handle()->prep_start();
+    // Prep each run object.  A recorded runlist prepares only run
+    // objects that have changed since last execution.
+    for (auto& run : m_runlist) {
+      auto rimpl = run.get_handle();
+      if (!m_recorded || rimpl->is_dirty())
+        rimpl->prep_start();
+      else
+        rimpl->reset_command_state();
+    }
 
     // Close the command list.
     m_state = state::closed;
@@ -3765,6 +3997,16 @@ public:
     }
   }
 
+  // Record the runlist for repeated execution
+  void
+  record()
+  {
+    if (m_state != state::idle)
+      throw xrt_core::error("runlist must be idle before recording, current state: " + state_to_string(m_state));
+
+    m_recorded = true;
+  }
+
   void
   reset()
   {
@@ -3777,9 +4019,160 @@ public:
 
     m_runlist.clear();
     m_bos.clear();
-    m_submitted_cmds.clear();
-    m_cmds.clear();
+    release_exec_bufs();
     m_state = state::idle;
+    m_recorded = false;
+  }
+};
+
+void
+run_impl::
+patch_check()
+{
+  if (m_runlist && m_runlist->is_executing())
+    throw xrt_core::error("Cannot change arguments of run object while its runlist is executing");
+
+  m_dirty = true;
+}
+
+// class run_template_impl - Run object with frozen command packet
+//
+// The command packet of the run object is encoded once when the
+// template is constructed, including the compute unit mask and all
+// arguments set so far.  Arguments declared patchable are resolved
+// to a table of payload offsets, such that set_arg writes only the
+// changed value directly into the command payload.  A buffer that is
+// already bound to an argument is not rebound.  Starting the template
+// resubmits the frozen command packet.
+//
+// Buffers patched through a template are not validated for compute
+// unit connectivity, they must be in the same memory bank as the
+// buffer set when the template was created.
+class run_template_impl
+{
+  static constexpr int not_patchable = -1;
+
+  // struct patch_slot - a patchable argument
+  //
+  // @arg: Kernel argument meta data
+  // @offset: Byte offset of argument in command payload
+  // @size: Size of argument in bytes
+  // @buffer: Argument is a global buffer, otherwise a scalar
+  // @bo: Buffer currently bound to the argument if any
+  struct patch_slot
+  {
+    const argument* arg;
+    size_t offset;
+    size_t size;
+    bool buffer;
+    xrt::bo bo;
+  };
+
+  xrt::run m_run;
+  std::shared_ptr<run_impl> m_impl;
+  std::vector<patch_slot> m_slots;
+  std::vector<int> m_slot_index;  // argument index to slot index
+  bool m_direct;                  // payload can be patched in place
+
+  patch_slot&
+  get_slot(int argidx, bool buffer)
+  {
+    if (argidx < 0 || static_cast<size_t>(argidx) >= m_slot_index.size()
+        || m_slot_index[argidx] == not_patchable)
+      throw xrt_core::error(EINVAL, "Argument at index " + std::to_string(argidx) + " is not patchable in run template");
+
+    auto& slot = m_slots[m_slot_index[argidx]];
+    if (slot.buffer != buffer)
+      throw xrt_core::error(EINVAL, "Argument at index " + std::to_string(argidx) + " is "
+                            + (slot.buffer ? "a buffer" : "not a buffer") + " argument");
+
+    return slot;
+  }
+
+  // Only global buffer and scalar arguments have a value in the
+  // command payload
+  static bool
+  is_buffer(const argument& arg)
+  {
+    using xarg = xrt_core::xclbin::kernel_argument;
+    switch (arg.type()) {
+    case xarg::argtype::global :
+    case xarg::argtype::constant :
+      return true;
+    case xarg::argtype::scalar :
+      return false;
+    default:
+      throw xrt_core::error(EINVAL, "Argument '" + arg.name() + "' has no value and cannot be patched in run template");
+    }
+  }
+
+public:
+  run_template_impl(xrt::run run, const std::vector<int>& patchable)
+    : m_run(std::move(run))
+    , m_impl(m_run.get_handle())
+    , m_direct(m_impl->has_direct_payload())
+  {
+    for (auto argidx : patchable) {
+      auto& arg = m_impl->get_kernel()->get_arg(argidx);
+      if (m_slot_index.size() <= static_cast<size_t>(argidx))
+        m_slot_index.resize(argidx + 1, not_patchable);
+      if (m_slot_index[argidx] != not_patchable)
+        continue;
+
+      arg.valid_or_error();
+      auto buffer = is_buffer(arg);
+      m_slot_index[argidx] = static_cast<int>(m_slots.size());
+      m_slots.push_back({&arg, arg.offset(), arg.size(), buffer, xrt::bo{}});
+    }
+
+    m_impl->freeze();
+  }
+
+  void
+  set_arg(int argidx, const xrt::bo& bo)
+  {
+    auto& slot = get_slot(argidx, true);
+    if (slot.bo && slot.bo.get_handle() == bo.get_handle())
+      return;
+
+    if (m_direct) {
+      auto addr = bo.address();
+      std::memcpy(m_impl->get_payload() + slot.offset, &addr, std::min(slot.size, sizeof(addr)));
+      m_impl->bind_arg(*slot.arg, bo);
+    }
+    else {
+      m_impl->set_arg_value(*slot.arg, bo);
+    }
+
+    slot.bo = bo;
+  }
+
+  void
+  set_arg(int argidx, const void* value, size_t bytes)
+  {
+    auto& slot = get_slot(argidx, false);
+    slot.arg->valid_or_error(bytes);
+    if (m_direct)
+      std::memcpy(m_impl->get_payload() + slot.offset, value, bytes);
+    else
+      m_impl->set_arg_value(*slot.arg, value, bytes);
+  }
+
+  // Kernels with a direct payload resubmit the frozen command packet,
+  // other kernels go through the regular start of the run object
+  void
+  start()
+  {
+    if (m_direct)
+      m_impl->start_frozen();
+    else
+      m_impl->start();
+  }
+
+  const xrt::run&
+  get_run() const
+  {
+    return m_run;
   }
 };
 
@@ -4150,6 +4543,12 @@ get_hw_ctx(const xrt::kernel& kernel)
   return kernel.get_handle()->get_hw_context();
 }
 
+xrt_core::bo_cache_stats
+get_exec_buffer_stats(const xrt::kernel& kernel)
+{
+  return kernel.get_handle()->get_device()->exec_buffer_pool.get_stats();
+}
+
 xrt::kernel
 create_kernel_from_implementation(const xrt::kernel_impl* kernel_impl)
 {
@@ -4159,6 +4558,12 @@ create_kernel_from_implementation(const xrt::kernel_impl* kernel_impl)
   return xrt::kernel(const_cast<xrt::kernel_impl*>(kernel_impl)->get_shared_ptr()); // NOLINT
 }
 
+uint32_t
+get_uid(const xrt::kernel_impl* kernel_impl)
+{
+  return kernel_impl->get_uid();
+}
+
 } // xrt_core::kernel_int
 
 
@@ -4514,6 +4919,13 @@ poll() const
   return handle->poll_or_throw_on_error();
 }
 
+void
+runlist::
+record()
+{
+  handle->record();
+}
+
 void
 runlist::
 reset()
@@ -4521,6 +4933,47 @@ reset()
   handle->reset();
 }
 
+run_template::
+run_template(const xrt::run& run, const std::vector<int>& patchable)
+  : detail::pimpl<run_template_impl>(std::make_shared<run_template_impl>(run, patchable))
+{}
+
+void
+run_template::
+set_arg_at_index(int index, const xrt::bo& bo)
+{
+  handle->set_arg(index, bo);
+}
+
+void
+run_template::
+set_arg_at_index(int index, const void* value, size_t bytes)
+{
+  handle->set_arg(index, value, bytes);
+}
+
+void
+run_template::
+start()
+{
+  XRT_TRACE_POINT_SCOPE(xrt_run_template_start);
+  handle->start();
+}
+
+ert_cmd_state
+run_template::
+wait(const std::chrono::milliseconds& timeout) const
+{
+  return handle->get_run().wait(timeout);
+}
+
+xrt::run
+run_template::
+get_run() const
+{
+  return handle->get_run();
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
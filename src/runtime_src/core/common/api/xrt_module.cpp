@@ -35,6 +35,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <functional>
 #include <numeric>
 #include <map>
 #include <memory>
@@ -191,6 +192,10 @@ protected:
   // Arguments patched in the buffer object
   std::set<std::string> m_patched_args;
 
+  // Ranges of buffer objects patched since last sync.  Synced
+  // together when the module is synced rather than per patch.
+  std::vector<std::pair<xrt::bo, xrt_core::elf_patcher::dirty_ranges>> m_dirty_ranges;
+
   // Dirty bit to indicate patching was done prior to last buffer sync
   bool m_dirty{ false };
 
@@ -240,6 +245,25 @@ protected:
       bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
   }
 
+  xrt_core::elf_patcher::dirty_ranges&
+  get_dirty_ranges(const xrt::bo& bo)
+  {
+    auto itr = std::find_if(m_dirty_ranges.begin(), m_dirty_ranges.end(),
+                            [&bo](const auto& entry) { return entry.first.get_handle() == bo.get_handle(); });
+    if (itr != m_dirty_ranges.end())
+      return itr->second;
+
+    return m_dirty_ranges.emplace_back(bo, xrt_core::elf_patcher::dirty_ranges{}).second;
+  }
+
+  // Sync patched ranges of buffer objects
+  void
+  sync_dirty_ranges()
+  {
+    for (auto& [bo, ranges] : m_dirty_ranges)
+      ranges.sync(bo);
+  }
+
   // Helper function for patching buffer with argument name or index
   bool
   patch_helper(xrt::bo& bo, const std::string& argnm, size_t index, uint64_t patch,
@@ -273,7 +297,7 @@ protected:
     }
 
     // Call patch - symbol_patcher owns its state internally
-    patcher_it->second.patch_symbol(bo, patch, m_first_patch);
+    patcher_it->second.patch_symbol(bo, patch, m_first_patch, get_dirty_ranges(bo));
 
     if (xrt_core::config::get_xrt_debug()) {
       if (not_found_use_argument_name) {
@@ -371,12 +395,54 @@ class module_run_aie_gen2 : public module_run
     }
   }
 
+  // Get buffer object with immutable content shared by all runs of
+  // this ELF in the hardware context.  The buffer is created by
+  // 'create' if no run currently shares a buffer for 'name'.
+  xrt::bo
+  get_shared_bo(const std::string& name, const std::function<xrt::bo()>& create) const
+  {
+    if (!xrt_core::config::get_share_module_bos())
+      return create();
+
+    std::stringstream key;
+    key << static_cast<const void*>(m_elf_impl.get()) << ':' << name;
+    return xrt_core::hw_context_int::get_shared_bo(m_hwctx, key.str(), create);
+  }
+
+  // Create preemption buffer and patch it with the scratchpad memory
+  // of the hardware context.  The buffer is never patched again.
+  xrt::bo
+  create_preempt_buf(const xrt::buf& data, const xrt::bo& scratchpad_mem,
+                     xrt_core::elf_patcher::buf_type type, const std::string& dump_name)
+  {
+    auto bo = xbi::create_bo(m_hwctx, data.size(), xbi::use_type::preemption);
+    fill_bo_with_data(bo, data, false);
+
+    if (is_dump_preemption_codes()) {
+      std::string dump_file_name = dump_name + std::to_string(get_id()) + ".bin";
+      dump_bo(bo, dump_file_name);
+
+      std::stringstream ss;
+      ss << "dumped file " << dump_file_name;
+      xrt_core::message::send(xrt_core::message::severity_level::debug, "xrt_module", ss.str());
+    }
+
+    patch_helper(bo, Scratch_Pad_Mem_Symbol, 0, scratchpad_mem.address(), type);
+    bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    return bo;
+  }
+
+  // The ctrlpkt preemption buffers are not patched and are shared
+  // by all runs
   void
   create_ctrlpkt_pm_bufs()
   {
     for (const auto& [key, buf] : m_config.ctrlpkt_pm_bufs) {
-      m_ctrlpkt_pm_bos[key] = xbi::create_bo(m_hwctx, buf.size(), xbi::use_type::ctrlpkt);
-      fill_bo_with_data(m_ctrlpkt_pm_bos.at(key), buf);
+      m_ctrlpkt_pm_bos[key] = get_shared_bo(std::to_string(m_ctrl_code_id) + ".ctrlpkt." + key, [this, &buf = buf] {
+        auto bo = xbi::create_bo(m_hwctx, buf.size(), xbi::use_type::ctrlpkt);
+        fill_bo_with_data(bo, buf);
+        return bo;
+      });
     }
   }
 
@@ -408,39 +474,24 @@ class module_run_aie_gen2 : public module_run
     auto preempt_restore_size = m_config.preempt_restore_data.size();
 
     if ((preempt_save_size > 0) && (preempt_restore_size > 0)) {
-      m_preempt_save_bo = xbi::create_bo(m_hwctx, preempt_save_size, xbi::use_type::preemption);
-      fill_bo_with_data(m_preempt_save_bo, m_config.preempt_save_data, false);
-
-      m_preempt_restore_bo = xbi::create_bo(m_hwctx, preempt_restore_size, xbi::use_type::preemption);
-      fill_bo_with_data(m_preempt_restore_bo, m_config.preempt_restore_data, false);
-
-      if (is_dump_preemption_codes()) {
-        std::string dump_file_name = "preemption_save_pre_patch" + std::to_string(get_id()) + ".bin";
-        dump_bo(m_preempt_save_bo, dump_file_name);
-
-        std::stringstream ss;
-        ss << "dumped file " << dump_file_name;
-        xrt_core::message::send(xrt_core::message::severity_level::debug, "xrt_module", ss.str());
-
-        dump_file_name = "preemption_restore_pre_patch" + std::to_string(get_id()) + ".bin";
-        dump_bo(m_preempt_restore_bo, dump_file_name);
-
-        ss.str("");
-        ss << "dumped file " << dump_file_name;
-        xrt_core::message::send(xrt_core::message::severity_level::debug, "xrt_module", ss.str());
-      }
-
-      // Get scratchpad memory and patch preemption buffers
+      // Get scratchpad memory used to patch preemption buffers
       const auto& scratchpad_mem =
           xrt_core::hw_context_int::get_scratchpad_mem_buf(m_hwctx, m_config.scratch_pad_mem_size);
 
       if (!scratchpad_mem)
         throw std::runtime_error("Failed to get scratchpad buffer from context\n");
 
-      patch_helper(m_preempt_save_bo, Scratch_Pad_Mem_Symbol, 0, scratchpad_mem.address(),
-                   xrt_core::elf_patcher::buf_type::preempt_save);
-      patch_helper(m_preempt_restore_bo, Scratch_Pad_Mem_Symbol, 0, scratchpad_mem.address(),
-                   xrt_core::elf_patcher::buf_type::preempt_restore);
+      // The scratchpad memory is per hardware context, so patched
+      // preemption buffers are shared by all runs
+      auto id = std::to_string(m_ctrl_code_id);
+      m_preempt_save_bo = get_shared_bo(id + ".preempt_save", [this, &scratchpad_mem] {
+        return create_preempt_buf(m_config.preempt_save_data, scratchpad_mem,
+                                  xrt_core::elf_patcher::buf_type::preempt_save, "preemption_save_pre_patch");
+      });
+      m_preempt_restore_bo = get_shared_bo(id + ".preempt_restore", [this, &scratchpad_mem] {
+        return create_preempt_buf(m_config.preempt_restore_data, scratchpad_mem,
+                                  xrt_core::elf_patcher::buf_type::preempt_restore, "preemption_restore_pre_patch");
+      });
 
       if (is_dump_preemption_codes()) {
         std::stringstream ss;
@@ -459,11 +510,15 @@ class module_run_aie_gen2 : public module_run
                    xrt_core::elf_patcher::buf_type::ctrltext);
     }
 
-    // Patch all PDI addresses using config's pdi symbols
+    // Patch all PDI addresses using config's pdi symbols.  PDI
+    // buffers are not patched and are shared by all runs.
     for (const auto& symbol : m_config.patch_pdi_symbols) {
-      const auto& pdi_data = m_config.elf_parent->get_pdi(symbol);
-      auto pdi_bo = xbi::create_bo(m_hwctx, pdi_data.size(), xbi::use_type::pdi);
-      fill_bo_with_data(pdi_bo, pdi_data);
+      auto pdi_bo = get_shared_bo("pdi." + symbol, [this, &symbol] {
+        const auto& pdi_data = m_config.elf_parent->get_pdi(symbol);
+        auto bo = xbi::create_bo(m_hwctx, pdi_data.size(), xbi::use_type::pdi);
+        fill_bo_with_data(bo, pdi_data);
+        return bo;
+      });
       // Move bo into map and get reference for patching
       auto [it, inserted] = m_pdi_bo_map.emplace(symbol, std::move(pdi_bo));
 
@@ -584,11 +639,7 @@ public:
       if (m_ctrlpkt_bo)
         m_ctrlpkt_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
 
-      if (m_preempt_save_bo && m_preempt_restore_bo) {
-        m_preempt_save_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
-        m_preempt_restore_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
-      }
-
+      // preemption buffers are shared and synced when created
       m_first_patch = false;
       return;
     }
@@ -597,6 +648,8 @@ public:
     // For subsequent runs only part of buffer that is patched is synced
     if (m_first_patch)
       m_instr_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    else
+      sync_dirty_ranges();
 
     if (is_dump_control_codes()) {
       std::string dump_file_name = "ctr_codes_post_patch" + std::to_string(get_id()) + ".bin";
@@ -622,11 +675,6 @@ public:
     }
 
     if (m_preempt_save_bo && m_preempt_restore_bo) {
-      if (m_first_patch) {
-        m_preempt_save_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
-        m_preempt_restore_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
-      }
-
       if (is_dump_preemption_codes()) {
         std::string dump_file_name = "preemption_save_post_patch" + std::to_string(get_id()) + ".bin";
         dump_bo(m_preempt_save_bo, dump_file_name);
@@ -1042,6 +1090,8 @@ public:
     // For subsequent runs only part of buffer that is patched is synced
     if (m_first_patch)
       m_buffer.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    else
+      sync_dirty_ranges();
 
     if (is_dump_control_codes()) {
       std::string dump_file_name = "ctr_codes_post_patch" + std::to_string(get_id()) + ".bin";
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 // This file implements XRT xclbin APIs as declared in
 // core/include/experimental/xrt_queue.h
@@ -8,10 +8,16 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #include "core/include/xrt/experimental/xrt_queue.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( disable : 4244 )
@@ -24,11 +30,349 @@ namespace xrt {
 // Manages and executes enqueued tasks.
 // Tasks are executed and completed in order of enqueuing.
 //
-// A queue is associated with exactly one handler thread that executes
-// the task asynchronously to the enqueuer.
+// A queue is consumed either by exactly one handler thread that
+// executes the tasks asynchronously to the enqueuer, or by a strand
+// on a shared executor.
 class queue_impl
 {
-  std::queue<xrt::queue::task> m_queue;  // task queue
+protected:
+  using task = queue::task;
+
+public:
+  queue_impl() = default;
+  virtual ~queue_impl() = default;
+
+  queue_impl(const queue_impl&) = delete;
+  queue_impl(queue_impl&&) = delete;
+  queue_impl& operator=(const queue_impl&) = delete;
+  queue_impl& operator=(queue_impl&&) = delete;
+
+  virtual void
+  enqueue(task&& t) = 0;
+};
+
+// class executor_impl - work stealing pool of worker threads
+//
+// Work items are serial queues (strands).  Each worker thread has
+// its own deque of scheduled strands.  A strand scheduled from a
+// worker thread goes to the deque of that worker, otherwise strands
+// are distributed round robin.  A worker executes strands from the
+// front of its own deque and steals from the back of other deques
+// when its own deque is empty.
+//
+// The executor is kept alive by the executor object and by the
+// queues using the executor.  A worker thread cannot join itself, so
+// when the last reference is released by one of the worker threads,
+// e.g. by a task that destroys its own queue, the executor is deleted
+// by the reaper thread of the executor.
+class executor_impl
+{
+public:
+  // class strand - serial task queue executed by the pool
+  //
+  // A strand is scheduled on the pool when it has tasks to execute
+  // and is not already scheduled.  At most one worker executes a
+  // strand at any time, which preserves the order of tasks.  A
+  // worker executes a bounded number of tasks before rescheduling
+  // the strand, so that busy queues do not starve other queues.
+  class strand : public std::enable_shared_from_this<strand>
+  {
+    static constexpr unsigned int max_batch = 16;
+
+    executor_impl* m_executor;  // outlives the strand's queue
+    std::queue<xrt::queue::task> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_idle;
+    bool m_scheduled = false;
+    bool m_running = false;
+    bool m_stop = false;
+
+  public:
+    explicit
+    strand(executor_impl* executor)
+      : m_executor(executor)
+    {}
+
+    void
+    enqueue(queue::task&& t)
+    {
+      {
+        std::lock_guard lk(m_mutex);
+        if (m_stop)
+          return;
+        m_tasks.push(std::move(t));
+        if (m_scheduled)
+          return;
+        m_scheduled = true;
+      }
+      m_executor->schedule(shared_from_this());
+    }
+
+    // Execute tasks, called by a worker thread of the executor
+    void
+    run()
+    {
+      for (unsigned int count = 0; count < max_batch; ++count) {
+        xrt::queue::task task;
+        {
+          std::lock_guard lk(m_mutex);
+          m_running = false;
+          if (m_stop || m_tasks.empty()) {
+            m_scheduled = false;
+            m_idle.notify_all();
+            return;
+          }
+          task = std::move(m_tasks.front());
+          m_tasks.pop();
+          m_running = true;
+        }
+
+        // allow enqueue while executing
+        t_strand = this;
+        task.execute();
+        t_strand = nullptr;
+      }
+
+      {
+        std::lock_guard lk(m_mutex);
+        m_running = false;
+        if (m_stop || m_tasks.empty()) {
+          m_scheduled = false;
+          m_idle.notify_all();
+          return;
+        }
+      }
+
+      // more tasks, give other strands a chance
+      m_executor->schedule(shared_from_this());
+    }
+
+    // Discard pending tasks and wait for the executing task if any.
+    // When called from the executing task itself, the task completes
+    // after this function returns.  The worker executing the strand
+    // holds a reference, the strand is released when the task returns.
+    void
+    stop()
+    {
+      std::queue<xrt::queue::task> discard;
+      std::unique_lock lk(m_mutex);
+      m_stop = true;
+      std::swap(discard, m_tasks);
+      if (t_strand != this)
+        m_idle.wait(lk, [this] { return !m_running; });
+    }
+  };
+
+private:
+  struct worker
+  {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<strand>> strands;
+  };
+
+  std::vector<std::unique_ptr<worker>> m_workers;
+  std::vector<std::thread> m_threads;
+  std::atomic<size_t> m_next {0};     // round robin scheduling
+  std::atomic<size_t> m_pending {0};  // scheduled strands not yet picked up
+  std::atomic<size_t> m_sleeping {0}; // workers waiting for work
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  bool m_stop = false;
+
+  // Reaper thread, deletes the executor when the last reference is
+  // released by a worker thread
+  std::thread m_reaper;
+  std::condition_variable m_reap;
+  bool m_reap_self = false;
+
+  // Worker thread index if the calling thread is a worker of this pool
+  static thread_local const executor_impl* t_executor;
+  static thread_local size_t t_worker;
+
+  // Strand executing a task on the calling thread if any
+  static thread_local const strand* t_strand;
+
+  // m_pending is changed with the deque mutex locked along with the
+  // deque, so a pending strand is always in one of the deques
+  std::shared_ptr<strand>
+  pop(size_t idx, bool wait)
+  {
+    // own deque first, oldest first
+    {
+      auto& w = *m_workers[idx];
+      std::lock_guard lk(w.mutex);
+      if (!w.strands.empty()) {
+        auto s = std::move(w.strands.front());
+        w.strands.pop_front();
+        --m_pending;
+        return s;
+      }
+    }
+
+    // steal newest from other deques, skip busy deques unless wait
+    for (size_t i = 1; i < m_workers.size(); ++i) {
+      auto& w = *m_workers[(idx + i) % m_workers.size()];
+      std::unique_lock lk(w.mutex, std::defer_lock);
+      if (wait)
+        lk.lock();
+      else if (!lk.try_lock())
+        continue;
+      if (w.strands.empty())
+        continue;
+      auto s = std::move(w.strands.back());
+      w.strands.pop_back();
+      --m_pending;
+      return s;
+    }
+
+    return nullptr;
+  }
+
+  void
+  run(size_t idx)
+  {
+    t_executor = this;
+    t_worker = idx;
+    while (true) {
+      // A strand may be pending but skipped due to a busy deque,
+      // lock the busy deques before going to sleep
+      auto s = pop(idx, false);
+      if (!s && m_pending.load())
+        s = pop(idx, true);
+
+      if (s) {
+        s->run();
+        continue;
+      }
+
+      std::unique_lock lk(m_mutex);
+      ++m_sleeping;
+      m_work.wait(lk, [this] { return m_stop || m_pending.load() > 0; });
+      --m_sleeping;
+      if (m_stop && !m_pending.load())
+        return;
+    }
+  }
+
+  // Wait until the executor is shut down, or until the last reference
+  // is released by a worker thread, in which case delete the executor
+  void
+  reap()
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_reap.wait(lk, [this] { return m_stop || m_reap_self; });
+      if (!m_reap_self)
+        return;
+    }
+
+    delete this;
+  }
+
+  // Deleter of shared executor, a worker thread hands the executor to
+  // the reaper thread
+  static void
+  release(executor_impl* executor)
+  {
+    if (!executor->is_worker()) {
+      delete executor;
+      return;
+    }
+
+    std::lock_guard lk(executor->m_mutex);
+    executor->m_reap_self = true;
+    executor->m_reap.notify_one();
+  }
+
+  explicit
+  executor_impl(unsigned int num_threads)
+  {
+    if (!num_threads)
+      throw std::invalid_argument("executor must have at least one thread");
+
+    for (unsigned int idx = 0; idx < num_threads; ++idx)
+      m_workers.push_back(std::make_unique<worker>());
+    for (unsigned int idx = 0; idx < num_threads; ++idx)
+      m_threads.emplace_back([this, idx] { run(idx); });
+    m_reaper = std::thread([this] { reap(); });
+  }
+
+public:
+  // Shut down worker threads.  Strands still scheduled belong to
+  // destroyed queues and are drained without executing tasks.  When
+  // deleted by the reaper thread, the reaper is detached and returns
+  // once the executor is deleted.
+  ~executor_impl()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_stop = true;
+    }
+    m_work.notify_all();
+    m_reap.notify_all();
+    for (auto& t : m_threads)
+      t.join();
+    if (m_reaper.get_id() == std::this_thread::get_id())
+      m_reaper.detach();
+    else
+      m_reaper.join();
+  }
+
+  // Create an executor that is deleted by the reaper thread if the
+  // last reference is released by a worker thread
+  static std::shared_ptr<executor_impl>
+  create(unsigned int num_threads)
+  {
+    return {new executor_impl(num_threads), &executor_impl::release};
+  }
+
+  executor_impl(const executor_impl&) = delete;
+  executor_impl(executor_impl&&) = delete;
+  executor_impl& operator=(const executor_impl&) = delete;
+  executor_impl& operator=(executor_impl&&) = delete;
+
+  // True if the calling thread is a worker thread of this executor
+  bool
+  is_worker() const
+  {
+    return t_executor == this;
+  }
+
+  void
+  schedule(std::shared_ptr<strand> s)
+  {
+    auto idx = (t_executor == this)
+      ? t_worker
+      : m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    // A worker increments m_sleeping before checking m_pending with
+    // m_mutex locked, so either the worker sees the pending strand
+    // or this thread sees the sleeping worker.
+    {
+      auto& w = *m_workers[idx];
+      std::lock_guard lk(w.mutex);
+      w.strands.push_back(std::move(s));
+      ++m_pending;
+    }
+    if (m_sleeping.load()) {
+      std::lock_guard lk(m_mutex);
+      m_work.notify_one();
+    }
+  }
+};
+
+thread_local const executor_impl* executor_impl::t_executor = nullptr;
+thread_local size_t executor_impl::t_worker = 0;
+thread_local const executor_impl::strand* executor_impl::t_strand = nullptr;
+
+} // xrt
+
+namespace {
+
+// class thread_queue - queue with a dedicated worker thread
+class thread_queue : public xrt::queue_impl
+{
+  std::queue<task> m_queue;  // task queue
   std::mutex m_mutex;
   std::condition_variable m_work;
   bool m_stop = false;
@@ -41,7 +385,7 @@ class queue_impl
   run()
   {
     while (!m_stop) {
-      xrt::queue::task task;
+      task task;
 
       // exclusive synchronized region
       {
@@ -61,12 +405,12 @@ class queue_impl
   }
 
 public:
-  queue_impl()
+  thread_queue()
     : m_worker([this] { run(); })
   {}
 
   // Shut down worker thread
-  ~queue_impl()
+  ~thread_queue() override
   {
     {
       std::lock_guard lk(m_mutex);
@@ -76,14 +420,14 @@ public:
     m_worker.join();
   }
 
-  queue_impl(const queue_impl&) = delete;
-  queue_impl(queue_impl&&) = delete;
-  queue_impl& operator=(const queue_impl&) = delete;
-  queue_impl& operator=(queue_impl&&) = delete;
+  thread_queue(const thread_queue&) = delete;
+  thread_queue(thread_queue&&) = delete;
+  thread_queue& operator=(const thread_queue&) = delete;
+  thread_queue& operator=(thread_queue&&) = delete;
 
   // Enqueue a task and notify worker
   void
-  enqueue(queue::task&& t)
+  enqueue(task&& t) override
   {
     std::lock_guard lk(m_mutex);
     m_queue.push(std::move(t));
@@ -91,16 +435,65 @@ public:
   }
 };
 
-} // xrt
+// class strand_queue - queue executed by a strand of an executor
+class strand_queue : public xrt::queue_impl
+{
+  // executor must be destroyed after strand
+  std::shared_ptr<xrt::executor_impl> m_executor;
+  std::shared_ptr<xrt::executor_impl::strand> m_strand;
+
+public:
+  explicit
+  strand_queue(std::shared_ptr<xrt::executor_impl> executor)
+    : m_executor(std::move(executor))
+    , m_strand(std::make_shared<xrt::executor_impl::strand>(m_executor.get()))
+  {}
+
+  // Discard pending tasks, wait for executing task.  The queue may
+  // be destroyed by a task executing on its own strand, in which case
+  // the executing task is not waited for.
+  ~strand_queue() override
+  {
+    m_strand->stop();
+  }
+
+  strand_queue(const strand_queue&) = delete;
+  strand_queue(strand_queue&&) = delete;
+  strand_queue& operator=(const strand_queue&) = delete;
+  strand_queue& operator=(strand_queue&&) = delete;
+
+  void
+  enqueue(task&& t) override
+  {
+    m_strand->enqueue(std::move(t));
+  }
+};
+
+} // namespace
 
 ////////////////////////////////////////////////////////////////
 // xrt_enqueue C++ API implmentations (xrt_enqueue.h)
 ////////////////////////////////////////////////////////////////
 namespace xrt {
 
+queue::executor::
+executor()
+  : executor(std::max(1u, std::thread::hardware_concurrency()))
+{}
+
+queue::executor::
+executor(unsigned int num_threads)
+  : m_impl(executor_impl::create(num_threads))
+{}
+
 queue::
 queue()
-  : m_impl(std::make_shared<queue_impl>())
+  : m_impl(std::make_shared<thread_queue>())
+{}
+
+queue::
+queue(const executor& ex)
+  : m_impl(std::make_shared<strand_queue>(ex.get_handle()))
 {}
 
 void
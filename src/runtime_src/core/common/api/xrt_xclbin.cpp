@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2020-2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2023-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 // This file implements XRT xclbin APIs as declared in
 // core/include/experimental/xrt_xclbin.h
@@ -8,6 +8,7 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #include "core/include/xrt/experimental/xrt_xclbin.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/system.h"
 #include "core/common/device.h"
 #include "core/common/message.h"
@@ -25,11 +26,13 @@
 #include <boost/algorithm/string.hpp>
 
 #include <array>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <numeric>
 #include <regex>
 #include <set>
+#include <utility>
 #include <vector>
 #include <mutex>
 
@@ -38,6 +41,10 @@
 # pragma warning( disable : 4244 4267 4996)
 #else
 # include <linux/uuid.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
 #endif
 
 namespace {
@@ -90,6 +97,101 @@ read_xclbin(const std::string& fnm)
   return read_file(path.string());
 }
 
+// class axlf_data - raw data of a full xclbin
+//
+// The data is either an owned copy of the xclbin, or a read-only
+// private mapping of an xclbin file.  A mapped xclbin is not read up
+// front, pages of the file are brought in when first accessed, and
+// sections that are never accessed, e.g. bitstreams of an xclbin
+// loaded for metadata only, never occupy memory.  The file must not
+// be truncated or rewritten in place while mapped, mapping can be
+// disabled with Runtime.xclbin_mmap.
+class axlf_data
+{
+  std::vector<char> m_copy;
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+  void* m_map = nullptr;
+
+  axlf_data() = default;
+
+public:
+  explicit
+  axlf_data(std::vector<char> data)
+    : m_copy(std::move(data))
+    , m_data(m_copy.data())
+    , m_size(m_copy.size())
+  {}
+
+  ~axlf_data()
+  {
+#ifndef _WIN32
+    if (m_map)
+      ::munmap(m_map, m_size);
+#endif
+  }
+
+  axlf_data(const axlf_data&) = delete;
+  axlf_data& operator=(const axlf_data&) = delete;
+
+  axlf_data(axlf_data&& rhs) noexcept
+    : m_copy(std::move(rhs.m_copy))
+    , m_data(std::exchange(rhs.m_data, nullptr))
+    , m_size(std::exchange(rhs.m_size, 0))
+    , m_map(std::exchange(rhs.m_map, nullptr))
+  {}
+
+  axlf_data& operator=(axlf_data&&) = delete;
+
+  // Map an xclbin file.  Reads the file if mapping is disabled in
+  // xrt.ini, not supported, or fails, e.g. for files that are not
+  // regular files.
+  static axlf_data
+  map_file(const std::string& fnm)
+  {
+#ifndef _WIN32
+    auto fd = xrt_core::config::get_xclbin_mmap() ? ::open(fnm.c_str(), O_RDONLY | O_CLOEXEC) : -1;
+    if (fd >= 0) {
+      struct stat st {};
+      auto size = (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) ? static_cast<size_t>(st.st_size) : 0;
+      auto addr = size ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+      ::close(fd);  // mapping keeps a reference to the file
+
+      if (addr != MAP_FAILED) {
+        axlf_data data;
+        data.m_map = addr;
+        data.m_data = static_cast<const char*>(addr);
+        data.m_size = size;
+        return data;
+      }
+    }
+#endif
+    return axlf_data{read_file(fnm)};
+  }
+
+  const char*
+  data() const
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+static axlf_data
+map_xclbin(const std::string& fnm)
+{
+  if (fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  auto path = xrt_core::environment::platform_path(fnm);
+  return axlf_data::map_file(path.string());
+}
+
 static std::vector<char>
 copy_axlf(const axlf* top)
 {
@@ -383,6 +485,7 @@ class xclbin_impl
   struct xclbin_info
   {
     const xclbin_impl* m_ximpl;
+    std::shared_ptr<const xrt_core::xclbin::xml_index> m_xml_index; // EMBEDDED_METADATA
     std::string m_project_name;           // <project name="foo">
     std::string m_fpga_device_name;       // <device fpgaDevice="foo">
     std::vector<xclbin::mem> m_mems;
@@ -448,21 +551,19 @@ class xclbin_impl
     // Pre-condition for this function is that init_mems() and init_ips()
     // have been called.
     static std::vector<xclbin::kernel>
-    init_kernels(const xclbin_impl* ximpl, const std::vector<xclbin::ip>& ips)
+    init_kernels(const xrt_core::xclbin::xml_index* xml_index, const std::vector<xclbin::ip>& ips)
     {
-      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
-      if (!xml.first)
+      if (!xml_index)
         return {};
 
       // get kernel CUs from xclbin meta data
       std::vector<xclbin::kernel> kernels;
-      for (auto& kernel : xrt_core::xclbin::get_kernels(xml.first, xml.second)) {
-        auto props = xrt_core::xclbin::get_kernel_properties(xml.first, xml.second, kernel.name);
+      for (auto& kernel : xrt_core::xclbin::get_kernels(*xml_index)) {
         std::vector<xclbin::ip> cus;
         copy_if_name_match(ips.begin(), ips.end(), std::back_inserter(cus), kernel.name);
         kernels.emplace_back
           (std::make_shared<xclbin::kernel_impl>
-           (std::move(kernel.name), std::move(props), std::move(cus), std::move(kernel.args)));
+           (std::move(kernel.name), std::move(kernel.properties), std::move(cus), std::move(kernel.args)));
       }
 
       return kernels;
@@ -480,21 +581,32 @@ class xclbin_impl
       return aie_partitions;
     }
 
-    static std::string
-    init_project_name(const xclbin_impl* ximpl)
+    // init_xml_index() - index xml meta data in one pass over the xml
+    //
+    // Kernel meta data queries of this xclbin are served from the
+    // index.
+    static std::shared_ptr<const xrt_core::xclbin::xml_index>
+    init_xml_index(const xclbin_impl* ximpl)
     {
       auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
       return xml.first
-        ? xrt_core::xclbin::get_project_name(xml.first, xml.second)
+        ? xrt_core::xclbin::create_xml_index(xml.first, xml.second)
+        : nullptr;
+    }
+
+    static std::string
+    init_project_name(const xrt_core::xclbin::xml_index* xml_index)
+    {
+      return xml_index
+        ? xrt_core::xclbin::get_project_name(*xml_index)
         : "";
     }
 
     static std::string
-    init_fpga_device_name(const xclbin_impl* ximpl)
+    init_fpga_device_name(const xrt_core::xclbin::xml_index* xml_index)
     {
-      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
-      return xml.first
-        ? xrt_core::xclbin::get_fpga_device_name(xml.first, xml.second)
+      return xml_index
+        ? xrt_core::xclbin::get_fpga_device_name(*xml_index)
         : "";
     }
 
@@ -572,11 +684,12 @@ class xclbin_impl
     explicit
     xclbin_info(const xrt::xclbin_impl* impl)
       : m_ximpl(impl)
-      , m_project_name(init_project_name(m_ximpl))
-      , m_fpga_device_name(init_fpga_device_name(m_ximpl))
+      , m_xml_index(init_xml_index(m_ximpl))
+      , m_project_name(init_project_name(m_xml_index.get()))
+      , m_fpga_device_name(init_fpga_device_name(m_xml_index.get()))
       , m_mems(init_mems(m_ximpl))
       , m_ips(init_ips(m_ximpl, m_mems))
-      , m_kernels(init_kernels(m_ximpl, m_ips))
+      , m_kernels(init_kernels(m_xml_index.get(), m_ips))
       , m_aie_partitions(init_aie_partitions(m_ximpl))
       , m_membank_encoding(init_mem_encoding(m_mems))
     {}
@@ -730,6 +843,12 @@ public:
     return get_xclbin_info()->m_membank_encoding;
   }
 
+  std::shared_ptr<const xrt_core::xclbin::xml_index>
+  get_xml_index() const
+  {
+    return get_xclbin_info()->m_xml_index;
+  }
+
   const std::string&
   get_project_name() const
   {
@@ -755,20 +874,34 @@ public:
 // binary images for file content
 class xclbin_full : public xclbin_impl
 {
-  std::vector<char> m_axlf;    // complete copy of xclbin raw data
+  // Sections that are referenced in place must be aligned such that
+  // section data can be accessed through section structs
+  static constexpr size_t section_alignment = alignof(uint64_t);
+
+  axlf_data m_axlf;            // xclbin raw data, copied or mapped
   const axlf* m_top = nullptr; // axlf pointer to the raw data
   uuid m_uuid;                 // uuid of xclbin
   uuid m_intf_uuid;
 
-  // sections within this xclbin
-  std::multimap<axlf_section_kind, std::vector<char>> m_axlf_sections;
+  // sections within this xclbin, referencing the raw data
+  std::multimap<axlf_section_kind, std::pair<const char*, size_t>> m_axlf_sections;
+
+  // copies of sections that are not aligned in the raw data
+  std::vector<std::vector<char>> m_section_copies;
 
   void
   emplace_section(const axlf_section_header* hdr, axlf_section_kind kind)
   {
-    auto section_data = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
-    std::vector<char> data{section_data, section_data + hdr->m_sectionSize};
-    m_axlf_sections.emplace(kind , std::move(data));
+    if (hdr->m_sectionOffset > m_axlf.size() || hdr->m_sectionSize > m_axlf.size() - hdr->m_sectionOffset)
+      throw std::runtime_error("Invalid xclbin, section " + std::to_string(kind) + " exceeds xclbin size");
+
+    auto section_data = m_axlf.data() + hdr->m_sectionOffset;
+    auto section_size = static_cast<size_t>(hdr->m_sectionSize);
+    if (reinterpret_cast<uintptr_t>(section_data) % section_alignment) {
+      auto& copy = m_section_copies.emplace_back(section_data, section_data + section_size);
+      section_data = copy.data();
+    }
+    m_axlf_sections.emplace(kind, std::make_pair(section_data, section_size));
   }
 
   void
@@ -783,6 +916,9 @@ class xclbin_full : public xclbin_impl
   void
   init_axlf()
   {
+    if (m_axlf.size() < sizeof(axlf))
+      throw std::runtime_error("Invalid xclbin");
+
     const axlf* tmp = reinterpret_cast<const axlf*>(m_axlf.data());
     if (strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
       throw std::runtime_error("Invalid xclbin");
@@ -814,7 +950,7 @@ class xclbin_full : public xclbin_impl
 public:
   explicit
   xclbin_full(const std::string& filename)
-    : m_axlf(read_xclbin(filename))
+    : m_axlf(map_xclbin(filename))
   {
     init();
   }
@@ -875,7 +1011,7 @@ public:
   {
     auto itr = m_axlf_sections.find(kind);
     return itr != m_axlf_sections.end()
-      ? std::make_pair((*itr).second.data(), (*itr).second.size())
+      ? itr->second
       : std::make_pair(nullptr, size_t(0));
   }
 
@@ -890,7 +1026,7 @@ public:
       std::vector<std::pair<const char*, size_t>> return_sections;
 
       for (auto itr = result.first; itr != result.second; itr++)
-        return_sections.emplace_back(std::make_pair(itr->second.data(), itr->second.size()));
+        return_sections.emplace_back(itr->second);
 
       return return_sections;
     }
@@ -1612,6 +1748,12 @@ get_project_name(const xrt::xclbin& xclbin)
   return xclbin.get_handle()->get_project_name();
 }
 
+std::shared_ptr<const xrt_core::xclbin::xml_index>
+get_xml_index(const xrt::xclbin& xclbin)
+{
+  return xclbin.get_handle()->get_xml_index();
+}
+
 } // xrt_core::xclbin_int
 
 ////////////////////////////////////////////////////////////////
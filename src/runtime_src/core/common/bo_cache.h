@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2019 Xilinx, Inc
-// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #ifndef core_common_bo_cache_h_
 #define core_common_bo_cache_h_
@@ -10,9 +10,17 @@
 #include "core/common/shim/buffer_handle.h"
 #include "core/include/xrt/detail/ert.h"
 
-#include <vector>
-#include <utility>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( push )
@@ -21,48 +29,141 @@
 
 namespace xrt_core {
 
-// Create a cache of CMD BO objects -- for now only used for M2M -- to reduce
-// the overhead of BO life cycle management.
-template <size_t BoSize>
-class bo_cache_t {
+// struct bo_cache_stats - Counters used to size a BO cache
+//
+// @hits: Allocations served from the cache
+// @misses: Allocations that required a new BO from the driver
+// @steals: Hits that were served from another thread's shard
+// @contention: Number of times a shard lock was found busy
+// @releases: BOs returned to the cache
+// @destroyed: BOs destroyed on release because the cache was full
+struct bo_cache_stats
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t steals = 0;
+  uint64_t contention = 0;
+  uint64_t releases = 0;
+  uint64_t destroyed = 0;
+
+  bo_cache_stats&
+  operator+=(const bo_cache_stats& rhs)
+  {
+    hits += rhs.hits;
+    misses += rhs.misses;
+    steals += rhs.steals;
+    contention += rhs.contention;
+    releases += rhs.releases;
+    destroyed += rhs.destroyed;
+    return *this;
+  }
+};
+
+// Create a cache of CMD BO objects to reduce the overhead of BO life
+// cycle management.
+//
+// The cache is split into shards, each with its own lock.  A thread
+// is assigned a home shard on first use, and allocates from and
+// releases to its home shard.  An allocation that misses in the home
+// shard tries to steal from other shards without blocking before
+// falling back to allocating a new BO.  This keeps multi-threaded
+// command construction and destruction from serializing on a single
+// lock.
+class bo_cache_base {
 public:
   // Helper typedef for std::pair. Note the elements are const so that the
   // pair is immutable. The clients should not change the contents of cmd_bo.
   template <typename CommandType>
   using cmd_bo = std::pair<std::unique_ptr<buffer_handle>, CommandType *const>;
 private:
+  static constexpr size_t cache_line = 64;
+  static constexpr unsigned int max_shards = 16;
+
+  struct alignas(cache_line) shard
+  {
+    std::mutex mutex;
+    std::vector<cmd_bo<void>> bos;
+    std::atomic<uint64_t> hits {0};
+    std::atomic<uint64_t> misses {0};
+    std::atomic<uint64_t> steals {0};
+    std::atomic<uint64_t> contention {0};
+    std::atomic<uint64_t> releases {0};
+    std::atomic<uint64_t> destroyed {0};
+  };
 
   // We are really allocating a page size as that is what xocl/zocl do. Note on
   // POWER9 pagesize maybe more than 4K, xocl would upsize the allocation to the
   // correct pagesize. unmap always unmaps the full page.
-  static constexpr size_t m_bo_size = BoSize;
+  const size_t m_bo_size;
   std::shared_ptr<device> m_device;
   // Maximum number of BOs that can be cached in the pool. Value of 0 indicates
   // caching should be disabled.
   const unsigned int m_cache_max_size;
-  std::vector<cmd_bo<void>> m_cmd_bo_cache;
-  std::mutex m_mutex;
+  const unsigned int m_num_shards;
+  const size_t m_shard_max_size;
+  std::unique_ptr<shard[]> m_shards;  // NOLINT
+
+  // Number of shards is bounded by number of CPUs and by the cache
+  // size such that the total number of cached BOs is close to the
+  // requested maximum.
+  static unsigned int
+  num_shards(unsigned int max_size)
+  {
+    unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+    unsigned int shards = 1;
+    while (shards < cpus && shards < max_shards && shards < max_size)
+      shards <<= 1;
+    return shards;
+  }
+
+  // Home shard of calling thread
+  shard&
+  get_shard()
+  {
+    static std::atomic<unsigned int> thread_count {0};
+    static thread_local unsigned int thread_idx = thread_count++;
+    return m_shards[thread_idx % m_num_shards];
+  }
 
 public:
-  bo_cache_t(std::shared_ptr<xrt_core::device> device, unsigned int max_size)
-    : m_device(std::move(device)), m_cache_max_size(max_size)
+  bo_cache_base(std::shared_ptr<xrt_core::device> device, size_t bo_size, unsigned int max_size)
+    : m_bo_size(bo_size)
+    , m_device(std::move(device))
+    , m_cache_max_size(max_size)
+    , m_num_shards(num_shards(max_size))
+    , m_shard_max_size((max_size + m_num_shards - 1) / m_num_shards)
+    , m_shards(std::make_unique<shard[]>(m_num_shards))  // NOLINT
   {}
 
-  bo_cache_t(xclDeviceHandle handle, unsigned int max_size)
-    : m_device(get_userpf_device(handle)), m_cache_max_size(max_size)
+  bo_cache_base(xclDeviceHandle handle, size_t bo_size, unsigned int max_size)
+    : bo_cache_base(get_userpf_device(handle), bo_size, max_size)
   {}
 
-  ~bo_cache_t()
+  ~bo_cache_base()
   {
     try {
-      std::lock_guard<std::mutex> lock(m_mutex);
-      for (auto& bo : m_cmd_bo_cache)
-        destroy(bo);
+      for (unsigned int idx = 0; idx < m_num_shards; ++idx) {
+        auto& s = m_shards[idx];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (auto& bo : s.bos)
+          destroy(bo);
+      }
     }
     catch (...) {
     }
   }
 
+  bo_cache_base(const bo_cache_base&) = delete;
+  bo_cache_base(bo_cache_base&&) = delete;
+  bo_cache_base& operator=(const bo_cache_base&) = delete;
+  bo_cache_base& operator=(bo_cache_base&&) = delete;
+
+  size_t
+  get_bo_size() const
+  {
+    return m_bo_size;
+  }
+
   template<typename T>
   cmd_bo<T>
   alloc()
@@ -78,36 +179,107 @@ public:
     release_impl(std::make_pair(std::move(bo.first), static_cast<void *>(bo.second)));
   }
 
+  // Populate the cache with up to 'count' BOs.  The BOs are
+  // distributed across all shards.
+  void
+  prefill(unsigned int count)
+  {
+    count = std::min(count, m_cache_max_size);
+    for (unsigned int idx = 0; idx < count; ++idx) {
+      auto& s = m_shards[idx % m_num_shards];
+      std::lock_guard lock(s.mutex);
+      if (s.bos.size() >= m_shard_max_size)
+        continue;
+      s.bos.push_back(create());
+    }
+  }
+
+  // Snapshot of cache counters
+  bo_cache_stats
+  get_stats() const
+  {
+    bo_cache_stats stats;
+    for (unsigned int idx = 0; idx < m_num_shards; ++idx) {
+      const auto& s = m_shards[idx];
+      stats.hits += s.hits.load(std::memory_order_relaxed);
+      stats.misses += s.misses.load(std::memory_order_relaxed);
+      stats.steals += s.steals.load(std::memory_order_relaxed);
+      stats.contention += s.contention.load(std::memory_order_relaxed);
+      stats.releases += s.releases.load(std::memory_order_relaxed);
+      stats.destroyed += s.destroyed.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
 private:
+  // Lock shard, record contention if the lock is busy.  If 'block'
+  // is false, return without the lock when the lock is busy.
+  static std::unique_lock<std::mutex>
+  lock_shard(shard& s, bool block)
+  {
+    std::unique_lock lock(s.mutex, std::try_to_lock);
+    if (lock.owns_lock())
+      return lock;
+
+    s.contention.fetch_add(1, std::memory_order_relaxed);
+    if (block)
+      lock.lock();
+    return lock;
+  }
+
+  cmd_bo<void>
+  create()
+  {
+    auto execHandle = m_device->alloc_bo(m_bo_size, XCL_BO_FLAGS_EXECBUF);
+    auto map = execHandle->map(buffer_handle::map_type::write);
+    return std::make_pair(std::move(execHandle), map);
+  }
+
   cmd_bo<void>
   alloc_impl()
   {
+    auto& home = get_shard();
     if (m_cache_max_size) {
-      // If caching is enabled first look up in the BO cache
-      std::lock_guard lock(m_mutex);
-      if (!m_cmd_bo_cache.empty()) {
-        auto bo = std::move(m_cmd_bo_cache.back());
-        m_cmd_bo_cache.pop_back();
+      // If caching is enabled first look up in the home shard
+      if (auto lock = lock_shard(home, true); !home.bos.empty()) {
+        auto bo = std::move(home.bos.back());
+        home.bos.pop_back();
+        home.hits.fetch_add(1, std::memory_order_relaxed);
+        return bo;
+      }
+
+      // Steal from other shards, but don't wait for busy shards
+      for (unsigned int idx = 1; idx < m_num_shards; ++idx) {
+        auto& s = m_shards[(&home - m_shards.get() + idx) % m_num_shards];
+        auto lock = lock_shard(s, false);
+        if (!lock.owns_lock() || s.bos.empty())
+          continue;
+        auto bo = std::move(s.bos.back());
+        s.bos.pop_back();
+        home.hits.fetch_add(1, std::memory_order_relaxed);
+        home.steals.fetch_add(1, std::memory_order_relaxed);
         return bo;
       }
     }
 
-    auto execHandle = m_device->alloc_bo(m_bo_size, XCL_BO_FLAGS_EXECBUF);
-    auto map = execHandle->map(buffer_handle::map_type::write);
-    return std::make_pair(std::move(execHandle), map);
+    home.misses.fetch_add(1, std::memory_order_relaxed);
+    return create();
   }
 
   void
   release_impl(cmd_bo<void>&& bo)
   {
+    auto& home = get_shard();
     if (m_cache_max_size) {
-      // If caching is enabled and BO cache is not fully populated add this the cache
-      std::lock_guard lock(m_mutex);
-      if (m_cmd_bo_cache.size() < m_cache_max_size) {
-        m_cmd_bo_cache.push_back(std::move(bo));
+      // If caching is enabled and home shard is not fully populated add this the cache
+      auto lock = lock_shard(home, true);
+      if (home.bos.size() < m_shard_max_size) {
+        home.bos.push_back(std::move(bo));
+        home.releases.fetch_add(1, std::memory_order_relaxed);
         return;
       }
     }
+    home.destroyed.fetch_add(1, std::memory_order_relaxed);
     destroy(bo);
   }
 
@@ -118,8 +290,86 @@ private:
   }
 };
 
+// Cache of BOs with compile time size
+template <size_t BoSize>
+class bo_cache_t : public bo_cache_base {
+public:
+  bo_cache_t(std::shared_ptr<xrt_core::device> device, unsigned int max_size)
+    : bo_cache_base(std::move(device), BoSize, max_size)
+  {}
+
+  bo_cache_t(xclDeviceHandle handle, unsigned int max_size)
+    : bo_cache_base(handle, BoSize, max_size)
+  {}
+};
+
 using bo_cache = bo_cache_t<4096>;
 
+// class exec_bo_pool - Size classed pool of exec BOs for a device
+//
+// Command BOs are served from separate caches per size class so that
+// frequently recycled kernel regmap commands and chained runlist
+// commands do not evict each other.  Mailbox commands use regmap
+// exec buffers.  Each size class is a sharded bo_cache_base.
+class exec_bo_pool {
+public:
+  template <typename CommandType>
+  using cmd_bo = bo_cache_base::cmd_bo<CommandType>;
+
+  enum class size_class { regmap, chain };
+
+  // Size of BOs in each class, the page size is the minimum BO size
+  static constexpr size_t regmap_size = 4096;
+  static constexpr size_t chain_size = 4096;
+
+private:
+  std::array<std::unique_ptr<bo_cache_base>, 2> m_caches;
+
+  bo_cache_base&
+  get_cache(size_class sc) const
+  {
+    return *m_caches[static_cast<size_t>(sc)];
+  }
+
+public:
+  // Construct the pool.  The regmap class holds up to 'max_size' BOs
+  // and is prefilled with 'prefill' BOs.  Chained commands each carry
+  // many runs and are cached in smaller numbers.
+  exec_bo_pool(const std::shared_ptr<xrt_core::device>& device, unsigned int max_size, unsigned int prefill)
+  {
+    m_caches[static_cast<size_t>(size_class::regmap)] = std::make_unique<bo_cache_base>(device, regmap_size, max_size);
+    m_caches[static_cast<size_t>(size_class::chain)] = std::make_unique<bo_cache_base>(device, chain_size, max_size / 4);
+
+    if (prefill)
+      get_cache(size_class::regmap).prefill(prefill);
+  }
+
+  template<typename T>
+  cmd_bo<T>
+  alloc(size_class sc)
+  {
+    return get_cache(sc).alloc<T>();
+  }
+
+  // Release a BO allocated from specified size class
+  template<typename T>
+  void
+  release(cmd_bo<T>&& bo, size_class sc)
+  {
+    get_cache(sc).release(std::move(bo));
+  }
+
+  // Snapshot of counters accumulated across all size classes
+  bo_cache_stats
+  get_stats() const
+  {
+    bo_cache_stats stats;
+    for (const auto& cache : m_caches)
+      stats += cache->get_stats();
+    return stats;
+  }
+};
+
 } // xrt_core
 
 #ifdef _WIN32
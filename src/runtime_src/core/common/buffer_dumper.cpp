@@ -1,40 +1,222 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #define XCL_DRIVER_DLL_EXPORT  // in same dll as xrt_bo.h
 #define XRT_API_SOURCE         // in same dll as api
 #include "buffer_dumper.h"
+#include "core/common/api/bo_int.h"
 #include "core/common/message.h"
 #include "core/common/time.h"
 #include "core/common/utils.h"
 #include "core/common/uc_log_schema.h"
 
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <stdexcept>
 #include <sstream>
 #include <array>
+#include <system_error>
+
+#ifdef __linux__
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
 
 namespace xrt_core {
 
+// class output_file - output file of a chunk
+//
+// The metadata header is rewritten at the beginning of the file and
+// chunk data is appended.
+class buffer_dumper::output_file
+{
+public:
+  virtual ~output_file() = default;
+
+  // Write at offset, may extend the file
+  virtual void
+  write_at(size_t offset, const void* data, size_t size) = 0;
+
+  // Append at end of file
+  virtual void
+  append(const void* data, size_t size) = 0;
+
+  // Make written data visible to readers of the file
+  virtual void
+  flush() = 0;
+};
+
+namespace {
+
+// File written through std::ofstream
+class stream_file : public buffer_dumper::output_file
+{
+  std::string m_name;
+  std::ofstream m_fs;
+
+  void
+  check(const char* what)
+  {
+    if (!m_fs)
+      throw std::runtime_error(std::string{"Failed to "} + what + " dump file " + m_name);
+  }
+
+public:
+  explicit
+  stream_file(std::string name)
+    : m_name(std::move(name))
+    , m_fs(m_name, std::ios::out | std::ios::binary)
+  {
+    if (!m_fs.is_open())
+      throw std::runtime_error("Failed to open dump file " + m_name);
+  }
+
+  void
+  write_at(size_t offset, const void* data, size_t size) override
+  {
+    m_fs.seekp(static_cast<std::streamoff>(offset));
+    m_fs.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    check("write");
+  }
+
+  void
+  append(const void* data, size_t size) override
+  {
+    m_fs.seekp(0, std::ios::end);
+    m_fs.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    check("write");
+  }
+
+  void
+  flush() override
+  {
+    m_fs.flush();
+    check("flush");
+  }
+};
+
+#ifdef __linux__
+// File written through a shared memory mapping.  The mapping is grown
+// in large steps, so most appends are a copy without remapping.  The
+// file itself is extended to exactly the written size before data is
+// copied, so it holds no padding past the written data, also while
+// the process runs or after it died.  The mapping shares the
+// page cache with readers of the file, flush is a no-op.
+class mapped_file : public buffer_dumper::output_file
+{
+  static constexpr size_t grow_size = 4 << 20;
+
+  std::string m_name;
+  int m_fd = -1;
+  char* m_addr = nullptr;
+  size_t m_size = 0;     // bytes written, size of file
+  size_t m_capacity = 0; // size of mapping
+
+  // Extend file to size and the mapping to cover it
+  void
+  extend(size_t size)
+  {
+    if (size <= m_size)
+      return;
+
+    if (size > m_capacity) {
+      auto capacity = std::max(size, m_capacity + grow_size);
+      auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      capacity = (capacity + page - 1) / page * page;
+
+      // Mapping past end of file is valid, only access is not
+      auto addr = m_addr
+        ? mremap(m_addr, m_capacity, capacity, MREMAP_MAYMOVE)
+        : mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+      if (addr == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "Failed to map dump file " + m_name);
+
+      m_addr = static_cast<char*>(addr);
+      m_capacity = capacity;
+    }
+
+    if (ftruncate(m_fd, static_cast<off_t>(size)))
+      throw std::system_error(errno, std::generic_category(), "Failed to grow dump file " + m_name);
+    m_size = size;
+  }
+
+public:
+  explicit
+  mapped_file(std::string name)
+    : m_name(std::move(name))
+    , m_fd(open(m_name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) // NOLINT
+  {
+    if (m_fd < 0)
+      throw std::system_error(errno, std::generic_category(), "Failed to open dump file " + m_name);
+  }
+
+  ~mapped_file() override
+  {
+    if (m_addr)
+      munmap(m_addr, m_capacity);
+    close(m_fd);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file(mapped_file&&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  mapped_file& operator=(mapped_file&&) = delete;
+
+  void
+  write_at(size_t offset, const void* data, size_t size) override
+  {
+    extend(offset + size);
+    std::memcpy(m_addr + offset, data, size);
+  }
+
+  void
+  append(const void* data, size_t size) override
+  {
+    write_at(m_size, data, size);
+  }
+
+  void
+  flush() override
+  {}
+};
+#endif
+
+std::unique_ptr<buffer_dumper::output_file>
+create_output_file(std::string name, bool mapped)
+{
+#ifdef __linux__
+  if (mapped)
+    return std::make_unique<mapped_file>(std::move(name));
+#else
+  (void)mapped;
+#endif
+  return std::make_unique<stream_file>(std::move(name));
+}
+
+} // namespace
+
 buffer_dumper::
 buffer_dumper(config cfg)
   : m_config(std::move(cfg))
   , m_data_size(m_config.chunk_size - m_config.metadata_size)
   , m_dumped_counts(m_config.num_chunks, 0)
-  , m_file_streams(m_config.num_chunks)
+  , m_files(m_config.num_chunks)
+  , m_interval_ms(m_config.dump_interval_ms)
 {
-  // Files are opened lazily in get_or_open_stream() when first data is available
+  // Files are opened lazily in get_or_open_file() when first data is available
   // start the background thread to dump the data
   m_dump_thread = std::thread(&buffer_dumper::dumping_loop, this);
 }
 
-std::ofstream&
+buffer_dumper::output_file&
 buffer_dumper::
-get_or_open_stream(size_t chunk_index)
+get_or_open_file(size_t chunk_index)
 {
-  std::ofstream& fs = m_file_streams[chunk_index];
-  if (fs.is_open())
-    return fs;
+  auto& file = m_files[chunk_index];
+  if (file)
+    return *file;
 
   if (m_session_timestamp.empty())
     m_session_timestamp = xrt_core::get_timestamp_for_filename();
@@ -43,11 +225,8 @@ get_or_open_stream(size_t chunk_index)
                          std::to_string(xrt_core::utils::get_pid()) + "_" +
                          std::to_string(chunk_index) + (m_config.dump_bin_format ? ".bin" : ".txt");
 
-  fs.open(filename, std::ios::out | std::ios::binary);
-  if (!fs.is_open())
-    throw std::runtime_error("Failed to open dump file " + filename);
-
-  return fs;
+  file = create_output_file(std::move(filename), m_config.mapped_output);
+  return *file;
 }
 
 buffer_dumper::
@@ -60,6 +239,13 @@ buffer_dumper::
     m_cv.notify_one();
     m_dump_thread.join();
     flush();
+
+    xrt_core::message::send(xrt_core::message::severity_level::debug, "buffer_dumper",
+        m_config.dump_file_prefix + ": " + std::to_string(m_stats.wakeups) + " wakeups ("
+        + std::to_string(m_stats.idle_wakeups) + " idle), " + std::to_string(m_stats.syncs) + " syncs, "
+        + std::to_string(m_stats.bytes) + " bytes dumped, "
+        + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(m_stats.busy).count())
+        + " us busy");
   }
   catch (const std::exception& e) {
     xrt_core::message::send(xrt_core::message::severity_level::warning, "buffer_dumper",
@@ -80,13 +266,7 @@ void
 buffer_dumper::
 dump_chunk_data(size_t chunk_index, size_t start, size_t length, uint8_t* chunk)
 {
-  std::ofstream& fs = get_or_open_stream(chunk_index);
-
-  // Check if stream is in good state before writing
-  if (!fs.good()) {
-    throw std::runtime_error("File stream for chunk " + std::to_string(chunk_index) +
-                             " is in bad state before write");
-  }
+  auto& file = get_or_open_file(chunk_index);
 
   // Calculate start offset and bytes to end for circular buffer wrapping
   const size_t start_offset = (start % m_data_size) + m_config.metadata_size;
@@ -96,49 +276,19 @@ dump_chunk_data(size_t chunk_index, size_t start, size_t length, uint8_t* chunk)
   if (m_config.dump_bin_format) {
     // Always write/update metadata since this function is called when there's new data
     // and metadata(count) gets updated when there is new data
-    // Seek to beginning and write/update metadata
-    fs.seekp(0);
-    fs.write(reinterpret_cast<const char*>(chunk),
-            static_cast<std::streamsize>(m_config.metadata_size));
-
-    if (!fs)
-      throw std::runtime_error("Failed to write metadata for chunk " + std::to_string(chunk_index));
-
-    // Seek to end to append actual data
-    fs.seekp(0, std::ios::end);
+    file.write_at(0, chunk, m_config.metadata_size);
 
     if (length <= bytes_to_end) { // data doesn't wrap around
-      fs.write(reinterpret_cast<const char*>(chunk + start_offset),
-              static_cast<std::streamsize>(length));
-
-      if (!fs)
-        throw std::runtime_error("Failed to write " + std::to_string(length) +
-                                " bytes to chunk " + std::to_string(chunk_index));
+      file.append(chunk + start_offset, length);
     }
     else {
       // data wraps around
-      // write the first part
-      fs.write(reinterpret_cast<const char*>(chunk + start_offset),
-              static_cast<std::streamsize>(bytes_to_end));
-
-      if (!fs)
-        throw std::runtime_error("Failed to write first part (" + std::to_string(bytes_to_end) +
-                                " bytes) to chunk " + std::to_string(chunk_index));
-
-      // write the wrapped part
-      fs.write(reinterpret_cast<const char*>(chunk + m_config.metadata_size),
-              static_cast<std::streamsize>(length - bytes_to_end));
-
-      if (!fs)
-        throw std::runtime_error("Failed to write wrapped part (" +
-                                std::to_string(length - bytes_to_end) +
-                                " bytes) to chunk " + std::to_string(chunk_index));
+      // write the first part, then the wrapped part
+      file.append(chunk + start_offset, bytes_to_end);
+      file.append(chunk + m_config.metadata_size, length - bytes_to_end);
     }
 
-    fs.flush();
-    if (!fs)
-      throw std::runtime_error("Failed to flush chunk " + std::to_string(chunk_index));
-
+    file.flush();
     return;
   }
 
@@ -210,11 +360,8 @@ dump_chunk_data(size_t chunk_index, size_t start, size_t length, uint8_t* chunk)
     parsed_stream << "[0.000000000] [CERT] [Dumper]--------------[Separator]--------------\n";
 
     // Append parsed output to file
-    fs.seekp(0, std::ios::end);
-    fs << parsed_stream.str();
-
-    if (!fs)
-      throw std::runtime_error("Failed to write parsed UC log for chunk " + std::to_string(chunk_index));
+    auto parsed = parsed_stream.str();
+    file.append(parsed.data(), parsed.size());
   }
   catch (const std::exception& e) {
     // Log parsing error, log warning and continue
@@ -222,25 +369,83 @@ dump_chunk_data(size_t chunk_index, size_t start, size_t length, uint8_t* chunk)
                             std::string{"UC log parsing failed: "} + e.what());
   }
 
-  fs.flush();
-  if (!fs)
-    throw std::runtime_error("Failed to flush chunk " + std::to_string(chunk_index));
+  file.flush();
 }
 
 void
 buffer_dumper::
+sync(const std::vector<sync_range>& ranges)
+{
+  if (ranges.empty())
+    return;
+
+  if (ranges.size() == 1)
+    m_config.dump_buffer.sync(XCL_BO_SYNC_BO_FROM_DEVICE, ranges.front().size, ranges.front().offset);
+  else
+    xrt_core::bo_int::sync(m_config.dump_buffer, XCL_BO_SYNC_BO_FROM_DEVICE, ranges);
+  ++m_stats.syncs;
+}
+
+void
+buffer_dumper::
+add_data_ranges(size_t chunk_index, size_t start, size_t length, std::vector<sync_range>& ranges)
+{
+  const size_t chunk_offset = chunk_index * m_config.chunk_size;
+  const size_t start_offset = (start % m_data_size) + m_config.metadata_size;
+  const size_t bytes_to_end = m_config.chunk_size - start_offset;
+
+  if (length <= bytes_to_end) {
+    // Data doesn't wrap, one contiguous range
+    ranges.push_back({length, chunk_offset + start_offset});
+  }
+  else {
+    // Data wraps around, two ranges
+    ranges.push_back({bytes_to_end, chunk_offset + start_offset});
+    ranges.push_back({length - bytes_to_end, chunk_offset + m_config.metadata_size});
+  }
+}
+
+bool
+buffer_dumper::
 process_chunks_no_lock()
 {
+  auto start_time = std::chrono::steady_clock::now();
+  ++m_stats.wakeups;
+
   // Map buffer once for all chunks
   auto base_ptr = m_config.dump_buffer.map<uint8_t*>();
 
+  // In batch mode the metadata of all chunks is synced with one
+  // request, then the new data of all chunks is synced with one
+  // request.  Otherwise the metadata and the new data of each chunk
+  // are synced on their own.  Only new data is synced in either case.
+  std::vector<sync_range> ranges;
+  if (m_config.batch_sync) {
+    ranges.reserve(m_config.num_chunks);
+    for (size_t i = 0; i < m_config.num_chunks; i++)
+      ranges.push_back({m_config.metadata_size, i * m_config.chunk_size});
+    sync(ranges);
+    ranges.clear();
+  }
+
+  // Chunks with new data to dump after the batched data sync
+  struct pending_dump
+  {
+    size_t chunk_index;
+    size_t start;
+    size_t length;
+  };
+  std::vector<pending_dump> pending;
+
+  bool new_data = false;
   for (size_t i = 0; i < m_config.num_chunks; i++)
   {
     const size_t chunk_offset = i * m_config.chunk_size;
     auto chunk = base_ptr + chunk_offset;
 
     // sync only the metadata for the current chunk to read the logged count
-    m_config.dump_buffer.sync(XCL_BO_SYNC_BO_FROM_DEVICE, m_config.metadata_size, chunk_offset);
+    if (!m_config.batch_sync)
+      sync({{m_config.metadata_size, chunk_offset}});
 
     size_t logged_count = read_logged_count(chunk);
     size_t& dumped_count = m_dumped_counts[i];
@@ -253,24 +458,34 @@ process_chunks_no_lock()
 
     if (dumped_count != logged_count) {
       size_t to_dump = logged_count - dumped_count;
-      const size_t start_offset = (dumped_count % m_data_size) + m_config.metadata_size;
-      const size_t bytes_to_end = m_config.chunk_size - start_offset;
 
-      // Sync only the data range we need to dump
-      if (to_dump <= bytes_to_end) {
-        // Data doesn't wrap, sync contiguous range
-        m_config.dump_buffer.sync(XCL_BO_SYNC_BO_FROM_DEVICE, to_dump, chunk_offset + start_offset);
+      // Sync only the data range we need to dump.  Data is written
+      // before the count is updated, so data synced after the count
+      // was read is valid for the count.
+      add_data_ranges(i, dumped_count, to_dump, ranges);
+      if (m_config.batch_sync) {
+        pending.push_back({i, dumped_count, to_dump});
       }
       else {
-        // Data wraps around, sync two ranges
-        m_config.dump_buffer.sync(XCL_BO_SYNC_BO_FROM_DEVICE, bytes_to_end, chunk_offset + start_offset);
-        m_config.dump_buffer.sync(XCL_BO_SYNC_BO_FROM_DEVICE, to_dump - bytes_to_end, chunk_offset + m_config.metadata_size);
+        sync(ranges);
+        ranges.clear();
+        dump_chunk_data(i, dumped_count, to_dump, chunk);
       }
 
-      dump_chunk_data(i, dumped_count, to_dump, chunk);
       dumped_count = logged_count;
+      m_stats.bytes += to_dump;
+      new_data = true;
     }
   }
+
+  sync(ranges);
+  for (const auto& p : pending)
+    dump_chunk_data(p.chunk_index, p.start, p.length, base_ptr + (p.chunk_index * m_config.chunk_size));
+
+  if (!new_data)
+    ++m_stats.idle_wakeups;
+  m_stats.busy += std::chrono::steady_clock::now() - start_time;
+  return new_data;
 }
 
 void
@@ -288,11 +503,19 @@ dumping_loop()
   while (!m_stop_thread) {
     try {
       std::unique_lock lock(m_dump_mutex);
-      m_cv.wait_for(lock, std::chrono::milliseconds(m_config.dump_interval_ms),
+      m_cv.wait_for(lock, std::chrono::milliseconds(m_interval_ms),
                     [this] { return m_stop_thread.load(); });
 
-      if (!m_stop_thread)
-        process_chunks_no_lock();
+      if (m_stop_thread)
+        break;
+
+      // Back off polling while idle, return to the configured
+      // interval as soon as there is new data
+      auto new_data = process_chunks_no_lock();
+      if (new_data || m_config.max_dump_interval_ms <= m_config.dump_interval_ms)
+        m_interval_ms = m_config.dump_interval_ms;
+      else
+        m_interval_ms = std::min(std::max<size_t>(m_interval_ms * 2, 1), m_config.max_dump_interval_ms);
     }
     catch (const std::exception& e) {
       // Log error but keep thread running
@@ -1,13 +1,15 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef xrtcore_util_buffer_dumper_h_
 #define xrtcore_util_buffer_dumper_h_
 #include "core/include/xrt/xrt_bo.h"
+#include "core/common/shim/buffer_handle.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
-#include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -29,6 +31,15 @@ namespace xrt_core {
  * - Handles circular buffer wrapping within chunks
  * - Dynamically updates metadata header as data accumulates
  * - Thread-safe with mutex protection
+ *
+ * Optional low overhead mode for many chunks:
+ * - Metadata of all chunks is synced with one request per wakeup,
+ *   followed by one request for the new data of all chunks
+ * - Files are appended through a memory mapping where supported
+ * - Polling interval backs off while no new data arrives
+ *
+ * Wakeups, syncs, dumped bytes, and time spent dumping are reported
+ * as debug message when the dumper is destroyed.
  */
 class buffer_dumper
 {
@@ -45,6 +56,9 @@ public:
     std::string dump_file_prefix;     // Output file prefix
     xrt::bo dump_buffer;              // xrt buffer object to dump
     bool dump_bin_format = false;     // Dump in binary format when enabled
+    bool batch_sync = false;          // Sync metadata and data of all chunks in one request each
+    bool mapped_output = false;       // Append to files through memory mapping
+    size_t max_dump_interval_ms = 0;  // Back off polling up to this interval while idle, 0 disables
   };
 
   // Log entry struct for uc log binary format
@@ -60,7 +74,20 @@ public:
     uint32_t argument2 = 0;           // Second argument (present if length > 7)
   };
 
+  // Output file of a chunk, defined in implementation
+  class output_file;
+
 private:
+  // Counters of dumper overhead
+  struct statistics
+  {
+    size_t wakeups = 0;               // Number of times chunks were processed
+    size_t idle_wakeups = 0;          // Wakeups without new data
+    size_t syncs = 0;                 // Number of buffer syncs
+    size_t bytes = 0;                 // Bytes of chunk data dumped
+    std::chrono::nanoseconds busy{0}; // Time spent processing chunks
+  };
+
   config m_config;
   size_t m_data_size = 0;
   std::vector<size_t> m_dumped_counts;
@@ -68,12 +95,25 @@ private:
   std::atomic<bool> m_stop_thread{false};
   std::mutex m_dump_mutex;
   std::condition_variable m_cv;
-  std::vector<std::ofstream> m_file_streams;
+  std::vector<std::unique_ptr<output_file>> m_files;
   std::string m_session_timestamp;  // Set on first file open for consistent naming
+  size_t m_interval_ms = 0;         // Current polling interval
+  statistics m_stats;
 
-  // Open file for chunk lazily when first data is available; returns stream
-  std::ofstream&
-  get_or_open_stream(size_t chunk_index);
+  // Open file for chunk lazily when first data is available; returns file
+  output_file&
+  get_or_open_file(size_t chunk_index);
+
+  using sync_range = xrt_core::buffer_handle::range;
+
+  // Sync ranges of dump buffer from device with one request
+  void
+  sync(const std::vector<sync_range>& ranges);
+
+  // Add the ranges of length bytes of chunk data from start, which
+  // may wrap around the end of the chunk
+  void
+  add_data_ranges(size_t chunk_index, size_t start, size_t length, std::vector<sync_range>& ranges);
 
   // Read the logged count from chunk metadata
   size_t
@@ -84,7 +124,8 @@ private:
   dump_chunk_data(size_t chunk_index, size_t start, size_t length, uint8_t* chunk);
 
   // Process all chunks without acquiring lock (caller must hold m_dump_mutex)
-  void
+  // Returns true if any chunk had new data
+  bool
   process_chunks_no_lock();
 
   // Process all chunks with lock acquisition
@@ -636,6 +636,42 @@ get_noop_completion_delay_us()
   return delay;
 }
 
+/**
+ * Distribution of simulated command execution time in the noop shim
+ * with Runtime.noop_completion_delay_us as mean.  One of "constant",
+ * "uniform", or "exponential".
+ */
+inline std::string
+get_noop_completion_distribution()
+{
+  static std::string value = detail::get_string_value("Runtime.noop_completion_distribution", "constant");
+  return value;
+}
+
+/**
+ * Give hw contexts of the noop shim a simulated shim hw queue that
+ * executes chained commands, as for devices with hw queues.  Default
+ * is the legacy exec_buf path.
+ */
+inline bool
+get_noop_hw_queue()
+{
+  static bool value = detail::get_bool_value("Runtime.noop_hw_queue", false);
+  return value;
+}
+
+/**
+ * Simulated bandwidth in MB/s of buffer syncs in the noop shim.  A
+ * sync sleeps for the time it would take to transfer the synced
+ * bytes.  Value of 0 completes syncs immediately.
+ */
+inline unsigned int
+get_noop_sync_bandwidth_mbps()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_sync_bandwidth_mbps", 0);
+  return value;
+}
+
 /**
  * Set CMD BO cache size. CUrrently it is only used in xclCopyBO()
  */
@@ -646,6 +682,156 @@ get_cmdbo_cache()
   return value;
 }
 
+/**
+ * Max number of cached exec BOs per device used by xrt::run and
+ * xrt::runlist.  Value of 0 disables caching.
+ */
+inline unsigned int
+get_exec_bo_cache()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_bo_cache", 128);
+  return value;
+}
+
+/**
+ * Number of exec BOs to allocate up front when a device is first
+ * used for kernel execution.  Avoids driver allocations for the first
+ * commands at the expense of device construction time.
+ */
+inline unsigned int
+get_exec_bo_prefill()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_bo_prefill", 0);
+  return value;
+}
+
+/**
+ * Map xclbin files into memory rather than reading them.  Mapped
+ * xclbin sections are paged in on first access and are not copied.
+ * Files that cannot be mapped are read.  A mapped xclbin file must
+ * not be truncated or rewritten in place while the xclbin is loaded,
+ * the process is otherwise terminated with SIGBUS when the changed
+ * pages are accessed.  Disable if xclbin files are modified in place.
+ */
+inline bool
+get_xclbin_mmap()
+{
+  static bool value = detail::get_bool_value("Runtime.xclbin_mmap", true);
+  return value;
+}
+
+/**
+ * Chunk size in KB for pipelined buffer copy through host memory,
+ * used when a buffer copy cannot be done by the device.  Syncing
+ * from the source, host copy, and syncing to the destination
+ * overlap for consecutive chunks.  Value of 0 disables pipelining.
+ */
+inline unsigned int
+get_copy_through_host_chunk_kb()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.copy_through_host_chunk_kb", 4096);
+  return value;
+}
+
+/**
+ * Max number of threads copying a chunk of a buffer copy through
+ * host memory.  Each thread copies at least 1MB.
+ */
+inline unsigned int
+get_copy_through_host_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.copy_through_host_threads", 2);
+  return value;
+}
+
+/**
+ * Share buffers with immutable content, e.g. PDIs, across runs of
+ * the same ELF within a hardware context.  Disable to give each run
+ * private copies, which can help when debugging control code.
+ */
+inline bool
+get_share_module_bos()
+{
+  static bool value = detail::get_bool_value("Runtime.share_module_bos", true);
+  return value;
+}
+
+/**
+ * Time window in microseconds within which independent command
+ * submissions to a shim hw queue are chained into one command.
+ * Value of 0 disables coalescing.  Legacy (kds) queues don't execute
+ * chained commands and ignore the setting.
+ */
+inline unsigned int
+get_submit_coalesce_window_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.submit_coalesce_window_us", 0);
+  return value;
+}
+
+/**
+ * Max number of commands chained by submission coalescing.  A chain
+ * is submitted when it reaches this size even if the window has not
+ * expired.
+ */
+inline unsigned int
+get_submit_coalesce_max()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.submit_coalesce_max", 16);
+  return value;
+}
+
+/**
+ * Record latency histograms of kernel commands per kernel and
+ * compute unit, see core/common/api/command_stats.h.  On by default
+ * so that statistics are available without configuration, set to
+ * false to remove the time stamp counter reads from command
+ * submission and completion.
+ */
+inline bool
+get_command_stats()
+{
+  static bool value = detail::get_bool_value("Runtime.command_stats", true);
+  return value;
+}
+
+/**
+ * File to which command statistics of all devices are written as
+ * json when the application exits.  Empty disables the dump.
+ */
+inline std::string
+get_command_stats_file()
+{
+  static std::string value = detail::get_string_value("Runtime.command_stats_file", "");
+  return value;
+}
+
+/**
+ * How threads wait for command completion on a hw queue.  "block"
+ * waits in the driver for completion, "spin" polls command state
+ * until completion, and "hybrid" polls command state for
+ * Runtime.hw_queue_spin_us before waiting in the driver.  Spinning
+ * lowers completion latency at the expense of a busy CPU core per
+ * waiting thread.
+ */
+inline std::string
+get_hw_queue_wait_strategy()
+{
+  static std::string value = detail::get_string_value("Runtime.hw_queue_wait_strategy", "block");
+  return value;
+}
+
+/**
+ * Time in microseconds to poll command state before blocking when
+ * the hw queue wait strategy is "hybrid".
+ */
+inline unsigned int
+get_hw_queue_spin_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.hw_queue_spin_us", 50);
+  return value;
+}
+
 /**
  * Enable QDMA AIO (Asynchronous I/O) support.
  * Default is false.
@@ -1165,6 +1351,19 @@ get_uc_log_bin_format()
   return value;
 }
 
+/**
+ * Dump uc logs with low overhead for many microcontrollers: one sync
+ * request for the log metadata and one for the new logs of all
+ * microcontrollers per wakeup, files appended through a memory
+ * mapping, and polling that backs off while no new logs arrive.
+ */
+inline bool
+get_uc_log_low_overhead()
+{
+  static bool value = detail::get_bool_value("Debug.uc_log_low_overhead", false);
+  return value;
+}
+
 }} // config,xrt_core
 
 #endif
@@ -414,9 +414,11 @@ get_cuidx(slot_id slot, const std::string& cuname)
   }
 }
 
-std::pair<size_t, size_t>
-device::
-get_ert_slots(const char* xml_data, size_t xml_size) const
+// Compute ERT CQ slots for an xclbin.  The number of CUs and the max
+// CU size are queried only if the slot size is not set in xrt.ini.
+template <typename NumCUs, typename MaxCUSize>
+static std::pair<size_t, size_t>
+get_ert_slots(NumCUs get_num_cus, MaxCUSize get_max_cu_size)
 {
   const size_t max_slots = 128;  // TODO: get from device driver
   const size_t min_slots = 16;   // TODO: get from device driver
@@ -434,13 +436,13 @@ get_ert_slots(const char* xml_data, size_t xml_size) const
   //  - minimum 2 concurrently scheduled CUs, plus 1 reserved slot
   //  - minimum min_slots
   //  - maximum max_slots
-  auto num_cus = xrt_core::xclbin::get_cus(xml_data, xml_size).size();
+  auto num_cus = get_num_cus();
   auto slots = std::min(max_slots, std::max(min_slots, (num_cus * 2) + 1));
 
   // Required slot size bounded by max of
   //  - number of slots needed
   //  - max cu_size per xclbin
-  auto size = std::max(cq_size / slots, xrt_core::xclbin::get_max_cu_size(xml_data, xml_size));
+  auto size = std::max(cq_size / slots, get_max_cu_size());
   slots = cq_size / size;
 
   // Round desired slots to minimum 32, 64, 96, 128 (status register boundary)
@@ -452,14 +454,27 @@ get_ert_slots(const char* xml_data, size_t xml_size) const
   return std::make_pair(slots, cq_size/slots);
 }
 
+std::pair<size_t, size_t>
+device::
+get_ert_slots(const char* xml_data, size_t xml_size) const
+{
+  return xrt_core::get_ert_slots
+    ([xml_data, xml_size] { return xclbin::get_cus(xml_data, xml_size).size(); },
+     [xml_data, xml_size] { return xclbin::get_max_cu_size(xml_data, xml_size); });
+}
+
+// Use the xml index of the loaded xclbin
 std::pair<size_t, size_t>
 device::
 get_ert_slots(const uuid& xclbin_id) const
 {
-  auto xml =  get_axlf_section(EMBEDDED_METADATA, xclbin_id);
-  if (!xml.first)
+  auto xclbin = get_xclbin(xclbin_id);
+  auto index = xclbin ? xclbin_int::get_xml_index(xclbin) : nullptr;
+  if (!index)
     throw error(EINVAL, "No xml metadata in xclbin");
-  return get_ert_slots(xml.first, xml.second);
+  return xrt_core::get_ert_slots
+    ([&index] { return xclbin::get_cus(*index).size(); },
+     [&index] { return xclbin::get_max_cu_size(*index); });
 }
 
 } // xrt_core
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as core_common
+#include "fill.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+# include <emmintrin.h>
+# define XRT_FILL_SSE2
+#endif
+
+namespace {
+
+constexpr size_t cache_line = 64;
+
+// Largest expanded pattern, patterns with a longer least common
+// multiple with the cache line are copied pattern by pattern
+constexpr size_t max_line = 4096;
+
+// Fills of at least this size bypass the cache
+constexpr size_t stream_threshold = 1 << 20;
+
+// Fills are split across threads in pieces of at least this size.
+// Few threads saturate memory bandwidth.
+constexpr size_t thread_min_chunk = 16 << 20;
+constexpr unsigned int max_threads = 8;
+
+// Write one cache line at 'dst' aligned to cache line
+inline void
+store_line(char* dst, const char* src, bool stream)
+{
+#ifdef XRT_FILL_SSE2
+  auto s = reinterpret_cast<const __m128i*>(src);
+  auto d = reinterpret_cast<__m128i*>(dst);
+  if (stream) {
+    _mm_stream_si128(d, _mm_load_si128(s));
+    _mm_stream_si128(d + 1, _mm_load_si128(s + 1));
+    _mm_stream_si128(d + 2, _mm_load_si128(s + 2));
+    _mm_stream_si128(d + 3, _mm_load_si128(s + 3));
+    return;
+  }
+  _mm_store_si128(d, _mm_load_si128(s));
+  _mm_store_si128(d + 1, _mm_load_si128(s + 1));
+  _mm_store_si128(d + 2, _mm_load_si128(s + 2));
+  _mm_store_si128(d + 3, _mm_load_si128(s + 3));
+#else
+  (void)stream;
+  std::memcpy(dst, src, cache_line);
+#endif
+}
+
+inline void
+store_fence()
+{
+#ifdef XRT_FILL_SSE2
+  _mm_sfence();
+#endif
+}
+
+// Fill pattern by pattern, used for patterns that do not expand
+// to a cache line multiple of reasonable size
+void
+fill_copy(char* dst, size_t size, const char* pattern, size_t pattern_size, size_t phase)
+{
+  auto head = std::min(size, pattern_size - phase);
+  std::memcpy(dst, pattern + phase, head);
+  dst += head;
+  size -= head;
+  for (; size >= pattern_size; size -= pattern_size, dst += pattern_size)
+    std::memcpy(dst, pattern, pattern_size);
+  if (size)
+    std::memcpy(dst, pattern, size);
+}
+
+// Fill 'size' bytes at 'dst' where the first byte at 'dst' is byte
+// 'phase' of the pattern
+void
+fill_range(char* dst, size_t size, const char* pattern, size_t pattern_size, size_t phase)
+{
+  auto line_size = std::lcm(pattern_size, cache_line);
+  if (line_size > max_line) {
+    fill_copy(dst, size, pattern, pattern_size, phase);
+    return;
+  }
+
+  // unaligned head
+  auto misalign = static_cast<size_t>(reinterpret_cast<uintptr_t>(dst) % cache_line);
+  auto head = std::min(size, misalign ? cache_line - misalign : 0);
+  for (size_t i = 0; i < head; ++i)
+    dst[i] = pattern[(phase + i) % pattern_size];
+  dst += head;
+  size -= head;
+  phase = (phase + head) % pattern_size;
+  if (!size)
+    return;
+
+  // pattern expanded to cache lines starting at 'phase'
+  alignas(cache_line) char line[max_line];
+  for (size_t i = 0; i < line_size; ++i)
+    line[i] = pattern[(phase + i) % pattern_size];
+
+  bool stream = size >= stream_threshold;
+  size_t idx = 0;
+  for (; size >= cache_line; size -= cache_line, dst += cache_line) {
+    store_line(dst, line + idx, stream);
+    idx = (idx + cache_line == line_size) ? 0 : idx + cache_line;
+  }
+  if (stream)
+    store_fence();
+
+  // tail is less than a cache line and line_size is a multiple
+  if (size)
+    std::memcpy(dst, line + idx, size);
+}
+
+} // namespace
+
+namespace xrt_core {
+
+void
+fill(void* dst, size_t size, const void* pattern, size_t pattern_size)
+{
+  if (!size || !pattern_size)
+    return;
+
+  auto d = static_cast<char*>(dst);
+  auto p = static_cast<const char*>(pattern);
+
+  if (pattern_size == 1 && size < stream_threshold) {
+    std::memset(d, *p, size);
+    return;
+  }
+
+  auto threads = static_cast<unsigned int>(std::min<size_t>(size / thread_min_chunk, max_threads));
+  threads = std::min(threads, std::max(1u, std::thread::hardware_concurrency()));
+  if (threads <= 1) {
+    fill_range(d, size, p, pattern_size, 0);
+    return;
+  }
+
+  // Page aligned pieces, the calling thread fills the last piece
+  constexpr size_t page = 4096;
+  auto chunk = (size / threads + page - 1) / page * page;
+  std::vector<std::thread> workers;
+  size_t offset = 0;
+  try {
+    for (; offset + chunk < size; offset += chunk)
+      workers.emplace_back(fill_range, d + offset, chunk, p, pattern_size, offset % pattern_size);
+  }
+  catch (const std::system_error&) {
+    // out of threads, fill the remaining pieces on this thread
+  }
+  fill_range(d + offset, size - offset, p, pattern_size, offset % pattern_size);
+
+  for (auto& t : workers)
+    t.join();
+}
+
+} // xrt_core
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrt_core_common_fill_h_
+#define xrt_core_common_fill_h_
+
+#include "config.h"
+#include <cstddef>
+
+namespace xrt_core {
+
+/**
+ * fill() - Fill host memory with a repeated pattern
+ *
+ * @dst:          Start of memory to fill
+ * @size:         Number of bytes to fill
+ * @pattern:      Pattern to repeat, the first byte of pattern is at @dst
+ * @pattern_size: Number of bytes in pattern
+ *
+ * The last pattern is truncated if @size is not a multiple of
+ * @pattern_size.
+ *
+ * The pattern is expanded to a cache line, which is written with
+ * vector stores.  Large fills use non-temporal stores so that the
+ * written memory does not evict the cache, and are split across
+ * multiple threads.  Intended for host buffers that are synced to
+ * device after the fill.
+ */
+XRT_CORE_COMMON_EXPORT
+void
+fill(void* dst, size_t size, const void* pattern, size_t pattern_size);
+
+} // xrt_core
+
+#endif
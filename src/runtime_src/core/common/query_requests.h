@@ -349,7 +349,9 @@ enum class key_type
 
   aie_read,
   aie_write,
-  aie_coredump
+  aie_coredump,
+
+  sysfs_cache_ttl
 };
 
 struct pcie_vendor : request
@@ -4287,6 +4289,24 @@ struct aie_coredump : request
   std::any
   get(const device*, const std::any&) const override = 0;
 };
+
+// Time to live in ms of cached sysfs reads of the device.  0 disables
+// caching, which is the default.  Tools enable caching while producing
+// a report, see pcie/linux/sysfs_cache.h.  The setting applies to all
+// users of the device in the process.
+struct sysfs_cache_ttl : request
+{
+  using result_type = uint32_t;  // get value type
+  using value_type = uint32_t;   // put value type
+
+  static const key_type key = key_type::sysfs_cache_ttl;
+
+  std::any
+  get(const device*) const override = 0;
+
+  void
+  put(const device*, const std::any&) const override = 0;
+};
 } // query
 
 } // xrt_core
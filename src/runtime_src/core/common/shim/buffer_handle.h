@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2023-2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2023-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_CORE_BUFFER_HANDLE_H
 #define XRT_CORE_BUFFER_HANDLE_H
 
@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace xrt_core {
 class hwctx_handle; // forward declaration
@@ -45,6 +46,13 @@ public:
     uint64_t kmhdl;  // kernel mode handle
   };
 
+  // range - byte range of a buffer
+  struct range
+  {
+    size_t size;
+    size_t offset;
+  };
+
 public:
   virtual ~buffer_handle()
   {}
@@ -129,6 +137,17 @@ public:
   {
     throw xrt_core::error(std::errc::not_supported, __func__);
   }
+
+  // Sync several ranges of a buffer to or from device with one
+  // request.  Shims that can sync a scatter list with one transfer
+  // override, the default syncs each range on its own.  Appended
+  // last so that vtable offsets of the entries above are unchanged.
+  virtual void
+  sync_ranges(direction dir, const std::vector<range>& ranges)
+  {
+    for (const auto& r : ranges)
+      sync(dir, r.size, r.offset);
+  }
 };
 
 } // xrt_core
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for xrt_core::buffer_dumper
+//
+// Logs data into the chunks of a device buffer and flushes the dumper
+// after each round.  The chunks with new data are scattered over the
+// buffer, so a flush syncs scattered ranges.  Verifies after every
+// flush that the dump file of each chunk holds exactly the latest
+// metadata followed by the dumped data, for every combination of
+// batched sync and memory mapped output.  Logged data that crosses
+// the end of a chunk is treated as overwritten by the dumper, which
+// skips to the logged count.  Reports time per flush.
+//
+// Without hardware the benchmark runs on the noop shim.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % XCL_EMULATION_MODE=noop <path>/buffer_dumper_bench [-c <chunks>] [-n <rounds>]
+
+#include "core/common/buffer_dumper.h"
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using clk = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t chunk_size = 4096;
+constexpr size_t metadata_size = sizeof(xrt_core::buffer_dumper::log_entry);
+constexpr size_t data_size = chunk_size - metadata_size;
+constexpr size_t count_size = 8;
+
+void
+usage()
+{
+  std::cout << "usage: buffer_dumper_bench [-c <chunks>] [-n <rounds>]\n";
+}
+
+// Byte at position pos of the data logged to a chunk
+uint8_t
+logged_byte(size_t chunk, size_t pos)
+{
+  return static_cast<uint8_t>((chunk * 31) + (pos * 7) + (pos >> 8));
+}
+
+// Simulate the device logging length bytes to a chunk
+void
+log_data(uint8_t* chunk_ptr, size_t chunk, size_t& count, size_t length)
+{
+  for (size_t i = 0; i < length; ++i, ++count)
+    chunk_ptr[metadata_size + (count % data_size)] = logged_byte(chunk, count);
+  std::memcpy(chunk_ptr, &count, count_size);
+}
+
+std::vector<uint8_t>
+read_file(const std::filesystem::path& path)
+{
+  std::ifstream ifs(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+// Dump file of chunk, empty path if the chunk has not been dumped
+std::filesystem::path
+dump_file(const std::filesystem::path& dir, size_t chunk)
+{
+  auto suffix = "_" + std::to_string(chunk) + ".bin";
+  for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+    auto name = entry.path().filename().string();
+    if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+      return entry.path();
+  }
+  return {};
+}
+
+// Data the dumper is expected to dump of a chunk
+struct expected_dump
+{
+  size_t dumped = 0;                                // logged count when last processed
+  std::vector<uint8_t> metadata{std::vector<uint8_t>(metadata_size, 0)};
+  std::vector<uint8_t> data;
+
+  // Data logged since last dump is dumped along with the metadata
+  // unless the logged count crossed the end of the chunk since then
+  void
+  flush(size_t chunk, const uint8_t* chunk_ptr, size_t count)
+  {
+    if (count != dumped && count / data_size == dumped / data_size) {
+      std::memcpy(metadata.data(), chunk_ptr, metadata_size);
+      for (size_t pos = dumped; pos < count; ++pos)
+        data.push_back(logged_byte(chunk, pos));
+    }
+    dumped = count;
+  }
+};
+
+void
+check_file(const std::filesystem::path& dir, size_t chunk, const expected_dump& expected)
+{
+  auto path = dump_file(dir, chunk);
+  if (path.empty()) {
+    if (!expected.data.empty())
+      throw std::runtime_error("no dump file for chunk " + std::to_string(chunk));
+    return;
+  }
+
+  auto data = read_file(path);
+  if (data.size() != metadata_size + expected.data.size())
+    throw std::runtime_error("dump file of chunk " + std::to_string(chunk) + " has "
+                             + std::to_string(data.size()) + " bytes, expected "
+                             + std::to_string(metadata_size + expected.data.size()));
+
+  if (std::memcmp(data.data(), expected.metadata.data(), metadata_size))
+    throw std::runtime_error("metadata mismatch in dump file of chunk " + std::to_string(chunk));
+
+  for (size_t pos = 0; pos < expected.data.size(); ++pos)
+    if (data[metadata_size + pos] != expected.data[pos])
+      throw std::runtime_error("data mismatch at " + std::to_string(pos)
+                               + " in dump file of chunk " + std::to_string(chunk));
+}
+
+// Log and flush rounds of data to every third chunk, each round
+// logging a different amount such that logged counts cross the end
+// of the chunks.  Returns average time of a flush.
+std::chrono::nanoseconds
+run(const xrt::device& device, size_t num_chunks, size_t rounds, bool batch_sync, bool mapped_output)
+{
+  auto dir = std::filesystem::temp_directory_path() / ("buffer_dumper_bench_" + std::to_string(clk::now().time_since_epoch().count()));
+  std::filesystem::create_directories(dir);
+
+  xrt::bo bo{device, num_chunks * chunk_size, xrt::bo::flags::normal, 0};
+  auto base = bo.map<uint8_t*>();
+  std::memset(base, 0, num_chunks * chunk_size);
+
+  std::vector<size_t> counts(num_chunks, 0);
+  std::vector<expected_dump> expected(num_chunks);
+  std::chrono::nanoseconds elapsed{0};
+  {
+    xrt_core::buffer_dumper::config cfg;
+    cfg.chunk_size = chunk_size;
+    cfg.metadata_size = metadata_size;
+    cfg.count_offset = 0;
+    cfg.count_size = count_size;
+    cfg.num_chunks = num_chunks;
+    cfg.dump_interval_ms = 3600000; // dump on flush only
+    cfg.dump_file_prefix = (dir / "dump").string();
+    cfg.dump_buffer = bo;
+    cfg.dump_bin_format = true;
+    cfg.batch_sync = batch_sync;
+    cfg.mapped_output = mapped_output;
+    xrt_core::buffer_dumper dumper{cfg};
+
+    for (size_t round = 0; round < rounds; ++round) {
+      for (size_t chunk = round % 3; chunk < num_chunks; chunk += 3)
+        log_data(base + (chunk * chunk_size), chunk, counts[chunk], ((round * 1237) + (chunk * 97)) % data_size);
+
+      auto start = clk::now();
+      dumper.flush();
+      elapsed += clk::now() - start;
+
+      // Files must be valid while the dumper is running
+      for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        expected[chunk].flush(chunk, base + (chunk * chunk_size), counts[chunk]);
+        check_file(dir, chunk, expected[chunk]);
+      }
+    }
+  }
+
+  // Destruction flushes nothing new and must leave files unchanged
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    check_file(dir, chunk, expected[chunk]);
+
+  std::filesystem::remove_all(dir);
+  return elapsed / rounds;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  size_t num_chunks = 16;
+  size_t rounds = 20;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-c" && i + 1 < args.size())
+      num_chunks = std::stoul(args[++i]);
+    else if (args[i] == "-n" && i + 1 < args.size())
+      rounds = std::stoul(args[++i]);
+    else {
+      usage();
+      return args[i] == "-h" ? 0 : 1;
+    }
+  }
+
+  try {
+    xrt::device device{0};
+    for (bool batch_sync : {false, true}) {
+      for (bool mapped_output : {false, true}) {
+        auto per_flush = run(device, num_chunks, rounds, batch_sync, mapped_output);
+        std::cout << "batch_sync(" << batch_sync << ") mapped_output(" << mapped_output << "): ok, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(per_flush).count()
+                  << " us/flush\n";
+      }
+    }
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "FAILED: " << ex.what() << '\n';
+    return 1;
+  }
+}
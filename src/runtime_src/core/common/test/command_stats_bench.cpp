@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for xrt_core::command_stats
+//
+// Verifies that bucket boundaries cover the 64-bit range without
+// gaps, that percentiles of random latency distributions are within
+// the histogram precision of exact percentiles, and that merging
+// tables into device statistics preserves counts, and that ticks of
+// command time stamps convert to nanoseconds of steady_clock.  Reports
+// the cost of recording one command (submit, complete) per thread
+// when threads record into the same entry or into separate entries,
+// and the cost of a time stamp with now_ticks() and steady_clock.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/command_stats_bench [-t <max threads>] [-n <commands per thread>]
+
+#include "core/common/api/command_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using clk = std::chrono::high_resolution_clock;
+using histogram = xrt_core::command_stats::histogram;
+
+static void
+usage()
+{
+  std::cout << "usage: command_stats_bench [-t <max threads>] [-n <commands per thread>]\n";
+}
+
+static void
+verify_buckets()
+{
+  // Consecutive buckets are adjacent and each value maps to the
+  // bucket whose range contains it
+  for (size_t idx = 1; idx < histogram::num_buckets; ++idx) {
+    auto low = histogram::bucket_upper(idx - 1) + 1;
+    if (histogram::bucket_index(low) != idx || histogram::bucket_index(histogram::bucket_upper(idx)) != idx)
+      throw std::runtime_error("bad bucket boundary at index " + std::to_string(idx));
+  }
+  if (histogram::bucket_upper(histogram::num_buckets - 1) != UINT64_MAX)
+    throw std::runtime_error("buckets do not cover 64-bit range");
+
+  std::cout << "verify buckets: ok\n";
+}
+
+static void
+verify_percentiles()
+{
+  std::mt19937_64 gen(1);
+  std::lognormal_distribution<double> dist(10.0, 1.5);  // ~20us median, long tail
+  for (size_t count : {1, 10, 1000, 100000}) {
+    histogram h;
+    std::vector<uint64_t> values(count);
+    for (auto& v : values) {
+      v = static_cast<uint64_t>(dist(gen));
+      h.record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    for (double pct : {50.0, 99.0, 99.9, 100.0}) {
+      auto rank = std::max<size_t>(1, static_cast<size_t>(std::ceil(pct / 100.0 * count)));
+      auto exact = values[rank - 1];
+      auto reported = h.get_percentile(pct);
+      auto bound = exact + exact / histogram::sub_buckets;
+      if (reported < exact || reported > bound)
+        throw std::runtime_error("p" + std::to_string(pct) + " of " + std::to_string(count)
+                                 + " values: reported " + std::to_string(reported)
+                                 + " exact " + std::to_string(exact));
+    }
+  }
+
+  std::cout << "verify percentiles: ok\n";
+}
+
+// Reported nanoseconds of a number of ticks, within 1% for the
+// calibration that may differ between reports
+static bool
+is_ns_of_ticks(uint64_t ns, uint64_t ticks)
+{
+  auto expected = static_cast<double>(ticks) * xrt_core::command_stats::ns_per_tick();
+  return std::abs(static_cast<double>(ns) - expected) <= expected / 100 + 1;
+}
+
+static void
+verify_ticks()
+{
+  xrt_core::command_stats::table tbl(1002);  // anchors calibration
+  auto ticks = xrt_core::command_stats::now_ticks();
+  auto ns = xrt_core::command_stats::now_ns();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ticks = xrt_core::command_stats::now_ticks() - ticks;
+  ns = xrt_core::command_stats::now_ns() - ns;
+
+  if (!is_ns_of_ticks(ns, ticks))
+    throw std::runtime_error("bad tick calibration, " + std::to_string(ticks) + " ticks in "
+                             + std::to_string(ns) + "ns, ns per tick "
+                             + std::to_string(xrt_core::command_stats::ns_per_tick()));
+
+  std::cout << "verify ticks: ok (" << xrt_core::command_stats::ns_per_tick() << " ns per tick)\n";
+}
+
+static void
+verify_merge()
+{
+  constexpr unsigned int device_id = 1000;  // not a real device
+  {
+    xrt_core::command_stats::table t1(device_id);
+    xrt_core::command_stats::table t2(device_id);
+    for (int i = 0; i < 10; ++i) {
+      auto e1 = t1.get_entry("k", 0);
+      auto e2 = t2.get_entry("k", xrt_core::command_stats::table::any_cu);
+      auto e3 = t2.get_entry("k", 0);
+      for (auto e : {e1, e2, e3}) {
+        e->submitted();
+        e->completed(100, 200, 300, false, false);
+      }
+    }
+
+    // Completion observed by a waiting application is only in the
+    // wait-observed total
+    auto w = t1.get_entry("w", 0);
+    w->submitted();
+    w->completed(100, 0, 300, false, true);
+    // t2 retires with its entries merged into device statistics
+  }
+
+  auto pt = xrt_core::command_stats::device_stats(device_id);
+  size_t entries = 0;
+  for (const auto& [key, entry] : pt) {
+    if (entry.get<std::string>("kernel") == "w") {
+      if (entry.get<int>("count") != 1 || entry.get<int>("total_ns.count") != 0
+          || entry.get<int>("exec_ns.count") != 0 || !is_ns_of_ticks(entry.get<uint64_t>("wait_total_ns.max"), 200))
+        throw std::runtime_error("bad wait-observed statistics");
+      continue;
+    }
+
+    auto expected = entry.get<std::string>("cu_index") == "any" ? 10 : 20;
+    if (entry.get<int>("count") != expected || entry.get<int>("inflight") != 0
+        || !is_ns_of_ticks(entry.get<uint64_t>("total_ns.p99"), 200) || entry.get<uint64_t>("depth.max") != 1)
+      throw std::runtime_error("bad merged statistics");
+    ++entries;
+  }
+  if (entries != 2)
+    throw std::runtime_error("expected 2 merged entries, got " + std::to_string(entries));
+
+  std::cout << "verify merge: ok\n";
+}
+
+// Cost of a time stamp in ns
+static double
+time_stamp(size_t count, uint64_t (*now)())
+{
+  uint64_t sum = 0;
+  auto start = clk::now();
+  for (size_t i = 0; i < count; ++i)
+    sum += now();
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now() - start).count();
+  if (!sum)
+    throw std::runtime_error("no time stamps");
+  return static_cast<double>(elapsed) / static_cast<double>(count);
+}
+
+// Record commands from threads, returns ns per command
+static double
+record(unsigned int threads, size_t commands, bool shared)
+{
+  xrt_core::command_stats::table tbl(1001);
+  std::vector<std::thread> workers;
+  auto start = clk::now();
+  for (unsigned int t = 0; t < threads; ++t) {
+    workers.emplace_back([&tbl, t, commands, shared] {
+      auto e = tbl.get_entry("k", shared ? 0 : static_cast<int>(t));
+      for (size_t i = 0; i < commands; ++i) {
+        auto submit = xrt_core::command_stats::now_ticks();
+        e->submitted();
+        e->completed(submit, 0, xrt_core::command_stats::now_ticks(), false, false);
+      }
+    });
+  }
+  for (auto& w : workers)
+    w.join();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now() - start).count();
+  return static_cast<double>(elapsed) / static_cast<double>(commands);
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  unsigned int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t commands = 1000000;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    else if (args[i] == "-t")
+      max_threads = std::stoul(args[++i]);
+    else if (args[i] == "-n")
+      commands = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!max_threads || !commands)
+    throw std::runtime_error("-t <max threads> and -n <commands per thread> must be greater than 0");
+
+  verify_buckets();
+  verify_percentiles();
+  verify_merge();
+  verify_ticks();
+
+  std::cout << "time stamp: " << std::fixed << std::setprecision(1)
+            << "now_ticks " << time_stamp(commands, xrt_core::command_stats::now_ticks) << "ns"
+            << " steady_clock " << time_stamp(commands, xrt_core::command_stats::now_ns) << "ns\n";
+  std::cout << "commands per thread: " << commands
+            << " (ns per command per thread, includes 2 time stamps)\n";
+  for (unsigned int threads = 1; threads <= max_threads; threads *= 2) {
+    auto shared = record(threads, commands, true);
+    auto separate = record(threads, commands, false);
+    std::cout << "threads: " << std::setw(3) << threads
+              << " shared entry: " << std::setw(8) << std::fixed << std::setprecision(1) << shared
+              << " entry per thread: " << std::setw(8) << separate << '\n';
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
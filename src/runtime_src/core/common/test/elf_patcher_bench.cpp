@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for control code patching
+//
+// Creates a synthetic control code buffer with many patch locations
+// across several symbols and patching schemes, then repeatedly
+// rebinds all symbols as done when run arguments change.  Verifies
+// that patching matches the reference patching and reports the
+// number of sync calls needed with per-location sync versus synced
+// dirty ranges.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/elf_patcher_bench -l 4096 -i 1000
+
+#include "core/common/api/elf_patcher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ep = xrt_core::elf_patcher;
+
+static void
+usage()
+{
+  std::cout << "usage: elf_patcher_bench [-l <locations per symbol>] [-i <iterations>]\n";
+}
+
+// Bytes between patch locations, large enough that the bd words
+// restored at one location do not overlap with another location
+constexpr size_t location_stride = 48;
+
+struct symbol
+{
+  ep::patcher_config config;
+  size_t sync_size;   // bytes synced per location by per-location sync
+};
+
+static std::vector<symbol>
+create_symbols(size_t locations)
+{
+  const std::vector<std::pair<ep::symbol_type, size_t>> schemes {
+    { ep::symbol_type::shim_dma_48, 3 * sizeof(uint32_t) },
+    { ep::symbol_type::control_packet_57, 4 * sizeof(uint32_t) },
+    { ep::symbol_type::address_64, sizeof(uint64_t) },
+    { ep::symbol_type::shim_dma_base_addr_symbol_kind, ep::max_bd_words * sizeof(uint32_t) }
+  };
+
+  // Locations of symbols are interleaved as in control code where
+  // consecutive BDs refer to different arguments
+  std::vector<symbol> symbols;
+  for (size_t sym = 0; sym < schemes.size(); ++sym) {
+    std::vector<ep::patch_config> configs;
+    for (size_t loc = 0; loc < locations; ++loc) {
+      auto offset = (loc * schemes.size() + sym) * location_stride;
+      configs.push_back({offset, static_cast<uint32_t>(loc * 64), 0});
+    }
+    symbols.push_back({{schemes[sym].first, std::move(configs), ep::buf_type::ctrltext}, schemes[sym].second});
+  }
+  return symbols;
+}
+
+void
+run(int argc, char* argv[])
+{
+  size_t locations = 4096;
+  size_t iterations = 1000;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-l")
+      locations = std::stoul(args[++i]);
+    else if (args[i] == "-i")
+      iterations = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  auto symbols = create_symbols(locations);
+  auto buffer_size = symbols.size() * locations * location_stride + location_stride;
+  std::vector<uint8_t> buffer(buffer_size);
+  for (size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = static_cast<uint8_t>(i * 31);
+  auto original = buffer;
+
+  std::vector<ep::symbol_patcher> patchers;
+  for (const auto& sym : symbols)
+    patchers.emplace_back(&sym.config);
+
+  uint64_t per_location_syncs = 0;
+  uint64_t per_location_bytes = 0;
+  uint64_t range_syncs = 0;
+  uint64_t range_bytes = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    ep::dirty_ranges ranges;
+    uint64_t value = 0x100000000ULL + iter * 0x1000;
+    for (auto& patcher : patchers)
+      patcher.patch_symbol(buffer.data(), value, &ranges);
+
+    for (const auto& sym : symbols) {
+      per_location_syncs += sym.config.m_patch_configs.size();
+      per_location_bytes += sym.config.m_patch_configs.size() * sym.sync_size;
+    }
+    for (const auto& [begin, end] : ranges.get()) {
+      ++range_syncs;
+      range_bytes += end - begin;
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  // Verify last iteration against reference patching of original buffer
+  uint64_t value = 0x100000000ULL + (iterations - 1) * 0x1000;
+  for (const auto& sym : symbols)
+    ep::symbol_patcher::patch_symbol_raw(original.data(), value, sym.config);
+  if (iterations && original != buffer)
+    throw std::runtime_error("patched buffer mismatch");
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto total_locations = symbols.size() * locations;
+  std::cout << "locations: " << total_locations
+            << " iterations: " << iterations
+            << " us/rebind: " << (iterations ? static_cast<double>(us) / iterations : 0.0) << '\n'
+            << "per-location sync calls/rebind: " << (iterations ? per_location_syncs / iterations : 0)
+            << " bytes/rebind: " << (iterations ? per_location_bytes / iterations : 0) << '\n'
+            << "dirty range sync calls/rebind: " << (iterations ? range_syncs / iterations : 0)
+            << " bytes/rebind: " << (iterations ? range_bytes / iterations : 0) << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
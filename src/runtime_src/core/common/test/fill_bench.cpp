@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for xrt_core::fill
+//
+// Verifies fills for pattern sizes, fill sizes, and destination
+// alignments that exercise the unaligned head and tail, the expanded
+// pattern, the pattern by pattern copy, and the multi-threaded
+// split.  Reports bandwidth of fill compared to the pattern by
+// pattern memcpy loop previously used by clEnqueueFillBuffer.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/fill_bench [-s <size in MB>] [-n <iterations>]
+
+#include "core/common/fill.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using clk = std::chrono::high_resolution_clock;
+
+static void
+usage()
+{
+  std::cout << "usage: fill_bench [-s <size in MB>] [-n <iterations>]\n";
+}
+
+// Pattern by pattern fill as done by earlier clEnqueueFillBuffer
+static void
+fill_loop(char* dst, size_t size, const void* pattern, size_t pattern_size)
+{
+  for (; pattern_size <= size; size -= pattern_size, dst += pattern_size)
+    std::memcpy(dst, pattern, pattern_size);
+  if (size)
+    std::memcpy(dst, pattern, size);
+}
+
+static void
+verify()
+{
+  constexpr char guard = 0x5a;
+  std::mt19937 gen(1);
+  for (size_t pattern_size : {1, 2, 3, 4, 7, 8, 16, 32, 64, 100, 128, 4097}) {
+    std::vector<char> pattern(pattern_size);
+    for (auto& c : pattern)
+      c = static_cast<char>(gen());
+    for (size_t size : {0, 1, 5, 63, 64, 65, 1000, (1 << 20) + 17, (40 << 20) + 3}) {
+      for (size_t offset : {0, 1, 13}) {
+        std::vector<char> buf(offset + size + 64, guard);
+        xrt_core::fill(buf.data() + offset, size, pattern.data(), pattern_size);
+        for (size_t i = 0; i < buf.size(); ++i) {
+          bool in_range = i >= offset && i < offset + size;
+          auto expected = in_range ? pattern[(i - offset) % pattern_size] : guard;
+          if (buf[i] != expected)
+            throw std::runtime_error("mismatch at byte " + std::to_string(i)
+                                     + " for pattern size " + std::to_string(pattern_size)
+                                     + " size " + std::to_string(size)
+                                     + " offset " + std::to_string(offset));
+        }
+      }
+    }
+  }
+  std::cout << "verify: ok\n";
+}
+
+template <typename Fill>
+static double
+bandwidth(Fill&& fill, char* dst, size_t size, unsigned int iterations)
+{
+  fill(dst, size);  // fault in pages
+  auto start = clk::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    fill(dst, size);
+  std::chrono::duration<double> elapsed = clk::now() - start;
+  return static_cast<double>(size) * iterations / elapsed.count() / (1 << 20);
+}
+
+void
+run(int argc, char* argv[])
+{
+  size_t size_mb = 1024;
+  unsigned int iterations = 5;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-s")
+      size_mb = std::stoul(args[++i]);
+    else if (args[i] == "-n")
+      iterations = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!size_mb || !iterations)
+    throw std::runtime_error("-s <size in MB> and -n <iterations> must be greater than 0");
+
+  verify();
+
+  size_t size = size_mb << 20;
+  std::vector<char> buf(size);
+  std::cout << "size(MB): " << size_mb << " iterations: " << iterations << '\n';
+  for (size_t pattern_size : {1, 4, 16, 128}) {
+    std::vector<char> pattern(pattern_size, 1);
+    auto engine = bandwidth([&](char* d, size_t sz) { xrt_core::fill(d, sz, pattern.data(), pattern_size); },
+                            buf.data(), size, iterations);
+    auto loop = bandwidth([&](char* d, size_t sz) { fill_loop(d, sz, pattern.data(), pattern_size); },
+                          buf.data(), size, iterations);
+    std::cout << "pattern size: " << std::setw(4) << pattern_size
+              << " fill(MB/s): " << std::setw(10) << std::fixed << std::setprecision(0) << engine
+              << " loop(MB/s): " << std::setw(10) << loop << '\n';
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for the emulation device memory allocator
+//
+// Replays a randomized trace of allocations and frees against the
+// emulation MemoryManager and against a first fit list allocator as
+// used by earlier versions of MemoryManager.  Verifies that live
+// buffers are aligned, within the memory, and do not overlap, and
+// that all memory coalesces into one block when all buffers are
+// freed.  Reports operations per second and fragmentation.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/memory_manager_bench [-n <operations>] [-l <live buffers>] [-s <seed>]
+
+#include "core/pcie/emulation/common_em/memorymanager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+constexpr uint64_t memory_start = 0x4000000000;
+constexpr uint64_t memory_size = 16ULL << 30;
+constexpr unsigned int alignment = 4096;
+
+static void
+usage()
+{
+  std::cout << "usage: memory_manager_bench [-n <operations>] [-l <live buffers>] [-s <seed>]\n";
+}
+
+// First fit allocator with free list and busy list as in earlier
+// versions of MemoryManager.  Used as baseline.
+class list_allocator
+{
+  using pair_list = std::list<std::pair<uint64_t, uint64_t>>;
+  pair_list m_free;
+  pair_list m_busy;
+
+public:
+  list_allocator()
+  {
+    m_free.emplace_back(memory_start, memory_size);
+  }
+
+  uint64_t
+  alloc(size_t& size)
+  {
+    size = (size + alignment - 1) / alignment * alignment;
+    for (auto i = m_free.begin(); i != m_free.end(); ++i) {
+      if (i->second < size)
+        continue;
+      auto result = i->first;
+      if (i->second > size) {
+        i->first += size;
+        i->second -= size;
+      }
+      else {
+        m_free.erase(i);
+      }
+      m_busy.emplace_back(result, size);
+      return result;
+    }
+    return xclemulation::MemoryManager::mNull;
+  }
+
+  void
+  free(uint64_t buf)
+  {
+    auto i = std::find_if(m_busy.begin(), m_busy.end(), [buf](const auto& b) { return b.first == buf; });
+    if (i == m_busy.end())
+      return;
+    m_free.push_back(*i);
+    m_busy.erase(i);
+    if (m_free.size() > 4) {
+      m_free.sort();
+      for (auto curr = m_free.begin(), next = std::next(curr); next != m_free.end(); next = std::next(curr)) {
+        if (curr->first + curr->second != next->first) {
+          curr = next;
+          continue;
+        }
+        curr->second += next->second;
+        m_free.erase(next);
+      }
+    }
+  }
+};
+
+struct operation
+{
+  bool alloc;
+  size_t size;    // size to allocate
+  size_t victim;  // index of live buffer to free
+};
+
+// Random trace that grows to 'live' buffers and then alternates
+// between allocations and frees of random buffers.  Sizes are log
+// uniform from 1 byte to 4MB, so most buffers are small.
+static std::vector<operation>
+create_trace(size_t count, size_t live, unsigned int seed)
+{
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> log_size(0.0, 22.0);
+  std::vector<operation> trace;
+  size_t num_live = 0;
+  for (size_t i = 0; i < count; ++i) {
+    bool alloc = num_live < live || (num_live < 2 * live && gen() % 2);
+    if (alloc) {
+      trace.push_back({true, static_cast<size_t>(std::exp2(log_size(gen))), 0});
+      ++num_live;
+    }
+    else {
+      trace.push_back({false, 0, static_cast<size_t>(gen() % num_live)});
+      --num_live;
+    }
+  }
+  return trace;
+}
+
+// Verify live buffers are aligned, in range, and do not overlap
+static void
+verify(const std::map<uint64_t, uint64_t>& live)
+{
+  uint64_t end = memory_start;
+  for (const auto& [addr, size] : live) {
+    if (addr % alignment)
+      throw std::runtime_error("misaligned buffer at " + std::to_string(addr));
+    if (addr < end)
+      throw std::runtime_error("overlapping buffer at " + std::to_string(addr));
+    end = addr + size;
+  }
+  if (end > memory_start + memory_size)
+    throw std::runtime_error("buffer beyond end of memory");
+}
+
+// Replay trace, return elapsed time.  Victims index the vector of
+// live buffers, so the same buffers are freed for all allocators.
+template <typename Allocator>
+static std::chrono::duration<double>
+replay(Allocator& allocator, const std::vector<operation>& trace)
+{
+  std::vector<uint64_t> buffers;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (const auto& op : trace) {
+    if (op.alloc) {
+      size_t size = op.size;
+      auto addr = allocator.alloc(size);
+      if (addr == xclemulation::MemoryManager::mNull)
+        throw std::runtime_error("out of memory");
+      buffers.push_back(addr);
+      continue;
+    }
+    auto addr = buffers[op.victim];
+    buffers[op.victim] = buffers.back();
+    buffers.pop_back();
+    allocator.free(addr);
+  }
+  auto elapsed = std::chrono::high_resolution_clock::now() - start;
+
+  for (auto addr : buffers)
+    allocator.free(addr);
+
+  return elapsed;
+}
+
+// Replay trace and verify live buffers after each of the first
+// operations and at the end of the trace
+static void
+verify_trace(const std::vector<operation>& trace)
+{
+  constexpr size_t verify_every_op = 2000;
+  xclemulation::MemoryManager mm(memory_size, memory_start, alignment);
+  std::map<uint64_t, uint64_t> live;
+  std::vector<uint64_t> buffers;
+  for (size_t i = 0; i < trace.size(); ++i) {
+    const auto& op = trace[i];
+    if (op.alloc) {
+      size_t size = op.size;
+      auto addr = mm.alloc(size);
+      if (addr == xclemulation::MemoryManager::mNull)
+        throw std::runtime_error("out of memory");
+      buffers.push_back(addr);
+      live[addr] = size;
+    }
+    else {
+      auto addr = buffers[op.victim];
+      buffers[op.victim] = buffers.back();
+      buffers.pop_back();
+      mm.free(addr);
+      live.erase(addr);
+    }
+    if (i < verify_every_op)
+      verify(live);
+  }
+  verify(live);
+
+  uint64_t busy = 0;
+  for (const auto& [addr, size] : live)
+    busy += size;
+  auto stats = mm.stats();
+  if (stats.freeSize + busy != memory_size || mm.freeSize() != stats.freeSize)
+    throw std::runtime_error("free size mismatch");
+
+  std::cout << "live buffers: " << stats.busyBlocks
+            << " free blocks: " << stats.freeBlocks
+            << " free(MB): " << (stats.freeSize >> 20)
+            << " largest free(MB): " << (stats.largestFree >> 20)
+            << " fragmentation: " << std::fixed << std::setprecision(4) << stats.fragmentation() << '\n';
+
+  for (auto addr : buffers)
+    mm.free(addr);
+  stats = mm.stats();
+  if (stats.freeBlocks != 1 || stats.largestFree != memory_size)
+    throw std::runtime_error("memory not coalesced after freeing all buffers");
+}
+
+void
+run(int argc, char* argv[])
+{
+  size_t operations = 100000;
+  size_t live_buffers = 10000;
+  unsigned int seed = 1;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-n")
+      operations = std::stoul(args[++i]);
+    else if (args[i] == "-l")
+      live_buffers = std::stoul(args[++i]);
+    else if (args[i] == "-s")
+      seed = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!live_buffers)
+    throw std::runtime_error("-l <live buffers> must be greater than 0");
+
+  auto trace = create_trace(operations, live_buffers, seed);
+
+  std::cout << "operations: " << trace.size() << " live buffers: " << live_buffers << " seed: " << seed << '\n';
+  verify_trace(trace);
+
+  xclemulation::MemoryManager mm(memory_size, memory_start, alignment);
+  auto mm_time = replay(mm, trace);
+  std::cout << "MemoryManager   ops/s: " << std::setw(12) << std::setprecision(0)
+            << static_cast<double>(trace.size()) / mm_time.count() << '\n';
+
+  list_allocator la;
+  auto la_time = replay(la, trace);
+  std::cout << "first fit list  ops/s: " << std::setw(12)
+            << static_cast<double>(trace.size()) / la_time.count() << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
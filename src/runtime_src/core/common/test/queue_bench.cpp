@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Benchmark for xrt::queue task dispatch
+//
+// Compares queues with a dedicated thread per queue against queues
+// sharing an xrt::queue::executor.  For 1, 64, and 1024 queues the
+// benchmark reports queue construction time, round trip dispatch
+// latency of a single task, and throughput of many enqueued tasks.
+// Per-queue FIFO order is verified for all tasks.  Verifies that
+// short lived queues can be destroyed by their own tasks while the
+// executor is in use, and reports the time per queue for doing so.
+// Verifies that the last reference to an executor can be released
+// by a task executing on one of its queues.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/queue_bench [-n <tasks per queue>] [-l <latency samples>] [-t <executor threads>]
+
+#include "xrt/experimental/xrt_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using clk = std::chrono::high_resolution_clock;
+
+static void
+usage()
+{
+  std::cout << "usage: queue_bench [-n <tasks per queue>] [-l <latency samples>] [-t <executor threads>]\n";
+}
+
+static double
+to_us(clk::duration d)
+{
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+struct result
+{
+  double create_us;     // time to construct all queues
+  double latency_us;    // mean enqueue to completion round trip
+  double latency_p99_us;
+  double tasks_per_sec;
+};
+
+static std::vector<std::unique_ptr<xrt::queue>>
+create_queues(size_t count, const xrt::queue::executor* ex)
+{
+  std::vector<std::unique_ptr<xrt::queue>> queues;
+  for (size_t i = 0; i < count; ++i)
+    queues.push_back(ex ? std::make_unique<xrt::queue>(*ex) : std::make_unique<xrt::queue>());
+  return queues;
+}
+
+static result
+run_test(size_t num_queues, size_t tasks, size_t samples, const xrt::queue::executor* ex)
+{
+  result r {};
+
+  auto start = clk::now();
+  auto queues = create_queues(num_queues, ex);
+  r.create_us = to_us(clk::now() - start);
+
+  // Latency: one outstanding task at a time, round robin over queues
+  std::vector<double> latencies;
+  for (size_t i = 0; i < samples; ++i) {
+    auto t0 = clk::now();
+    queues[i % num_queues]->enqueue([] {}).wait();
+    latencies.push_back(to_us(clk::now() - t0));
+  }
+  std::sort(latencies.begin(), latencies.end());
+  for (auto l : latencies)
+    r.latency_us += l;
+  r.latency_us /= static_cast<double>(samples);
+  r.latency_p99_us = latencies[std::min(samples - 1, samples * 99 / 100)];
+
+  // Throughput: many outstanding tasks on all queues.  Each task
+  // checks it executes in order of enqueuing for its queue.
+  std::vector<size_t> next(num_queues, 0);
+  std::atomic<size_t> out_of_order {0};
+  std::vector<xrt::queue::event> last(num_queues);
+  start = clk::now();
+  for (size_t t = 0; t < tasks; ++t) {
+    for (size_t q = 0; q < num_queues; ++q) {
+      last[q] = queues[q]->enqueue([&next, &out_of_order, q, t] {
+        if (next[q]++ != t)
+          ++out_of_order;
+      });
+    }
+  }
+  for (auto& ev : last)
+    ev.wait();
+  auto elapsed = clk::now() - start;
+  r.tasks_per_sec = static_cast<double>(tasks * num_queues) / std::chrono::duration<double>(elapsed).count();
+
+  if (out_of_order)
+    throw std::runtime_error(std::to_string(out_of_order) + " tasks executed out of order");
+
+  return r;
+}
+
+// Create queues that are destroyed by their own last task while the
+// executor stays alive.  Returns mean time per queue from creation
+// until destruction by its task.
+static double
+verify_release_own_task(const xrt::queue::executor& ex, size_t num_queues)
+{
+  std::vector<std::promise<void>> released(num_queues);
+  std::vector<std::future<void>> done;
+  for (auto& p : released)
+    done.push_back(p.get_future());
+
+  auto start = clk::now();
+  for (size_t i = 0; i < num_queues; ++i) {
+    auto queue = std::make_shared<std::unique_ptr<xrt::queue>>(std::make_unique<xrt::queue>(ex));
+    (*queue)->enqueue([] {});
+    (*queue)->enqueue([queue, &released, i] {
+      queue->reset();
+      released[i].set_value();
+    });
+  }
+
+  for (auto& f : done)
+    if (f.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+      throw std::runtime_error("queue destroyed by own task did not complete");
+
+  return to_us(clk::now() - start) / static_cast<double>(num_queues);
+}
+
+// Release a queue, and then the last reference to the executor,
+// from a task executing on the queue.  Must complete without
+// deadlock and without destroying the executor on its own thread.
+static void
+verify_release(unsigned int threads)
+{
+  struct owner
+  {
+    std::unique_ptr<xrt::queue::executor> ex;
+    std::unique_ptr<xrt::queue> queue;
+  };
+
+  auto refs = std::make_shared<owner>();
+  refs->ex = std::make_unique<xrt::queue::executor>(threads);
+  refs->queue = std::make_unique<xrt::queue>(*refs->ex);
+  std::promise<void> released;
+  auto done = released.get_future();
+
+  // The task holds the only references to the queue and executor
+  refs->queue->enqueue([refs, &released] {
+    refs->ex.reset();
+    refs->queue.reset();
+    released.set_value();
+  });
+
+  if (done.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+    throw std::runtime_error("queue release from own task did not complete");
+}
+
+static void
+report(const std::string& mode, size_t num_queues, const result& r)
+{
+  std::cout << std::setw(9) << mode
+            << " queues: " << std::setw(5) << num_queues
+            << " create(us): " << std::setw(10) << std::fixed << std::setprecision(1) << r.create_us
+            << " latency(us): " << std::setw(7) << std::setprecision(2) << r.latency_us
+            << " p99(us): " << std::setw(7) << r.latency_p99_us
+            << " tasks/s: " << std::setw(11) << std::setprecision(0) << r.tasks_per_sec
+            << '\n';
+}
+
+void
+run(int argc, char* argv[])
+{
+  size_t tasks = 1000;
+  size_t samples = 10000;
+  unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-n")
+      tasks = std::stoul(args[++i]);
+    else if (args[i] == "-l")
+      samples = std::stoul(args[++i]);
+    else if (args[i] == "-t")
+      threads = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!samples)
+    throw std::runtime_error("-l <latency samples> must be greater than 0");
+
+  verify_release(threads);
+
+  xrt::queue::executor ex{threads};
+  std::cout << "tasks per queue: " << tasks << " latency samples: " << samples
+            << " executor threads: " << threads << '\n';
+
+  std::cout << "queues destroyed by own task: 1024 per queue(us): " << std::fixed << std::setprecision(2)
+            << verify_release_own_task(ex, 1024) << '\n';
+
+  for (size_t num_queues : {1, 64, 1024}) {
+    report("thread", num_queues, run_test(num_queues, tasks, samples, nullptr));
+    report("executor", num_queues, run_test(num_queues, tasks, samples, &ex));
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for recorded runlists
+//
+// Records a runlist of runs of a kernel and patches a buffer argument
+// of one run in place between executions.  Verifies that the patched
+// command packet matches the packet of a run freshly encoded with the
+// same argument, that other runs are left untouched, and that invalid
+// patches throw.  Reports runlist executions per second in recorded
+// and normal mode.
+//
+// Runlists require a shim hw queue.  Without hardware the noop shim
+// simulates a hw queue, the benchmark enables it with
+// Runtime.noop_hw_queue.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % XCL_EMULATION_MODE=noop <path>/runlist_record_bench -k verify.xclbin [--kernel <name>] [-n <runs>]
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_ini.h"
+#include "xrt/experimental/xrt_kernel.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using clk = std::chrono::steady_clock;
+
+static void
+usage()
+{
+  std::cout << "usage: runlist_record_bench -k <xclbin> [--kernel <name>] [-n <runs>]\n"
+            << "  --kernel kernel with one buffer argument (default hello)\n";
+}
+
+// Compare command packets ignoring the command state, which differs
+// between a run executed by itself and a run executed in a runlist
+static bool
+same_packet(const ert_packet* lhs, const ert_packet* rhs)
+{
+  return lhs->opcode == rhs->opcode
+    && lhs->type == rhs->type
+    && lhs->custom == rhs->custom
+    && lhs->count == rhs->count
+    && std::memcmp(lhs->data, rhs->data, lhs->count * sizeof(uint32_t)) == 0;
+}
+
+static std::vector<uint32_t>
+copy_packet(const ert_packet* pkt)
+{
+  return {pkt->data, pkt->data + pkt->count};
+}
+
+// Encode a run with specified buffer argument outside of any runlist
+static xrt::run
+encode_fresh(const xrt::kernel& kernel, const xrt::bo& bo)
+{
+  xrt::run run{kernel};
+  run.set_arg(0, bo);
+  run.start();
+  run.wait();
+  return run;
+}
+
+static void
+execute(xrt::runlist& runlist)
+{
+  runlist.execute();
+  runlist.wait();
+}
+
+static void
+verify_patch(const xrt::device& device, const xrt::kernel& kernel,
+             xrt::runlist& runlist, std::vector<xrt::run>& runs)
+{
+  execute(runlist);
+
+  auto& patched = runs.front();
+  auto untouched = copy_packet(runs.back().get_ert_packet());
+
+  for (int round = 0; round < 3; ++round) {
+    xrt::bo bo(device, 20, kernel.group_id(0));
+    patched.set_arg(0, bo);
+    execute(runlist);
+
+    auto fresh = encode_fresh(kernel, bo);
+    if (!same_packet(patched.get_ert_packet(), fresh.get_ert_packet()))
+      throw std::runtime_error("patch: packet of patched run differs from freshly encoded packet");
+
+    if (copy_packet(runs.back().get_ert_packet()) != untouched)
+      throw std::runtime_error("patch: packet of unpatched run changed");
+  }
+
+  std::cout << "verify patch: ok\n";
+}
+
+template <typename Function>
+static void
+expect_throw(const std::string& what, Function&& f)
+{
+  try {
+    f();
+  }
+  catch (const std::exception&) {
+    return;
+  }
+  throw std::runtime_error("invalid patch: " + what + " did not throw");
+}
+
+static void
+verify_invalid_patch(const xrt::device& device, const xrt::kernel& kernel,
+                     xrt::runlist& runlist, std::vector<xrt::run>& runs)
+{
+  xrt::bo bo(device, 20, kernel.group_id(0));
+  auto& run = runs.front();
+  auto before = copy_packet(run.get_ert_packet());
+
+  expect_throw("bad argument index", [&] { run.set_arg(1000, bo); });
+
+  runlist.execute();
+  expect_throw("patch of executing runlist", [&] { run.set_arg(0, bo); });
+  runlist.wait();
+
+  if (copy_packet(run.get_ert_packet()) != before)
+    throw std::runtime_error("invalid patch: packet changed");
+
+  expect_throw("add to recorded runlist", [&] { runlist.add(xrt::run{kernel}); });
+
+  // Patching is allowed again once the runlist is idle
+  run.set_arg(0, bo);
+  execute(runlist);
+
+  std::cout << "verify invalid patch: ok\n";
+}
+
+// Runlist executions per second
+static double
+executions_per_sec(xrt::runlist& runlist, size_t total)
+{
+  auto start = clk::now();
+  for (size_t i = 0; i < total; ++i)
+    execute(runlist);
+
+  return total / std::chrono::duration<double>(clk::now() - start).count();
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string xclbin;
+  std::string kernel_name = "hello";
+  size_t num_runs = 16;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    else if (args[i] == "-k")
+      xclbin = args[++i];
+    else if (args[i] == "--kernel")
+      kernel_name = args[++i];
+    else if (args[i] == "-n")
+      num_runs = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (xclbin.empty())
+    throw std::runtime_error("-k <xclbin> is required");
+  if (num_runs < 2)
+    throw std::runtime_error("-n <runs> must be at least 2");
+
+  // Ignored by shims other than noop
+  xrt::ini::set("Runtime.noop_hw_queue", "true");
+
+  xrt::device device{0};
+  auto uuid = device.register_xclbin(xrt::xclbin{xclbin});
+  xrt::hw_context hwctx{device, uuid};
+  xrt::kernel kernel{hwctx, kernel_name};
+
+  std::vector<xrt::run> runs;
+  xrt::runlist runlist{hwctx};
+  for (size_t i = 0; i < num_runs; ++i) {
+    xrt::run krun{kernel};
+    krun.set_arg(0, xrt::bo(device, 20, kernel.group_id(0)));
+    runlist.add(krun);
+    runs.push_back(std::move(krun));
+  }
+  runlist.record();
+
+  verify_patch(device, kernel, runlist, runs);
+  verify_invalid_patch(device, kernel, runlist, runs);
+
+  constexpr size_t total = 10000;
+  auto recorded = executions_per_sec(runlist, total);
+
+  runlist.reset();
+  for (auto& krun : runs)
+    runlist.add(krun);
+  auto normal = executions_per_sec(runlist, total);
+
+  std::cout << "executions/sec: " << static_cast<uint64_t>(normal) << " normal, "
+            << static_cast<uint64_t>(recorded) << " recorded\n";
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for hw queue submission coalescing
+//
+// Starts independent runs of a kernel with submission coalescing
+// enabled for the hw context, so runs are submitted to the shim hw
+// queue as chained commands.  Verifies that every run completes when
+// waited for in order, in reverse order, from several threads, or
+// only polled, and that runs can be restarted.  Reports runs per
+// second with and without coalescing.
+//
+// Coalescing requires a shim hw queue.  Without hardware the noop
+// shim simulates a hw queue that checks and executes chained commands
+// as drivers do, the benchmark enables it with Runtime.noop_hw_queue.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % XCL_EMULATION_MODE=noop <path>/submit_coalesce_bench -k verify.xclbin [--kernel <name>] [-n <runs>]
+
+#include "core/common/api/hw_context_int.h"
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_ini.h"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using clk = std::chrono::steady_clock;
+
+static void
+usage()
+{
+  std::cout << "usage: submit_coalesce_bench -k <xclbin> [--kernel <name>] [-n <runs>]\n"
+            << "  --kernel kernel with one buffer argument (default hello)\n";
+}
+
+static void
+check_completed(const xrt::run& run, const std::string& what)
+{
+  if (run.state() != ERT_CMD_STATE_COMPLETED)
+    throw std::runtime_error(what + ": run state " + std::to_string(run.state()));
+}
+
+static void
+start_all(std::vector<xrt::run>& runs)
+{
+  for (auto& run : runs)
+    run.start();
+}
+
+static void
+verify_in_order(std::vector<xrt::run>& runs)
+{
+  start_all(runs);
+  for (auto& run : runs)
+    run.wait();
+  for (auto& run : runs)
+    check_completed(run, "in order");
+
+  std::cout << "verify in order: ok\n";
+}
+
+static void
+verify_reverse(std::vector<xrt::run>& runs)
+{
+  start_all(runs);
+  for (auto itr = runs.rbegin(); itr != runs.rend(); ++itr)
+    itr->wait();
+  for (auto& run : runs)
+    check_completed(run, "reverse order");
+
+  std::cout << "verify reverse order: ok\n";
+}
+
+// Threads start and wait for interleaved runs, chains mix runs of
+// all threads
+static void
+verify_threads(std::vector<xrt::run>& runs)
+{
+  constexpr size_t num_threads = 4;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&runs, t] {
+      for (size_t i = t; i < runs.size(); i += num_threads)
+        runs[i].start();
+      for (size_t i = t; i < runs.size(); i += num_threads)
+        runs[i].wait();
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  for (auto& run : runs)
+    check_completed(run, "threads");
+
+  std::cout << "verify threads: ok\n";
+}
+
+// Runs complete when only polled
+static void
+verify_poll(std::vector<xrt::run>& runs)
+{
+  start_all(runs);
+  auto deadline = clk::now() + std::chrono::seconds(10);
+  for (auto& run : runs) {
+    while (run.state() < ERT_CMD_STATE_COMPLETED) {
+      if (clk::now() > deadline)
+        throw std::runtime_error("poll: run did not complete");
+    }
+  }
+  for (auto& run : runs)
+    check_completed(run, "poll");
+
+  std::cout << "verify poll: ok\n";
+}
+
+static void
+verify_restart(std::vector<xrt::run>& runs)
+{
+  for (int round = 0; round < 3; ++round) {
+    start_all(runs);
+    for (auto& run : runs)
+      run.wait();
+  }
+  for (auto& run : runs)
+    check_completed(run, "restart");
+
+  std::cout << "verify restart: ok\n";
+}
+
+// Runs per second keeping all runs in flight
+static double
+runs_per_sec(std::vector<xrt::run>& runs, size_t total)
+{
+  auto start = clk::now();
+  size_t issued = 0;
+  for (auto& run : runs) {
+    if (issued == total)
+      break;
+    run.start();
+    ++issued;
+  }
+
+  for (size_t completed = 0, i = 0; completed < total; ++completed, i = (i + 1) % runs.size()) {
+    runs[i].wait();
+    if (issued < total) {
+      runs[i].start();
+      ++issued;
+    }
+  }
+
+  return total / std::chrono::duration<double>(clk::now() - start).count();
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string xclbin;
+  std::string kernel_name = "hello";
+  size_t num_runs = 64;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    else if (args[i] == "-k")
+      xclbin = args[++i];
+    else if (args[i] == "--kernel")
+      kernel_name = args[++i];
+    else if (args[i] == "-n")
+      num_runs = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (xclbin.empty())
+    throw std::runtime_error("-k <xclbin> is required");
+  if (!num_runs)
+    throw std::runtime_error("-n <runs> must be greater than 0");
+
+  // Ignored by shims other than noop
+  xrt::ini::set("Runtime.noop_hw_queue", "true");
+
+  xrt::device device{0};
+  auto uuid = device.register_xclbin(xrt::xclbin{xclbin});
+  xrt::hw_context hwctx{device, uuid};
+  xrt::kernel kernel{hwctx, kernel_name};
+
+  std::vector<xrt::run> runs;
+  for (size_t i = 0; i < num_runs; ++i) {
+    xrt::run krun{kernel};
+    krun.set_arg(0, xrt::bo(device, 20, kernel.group_id(0)));
+    runs.push_back(std::move(krun));
+  }
+
+  // The kernel keeps the hw queue of the context alive
+  xrt_core::hw_context_int::set_submit_coalescing(hwctx, std::chrono::microseconds(100), 16);
+
+  verify_in_order(runs);
+  verify_reverse(runs);
+  verify_threads(runs);
+  verify_poll(runs);
+  verify_restart(runs);
+
+  constexpr size_t total = 100000;
+  auto coalesced = runs_per_sec(runs, total);
+  xrt_core::hw_context_int::set_submit_coalescing(hwctx, std::chrono::microseconds(0), 0);
+  auto plain = runs_per_sec(runs, total);
+  std::cout << "runs/sec: " << static_cast<uint64_t>(plain) << " plain, "
+            << static_cast<uint64_t>(coalesced) << " coalesced\n";
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
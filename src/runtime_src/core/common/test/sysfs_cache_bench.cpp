@@ -0,0 +1,709 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark of the sysfs read cache
+//
+// Verifies against a synthetic device directory that cached and
+// uncached reads return the same contents and error messages,
+// including a missing subdevice, missing entries, and write only
+// entries, that a write through the cache drops cached contents, and
+// that reads find a subdevice directory that was renamed, as when a
+// subdevice is reloaded, also with kept file descriptors.  Runs as an
+// unprivileged user when started as root, root can read write only
+// entries.
+//
+// Replays the sysfs reads of one examine report and counts the system
+// calls per report.  Each report runs in a child process traced with
+// ptrace, system calls between the start and the end of a report are
+// counted.  Time per report is measured in a separate untraced run.
+//
+// Modes:
+//  uncached: cache disabled, what applications and tools did before
+//  examine:  cold cache per report, as one xrt-smi examine invocation
+//  watch:    one cache for all reports with entries expired between
+//            reports, as watch mode refreshes
+//
+// The default workload reads every sysfs entry of the linux query
+// table once, plus the device identity per report section.  A workload
+// file has one '<subdev> <entry> [<count>]' per line, '-' is the
+// device directory, '#' starts a comment.
+//
+// Without -d a synthetic Alveo user function directory is created with
+// the subdevice directories and entries of the workload.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/sysfs_cache_bench [-d <device dir>] [-f <file>] [-n <reports>]
+//                            [-t <ttl ms>] [-i <watch interval ms>]
+//                            [-m <uncached|examine|watch>]...
+
+#include "core/pcie/linux/sysfs_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/ptrace.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using xrt_core::pci::sysfs_cache;
+
+namespace {
+
+struct query
+{
+  std::string subdev;
+  std::string entry;
+};
+
+// sysfs entries of the linux query table by subdevice
+const std::vector<std::pair<std::string, std::vector<std::string>>> query_table = {
+  {"", {"vendor", "device", "subsystem_vendor", "subsystem_device", "link_width",
+        "link_speed", "link_speed_max", "link_width_max", "local_cpulist", "ready",
+        "dev_offline", "mfg", "mfg_ver", "board_name", "flash_type", "interface_uuids",
+        "logic_uuids", "mig_calibration", "nodma", "versal", "xclbinuuid", "memstat",
+        "memstat_raw", "kds_numcdmas", "xocl_errors", "device_bad_state", "host_mem_size",
+        "cache_xclbin", "size", "read_range"}},
+  {"rom", {"VBNV", "ddr_bank_size", "ddr_bank_count_max", "FPGA", "raw", "uuid", "timestamp"}},
+  {"xmc", {"temp_by_mem_topology", "version", "bd_name", "serial_num", "max_power",
+           "sc_presence", "sc_is_fixed", "bmc_ver", "exp_bmc_ver", "status", "reg_base",
+           "scaling_support", "scaling_enabled", "scaling_critical_power_threshold",
+           "scaling_critical_temp_threshold", "scaling_threshold_power_limit",
+           "scaling_threshold_temp_limit", "scaling_threshold_power_override_en",
+           "scaling_threshold_temp_override_en", "scaling_threshold_power_override",
+           "scaling_threshold_temp_override", "xmc_se98_temp0", "xmc_se98_temp1",
+           "xmc_se98_temp2", "xmc_fpga_temp", "xmc_fan_temp", "fan_presence", "xmc_fan_rpm",
+           "xmc_ddr_temp0", "xmc_ddr_temp1", "xmc_ddr_temp2", "xmc_ddr_temp3", "xmc_hbm_temp",
+           "xmc_cage_temp0", "xmc_cage_temp1", "xmc_cage_temp2", "xmc_cage_temp3",
+           "xmc_dimm_temp0", "xmc_dimm_temp1", "xmc_dimm_temp2", "xmc_dimm_temp3",
+           "xmc_12v_pex_vol", "xmc_12v_pex_curr", "xmc_12v_aux_vol", "xmc_12v_aux_curr",
+           "xmc_3v3_pex_vol", "xmc_3v3_aux_vol", "xmc_3v3_aux_cur", "xmc_ddr_vpp_btm",
+           "xmc_ddr_vpp_top", "xmc_sys_5v5", "xmc_1v2_top", "xmc_vcc1v2_btm", "xmc_1v8",
+           "xmc_0v85", "xmc_mgt0v9avcc", "xmc_12v_sw", "xmc_mgtavtt", "xmc_vccint_vol",
+           "xmc_vccint_curr", "xmc_vccint_temp", "xmc_12v_aux1", "xmc_vcc1v2_i",
+           "xmc_v12_in_i", "xmc_v12_in_aux0_i", "xmc_v12_in_aux1_i", "xmc_vccaux",
+           "xmc_vccaux_pmc", "xmc_vccram", "xmc_3v3_pex_curr", "xmc_0v85_curr",
+           "xmc_3v3_vcc_vol", "xmc_hbm_1v2_vol", "xmc_vpp2v5_vol", "xmc_vccint_bram_vol",
+           "xmc_vccint_vcu_0v9", "mac_contiguous_num", "mac_addr_first", "xmc_oem_id",
+           "xmc_heartbeat_count", "xmc_heartbeat_err_code", "xmc_heartbeat_err_time",
+           "xmc_heartbeat_stall", "xmc_power", "xmc_power_warn"}},
+  {"hwmon_sdm", {"serial_num", "oem_id", "bd_name", "active_msp_ver", "target_msp_ver",
+                 "mac_addr0", "mac_addr1", "fan_presence", "revision", "mfg_date"}},
+  {"icap", {"mem_topology", "group_topology", "ip_layout", "debug_ip_layout",
+            "clock_freq_topology", "clock_freqs", "idcode", "data_retention", "sec_level",
+            "max_host_mem_aperture", "ps_kernel"}},
+  {"ert_ctrl", {"clock_timestamp", "mb_sleep", "cq_read_cnt", "cq_write_cnt", "cu_read_cnt",
+                "cu_write_cnt", "data_integrity", "status"}},
+  {"xgq_vmr", {"boot_from_backup", "flush_default_only", "program_sc", "vmr_verbose_info",
+               "xgq_scaling_enable", "xgq_scaling_power_override", "xgq_scaling_temp_override"}},
+  {"mig", {"ecc_status", "ecc_ce_cnt", "ecc_ue_cnt", "ecc_ce_ffa", "ecc_ue_ffa"}},
+  {"firewall", {"detected_level", "detected_level_name", "detected_status", "detected_time"}},
+  {"flash", {"bar_off", "flash_type", "size"}},
+  {"icap_controller", {"enable", "load_flash_addr"}},
+  {"dma", {"channel_stat_raw"}},
+  {"address_translator", {"host_mem_size"}},
+  {"mailbox", {"recv_metrics"}},
+  {"p2p", {"config"}},
+  {"dna", {"dna"}},
+};
+
+// Entries every report section reads to identify the device
+const std::vector<query> identity = {
+  {"", "vendor"}, {"", "device"}, {"", "subsystem_vendor"}, {"", "subsystem_device"},
+  {"rom", "VBNV"}, {"rom", "uuid"}, {"", "xclbinuuid"}
+};
+constexpr int report_sections = 8;
+
+// Entries of a PCIe function directory that are not queried
+const std::vector<std::string> pci_files = {
+  "class", "config", "resource", "resource0", "resource2", "irq", "numa_node", "enable",
+  "driver_override", "msi_bus", "uevent", "modalias", "d3cold_allowed", "revision",
+  "consistent_dma_mask_bits", "dma_mask_bits", "broken_parity_status", "current_link_speed",
+  "current_link_width", "max_link_speed", "max_link_width", "remove", "rescan", "reset",
+  "ari_enabled", "instance", "userbar", "shutdown", "rp_program", "mig_cache_update"
+};
+const std::vector<std::string> pci_dirs = {"power", "msi_irqs", "drm", "iommu_group", "driver"};
+
+// close(2) of these descriptors marks start and end of a report
+constexpr int begin_marker = -1000;
+constexpr int end_marker = -1001;
+
+enum class mode { uncached, examine, watch };
+
+struct counts
+{
+  uint64_t open = 0;
+  uint64_t read = 0;
+  uint64_t close = 0;
+  uint64_t getdents = 0;
+  uint64_t other = 0;
+
+  uint64_t
+  total() const
+  {
+    return open + read + close + getdents + other;
+  }
+
+  void
+  add(uint64_t nr)
+  {
+    switch (nr) {
+#ifdef SYS_open
+    case SYS_open:
+#endif
+    case SYS_openat:
+      ++open;
+      break;
+    case SYS_read:
+    case SYS_pread64:
+      ++read;
+      break;
+    case SYS_close:
+      ++close;
+      break;
+    case SYS_getdents64:
+      ++getdents;
+      break;
+    default:
+      ++other;
+    }
+  }
+};
+
+void
+usage()
+{
+  std::cout << "usage: sysfs_cache_bench [-d <device dir>] [-f <file>] [-n <reports>]\n"
+            << "                         [-t <ttl ms>] [-i <watch interval ms>]\n"
+            << "                         [-m <uncached|examine|watch>]...\n";
+}
+
+std::string
+to_string(mode m)
+{
+  switch (m) {
+  case mode::uncached: return "uncached";
+  case mode::examine:  return "examine";
+  case mode::watch:    return "watch";
+  }
+  return "";
+}
+
+mode
+to_mode(const std::string& str)
+{
+  for (auto m : {mode::uncached, mode::examine, mode::watch})
+    if (to_string(m) == str)
+      return m;
+  throw std::runtime_error("Unknown mode " + str);
+}
+
+std::vector<query>
+default_workload()
+{
+  std::vector<query> queries;
+  for (const auto& [subdev, entries] : query_table)
+    for (const auto& entry : entries)
+      queries.push_back({subdev, entry});
+  for (int i = 0; i < report_sections; ++i)
+    queries.insert(queries.end(), identity.begin(), identity.end());
+  return queries;
+}
+
+std::vector<query>
+read_workload(const std::string& file)
+{
+  std::ifstream istr(file);
+  if (!istr)
+    throw std::runtime_error("Failed to open " + file);
+
+  std::vector<query> queries;
+  std::string line;
+  for (size_t lineno = 1; std::getline(istr, line); ++lineno) {
+    std::istringstream sstr(line.substr(0, line.find('#')));
+    query q;
+    if (!(sstr >> q.subdev))
+      continue;
+    if (!(sstr >> q.entry))
+      throw std::runtime_error(file + ":" + std::to_string(lineno) + ": missing entry");
+    if (q.subdev == "-")
+      q.subdev.clear();
+    size_t count = 1;
+    sstr >> count;
+    queries.insert(queries.end(), count, q);
+  }
+  return queries;
+}
+
+void
+write_file(const std::filesystem::path& path, const std::string& data)
+{
+  std::ofstream ostr(path);
+  ostr << data;
+  if (!ostr)
+    throw std::runtime_error("Failed to write " + path.string());
+}
+
+// Synthetic device directory with subdevice directories named as xocl
+// names them, <subdev>.u.<instance>
+std::filesystem::path
+create_device_dir(const std::vector<query>& queries)
+{
+  char tmpl[] = "/tmp/sysfs_cache_bench.XXXXXX";
+  if (!mkdtemp(tmpl))
+    throw std::runtime_error(std::string("Failed to create temp dir: ") + strerror(errno));
+
+  std::filesystem::path dir = tmpl;
+  for (const auto& name : pci_files)
+    write_file(dir / name, "0x1\n");
+  for (const auto& name : pci_dirs)
+    std::filesystem::create_directory(dir / name);
+
+  unsigned int instance = 0x800000;
+  std::vector<std::string> subdevs;
+  for (const auto& q : queries) {
+    auto subdir = dir;
+    if (!q.subdev.empty()) {
+      auto it = std::find(subdevs.begin(), subdevs.end(), q.subdev);
+      auto idx = std::distance(subdevs.begin(), it);
+      if (it == subdevs.end())
+        subdevs.push_back(q.subdev);
+      subdir /= q.subdev + ".u." + std::to_string(instance + idx);
+      if (std::filesystem::create_directory(subdir)) {
+        write_file(subdir / "uevent", "DRIVER=" + q.subdev + "\n");
+        std::filesystem::create_directory(subdir / "power");
+      }
+    }
+    write_file(subdir / q.entry, "1234\n");
+  }
+  return dir;
+}
+
+struct result
+{
+  std::string err;
+  std::string data;
+
+  bool
+  operator==(const result& other) const
+  {
+    return err == other.err && data == other.data;
+  }
+};
+
+result
+read(sysfs_cache& cache, const std::string& subdev, const std::string& entry, bool binary = false)
+{
+  result r;
+  cache.read(subdev, entry, binary, r.err, r.data);
+  return r;
+}
+
+std::filesystem::path
+find_subdir(const std::filesystem::path& dir, const std::string& subdev)
+{
+  for (const auto& dent : std::filesystem::directory_iterator(dir))
+    if (dent.path().filename().string().rfind(subdev + ".", 0) == 0)
+      return dent.path();
+  throw std::runtime_error("No subdevice directory for " + subdev);
+}
+
+void
+check(bool ok, const std::string& what, const result& r = {})
+{
+  if (!ok)
+    throw std::runtime_error(what + " (data '" + r.data + "' error '" + r.err + "')");
+}
+
+// Cached reads, first from sysfs then from cache, match uncached
+// reads for all queries and error cases
+void
+verify_reads(const std::filesystem::path& dir, std::vector<query> queries)
+{
+  // Write only entries fail to open for reading
+  std::filesystem::permissions(dir / "remove", std::filesystem::perms::owner_write);
+  write_file(find_subdir(dir, "xmc") / "reset", "");
+  std::filesystem::permissions(find_subdir(dir, "xmc") / "reset", std::filesystem::perms::owner_write);
+
+  queries.push_back({"nosuch", "version"});   // missing subdevice
+  queries.push_back({"", "nosuch"});          // missing entry
+  queries.push_back({"xmc", "nosuch"});       // missing entry of prefetched subdevice
+  queries.push_back({"", "remove"});          // write only entry
+  queries.push_back({"xmc", "reset"});        // write only entry of prefetched subdevice
+
+  sysfs_cache uncached(dir);
+  sysfs_cache cached(dir);
+  cached.set_ttl(60000);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const auto& q : queries) {
+      for (bool binary : {false, true}) {
+        auto expected = read(uncached, q.subdev, q.entry, binary);
+        auto r = read(cached, q.subdev, q.entry, binary);
+        check(r == expected, "cached read of " + q.subdev + "/" + q.entry
+              + " differs from uncached '" + expected.data + "' '" + expected.err + "'", r);
+      }
+    }
+  }
+
+  check(!read(cached, "", "remove").err.empty(), "write only entry read");
+  check(!read(cached, "nosuch", "version").err.empty(), "missing subdevice read");
+  auto stats = cached.get_stats();
+  check(stats.hits >= queries.size(), "reads not served from cache");
+}
+
+// A write through the cache drops cached contents
+void
+verify_write(const std::filesystem::path& dir)
+{
+  sysfs_cache cached(dir);
+  cached.set_ttl(60000);
+  auto path = find_subdir(dir, "icap") / "clock_freqs";
+
+  write_file(path, "100\n");
+  check(read(cached, "icap", "clock_freqs").data == "100\n", "bad initial read");
+
+  // Changes behind the cache are not seen within the ttl
+  write_file(path, "200\n");
+  auto r = read(cached, "icap", "clock_freqs");
+  check(r.data == "100\n", "entry not cached", r);
+
+  std::string err;
+  cached.write("icap", "clock_freqs", false, "300\n", err);
+  check(err.empty(), "write failed: " + err);
+  r = read(cached, "icap", "clock_freqs");
+  check(r.data == "300\n", "write did not invalidate cached contents", r);
+
+  cached.write("nosuch", "version", false, "1", err);
+  sysfs_cache uncached(dir);
+  check(err == read(uncached, "nosuch", "version").err, "bad write error of missing subdevice: " + err);
+}
+
+// Reads find a renamed subdevice directory, entries read before the
+// rename are re-read on kept descriptors and entries not read before
+// are opened in the new directory
+void
+verify_rename(const std::filesystem::path& dir)
+{
+  sysfs_cache cached(dir);
+  cached.set_ttl(1);
+  check(read(cached, "icap", "mem_topology").data == "1234\n", "bad initial read");
+
+  auto from = find_subdir(dir, "icap");
+  auto to = dir / "icap.u.9999999";
+  std::filesystem::rename(from, to);
+  write_file(to / "mem_topology", "5678\n");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  auto scans = cached.get_stats().dir_scans;
+  sysfs_cache uncached(dir);
+  for (const auto& entry : {"mem_topology", "ip_layout"}) {
+    auto expected = read(uncached, "icap", entry);
+    auto r = read(cached, "icap", entry);
+    check(expected.err.empty() && r == expected, std::string("bad read of renamed subdevice entry ") + entry, r);
+  }
+  check(read(cached, "icap", "mem_topology").data == "5678\n", "stale contents after rename");
+  check(cached.get_stats().dir_scans > scans, "renamed subdevice not looked up again");
+
+  std::filesystem::rename(to, from);
+}
+
+// Root can read write only entries, verification runs as nobody in a
+// child process when started as root
+void
+run_unprivileged(const std::function<void()>& fn)
+{
+  if (geteuid() != 0) {
+    fn();
+    return;
+  }
+
+  std::cout.flush();
+  auto pid = fork();
+  if (pid < 0)
+    throw std::runtime_error(std::string("fork failed: ") + strerror(errno));
+
+  if (pid == 0) {
+    constexpr uid_t nobody = 65534;
+    int status = 0;
+    if (setgid(nobody) != 0 || setuid(nobody) != 0) {
+      std::cout << "Failed to run as unprivileged user: " << strerror(errno) << '\n';
+      status = 2;
+    }
+    else {
+      try {
+        fn();
+      }
+      catch (const std::exception& ex) {
+        std::cout << "Exception caught: " << ex.what() << '\n';
+        status = 1;
+      }
+    }
+    std::cout.flush();
+    _exit(status);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status))
+    throw std::runtime_error("Verification failed");
+}
+
+void
+verify()
+{
+  run_unprivileged([] {
+    auto queries = default_workload();
+    auto dir = create_device_dir(queries);
+    try {
+      verify_reads(dir, queries);
+      std::cout << "verify reads: ok\n";
+      verify_write(dir);
+      std::cout << "verify write: ok\n";
+      verify_rename(dir);
+      std::cout << "verify rename: ok\n";
+    }
+    catch (...) {
+      std::filesystem::remove_all(dir);
+      throw;
+    }
+    std::filesystem::remove_all(dir);
+  });
+}
+
+void
+run_report(sysfs_cache& cache, const std::vector<query>& queries)
+{
+  std::string err;
+  std::string data;
+  for (const auto& q : queries)
+    cache.read(q.subdev, q.entry, false, err, data);
+}
+
+// Run reports and return accumulated cache statistics
+sysfs_cache::stats
+run_reports(mode m, const std::string& dir, const std::vector<query>& queries,
+            size_t reports, uint32_t ttl, uint32_t interval, bool traced)
+{
+  sysfs_cache::stats total;
+  auto add = [&total](const sysfs_cache::stats& s) {
+    total.hits += s.hits;
+    total.misses += s.misses;
+    total.prefetches += s.prefetches;
+    total.dir_scans += s.dir_scans;
+  };
+
+  std::unique_ptr<sysfs_cache> watch;
+  if (m == mode::watch) {
+    watch = std::make_unique<sysfs_cache>(dir);
+    watch->set_ttl(ttl);
+  }
+
+  for (size_t i = 0; i < reports; ++i) {
+    if (watch && i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+
+    if (traced)
+      syscall(SYS_close, begin_marker);
+
+    if (watch) {
+      run_report(*watch, queries);
+    }
+    else {
+      sysfs_cache cache(dir);
+      cache.set_ttl(m == mode::uncached ? 0 : ttl);
+      run_report(cache, queries);
+      add(cache.get_stats());
+    }
+
+    if (traced)
+      syscall(SYS_close, end_marker);
+  }
+
+  if (watch)
+    add(watch->get_stats());
+  return total;
+}
+
+// Count system calls of function run in a traced child process
+counts
+trace(const std::function<void()>& fn)
+{
+  auto pid = fork();
+  if (pid < 0)
+    throw std::runtime_error(std::string("fork failed: ") + strerror(errno));
+
+  if (pid == 0) {
+    if (ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) != 0)
+      _exit(2);
+    raise(SIGSTOP);
+    try {
+      fn();
+    }
+    catch (...) {
+      _exit(1);
+    }
+    _exit(0);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFSTOPPED(status))
+    throw std::runtime_error("Failed to trace child process, ptrace not permitted");
+  ptrace(PTRACE_SETOPTIONS, pid, nullptr, PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL);
+
+  counts c;
+  bool counting = false;
+  int sig = 0;
+  while (true) {
+    ptrace(PTRACE_SYSCALL, pid, nullptr, sig);
+    sig = 0;
+    waitpid(pid, &status, 0);
+    if (WIFEXITED(status) || WIFSIGNALED(status))
+      break;
+    if (!WIFSTOPPED(status))
+      continue;
+    if (WSTOPSIG(status) != (SIGTRAP | 0x80)) {
+      sig = WSTOPSIG(status);
+      continue;
+    }
+
+    __ptrace_syscall_info info = {};
+    if (ptrace(PTRACE_GET_SYSCALL_INFO, pid, sizeof(info), &info) <= 0
+        || info.op != PTRACE_SYSCALL_INFO_ENTRY)
+      continue;
+
+    auto arg0 = static_cast<int>(info.entry.args[0]);
+    if (info.entry.nr == SYS_close && (arg0 == begin_marker || arg0 == end_marker)) {
+      counting = arg0 == begin_marker;
+      continue;
+    }
+    if (counting)
+      c.add(info.entry.nr);
+  }
+
+  if (!WIFEXITED(status) || WEXITSTATUS(status))
+    throw std::runtime_error("Reports failed in traced child process");
+  return c;
+}
+
+void
+run(int argc, char* argv[])
+{
+  std::string dir;
+  std::string file;
+  size_t reports = 10;
+  uint32_t ttl = 1000;
+  uint32_t interval = 5;
+  std::vector<mode> modes;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-d")
+      dir = args[++i];
+    else if (args[i] == "-f")
+      file = args[++i];
+    else if (args[i] == "-n")
+      reports = std::stoul(args[++i]);
+    else if (args[i] == "-t")
+      ttl = std::stoul(args[++i]);
+    else if (args[i] == "-i")
+      interval = std::stoul(args[++i]);
+    else if (args[i] == "-m")
+      modes.push_back(to_mode(args[++i]));
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!reports)
+    throw std::runtime_error("-n <reports> must be greater than 0");
+  if (!ttl)
+    throw std::runtime_error("-t <ttl ms> must be greater than 0");
+  if (modes.empty())
+    modes = {mode::uncached, mode::examine, mode::watch};
+
+  verify();
+
+  auto queries = file.empty() ? default_workload() : read_workload(file);
+  bool synthetic = dir.empty();
+  if (synthetic)
+    dir = create_device_dir(queries).string();
+
+  std::cout << "device: " << dir << (synthetic ? " (synthetic)" : "")
+            << " queries/report: " << queries.size() << " reports: " << reports
+            << " ttl: " << ttl << "ms watch interval: " << interval << "ms\n"
+            << "      mode  syscalls   open   read  close  getdents  other   us/report"
+            << "    hits  misses  prefetch  dirscan\n";
+
+  for (auto m : modes) {
+    // Entries must expire between watch refreshes
+    auto mode_ttl = m == mode::watch ? std::min(ttl, interval) : ttl;
+    auto mode_interval = m == mode::watch ? std::max(interval, mode_ttl + 1) : interval;
+
+    auto c = trace([&] { run_reports(m, dir, queries, reports, mode_ttl, mode_interval, true); });
+
+    auto start = std::chrono::steady_clock::now();
+    auto stats = run_reports(m, dir, queries, reports, mode_ttl, mode_interval, false);
+    std::chrono::duration<double, std::micro> wall = std::chrono::steady_clock::now() - start;
+    if (m == mode::watch)
+      wall -= std::chrono::milliseconds(mode_interval * (reports - 1));
+
+    auto per = [reports](uint64_t v) { return double(v) / reports; };
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(10) << to_string(m)
+              << std::setw(10) << per(c.total())
+              << std::setw(7) << per(c.open)
+              << std::setw(7) << per(c.read)
+              << std::setw(7) << per(c.close)
+              << std::setw(10) << per(c.getdents)
+              << std::setw(7) << per(c.other)
+              << std::setw(12) << wall.count() / reports
+              << std::setw(8) << per(stats.hits)
+              << std::setw(8) << per(stats.misses)
+              << std::setw(10) << per(stats.prefetches)
+              << std::setw(9) << per(stats.dir_scans) << '\n';
+  }
+
+  if (synthetic)
+    std::filesystem::remove_all(dir);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for usage metrics counters
+//
+// Verifies that counters updated by many threads, including threads
+// that exit and whose blocks are reused, sum to the expected totals,
+// and that the run timer matches starts with stops and bounds the
+// number of tracked runs.
+//
+// Measures operations per second of the usage metrics logger hooks
+// called by XRT when a buffer is constructed and synced and when a
+// kernel run is started and completes, from 1 up to max threads.  The
+// hooks of the logger enabled with Runtime.usage_metrics_logging are
+// compared with the no-op hooks of the disabled logger.  Fails if
+// throughput with metrics relative to throughput without metrics is
+// more than 10% lower with any number of threads than with 1 thread.
+//
+// Without hardware the benchmark runs on the noop shim.  Usage
+// metrics are written to XRT_usage_metrics_<pid>_<time>.json in the
+// current directory when the benchmark exits.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % XCL_EMULATION_MODE=noop <path>/usage_metrics_bench -k verify.xclbin [--kernel <name>]
+//                            [-t <max threads>] [-n <operations per thread>]
+
+#include "core/common/api/hw_context_int.h"
+#include "core/common/device.h"
+#include "core/common/usage_metrics.h"
+#include "core/common/usage_metrics_counters.h"
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_ini.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using clk = std::chrono::high_resolution_clock;
+using xrt_core::usage_metrics::thread_counters;
+using xrt_core::usage_metrics::run_timer;
+using xrt_core::usage_metrics::base_logger;
+
+static void
+usage()
+{
+  std::cout << "usage: usage_metrics_bench -k <xclbin> [--kernel <name>] [-t <max threads>] [-n <operations per thread>]\n"
+            << "  --kernel kernel to log runs of (default hello)\n"
+            << "  -t       max threads, at least 2 (default number of cpus)\n";
+}
+
+static void
+verify_counters()
+{
+  auto& counters = thread_counters::instance();
+  auto slot = counters.allocate();
+  constexpr unsigned int threads = 8;
+  constexpr uint64_t count = 10000;
+
+  // Two rounds, second round reuses blocks of exited threads
+  for (int round = 0; round < 2; ++round) {
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t) {
+      workers.emplace_back([&counters, slot, t] {
+        for (uint64_t i = 0; i < count; ++i)
+          counters.add(slot, 0, 1);
+        counters.max(slot, 1, t + 1);
+      });
+    }
+    for (auto& w : workers)
+      w.join();
+  }
+
+  if (counters.sum(slot, 0) != 2 * threads * count)
+    throw std::runtime_error("bad counter sum " + std::to_string(counters.sum(slot, 0)));
+  if (counters.max_of(slot, 1) != threads)
+    throw std::runtime_error("bad counter max " + std::to_string(counters.max_of(slot, 1)));
+  if (counters.get_num_blocks() > threads + 1)
+    throw std::runtime_error("blocks of exited threads not reused");
+
+  // Updates of exhausted slots are ignored
+  counters.add(thread_counters::no_slot, 0, 1);
+  if (counters.sum(thread_counters::no_slot, 0))
+    throw std::runtime_error("no_slot counted");
+
+  std::cout << "verify counters: ok\n";
+}
+
+static void
+verify_run_timer()
+{
+  static run_timer timer;
+  std::vector<int> runs(run_timer::capacity * 2);
+
+  for (size_t i = 0; i < runs.size(); ++i)
+    timer.start(&runs[i], i, i);
+
+  // Started runs beyond capacity are evicted, the others are found
+  // with their tag and start time
+  size_t found = 0;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    uint64_t tag = 0, start = 0;
+    if (timer.stop(&runs[i], tag, start)) {
+      if (tag != i || start != i)
+        throw std::runtime_error("bad run entry " + std::to_string(i));
+      ++found;
+    }
+  }
+  if (found > run_timer::capacity || found + timer.get_evictions() != runs.size())
+    throw std::runtime_error("bad run count " + std::to_string(found)
+                             + " evictions " + std::to_string(timer.get_evictions()));
+
+  // A restarted run replaces its start time, a stopped run is gone
+  uint64_t tag = 0, start = 0;
+  timer.start(&runs[0], 1, 10);
+  timer.start(&runs[0], 2, 20);
+  if (!timer.stop(&runs[0], tag, start) || tag != 2 || start != 20 || timer.stop(&runs[0], tag, start))
+    throw std::runtime_error("bad restarted run");
+
+  std::cout << "verify run timer: ok (" << found << " of " << runs.size() << " runs tracked)\n";
+}
+
+// Objects whose operations are logged
+struct logged_objects
+{
+  unsigned int dev_id;
+  const xrt_core::hwctx_handle* hwctx;
+  xrt::kernel kernel;
+};
+
+// Log buffers, syncs, and runs from threads through the hooks of a
+// logger, returns ns per operation
+static double
+log_operations(unsigned int threads, size_t operations, const logged_objects& objs, bool enabled)
+{
+  std::vector<std::thread> workers;
+  auto start = clk::now();
+  for (unsigned int t = 0; t < threads; ++t) {
+    workers.emplace_back([&objs, operations, enabled] {
+      // Like XRT objects, the logger is looked up once per thread
+      auto logger = enabled
+        ? xrt_core::usage_metrics::get_usage_metrics_logger()
+        : std::make_shared<base_logger>();
+      xrt::run run{objs.kernel};
+      auto kernel_impl = objs.kernel.get_handle().get();
+      auto run_impl = run.get_handle().get();
+      for (size_t i = 0; i < operations; ++i) {
+        logger->log_buffer_info_construct(objs.dev_id, 4096, objs.hwctx);
+        logger->log_buffer_sync(objs.dev_id, objs.hwctx, 4096, XCL_BO_SYNC_BO_TO_DEVICE);
+        logger->log_kernel_run_info(kernel_impl, run_impl, ERT_CMD_STATE_NEW);
+        logger->log_kernel_run_info(kernel_impl, run_impl, ERT_CMD_STATE_COMPLETED);
+      }
+    });
+  }
+  for (auto& w : workers)
+    w.join();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now() - start).count();
+  return static_cast<double>(elapsed) / static_cast<double>(operations);
+}
+
+// Operations per second of all threads, best of a few rounds
+static double
+ops_per_second(unsigned int threads, size_t operations, const logged_objects& objs, bool enabled)
+{
+  constexpr int rounds = 3;
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < rounds; ++i)
+    best = std::min(best, log_operations(threads, operations, objs, enabled));
+  return 1e9 * threads / best;
+}
+
+// Throughput with metrics relative to throughput without metrics must
+// not drop as threads are added.  Hooks that count in per thread
+// counters keep the ratio of a single thread, shared state that is
+// locked or written by all threads makes it drop with contention.
+static void
+verify_scaling(unsigned int max_threads, size_t operations, const logged_objects& objs)
+{
+  constexpr double max_loss = 0.10;
+  double base_ratio = 0;
+
+  std::vector<unsigned int> thread_counts;
+  for (unsigned int threads = 1; threads < max_threads; threads *= 2)
+    thread_counts.push_back(threads);
+  thread_counts.push_back(max_threads);
+
+  std::cout << "operations per thread: " << operations
+            << " (operations per second, an operation is a buffer, a sync, and a kernel run)\n";
+  for (auto threads : thread_counts) {
+    auto disabled = ops_per_second(threads, operations, objs, false);
+    auto enabled = ops_per_second(threads, operations, objs, true);
+    auto ratio = enabled / disabled;
+    std::cout << "threads: " << std::setw(3) << threads
+              << std::fixed << std::setprecision(0)
+              << " no metrics: " << std::setw(11) << disabled
+              << " metrics: " << std::setw(11) << enabled
+              << std::setprecision(3) << " (metrics / no metrics: " << ratio << ")\n";
+
+    if (threads == 1)
+      base_ratio = ratio;
+    else if (ratio < base_ratio * (1 - max_loss))
+      throw std::runtime_error("usage metrics do not scale with " + std::to_string(threads)
+                               + " threads, relative throughput " + std::to_string(ratio)
+                               + " vs " + std::to_string(base_ratio) + " with 1 thread");
+  }
+
+  std::cout << "verify scaling: ok\n";
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string xclbin;
+  std::string kernel_name = "hello";
+  unsigned int max_threads = std::max(2u, std::thread::hardware_concurrency());
+  size_t operations = 1000000;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    else if (args[i] == "-k")
+      xclbin = args[++i];
+    else if (args[i] == "--kernel")
+      kernel_name = args[++i];
+    else if (args[i] == "-t")
+      max_threads = std::stoul(args[++i]);
+    else if (args[i] == "-n")
+      operations = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (xclbin.empty())
+    throw std::runtime_error("-k <xclbin> is required");
+
+  if (max_threads < 2)
+    throw std::runtime_error("-t <max threads> must be at least 2 to measure scaling");
+
+  if (!operations)
+    throw std::runtime_error("-n <operations per thread> must be greater than 0");
+
+  verify_counters();
+  verify_run_timer();
+
+  // Objects are logged when constructed if metrics are enabled
+  xrt::ini::set("Runtime.usage_metrics_logging", "true");
+  xrt::device device{0};
+  auto uuid = device.register_xclbin(xrt::xclbin{xclbin});
+  xrt::hw_context hwctx{device, uuid};
+  logged_objects objs {
+    xrt_core::hw_context_int::get_core_device(hwctx)->get_device_id(),
+    static_cast<xrt_core::hwctx_handle*>(hwctx),
+    xrt::kernel{hwctx, kernel_name}
+  };
+  verify_scaling(max_threads, operations, objs);
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
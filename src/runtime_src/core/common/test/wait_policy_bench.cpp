@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit test and benchmark for hw queue wait strategies
+//
+// Verifies that the queues of two hw contexts start out with the
+// strategy of xrt.ini, that selecting a strategy for one context
+// applies to the queue of that context only, also when the contexts
+// share a queue implementation, and that block, spin and hybrid
+// waiting poll and time out as documented.  Reports the latency from
+// command completion to a spinning waiter returning.
+//
+// Without hardware the contexts are created on the noop shim.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % XCL_EMULATION_MODE=noop <path>/wait_policy_bench -k verify.xclbin [-n <samples>]
+
+#include "core/common/api/hw_context_int.h"
+#include "core/common/api/hw_queue.h"
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using clk = std::chrono::steady_clock;
+using wait_strategy = xrt_core::hw_queue::wait_strategy;
+using wait_policy = xrt_core::hw_queue::wait_policy;
+
+static void
+usage()
+{
+  std::cout << "usage: wait_policy_bench -k <xclbin> [-n <samples>]\n";
+}
+
+// Strategies of two contexts are independent, a strategy starts out
+// per xrt.ini, which is block unless the ini file of the run says
+// otherwise
+static void
+verify_contexts(const xrt::device& device, const xrt::uuid& uuid)
+{
+  xrt::hw_context ctx1{device, uuid};
+  xrt::hw_context ctx2{device, uuid};
+  xrt_core::hw_queue queue1{ctx1};
+  xrt_core::hw_queue queue2{ctx2};
+
+  auto ini_strategy = queue2.get_wait_strategy();
+  if (queue1.get_wait_strategy() != ini_strategy)
+    throw std::runtime_error("contexts start out with different strategies");
+
+  auto other = ini_strategy == wait_strategy::spin ? wait_strategy::hybrid : wait_strategy::spin;
+  xrt_core::hw_context_int::set_wait_strategy(ctx1, other, std::chrono::microseconds(10));
+
+  if (queue1.get_wait_strategy() != other)
+    throw std::runtime_error("strategy not selected for queue of context");
+  if (queue2.get_wait_strategy() != ini_strategy)
+    throw std::runtime_error("strategy of other context changed");
+
+  // A queue constructed later reports the strategy of its context
+  if (xrt_core::hw_queue{ctx1}.get_wait_strategy() != other
+      || xrt_core::hw_queue{ctx2}.get_wait_strategy() != ini_strategy)
+    throw std::runtime_error("new queue does not use strategy of its context");
+
+  std::cout << "verify contexts: ok\n";
+}
+
+static void
+verify_strategies()
+{
+  constexpr size_t polls = 1000;
+  size_t count = 0;
+  auto complete_after = [&count](size_t n) { return [&count, n] { return ++count >= n; }; };
+  auto never = [&count] { ++count; return false; };
+
+  // Blocking waits in the driver without polling
+  wait_policy block(wait_strategy::block, std::chrono::microseconds(0));
+  if (block.spin_wait(never, 0) || count)
+    throw std::runtime_error("block strategy polled");
+
+  // Spinning polls until completion, or times out
+  wait_policy spin(wait_strategy::spin, std::chrono::microseconds(0));
+  count = 0;
+  if (spin.spin_wait(complete_after(polls), 0) != std::cv_status::no_timeout || count != polls)
+    throw std::runtime_error("spin strategy did not poll to completion");
+
+  auto start = clk::now();
+  if (spin.spin_wait(never, 10) != std::cv_status::timeout || clk::now() - start < std::chrono::milliseconds(10))
+    throw std::runtime_error("spin strategy did not time out");
+
+  // Hybrid polls for the spin time, then the caller blocks
+  wait_policy hybrid(wait_strategy::hybrid, std::chrono::microseconds(1000));
+  count = 0;
+  if (hybrid.spin_wait(complete_after(polls), 0) != std::cv_status::no_timeout || count != polls)
+    throw std::runtime_error("hybrid strategy did not poll to completion");
+
+  start = clk::now();
+  if (hybrid.spin_wait(never, 0) || clk::now() - start < std::chrono::microseconds(1000))
+    throw std::runtime_error("hybrid strategy did not block after spin time");
+
+  // A strategy selected later applies to following waits
+  hybrid.set(wait_strategy::block, std::chrono::microseconds(0));
+  count = 0;
+  if (hybrid.spin_wait(never, 0) || count)
+    throw std::runtime_error("selected strategy not applied");
+
+  std::cout << "verify strategies: ok\n";
+}
+
+// Latency from completion in another thread to a spinning waiter
+// returning, median of samples in ns
+static double
+wake_latency(size_t samples)
+{
+  wait_policy spin(wait_strategy::spin, std::chrono::microseconds(0));
+  std::vector<double> latency;
+  for (size_t i = 0; i < samples; ++i) {
+    std::atomic<int64_t> completed {0};
+    std::thread completer([&completed] {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      completed = clk::now().time_since_epoch().count();
+    });
+    spin.spin_wait([&completed] { return completed.load() != 0; }, 0);
+    auto now = clk::now().time_since_epoch().count();
+    completer.join();
+    latency.push_back(static_cast<double>(now - completed.load()));
+  }
+
+  std::nth_element(latency.begin(), latency.begin() + latency.size() / 2, latency.end());
+  return latency[latency.size() / 2] * 1e9 * clk::period::num / clk::period::den;
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string xclbin;
+  size_t samples = 100;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    else if (args[i] == "-k")
+      xclbin = args[++i];
+    else if (args[i] == "-n")
+      samples = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (xclbin.empty())
+    throw std::runtime_error("-k <xclbin> is required");
+
+  if (!samples)
+    throw std::runtime_error("-n <samples> must be greater than 0");
+
+  xrt::device device{0};
+  auto uuid = device.register_xclbin(xrt::xclbin{xclbin});
+  verify_contexts(device, uuid);
+  verify_strategies();
+
+  std::cout << "spin wake latency: " << wake_latency(samples) << "ns (median of " << samples << ")\n";
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Benchmark for xclbin file loading
+//
+// Loads an xclbin file repeatedly and reports load time and resident
+// set size.  Compare mapped (default) and read loading with
+// Runtime.xclbin_mmap in xrt.ini.  With -g the benchmark first writes
+// a synthetic xclbin of the specified size in MB, one bitstream
+// section, to the xclbin path.
+//
+// % cmake -B build -DXILINX_XRT=<path> -DXRT_BUILD_BENCHMARKS=ON
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/xclbin_load -x <xclbin> [-g <MB>] [-i <iterations>] [-t]
+//
+// Mapped versus read loading of a 256 MB xclbin, with and without
+// touching all section data:
+//
+// % <path>/xclbin_load -x /tmp/bench.xclbin -g 256 -i 4
+// % <path>/xclbin_load -x /tmp/bench.xclbin -i 4 -t
+// % printf '[Runtime]\nxclbin_mmap=false\n' > /tmp/xrt.ini
+// % XRT_INI_PATH=/tmp/xrt.ini <path>/xclbin_load -x /tmp/bench.xclbin -i 4
+// % XRT_INI_PATH=/tmp/xrt.ini <path>/xclbin_load -x /tmp/bench.xclbin -i 4 -t
+
+#include "xrt/experimental/xrt_xclbin.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+static void
+usage()
+{
+  std::cout << "usage: xclbin_load -x <xclbin> [-g <MB>] [-i <iterations>] [-t]\n"
+            << "  -g write synthetic xclbin of <MB> size to <xclbin> before loading\n"
+            << "  -t touch all bytes of all sections after loading\n";
+}
+
+// Write an xclbin with one bitstream section of the specified size
+static void
+write_xclbin(const std::string& fnm, size_t mb)
+{
+  std::vector<char> section(mb * 1024 * 1024);
+  for (size_t i = 0; i < section.size(); ++i)
+    section[i] = static_cast<char>(i * 7);
+
+  axlf top {};
+  std::strncpy(top.m_magic, "xclbin2", sizeof(top.m_magic));
+  top.m_header.m_length = sizeof(axlf) + section.size();
+  top.m_header.m_mode = XCLBIN_FLAT;
+  top.m_header.m_numSections = 1;
+  top.m_sections[0].m_sectionKind = BITSTREAM;
+  std::strncpy(top.m_sections[0].m_sectionName, "bitstream", sizeof(top.m_sections[0].m_sectionName));
+  top.m_sections[0].m_sectionOffset = sizeof(axlf);
+  top.m_sections[0].m_sectionSize = section.size();
+
+  std::ofstream ofs(fnm, std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char*>(&top), sizeof(top));
+  ofs.write(section.data(), static_cast<std::streamsize>(section.size()));
+  if (!ofs)
+    throw std::runtime_error("Failed to write " + fnm);
+}
+
+// Resident set size in KB, 0 if not available
+static size_t
+get_rss_kb()
+{
+#ifndef _WIN32
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0, resident = 0;
+  if (statm >> size >> resident)
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+  return 0;
+}
+
+// Read all section data through the axlf header as done when
+// loading the xclbin to a device
+static unsigned int
+touch_sections(const xrt::xclbin& xclbin)
+{
+  unsigned int sum = 0;
+  auto top = xclbin.get_axlf();
+  auto base = reinterpret_cast<const unsigned char*>(top);
+  for (uint32_t idx = 0; idx < top->m_header.m_numSections; ++idx) {
+    const auto& hdr = top->m_sections[idx];
+    for (uint64_t i = 0; i < hdr.m_sectionSize; ++i)
+      sum += base[hdr.m_sectionOffset + i];
+  }
+  return sum;
+}
+
+void
+run(int argc, char* argv[])
+{
+  std::string xclbin_fnm;
+  size_t iterations = 10;
+  size_t generate_mb = 0;
+  bool touch = false;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (args[i] == "-t") {
+      touch = true;
+      continue;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-x")
+      xclbin_fnm = args[++i];
+    else if (args[i] == "-g")
+      generate_mb = std::stoul(args[++i]);
+    else if (args[i] == "-i")
+      iterations = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("-x <xclbin> must be specified");
+
+  if (!iterations)
+    throw std::runtime_error("-i <iterations> must be greater than 0");
+
+  if (generate_mb)
+    write_xclbin(xclbin_fnm, generate_mb);
+
+  auto rss_start = get_rss_kb();
+  std::vector<xrt::xclbin> xclbins;
+  unsigned int sum = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    xclbins.emplace_back(xclbin_fnm);
+    if (touch)
+      sum += touch_sections(xclbins.back());
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  auto rss = static_cast<long long>(get_rss_kb()) - static_cast<long long>(rss_start);
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  std::cout << "xclbin: " << xclbin_fnm << " (" << xclbins.front().get_axlf()->m_header.m_length << " bytes)\n"
+            << "iterations: " << iterations << (touch ? " (sections touched)" : "") << '\n'
+            << "us/load: " << static_cast<double>(us) / iterations << '\n'
+            << "rss increase (KB): " << rss
+            << " per xclbin (KB): " << rss / static_cast<long long>(iterations) << '\n';
+
+  if (touch)
+    std::cout << "checksum: " << sum << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
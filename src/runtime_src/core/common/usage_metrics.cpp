@@ -1,10 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2023-2026 Advanced Micro Devices, Inc. All rights reserved.
 #define XRT_API_SOURCE
 #define XCL_DRIVER_DLL_EXPORT
 #define XRT_CORE_COMMON_SOURCE
 #include "config_reader.h"
 #include "usage_metrics.h"
+#include "usage_metrics_counters.h"
 
 #include "core/common/api/hw_context_int.h"
 #include "core/common/api/kernel_int.h"
@@ -18,14 +19,19 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
-#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning ( disable : 4996 )
@@ -34,133 +40,202 @@
 namespace bpt = boost::property_tree;
 
 namespace {
-// global variables
-static std::mutex m;
-static std::atomic<uint32_t> thread_count {0};
 
-template <typename MetType, typename FindType>
-static MetType*
-get_metrics(std::vector<MetType>& metrics_vec, const FindType& finder)
+using xrt_core::usage_metrics::thread_counters;
+using xrt_core::usage_metrics::run_timer;
+
+// Counters of buffers in a thread_counters slot
+enum bo_counter : size_t {
+  bo_total_count,
+  bo_total_size,
+  bo_peak_size,             // max
+  bo_synced_to_device,
+  bo_synced_from_device
+};
+
+// Counters of a kernel in a thread_counters slot
+enum kernel_counter : size_t {
+  kernel_total_runs,
+  kernel_total_time_ns
+};
+
+inline uint64_t
+now_ns()
 {
-  auto it = std::find_if(metrics_vec.begin(), metrics_vec.end(), 
-                        [finder](const auto& met) 
-                        {
-                          return met.handle == finder;
-                        }
-                        );
-  return it == metrics_vec.end()
-    ? nullptr
-    : &(*it);
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
 }
 
-struct bo_metrics
+struct kernel_record
 {
-  uint32_t total_count = 0;
-  size_t   total_size_in_bytes = 0;
-  size_t   peak_size_in_bytes = 0;
-  size_t   bytes_synced_to_device = 0;
-  size_t   bytes_synced_from_device = 0;
+  std::string name;
+  size_t num_args = 0;
+  size_t slot = thread_counters::no_slot;
 };
 
-struct kernel_metrics
+struct hw_ctx_record
 {
-  using tp = std::chrono::time_point<std::chrono::high_resolution_clock>;
-  struct timestamp
-  {
-    tp start_time;
-    bool is_valid = false;
-  };
-
-  std::string handle; // kernel name is used as handle for identifying kernel
-  std::vector<uint32_t> cu_index_vec;
-  uint32_t total_runs = 0;
-  std::chrono::microseconds total_time = {};
-  std::unordered_map<const xrt::run_impl*, timestamp> exec_times; // run handle ptr is used for indexing
-  size_t num_args = 0;
+  const xrt_core::hwctx_handle* handle;  // using hw_ctx handle ptr as identifier for logging
+  xrt::uuid xclbin_uuid;
+  size_t bo_slot = thread_counters::no_slot;
+  std::vector<kernel_record> kernels;
+};
 
-  void
-  log_kernel_exec_time(const xrt::run_impl* run_hdl, const tp& tp_now, ert_cmd_state state)
+struct device_record
+{
+  std::string bdf;
+  size_t bo_slot = thread_counters::no_slot;          // global bos
+  std::vector<std::unique_ptr<hw_ctx_record>> hw_ctxs;
+
+  // Most recent context with handle, a handle can be reused after its
+  // context is destructed
+  hw_ctx_record*
+  find_hw_ctx(const xrt_core::hwctx_handle* handle) const
   {
-    // state ERT_CMD_STATE_NEW indicates kernel start is called
-    if (state == ERT_CMD_STATE_NEW) {
-      // record start everytime because previous run may be finished, timeout, aborted or stopped
-      exec_times[run_hdl].start_time = tp_now;
-      exec_times[run_hdl].is_valid = true;
-    }
-    else {
-      // make start time invalid so we can record for next run, add duration to total time and increment total runs
-      if (exec_times[run_hdl].is_valid && state == ERT_CMD_STATE_COMPLETED) {
-        // valid run increament run
-        total_runs++;
-        total_time += std::chrono::duration_cast<std::chrono::microseconds>(tp_now - exec_times[run_hdl].start_time);
-
-        // invalidate start time, run may be finished, aborted or timed out
-        exec_times[run_hdl].is_valid = false;
-      }
-    }
+    auto it = std::find_if(hw_ctxs.rbegin(), hw_ctxs.rend(),
+                           [handle](const auto& ctx) { return ctx->handle == handle; });
+    return it == hw_ctxs.rend() ? nullptr : it->get();
   }
 };
 
-struct hw_ctx_metrics
+// class registry - devices, hw contexts, and kernels that are logged
+//
+// Records are created when objects are constructed and are looked
+// up by hooks of frequent operations once per thread, see
+// thread_cache.  Counters of records are in thread_counters.
+class registry
 {
-  const xrt_core::hwctx_handle* handle;  // using hw_ctx handle ptr as unique identifier for logging
-  xrt::uuid xclbin_uuid;
-  bo_metrics bos_met;
-  std::vector<kernel_metrics> kernel_metrics_vec;
+public:
+  std::mutex m_mutex;
+  std::map<device_id, device_record> m_devices;
+
+  // Changed when devices or hw contexts are added, invalidates
+  // buffer lookups cached by threads
+  std::atomic<uint64_t> m_generation {0};
+
+  // Start times of runs of kernels, tagged with kernel slot
+  run_timer m_runs;
+
+  // Never destructed, metrics are reported during static destruction
+  static registry&
+  instance()
+  {
+    static auto reg = new registry;
+    return *reg;
+  }
+
+  device_record*
+  find_device(device_id dev_id)
+  {
+    auto it = m_devices.find(dev_id);
+    return it == m_devices.end() ? nullptr : &it->second;
+  }
 
   void
-  log_kernel(const std::string& name, size_t args)
+  bump_generation()
   {
-    kernel_metrics k;
-    k.handle = name;
-    k.num_args = args;
-    kernel_metrics_vec.emplace_back(k);
+    m_generation.fetch_add(1, std::memory_order_release);
   }
 };
 
-struct device_metrics
+// struct thread_cache - slots of records looked up by this thread
+//
+// Hooks of frequent operations identify records by device index,
+// hw context handle, or kernel implementation.  A thread resolves
+// these once under the registry lock.  Unknown objects are cached as
+// no_slot.  Buffer slots are dropped when devices or hw contexts are
+// added, which is also the case when a handle is reused by a new
+// object.  Kernel slots are tagged with the unique id of the kernel
+// and survive construction of other kernels, an entry for a reused
+// address is resolved again.
+struct thread_cache
 {
-  std::string bdf = "";
-  bo_metrics global_bos_met;
-  uint32_t bo_active_count = 0;
-  uint32_t bo_peak_count = 0;
-  std::vector<hw_ctx_metrics> hw_ctx_vec;
+  struct kernel_entry
+  {
+    uint32_t uid;
+    size_t slot;
+  };
 
-  void
-  log_hw_ctx(const xrt_core::hwctx_handle* handle, const xrt::uuid& uuid)
+  // Bound on cached kernels, entries of destructed kernels are not
+  // removed individually
+  static constexpr size_t kernel_slots_max = 1024;
+
+  uint64_t generation = std::numeric_limits<uint64_t>::max();
+  std::map<std::pair<device_id, const xrt_core::hwctx_handle*>, size_t> bo_slots;
+  std::unordered_map<const xrt::kernel_impl*, kernel_entry> kernel_slots;
+
+  static thread_cache&
+  get()
   {
-    hw_ctx_vec.emplace_back(hw_ctx_metrics{handle, uuid, {}, {}});
+    static thread_local thread_cache cache;
+    auto generation = registry::instance().m_generation.load(std::memory_order_acquire);
+    if (cache.generation != generation) {
+      cache.bo_slots.clear();
+      cache.generation = generation;
+    }
+    return cache;
   }
 };
 
-using metrics_map = std::map<std::thread::id, std::map<device_id, device_metrics>>;
-using device_metrics_map = std::map<device_id, device_metrics>;
-// Global map to store usage metrics of all threads
-static auto usage_metrics_map = std::make_shared<metrics_map>();
-
-// Helper functions to get metrics
-static device_metrics*
-get_device_metrics(device_metrics_map& dev_map, device_id dev_id)
+// Slot of buffers of hw context, or global buffers if no context
+static size_t
+get_bo_slot(device_id dev_id, const xrt_core::hwctx_handle* handle)
 {
-  auto map_it = dev_map.find(dev_id);
-  return map_it == dev_map.end()
-    ? nullptr
-    : &(*map_it).second;
+  auto& cache = thread_cache::get();
+  auto key = std::make_pair(dev_id, handle);
+  if (auto it = cache.bo_slots.find(key); it != cache.bo_slots.end())
+    return it->second;
+
+  auto slot = thread_counters::no_slot;
+  {
+    auto& reg = registry::instance();
+    std::lock_guard lk(reg.m_mutex);
+    if (auto dev = reg.find_device(dev_id)) {
+      if (!handle)
+        slot = dev->bo_slot;
+      else if (auto ctx = dev->find_hw_ctx(handle))
+        slot = ctx->bo_slot;
+    }
+  }
+  cache.bo_slots.emplace(key, slot);
+  return slot;
 }
 
-static bo_metrics*
-get_buffer_metrics(device_metrics* dev_metrics, const xrt_core::hwctx_handle* handle)
+// Slot of kernel of implementation
+static size_t
+get_kernel_slot(const xrt::kernel_impl* krnl_impl)
 {
-  if (!handle) {
-    // global bo
-    return &dev_metrics->global_bos_met;
+  auto& cache = thread_cache::get();
+  auto uid = xrt_core::kernel_int::get_uid(krnl_impl);
+  if (auto it = cache.kernel_slots.find(krnl_impl); it != cache.kernel_slots.end() && it->second.uid == uid)
+    return it->second.slot;
+
+  auto slot = thread_counters::no_slot;
+  try {
+    auto kernel = xrt_core::kernel_int::create_kernel_from_implementation(krnl_impl);
+    auto hw_ctx = xrt_core::kernel_int::get_hw_ctx(kernel);
+    auto hwctx_handle = static_cast<xrt_core::hwctx_handle*>(hw_ctx);
+    auto dev_id = xrt_core::hw_context_int::get_core_device(hw_ctx)->get_device_id();
+    auto name = kernel.get_name();
+
+    auto& reg = registry::instance();
+    std::lock_guard lk(reg.m_mutex);
+    if (auto dev = reg.find_device(dev_id)) {
+      if (auto ctx = dev->find_hw_ctx(hwctx_handle)) {
+        auto it = std::find_if(ctx->kernels.begin(), ctx->kernels.end(),
+                               [&name](const auto& k) { return k.name == name; });
+        if (it != ctx->kernels.end())
+          slot = it->slot;
+      }
+    }
   }
-  else {
-    auto hw_ctx_met = get_metrics(dev_metrics->hw_ctx_vec, handle);
-    if (hw_ctx_met != nullptr)
-      return &hw_ctx_met->bos_met;
+  catch (...) {
+    // dont log anything
   }
-  return nullptr;
+  if (cache.kernel_slots.size() >= thread_cache::kernel_slots_max)
+    cache.kernel_slots.clear();
+  cache.kernel_slots.insert_or_assign(krnl_impl, thread_cache::kernel_entry{uid, slot});
+  return slot;
 }
 
 // Helper functions to print usage metrics as json
@@ -191,36 +266,43 @@ print_json(const bpt::ptree& pt)
 }
 
 static bpt::ptree
-get_bos_ptree(const bo_metrics& bo_met)
+get_bos_ptree(size_t slot)
 {
+  auto& counters = thread_counters::instance();
+  auto total_count = counters.sum(slot, bo_total_count);
+  auto total_size = counters.sum(slot, bo_total_size);
+
   bpt::ptree bo_tree;
 
-  bo_tree.add("total_count", bo_met.total_count);
-  bo_tree.add("size", std::to_string(bo_met.total_size_in_bytes) + " bytes");
+  bo_tree.add("total_count", total_count);
+  bo_tree.add("size", std::to_string(total_size) + " bytes");
 
-  auto avg_size = (bo_met.total_count > 0) ? (bo_met.total_size_in_bytes / bo_met.total_count) : 0;
+  auto avg_size = (total_count > 0) ? (total_size / total_count) : 0;
   bo_tree.add("avg_size", std::to_string(avg_size) + " bytes");
 
-  bo_tree.add("peak_size", std::to_string(bo_met.peak_size_in_bytes) + " bytes");
-  bo_tree.add("bytes_synced_to_device", std::to_string(bo_met.bytes_synced_to_device) + " bytes");
-  bo_tree.add("bytes_synced_from_device", std::to_string(bo_met.bytes_synced_from_device) + " bytes");
+  bo_tree.add("peak_size", std::to_string(counters.max_of(slot, bo_peak_size)) + " bytes");
+  bo_tree.add("bytes_synced_to_device", std::to_string(counters.sum(slot, bo_synced_to_device)) + " bytes");
+  bo_tree.add("bytes_synced_from_device", std::to_string(counters.sum(slot, bo_synced_from_device)) + " bytes");
 
   return bo_tree;
 }
 
 static bpt::ptree
-get_kernels_ptree(const std::vector<kernel_metrics>& kernels_vec)
+get_kernels_ptree(const std::vector<kernel_record>& kernels)
 {
+  auto& counters = thread_counters::instance();
   bpt::ptree kernel_array;
 
-  for (const auto& kernel : kernels_vec) {
+  for (const auto& kernel : kernels) {
     bpt::ptree kernel_tree;
+    auto total_runs = counters.sum(kernel.slot, kernel_total_runs);
+    auto total_time_us = counters.sum(kernel.slot, kernel_total_time_ns) / 1000;
 
-    kernel_tree.put("name", kernel.handle);
+    kernel_tree.put("name", kernel.name);
     kernel_tree.put("num_of_args", kernel.num_args);
-    kernel_tree.put("num_total_runs", std::to_string(kernel.total_runs));
+    kernel_tree.put("num_total_runs", std::to_string(total_runs));
 
-    auto avg_run_time = (kernel.total_runs > 0) ? (kernel.total_time.count() / kernel.total_runs) : 0;
+    auto avg_run_time = (total_runs > 0) ? (total_time_us / total_runs) : 0;
     kernel_tree.put("avg_run_time", std::to_string(avg_run_time) + " us");
 
     kernel_array.push_back(std::make_pair("", kernel_tree));
@@ -230,21 +312,21 @@ get_kernels_ptree(const std::vector<kernel_metrics>& kernels_vec)
 }
 
 static bpt::ptree
-get_hw_ctx_ptree(const std::vector<hw_ctx_metrics>& hw_ctx_vec)
+get_hw_ctx_ptree(const std::vector<std::unique_ptr<hw_ctx_record>>& hw_ctxs)
 {
   bpt::ptree hw_ctx_array;
 
   uint32_t ctx_count = 0;
-  for (const auto& ctx : hw_ctx_vec) {
+  for (const auto& ctx : hw_ctxs) {
     bpt::ptree hw_ctx;
     hw_ctx.put("id", std::to_string(ctx_count));
-    hw_ctx.put("xclbin_uuid", ctx.xclbin_uuid.to_string());
+    hw_ctx.put("xclbin_uuid", ctx->xclbin_uuid.to_string());
 
     // add buffer info
-    hw_ctx.add_child("bos", get_bos_ptree(ctx.bos_met));
+    hw_ctx.add_child("bos", get_bos_ptree(ctx->bo_slot));
 
     // add kernel info
-    hw_ctx.add_child("kernels", get_kernels_ptree(ctx.kernel_metrics_vec));
+    hw_ctx.add_child("kernels", get_kernels_ptree(ctx->kernels));
 
     hw_ctx_array.push_back(std::make_pair("", hw_ctx));
     ctx_count++;
@@ -253,51 +335,67 @@ get_hw_ctx_ptree(const std::vector<hw_ctx_metrics>& hw_ctx_vec)
   return hw_ctx_array;
 }
 
+// Counters are summed over all threads without stopping them, the
+// report is consistent per counter
 static void
 print_usage_metrics()
 {
-  bpt::ptree thread_array;
-
-  uint32_t t_count = 0;
-  // iterate over all threads
-  for (const auto& [thread_id, dev_metrics_map] : *usage_metrics_map) {
-    bpt::ptree dev_array;
-    // iterate over all devices
-    for (const auto& [dev_id, dev_metrics] : dev_metrics_map) {
-      bpt::ptree dev;
-      dev.put("device_index", std::to_string(dev_id));
-      dev.put("bdf", dev_metrics.bdf);
-      dev.put("bos_peak_count", std::to_string(dev_metrics.bo_peak_count));
-
-      // add global bos
-      dev.add_child("global_bos", get_bos_ptree(dev_metrics.global_bos_met));
-
-      // add hw ctx info
-      dev.add_child("hw_context", get_hw_ctx_ptree(dev_metrics.hw_ctx_vec));
-
-      dev_array.push_back(std::make_pair("device", dev));
-    }
-
-    thread_array.add_child("thread " + std::to_string(t_count), dev_array);
-    t_count++;
+  auto& reg = registry::instance();
+  auto& counters = thread_counters::instance();
+  std::lock_guard lk(reg.m_mutex);
+
+  bpt::ptree dev_array;
+  // iterate over all devices
+  for (const auto& [dev_id, dev_metrics] : reg.m_devices) {
+    bpt::ptree dev;
+    dev.put("device_index", std::to_string(dev_id));
+    dev.put("bdf", dev_metrics.bdf);
+
+    // buffers are not yet logged on destruction, peak count is the
+    // count of all buffers created on the device
+    auto bo_count = counters.sum(dev_metrics.bo_slot, bo_total_count);
+    for (const auto& ctx : dev_metrics.hw_ctxs)
+      bo_count += counters.sum(ctx->bo_slot, bo_total_count);
+    dev.put("bos_peak_count", std::to_string(bo_count));
+
+    // add global bos
+    dev.add_child("global_bos", get_bos_ptree(dev_metrics.bo_slot));
+
+    // add hw ctx info
+    dev.add_child("hw_context", get_hw_ctx_ptree(dev_metrics.hw_ctxs));
+
+    dev_array.push_back(std::make_pair("", dev));
   }
 
-  print_json(thread_array);
+  bpt::ptree root;
+  root.put("num_threads", std::to_string(counters.get_num_blocks()));
+  root.put("untimed_runs", std::to_string(reg.m_runs.get_evictions()));
+  root.add_child("devices", dev_array);
+  print_json(root);
 }
 
+// Print usage metrics when the application exits
+struct report_at_exit
+{
+  ~report_at_exit()
+  {
+    try {
+      print_usage_metrics();
+    }
+    catch (const std::exception& e) {
+      std::cerr << " Failed to dump Usage metrics, exception occured - " << e.what() << std::endl;
+    }
+  }
+};
+
 // class usage_metrics_logger - class for logging usage metrics
 //
-// Logging objects are created per thread 
-//
-// This class collects metrics from all threads using XRT
-// The metrics are collected in a thread safe manner.
+// One logger object is shared by all threads.  Objects are logged
+// in the registry when constructed, frequent operations are counted
+// in counters of the calling thread without locking.
 class usage_metrics_logger : public xrt_core::usage_metrics::base_logger
 {
 public:
-  usage_metrics_logger();
-
-  ~usage_metrics_logger();
-
   void
   log_device_info(const xrt_core::device*) override;
 
@@ -318,54 +416,35 @@ public:
 
   void
   log_kernel_run_info(const xrt::kernel_impl*, const xrt::run_impl*, ert_cmd_state) override;
-
-private:
-  device_metrics_map m_dev_map;
-  std::shared_ptr<metrics_map> map_ptr;
 };
 
+void
 usage_metrics_logger::
-usage_metrics_logger() : map_ptr(usage_metrics_map)
-{
-  thread_count++;
-}
-
-usage_metrics_logger::
-~usage_metrics_logger()
+log_device_info(const xrt_core::device* dev)
 {
-  thread_count--;
+  auto dev_id = dev->get_device_id();
+  auto& reg = registry::instance();
   {
-    std::lock_guard<std::mutex> lk(m);
-    // push this threads usage metrics to global map
-    // in thread safe manner
-    (*map_ptr)[std::this_thread::get_id()] = std::move(m_dev_map);
+    std::lock_guard lk(reg.m_mutex);
+    if (reg.find_device(dev_id))
+      return;
   }
 
-  if (thread_count == 0) {
-    // print usage metrics log after all threads are destroyed
-    try {
-      print_usage_metrics();
-    }
-    catch (const std::exception& e) {
-      std::cerr << " Failed to dump Usage metrics, exception occured - " << e.what() << std::endl;
-    }
+  std::string bdf;
+  try {
+    bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(dev));
   }
-}
+  catch (...) {}
 
-void
-usage_metrics_logger::
-log_device_info(const xrt_core::device* dev)
-{
-  auto dev_id = dev->get_device_id();
-  if (!get_device_metrics(m_dev_map, dev_id)) {
-    // initialize map with this device index
-    m_dev_map[dev_id] = {};
-    try {
-      auto bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(dev));
-      m_dev_map[dev_id].bdf = std::move(bdf);
-    }   
-    catch (...) {}
-  }
+  std::lock_guard lk(reg.m_mutex);
+  if (reg.find_device(dev_id))
+    return;
+
+  // initialize map with this device index
+  auto& dev_metrics = reg.m_devices[dev_id];
+  dev_metrics.bdf = std::move(bdf);
+  dev_metrics.bo_slot = thread_counters::instance().allocate();
+  reg.bump_generation();
 }
 
 void 
@@ -380,14 +459,22 @@ log_hw_ctx_info(const xrt::hw_context_impl* hwctx_impl)
     auto dev_id = xrt_core::hw_context_int::get_core_device(hw_ctx)->get_device_id();
     auto uuid = hw_ctx.get_xclbin_uuid();
 
+    auto& reg = registry::instance();
+    std::lock_guard lk(reg.m_mutex);
+
     // dont log if device didn't match
-    auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
+    auto dev_metrics = reg.find_device(dev_id);
     if (!dev_metrics)
       return;
 
-    // log if this entry is not logged before
-    if (!get_metrics(dev_metrics->hw_ctx_vec, hwctx_handle))
-      dev_metrics->log_hw_ctx(hwctx_handle, uuid);
+    // Each context is logged, a handle that matches a logged context
+    // belongs to a new context that reuses the handle
+    auto ctx = std::make_unique<hw_ctx_record>();
+    ctx->handle = hwctx_handle;
+    ctx->xclbin_uuid = uuid;
+    ctx->bo_slot = thread_counters::instance().allocate();
+    dev_metrics->hw_ctxs.push_back(std::move(ctx));
+    reg.bump_generation();
   }
   catch(...) {
     // dont log anything
@@ -398,22 +485,15 @@ void
 usage_metrics_logger::
 log_buffer_info_construct(device_id dev_id, size_t sz, const xrt_core::hwctx_handle* handle)
 {
-  auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-  if (!dev_metrics)
-    return;
-
-  bo_metrics* bo_met = get_buffer_metrics(dev_metrics, handle);
+  auto slot = get_bo_slot(dev_id, handle);
   // don't log if bo not found
-  if (!bo_met)
+  if (slot == thread_counters::no_slot)
     return;
 
-  bo_met->total_count++;
-  bo_met->total_size_in_bytes += sz;
-  bo_met->peak_size_in_bytes = std::max(bo_met->peak_size_in_bytes, sz);
-  // increase active count in case of global or ctx bound bo
-  dev_metrics->bo_active_count++;
-  dev_metrics->bo_peak_count = 
-      std::max(dev_metrics->bo_peak_count, dev_metrics->bo_active_count);
+  auto& counters = thread_counters::instance();
+  counters.add(slot, bo_total_count, 1);
+  counters.add(slot, bo_total_size, sz);
+  counters.max(slot, bo_peak_size, sz);
 }
 
 void
@@ -429,19 +509,12 @@ void
 usage_metrics_logger::
 log_buffer_sync(device_id dev_id, const xrt_core::hwctx_handle* handle, size_t sz, xclBOSyncDirection dir)
 {
-  auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-  if (!dev_metrics)
-    return;
-
-  bo_metrics* bo_met = get_buffer_metrics(dev_metrics, handle);
+  auto slot = get_bo_slot(dev_id, handle);
   // don't log if bo not found
-  if (!bo_met)
+  if (slot == thread_counters::no_slot)
     return;
 
-  if (dir == XCL_BO_SYNC_BO_TO_DEVICE)
-    bo_met->bytes_synced_to_device += sz;
-  else
-    bo_met->bytes_synced_from_device += sz;
+  thread_counters::instance().add(slot, dir == XCL_BO_SYNC_BO_TO_DEVICE ? bo_synced_to_device : bo_synced_from_device, sz);
 }
 
 void
@@ -451,19 +524,21 @@ log_kernel_info(const xrt_core::device* dev, const xrt::hw_context& ctx, const s
   auto dev_id = dev->get_device_id();
   auto hwctx_handle = static_cast<xrt_core::hwctx_handle*>(ctx);
 
-  auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
+  auto& reg = registry::instance();
+  std::lock_guard lk(reg.m_mutex);
+  auto dev_metrics = reg.find_device(dev_id);
   if (!dev_metrics)
     return;
 
-  auto hw_ctx_met = get_metrics(dev_metrics->hw_ctx_vec, hwctx_handle);
+  auto hw_ctx_met = dev_metrics->find_hw_ctx(hwctx_handle);
   // dont log if hw ctx didn't match existing ones
   if (!hw_ctx_met)
     return;
   
   // log if this entry is not logged before
-  if (!get_metrics(hw_ctx_met->kernel_metrics_vec, name)) {
-    hw_ctx_met->log_kernel(name, args);
-  }
+  auto& kernels = hw_ctx_met->kernels;
+  if (std::none_of(kernels.begin(), kernels.end(), [&name](const auto& k) { return k.name == name; }))
+    kernels.push_back(kernel_record{name, args, thread_counters::instance().allocate()});
 }
 
 void
@@ -471,43 +546,44 @@ usage_metrics_logger::
 log_kernel_run_info(const xrt::kernel_impl* krnl_impl, const xrt::run_impl* run_hdl, ert_cmd_state state)
 {
   // collecting time at start of call as next calls will be overhead
-  auto ts_now = std::chrono::high_resolution_clock::now();
-  try {
-    auto kernel =
-        xrt_core::kernel_int::create_kernel_from_implementation(krnl_impl);
+  auto ts_now = now_ns();
 
-    auto hw_ctx = xrt_core::kernel_int::get_hw_ctx(kernel);
-    auto hwctx_handle = static_cast<xrt_core::hwctx_handle*>(hw_ctx);
+  auto& runs = registry::instance().m_runs;
 
-    auto dev_id = xrt_core::hw_context_int::get_core_device(hw_ctx)->get_device_id();
-    auto name = kernel.get_name();
+  // state ERT_CMD_STATE_NEW indicates kernel start is called
+  if (state == ERT_CMD_STATE_NEW) {
+    auto slot = get_kernel_slot(krnl_impl);
+    if (slot != thread_counters::no_slot)
+      // record start everytime because previous run may be finished, timeout, aborted or stopped
+      runs.start(run_hdl, slot, ts_now);
+    return;
+  }
 
-    auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-    if (!dev_metrics)
-      return;
+  // run may still be running after a wait that timed out
+  if (state < ERT_CMD_STATE_COMPLETED)
+    return;
 
-    auto hw_ctx_met = get_metrics(dev_metrics->hw_ctx_vec, hwctx_handle);
-    // dont log if hw ctx didn't match existing ones
-    if (!hw_ctx_met)
-      return;
-  
-    auto kernel_met = get_metrics(hw_ctx_met->kernel_metrics_vec, name);
-    if (!kernel_met)
-      return;
+  // remove start time, the run may be finished, aborted or timed out
+  uint64_t slot = 0;
+  uint64_t start_ns = 0;
+  if (!runs.stop(run_hdl, slot, start_ns) || state != ERT_CMD_STATE_COMPLETED)
+    return;
 
-    kernel_met->log_kernel_exec_time(run_hdl, ts_now, state);
-  }
-  catch(...) {
-    // dont log anything
-  }
+  // valid run increment run
+  auto& counters = thread_counters::instance();
+  counters.add(slot, kernel_total_runs, 1);
+  counters.add(slot, kernel_total_time_ns, ts_now - start_ns);
 }
 
 // Create specific logger if ini option is enabled
 static std::shared_ptr<xrt_core::usage_metrics::base_logger>
 get_logger_object()
 {
-  if (xrt_core::config::get_usage_metrics_logging())
-    return std::make_shared<usage_metrics_logger>();
+  if (xrt_core::config::get_usage_metrics_logging()) {
+    static report_at_exit report;
+    static auto logger = std::make_shared<usage_metrics_logger>();
+    return logger;
+  }
 
   return std::make_shared<xrt_core::usage_metrics::base_logger>();
 }
@@ -515,7 +591,7 @@ get_logger_object()
 } // namespace
 
 namespace xrt_core::usage_metrics {
-// Per thread logger object  
+// Per thread reference to logger object
 std::shared_ptr<base_logger>
 get_usage_metrics_logger()
 {
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2023-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_CORE_USAGE_METRICS_H
 #define XRT_CORE_USAGE_METRICS_H
 
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <string>
 
+#include "core/common/config.h"
 #include "core/include/xrt.h"
 #include "core/include/xrt/xrt_hw_context.h"
 #include "core/include/xrt/xrt_kernel.h"
@@ -65,11 +66,13 @@ public:
 
 // get_usage_metrics_logger() - Return logger object for current thread
 //
-// Creates the logger object as thread local object.
+// The logger object is shared by all threads and is cached as a
+// thread local reference.  Logging is safe from any thread.
 // It is undefined behavior to delete the returned object.
 //
 // Access to underlying logger object is to facilitate caching
 // to avoid repeated calls to get_usage_metrics_logger() where applicable.
+XRT_CORE_COMMON_EXPORT
 std::shared_ptr<base_logger>
 get_usage_metrics_logger();
 
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as core_common
+#include "usage_metrics_counters.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace xrt_core::usage_metrics {
+
+using counter_type = std::atomic<uint64_t>;
+
+struct chunk
+{
+  std::array<std::array<counter_type, thread_counters::counters_per_slot>, thread_counters::slots_per_chunk> slots {};
+};
+
+struct thread_counters::block
+{
+  std::array<std::atomic<chunk*>, max_chunks> chunks {};
+  block* next = nullptr;  // immutable once block is published
+};
+
+// Thread local owner of a counter block, returns the block for reuse
+// when the thread exits
+struct block_owner
+{
+  thread_counters::block* blk = nullptr;
+
+  ~block_owner()
+  {
+    if (blk)
+      thread_counters::instance().release_block(blk);
+  }
+};
+
+thread_counters&
+thread_counters::
+instance()
+{
+  // Never destructed, counters are reported during static destruction
+  // and can be updated by threads that exit after that
+  static auto counters = new thread_counters;
+  return *counters;
+}
+
+size_t
+thread_counters::
+allocate()
+{
+  auto slot = m_next_slot.fetch_add(1, std::memory_order_relaxed);
+  return slot < max_slots ? slot : no_slot;
+}
+
+thread_counters::block*
+thread_counters::
+acquire_block()
+{
+  std::lock_guard lk(m_free_mutex);
+  if (!m_free.empty()) {
+    auto blk = m_free.back();
+    m_free.pop_back();
+    return blk;
+  }
+
+  // Publish the new block to readers, blocks are never removed
+  auto blk = new block;
+  blk->next = m_blocks.load(std::memory_order_relaxed);
+  m_blocks.store(blk, std::memory_order_release);
+  m_num_blocks.fetch_add(1, std::memory_order_relaxed);
+  return blk;
+}
+
+void
+thread_counters::
+release_block(block* blk)
+{
+  std::lock_guard lk(m_free_mutex);
+  m_free.push_back(blk);
+}
+
+counter_type*
+thread_counters::
+get_counter(size_t slot, size_t idx)
+{
+  if (slot >= max_slots || idx >= counters_per_slot)
+    return nullptr;
+
+  static thread_local block_owner owner;
+  if (!owner.blk)
+    owner.blk = acquire_block();
+
+  auto& chk = owner.blk->chunks[slot / slots_per_chunk];
+  auto ptr = chk.load(std::memory_order_relaxed);
+  if (!ptr) {
+    ptr = new chunk;
+    chk.store(ptr, std::memory_order_release);
+  }
+  return &ptr->slots[slot % slots_per_chunk][idx];
+}
+
+void
+thread_counters::
+add(size_t slot, size_t idx, uint64_t value)
+{
+  // Single writer, no read-modify-write needed
+  if (auto ctr = get_counter(slot, idx))
+    ctr->store(ctr->load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void
+thread_counters::
+max(size_t slot, size_t idx, uint64_t value)
+{
+  if (auto ctr = get_counter(slot, idx)) {
+    if (value > ctr->load(std::memory_order_relaxed))
+      ctr->store(value, std::memory_order_relaxed);
+  }
+}
+
+template <typename Op>
+void
+thread_counters::
+for_each_counter(size_t slot, size_t idx, Op op) const
+{
+  if (slot >= max_slots || idx >= counters_per_slot)
+    return;
+
+  for (auto blk = m_blocks.load(std::memory_order_acquire); blk; blk = blk->next) {
+    if (auto ptr = blk->chunks[slot / slots_per_chunk].load(std::memory_order_acquire))
+      op(ptr->slots[slot % slots_per_chunk][idx].load(std::memory_order_relaxed));
+  }
+}
+
+uint64_t
+thread_counters::
+sum(size_t slot, size_t idx) const
+{
+  uint64_t value = 0;
+  for_each_counter(slot, idx, [&value](uint64_t v) { value += v; });
+  return value;
+}
+
+uint64_t
+thread_counters::
+max_of(size_t slot, size_t idx) const
+{
+  uint64_t value = 0;
+  for_each_counter(slot, idx, [&value](uint64_t v) { value = std::max(value, v); });
+  return value;
+}
+
+size_t
+thread_counters::
+get_num_blocks() const
+{
+  return m_num_blocks.load(std::memory_order_relaxed);
+}
+
+size_t
+run_timer::
+hash(const void* run)
+{
+  // Fibonacci hashing of the object address
+  auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(run)) >> 4;
+  return static_cast<size_t>((key * 0x9e3779b97f4a7c15ull) >> 40);
+}
+
+void
+run_timer::
+start(const void* run, uint64_t tag, uint64_t start_ns)
+{
+  auto key = reinterpret_cast<uintptr_t>(run);
+  auto base = hash(run);
+
+  auto publish = [&](entry& e) {
+    e.tag.store(tag, std::memory_order_relaxed);
+    e.start_ns.store(start_ns, std::memory_order_relaxed);
+    e.key.store(key, std::memory_order_release);
+  };
+
+  // Run started again without being waited on
+  for (size_t i = 0; i < window; ++i) {
+    auto& e = at(base, i);
+    auto expected = key;
+    if (e.key.load(std::memory_order_relaxed) == key
+        && e.key.compare_exchange_strong(expected, reserved, std::memory_order_acquire)) {
+      publish(e);
+      return;
+    }
+  }
+
+  for (size_t i = 0; i < window; ++i) {
+    auto& e = at(base, i);
+    uintptr_t expected = 0;
+    if (e.key.load(std::memory_order_relaxed) == 0
+        && e.key.compare_exchange_strong(expected, reserved, std::memory_order_acquire)) {
+      publish(e);
+      return;
+    }
+  }
+
+  // Window is full, evict the oldest run
+  entry* oldest = nullptr;
+  auto oldest_key = reserved;
+  auto oldest_ns = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < window; ++i) {
+    auto& e = at(base, i);
+    auto k = e.key.load(std::memory_order_relaxed);
+    auto ns = e.start_ns.load(std::memory_order_relaxed);
+    if (k > reserved && ns < oldest_ns) {
+      oldest = &e;
+      oldest_key = k;
+      oldest_ns = ns;
+    }
+  }
+
+  m_evictions.fetch_add(1, std::memory_order_relaxed);
+  if (oldest && oldest->key.compare_exchange_strong(oldest_key, reserved, std::memory_order_acquire))
+    publish(*oldest);
+}
+
+bool
+run_timer::
+stop(const void* run, uint64_t& tag, uint64_t& start_ns)
+{
+  auto key = reinterpret_cast<uintptr_t>(run);
+  auto base = hash(run);
+  for (size_t i = 0; i < window; ++i) {
+    auto& e = at(base, i);
+    auto expected = key;
+    if (e.key.load(std::memory_order_relaxed) == key
+        && e.key.compare_exchange_strong(expected, reserved, std::memory_order_acquire)) {
+      tag = e.tag.load(std::memory_order_relaxed);
+      start_ns = e.start_ns.load(std::memory_order_relaxed);
+      e.key.store(0, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+} // xrt_core::usage_metrics
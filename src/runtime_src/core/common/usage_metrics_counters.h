@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_USAGE_METRICS_COUNTERS_H
+#define XRT_CORE_USAGE_METRICS_COUNTERS_H
+
+#include "core/common/config.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Lock-free building blocks of the usage metrics logger
+//
+// Logging hooks are called from any thread on any object, counting
+// must not serialize threads.  Counters are kept in blocks owned by
+// one thread each and are summed when the metrics are reported.
+////////////////////////////////////////////////////////////////
+namespace xrt_core::usage_metrics {
+
+// class thread_counters - per thread counter blocks
+//
+// A slot is a group of counters allocated once per logged object,
+// e.g. buffers of a hw context or a kernel.  Each thread updates
+// its own copy of a slot, which is a plain load and store of a
+// counter no other thread writes.
+//
+// A thread registers a block on first update.  Blocks of exited
+// threads keep their counts and are reused by new threads, so memory
+// is bounded by the max number of concurrent threads.
+class thread_counters
+{
+public:
+  static constexpr size_t counters_per_slot = 6;
+  static constexpr size_t slots_per_chunk = 64;
+  static constexpr size_t max_chunks = 1024;
+  static constexpr size_t max_slots = slots_per_chunk * max_chunks;
+
+  // Value returned by allocate when slots are exhausted, updates of
+  // this slot are ignored
+  static constexpr size_t no_slot = max_slots;
+
+  // Process wide instance, never destructed
+  XRT_CORE_COMMON_EXPORT
+  static thread_counters&
+  instance();
+
+  XRT_CORE_COMMON_EXPORT
+  size_t
+  allocate();
+
+  // Add value to counter of calling thread
+  XRT_CORE_COMMON_EXPORT
+  void
+  add(size_t slot, size_t idx, uint64_t value);
+
+  // Raise counter of calling thread to value
+  XRT_CORE_COMMON_EXPORT
+  void
+  max(size_t slot, size_t idx, uint64_t value);
+
+  // Sum of counter over all threads
+  XRT_CORE_COMMON_EXPORT
+  uint64_t
+  sum(size_t slot, size_t idx) const;
+
+  // Max of counter over all threads
+  XRT_CORE_COMMON_EXPORT
+  uint64_t
+  max_of(size_t slot, size_t idx) const;
+
+  // Number of counter blocks, the max number of threads that
+  // updated counters concurrently
+  XRT_CORE_COMMON_EXPORT
+  size_t
+  get_num_blocks() const;
+
+  struct block;
+
+private:
+  thread_counters() = default;
+
+  std::atomic<uint64_t>*
+  get_counter(size_t slot, size_t idx);
+
+  template <typename Op>
+  void
+  for_each_counter(size_t slot, size_t idx, Op op) const;
+
+  friend struct block_owner;
+
+  block*
+  acquire_block();
+
+  void
+  release_block(block* blk);
+
+  std::atomic<size_t> m_next_slot {0};
+  std::atomic<block*> m_blocks {nullptr};  // all blocks, push only
+  std::atomic<size_t> m_num_blocks {0};
+  std::mutex m_free_mutex;
+  std::vector<block*> m_free;               // blocks of exited threads
+};
+
+// class run_timer - bounded table of start times of running commands
+//
+// Start and completion of a run are often logged by different
+// threads.  Runs are hashed to a window of entries in a fixed size
+// table.  If all entries of the window are used, the oldest entry is
+// evicted, the run of an evicted entry is not timed.  A run that is
+// never waited on occupies its entry until it is evicted or until
+// the run object is started again.
+class run_timer
+{
+public:
+  static constexpr size_t capacity = 2048;
+  static constexpr size_t window = 8;
+
+  // Record start time of run and a tag identifying what it runs
+  XRT_CORE_COMMON_EXPORT
+  void
+  start(const void* run, uint64_t tag, uint64_t start_ns);
+
+  // Remove run from table, returns false if run is not found
+  XRT_CORE_COMMON_EXPORT
+  bool
+  stop(const void* run, uint64_t& tag, uint64_t& start_ns);
+
+  // Number of runs evicted or dropped because the window was full
+  uint64_t
+  get_evictions() const
+  {
+    return m_evictions.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Key of an entry being written
+  static constexpr uintptr_t reserved = 1;
+
+  struct alignas(64) entry
+  {
+    std::atomic<uintptr_t> key {0};
+    std::atomic<uint64_t> tag {0};
+    std::atomic<uint64_t> start_ns {0};
+  };
+
+  static size_t
+  hash(const void* run);
+
+  entry&
+  at(size_t base, size_t i)
+  {
+    return m_entries[(base + i) & (capacity - 1)];
+  }
+
+  std::array<entry, capacity> m_entries;
+  std::atomic<uint64_t> m_evictions {0};
+};
+
+} // xrt_core::usage_metrics
+
+#endif
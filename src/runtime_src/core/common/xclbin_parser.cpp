@@ -19,8 +19,13 @@
 #include "error.h"
 
 #include <algorithm>
+#include <exception>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <sstream>
+#include <string_view>
 #include <cstring>
 #include <cstdlib>
 #include <boost/property_tree/ptree.hpp>
@@ -387,6 +392,278 @@ merge_args(std::vector<xrt_core::xclbin::kernel_argument>& args)
       throw std::runtime_error("xclbin parser internal error: mismatched argument index");
 }
 
+} // namespace
+
+namespace xrt_core { namespace xclbin {
+
+// class xml_index - Kernel meta data extracted from one pass over the
+// EMBEDDED_METADATA xml.
+//
+// Parsing the xml with boost property_tree is expensive and meta
+// data queries are made per kernel and from several places when an
+// xclbin is loaded.  The index is built once per xclbin by
+// xrt::xclbin, queries are served from the index.
+//
+// Malformed meta data of a kernel does not fail the index.  The
+// parse error is recorded and rethrown by queries that need the
+// malformed data, other queries are served as usual.
+class xml_index
+{
+public:
+  struct kernel_entry
+  {
+    xrt_core::xclbin::kernel_properties properties;
+    std::vector<xrt_core::xclbin::kernel_argument> args;
+    std::exception_ptr properties_error;
+    std::exception_ptr args_error;
+  };
+
+  std::string project_name;                // <project name="foo">
+  std::string fpga_device_name;            // <device fpgaDevice="foo">
+  std::vector<kernel_entry> kernels;       // in meta data order
+  std::map<std::string, size_t> kernel_idx;  // kernel name to index in kernels
+  std::exception_ptr kernels_error;        // kernel without name, if any
+  std::vector<uint64_t> cus;               // sorted addrRemap base addresses
+  std::exception_ptr cus_error;            // invalid addrRemap, if any
+  size_t max_cu_size = 0;                  // max register map size of CUs
+  std::string max_cu_size_error;           // invalid arg offset, if any
+
+  xml_index(const char* xml_data, size_t xml_size)
+  {
+    pt::ptree xml_project;
+    std::stringstream xml_stream;
+    xml_stream.write(xml_data, xml_size);
+    pt::read_xml(xml_stream, xml_project);
+
+    project_name = xml_project.get<std::string>("project.<xmlattr>.name", "");
+    fpga_device_name = xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice", "");
+
+    for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
+      if (xml_kernel.first != "kernel")
+        continue;
+
+      try {
+        add_cus(xml_kernel.second);
+      }
+      catch (...) {
+        if (!cus_error)
+          cus_error = std::current_exception();
+      }
+
+      std::string kname;
+      try {
+        kname = xml_kernel.second.get<std::string>("<xmlattr>.name");
+      }
+      catch (...) {
+        if (!kernels_error)
+          kernels_error = std::current_exception();
+        continue;
+      }
+
+      kernel_entry kernel;
+      kernel.properties.name = kname;
+      try {
+        kernel.properties = get_properties(xml_kernel.second, kname);
+      }
+      catch (...) {
+        kernel.properties_error = std::current_exception();
+      }
+
+      try {
+        kernel.args = get_args(xml_kernel.second);
+      }
+      catch (...) {
+        kernel.args_error = std::current_exception();
+      }
+
+      kernel_idx.emplace(kname, kernels.size());
+      kernels.push_back(std::move(kernel));
+    }
+
+    std::sort(cus.begin(), cus.end());
+  }
+
+  const kernel_entry*
+  get_kernel(const std::string& kname) const
+  {
+    auto itr = kernel_idx.find(kname);
+    return (itr != kernel_idx.end()) ? &kernels[(*itr).second] : nullptr;
+  }
+
+  // Throw parse error of any kernel, for queries of all kernels
+  void
+  all_kernels_or_error() const
+  {
+    if (kernels_error)
+      std::rethrow_exception(kernels_error);
+
+    for (const auto& kernel : kernels) {
+      if (kernel.properties_error)
+        std::rethrow_exception(kernel.properties_error);
+      if (kernel.args_error)
+        std::rethrow_exception(kernel.args_error);
+    }
+  }
+
+private:
+  static xrt_core::xclbin::kernel_properties
+  get_properties(const pt::ptree& xml_kernel, const std::string& kname)
+  {
+    // Determine features
+    auto mailbox = convert_to_mailbox_type(xml_kernel.get<std::string>("<xmlattr>.mailbox", "none"));
+    if (mailbox == xrt_core::xclbin::kernel_properties::mailbox_type::none)
+      mailbox = get_mailbox_from_ini(kname);
+    auto restart = convert(xml_kernel.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
+    if (restart == 0)
+      restart = get_restart_from_ini(kname);
+    auto sw_reset = to_bool(xml_kernel.get<std::string>("<xmlattr>.swReset", "false"));
+    if (!sw_reset)
+      sw_reset = get_sw_reset_from_ini(kname);
+
+    auto functional = get_functional(xml_kernel, "extended-data");
+    auto kernel_id = get_kernel_id(xml_kernel, "extended-data");
+
+    return xrt_core::xclbin::kernel_properties
+      { kname
+      , to_kernel_type(xml_kernel.get<std::string>("<xmlattr>.type", "pl"))
+      , restart
+      , mailbox
+      , get_address_range(xml_kernel)
+      , sw_reset
+      , functional
+      , kernel_id
+
+      , convert(xml_kernel.get<std::string>("<xmlattr>.workGroupSize", "0"))
+      , get_xyz(xml_kernel, "compileWorkGroupSize")
+      , get_xyz(xml_kernel, "maxWorkGroupSize")
+      , get_stringtable(xml_kernel) };
+  }
+
+  // Arguments of kernel.  Also validates argument offsets against
+  // the kernel address range and computes max CU size.
+  std::vector<xrt_core::xclbin::kernel_argument>
+  get_args(const pt::ptree& xml_kernel)
+  {
+    using kernel_argument = xrt_core::xclbin::kernel_argument;
+    std::vector<kernel_argument> args;
+
+    auto pwmap = get_portname_width_map(xml_kernel);
+    auto address_range = get_address_range(xml_kernel);
+
+    for (auto& xml_arg : xml_kernel) {
+      if (xml_arg.first != "arg")
+        continue;
+
+      std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
+      size_t index = id.empty() ? kernel_argument::no_index : convert(id);
+
+      std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
+      auto itr = pwmap.find(port);
+      size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
+
+      auto ofs = convert(xml_arg.second.get<std::string>("<xmlattr>.offset"));
+      auto sz = convert(xml_arg.second.get<std::string>("<xmlattr>.size"));
+
+      if (ofs + sz > address_range && max_cu_size_error.empty()) {
+        auto fmt = boost::format
+          ("Invalid kernel offset in xclbin for kernel (%s) argument (%s).\n"
+           "The offset (0x%x) and size (0x%x) exceeds kernel address range (0x%x)")
+          % xml_kernel.get<std::string>("<xmlattr>.name")
+          % xml_arg.second.get<std::string>("<xmlattr>.name")
+          % ofs % sz % address_range;
+        max_cu_size_error = fmt.str();
+      }
+      max_cu_size = std::max(max_cu_size, ofs + sz);
+
+      args.emplace_back(kernel_argument{
+          xml_arg.second.get<std::string>("<xmlattr>.name")
+         ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
+         ,std::move(port)
+         ,pwidth
+         ,index
+         ,ofs
+         ,sz
+         ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
+         ,0  // fa_desc_offset post computed if necessary
+         ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
+         ,kernel_argument::direction(kernel_argument::direction::input)
+      });
+    }
+
+    // stable sort to preserve order of multi-component arguments
+    // for example global_size, local_size, etc.
+    std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
+
+    // merge args with same index
+    merge_args(args);
+
+    return args;
+  }
+
+  // Extract CU base addresses of kernel instances.  Used in sw_emu
+  // because IP_LAYOUT section is not available in sw emu.
+  void
+  add_cus(const pt::ptree& xml_kernel)
+  {
+    for (auto& xml_inst : xml_kernel) {
+      if (xml_inst.first != "instance")
+        continue;
+      for (auto& xml_remap : xml_inst.second) {
+        if (xml_remap.first != "addrRemap")
+          continue;
+        cus.push_back(convert(xml_remap.second.get<std::string>("<xmlattr>.base")));
+      }
+    }
+  }
+};
+
+}} // xclbin, xrt_core
+
+namespace {
+
+using xrt_core::xclbin::xml_index;
+
+// Get the cached index for xml meta data, create the index if
+// necessary.  Used by queries that have only the xml and not the
+// xclbin, queries of a loaded xclbin use the index of the xclbin.
+// The cache is keyed by the xml content rather than by address
+// because the xml may come from an xclbin buffer that is freed and
+// reused.  The hash selects candidates, which are compared with the
+// cached xml.  A small number of indices is cached, the oldest is
+// evicted when the cache is full.
+static std::shared_ptr<const xml_index>
+get_xml_index(const char* xml_data, size_t xml_size)
+{
+  constexpr size_t max_cached = 8;
+  struct entry
+  {
+    size_t hash;
+    std::string xml;
+    std::shared_ptr<const xml_index> index;
+  };
+  static std::mutex mutex;
+  static std::vector<entry> cache;
+
+  std::string_view xml{xml_data, xml_size};
+  auto hash = std::hash<std::string_view>{}(xml);
+  {
+    std::lock_guard lk(mutex);
+    for (const auto& e : cache)
+      if (e.hash == hash && e.xml == xml)
+        return e.index;
+  }
+
+  // Parse outside the lock, concurrent loading of same xml at worst
+  // parses more than once
+  auto index = std::make_shared<const xml_index>(xml_data, xml_size);
+
+  std::lock_guard lk(mutex);
+  if (cache.size() == max_cached)
+    cache.erase(cache.begin());
+  cache.push_back({hash, std::string{xml}, index});
+  return index;
+}
+
 
 } // namespace
 
@@ -468,46 +745,28 @@ get_first_used_mem(const axlf* top)
   return -1;
 }
 
+std::shared_ptr<const xml_index>
+create_xml_index(const char* xml_data, size_t xml_size)
+{
+  return std::make_shared<const xml_index>(xml_data, xml_size);
+}
+
 // Compute max register map size of CUs in xclbin
 size_t
-get_max_cu_size(const char* xml_data, size_t xml_size)
+get_max_cu_size(const xml_index& index)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  size_t maxsz = 0;
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-
-    // determine address range to ensure args are within
-    size_t address_range = get_address_range(xml_kernel.second);
-
-    // iterate arguments and find offset and size to compute max
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
-
-      auto ofs = convert(xml_arg.second.get<std::string>("<xmlattr>.offset"));
-      auto sz = convert(xml_arg.second.get<std::string>("<xmlattr>.size"));
+  for (const auto& kernel : index.kernels)
+    if (kernel.args_error)
+      std::rethrow_exception(kernel.args_error);
+  if (!index.max_cu_size_error.empty())
+    throw xrt_core::error(index.max_cu_size_error);
+  return index.max_cu_size;
+}
 
-      // Validate offset and size against address range
-      if (ofs + sz > address_range) {
-        auto knm = xml_kernel.second.get<std::string>("<xmlattr>.name");
-        auto argnm = xml_arg.second.get<std::string>("<xmlattr>.name");
-        auto fmt = boost::format
-          ("Invalid kernel offset in xclbin for kernel (%s) argument (%s).\n"
-           "The offset (0x%x) and size (0x%x) exceeds kernel address range (0x%x)")
-          % knm % argnm % ofs % sz % address_range;
-        throw xrt_core::error(fmt.str());
-      }
-      maxsz = std::max(maxsz, ofs + sz);
-    }
-  }
-  return maxsz;
+size_t
+get_max_cu_size(const char* xml_data, size_t xml_size)
+{
+  return get_max_cu_size(*get_xml_index(xml_data, xml_size));
 }
 
 std::map<std::string, cuidx_type>
@@ -623,32 +882,17 @@ get_cus(const ip_layout* ip_layout, const std::string& kname)
 // Extract CU base addresses for xml meta data
 // Used in sw_emu because IP_LAYOUT section is not available in sw emu.
 std::vector<uint64_t>
-get_cus(const char* xml_data, size_t xml_size, bool)
+get_cus(const xml_index& index)
 {
-  std::vector<uint64_t> cus;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data, xml_size);
-  pt::read_xml(xml_stream, xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    for (auto& xml_inst : xml_kernel.second) {
-      if (xml_inst.first != "instance")
-        continue;
-      for (auto& xml_remap : xml_inst.second) {
-        if (xml_remap.first != "addrRemap")
-          continue;
-        auto base = convert(xml_remap.second.get<std::string>("<xmlattr>.base"));
-        cus.push_back(base);
-      }
-    }
-  }
+  if (index.cus_error)
+    std::rethrow_exception(index.cus_error);
+  return index.cus;
+}
 
-  std::sort(cus.begin(), cus.end());
-  return cus;
+std::vector<uint64_t>
+get_cus(const char* xml_data, size_t xml_size, bool)
+{
+  return get_cus(*get_xml_index(xml_data, xml_size));
 }
 
 std::vector<uint64_t>
@@ -928,57 +1172,11 @@ get_kernel_freq(const axlf* top)
 std::vector<kernel_argument>
 get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  std::vector<kernel_argument> args;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
-
-    auto pwmap = get_portname_width_map(xml_kernel.second);
-
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
-
-      std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
-      size_t index = id.empty() ? kernel_argument::no_index : convert(id);
-
-      std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
-      auto itr = pwmap.find(port);
-      size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
-
-      args.emplace_back(kernel_argument{
-          xml_arg.second.get<std::string>("<xmlattr>.name")
-         ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
-         ,std::move(port)
-         ,pwidth
-         ,index
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
-         ,0  // fa_desc_offset post computed if necessary
-         ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
-         ,kernel_argument::direction(kernel_argument::direction::input)
-      });
-    }
-
-    // stable sort to preserve order of multi-component arguments
-    // for example global_size, local_size, etc.
-    std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
-
-    // merge args with same index
-    merge_args(args);
-
-    break;
-  }
-  return args;
+  auto index = get_xml_index(xml_data, xml_size);
+  auto kernel = index->get_kernel(kname);
+  if (kernel && kernel->args_error)
+    std::rethrow_exception(kernel->args_error);
+  return kernel ? kernel->args : std::vector<kernel_argument>{};
 }
 
 std::vector<kernel_argument>
@@ -991,49 +1189,11 @@ get_kernel_arguments(const axlf* top, const std::string& kname)
 kernel_properties
 get_kernel_properties(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
-
-    // Determine features
-    auto mailbox = convert_to_mailbox_type(xml_kernel.second.get<std::string>("<xmlattr>.mailbox", "none"));
-    if (mailbox == kernel_properties::mailbox_type::none)
-      mailbox = get_mailbox_from_ini(kname);
-    auto restart = convert(xml_kernel.second.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
-    if (restart == 0)
-      restart = get_restart_from_ini(kname);
-    auto sw_reset = to_bool(xml_kernel.second.get<std::string>("<xmlattr>.swReset", "false"));
-    if (!sw_reset)
-      sw_reset = get_sw_reset_from_ini(kname);
-
-    auto functional = get_functional(xml_kernel.second, "extended-data");
-    auto kernel_id = get_kernel_id(xml_kernel.second, "extended-data");
-
-    return kernel_properties
-      { kname
-      , to_kernel_type(xml_kernel.second.get<std::string>("<xmlattr>.type", "pl"))
-      , restart
-      , mailbox
-      , get_address_range(xml_kernel.second)
-      , sw_reset
-      , functional
-      , kernel_id
-
-      , convert(xml_kernel.second.get<std::string>("<xmlattr>.workGroupSize", "0"))
-      , get_xyz(xml_kernel.second, "compileWorkGroupSize")
-      , get_xyz(xml_kernel.second, "maxWorkGroupSize")
-      , get_stringtable(xml_kernel.second) };
-
-  }
-
-  return kernel_properties{};
+  auto index = get_xml_index(xml_data, xml_size);
+  auto kernel = index->get_kernel(kname);
+  if (kernel && kernel->properties_error)
+    std::rethrow_exception(kernel->properties_error);
+  return kernel ? kernel->properties : kernel_properties{};
 }
 
 kernel_properties
@@ -1046,42 +1206,42 @@ get_kernel_properties(const axlf* top, const std::string& kname)
 std::vector<std::string>
 get_kernel_names(const char *xml_data, size_t xml_size)
 {
-  std::vector<std::string> names;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
+  auto index = get_xml_index(xml_data, xml_size);
+  if (index->kernels_error)
+    std::rethrow_exception(index->kernels_error);
 
-    names.push_back(xml_kernel.second.get<std::string>("<xmlattr>.name"));
-  }
+  std::vector<std::string> names;
+  for (const auto& kernel : index->kernels)
+    names.push_back(kernel.properties.name);
 
   return names;
 }
 
 std::vector<kernel_object>
-get_kernels(const char* xml_data, size_t xml_size)
+get_kernels(const xml_index& index)
 {
-  std::vector<kernel_object> kernels;
+  index.all_kernels_or_error();
 
-  auto knames = get_kernel_names(xml_data, xml_size);
-  for (auto& kname : get_kernel_names(xml_data, xml_size)) {
-    auto kprop = get_kernel_properties(xml_data, xml_size, kname);
+  std::vector<kernel_object> kernels;
+  for (const auto& kernel : index.kernels) {
     kernels.emplace_back(kernel_object{
-        kname
-       ,get_kernel_arguments(xml_data, xml_size, kname)
-       ,kprop.address_range
-       ,kprop.sw_reset
+        kernel.properties.name
+       ,kernel.args
+       ,kernel.properties.address_range
+       ,kernel.properties.sw_reset
+       ,kernel.properties
     });
   }
 
   return kernels;
 }
 
+std::vector<kernel_object>
+get_kernels(const char* xml_data, size_t xml_size)
+{
+  return get_kernels(*get_xml_index(xml_data, xml_size));
+}
+
 std::vector<kernel_object>
 get_kernels(const axlf* top)
 {
@@ -1118,6 +1278,12 @@ get_project_name(const char* xml_data, size_t xml_size)
   return xml_project.get<std::string>("project.<xmlattr>.name","");
 }
 
+std::string
+get_project_name(const xml_index& index)
+{
+  return index.project_name;
+}
+
 std::string
 get_project_name(const axlf* top)
 {
@@ -1141,4 +1307,10 @@ get_fpga_device_name(const char* xml_data, size_t xml_size)
   return xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
 }
 
+std::string
+get_fpga_device_name(const xml_index& index)
+{
+  return index.fpga_device_name;
+}
+
 }} // xclbin, xrt_core
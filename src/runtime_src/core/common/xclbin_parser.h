@@ -24,6 +24,7 @@
 #include <array>
 #include <limits>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -73,12 +74,20 @@ struct kernel_properties
   std::map<uint32_t, std::string> stringtable;
 };
 
+// struct kernel_object - kernel meta data
+//
+// @name: name of kernel
+// @args: kernel arguments sorted by argument index
+// @range: kernel address range
+// @sw_reset: kernel supports software reset
+// @properties: all kernel properties
 struct kernel_object
 {
   std::string name;
   std::vector<kernel_argument> args;
   size_t range;
   bool sw_reset;
+  kernel_properties properties;
 };
 
 // struct softkernel_object - wrapper for a soft kernel object
@@ -201,9 +210,30 @@ address_to_memidx(const mem_topology* mem, uint64_t address);
 std::map<std::string, cuidx_type>
 get_cu_indices(const ip_layout* ip_layout);
 
+// class xml_index - kernel meta data of EMBEDDED_METADATA xml
+// indexed in one pass over the xml, see xclbin_parser.cpp
+class xml_index;
+
+/**
+ * create_xml_index() - Index meta data of xml
+ *
+ * Return: Index to query with the index overloads below
+ *
+ * An xrt::xclbin builds the index once when the xclbin is loaded.
+ * Queries of xml without an xclbin index the xml on demand and
+ * cache a small number of indices keyed by the xml content.
+ */
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<const xml_index>
+create_xml_index(const char* xml_data, size_t xml_size);
+
 /**
  * get_max_cu_size() - Compute max register map size of CUs in xclbin
  */
+XRT_CORE_COMMON_EXPORT
+size_t
+get_max_cu_size(const xml_index& index);
+
 XRT_CORE_COMMON_EXPORT
 size_t
 get_max_cu_size(const char* xml_data, size_t xml_size);
@@ -213,6 +243,10 @@ get_max_cu_size(const char* xml_data, size_t xml_size);
  *
  * @encode: If true encode control protocol in lower address bit
  */
+XRT_CORE_COMMON_EXPORT
+std::vector<uint64_t>
+get_cus(const xml_index& index);
+
 XRT_CORE_COMMON_EXPORT
 std::vector<uint64_t>
 get_cus(const char* xml_data, size_t xml_size, bool encode=false);
@@ -379,6 +413,18 @@ get_kernel_properties(const axlf* top, const std::string& kname);
  */
 XRT_CORE_COMMON_EXPORT
 std::vector<kernel_object>
+get_kernels(const xml_index& index);
+
+/**
+ * get_kernels() - Get meta data for all kernels
+ *
+ * Return: List of struct kernel_object
+ *
+ * The xml meta data is parsed once and cached, subsequent meta data
+ * queries for same xml are served from the cached parse.
+ */
+XRT_CORE_COMMON_EXPORT
+std::vector<kernel_object>
 get_kernels(const char* xml_data, size_t xml_size);
 
 /**
@@ -418,12 +464,24 @@ XRT_CORE_COMMON_EXPORT
 std::string
 get_project_name(const axlf* top);
 
+/**
+ * get_project_name() - Get the project name from the XML index
+ */
+std::string
+get_project_name(const xml_index& index);
+
 /**
  * get_project_name() - Get the project name from the XML
  */
 std::string
 get_fpga_device_name(const char* xml_data, size_t xml_size);
 
+/**
+ * get_fpga_device_name() - Get the FPGA device name from the XML index
+ */
+std::string
+get_fpga_device_name(const xml_index& index);
+
 }} // xclbin, xrt_core
 
 #endif
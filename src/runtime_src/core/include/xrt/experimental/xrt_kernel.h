@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2021 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2024-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_EXPERIMENTAL_KERNEL_H
 #define XRT_EXPERIMENTAL_KERNEL_H
 #include "xrt/xrt_kernel.h"
@@ -12,6 +12,8 @@
 # include "xrt/detail/pimpl.h"
 # include <chrono>
 # include <condition_variable>
+# include <type_traits>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
@@ -256,7 +258,30 @@ public:
   XRT_API_EXPORT
   int
   poll() const;
-  
+
+  /**
+   * record() - Record the runlist for repeated execution
+   *
+   * A recorded runlist is closed for adding run objects.  The chained
+   * commands built when run objects were added stay resident and are
+   * resubmitted as is by each execute().  Only run objects whose
+   * arguments have changed since the previous execution are prepared
+   * again, all others are just reset for re-execution.
+   *
+   * Arguments of run objects in a runlist can be changed in place
+   * with `xrt::run::set_arg()` between executions, for example to
+   * change the input and output buffers for each frame, without
+   * rebuilding the runlist.  Changing the arguments of a run object
+   * while its runlist is executing throws.
+   *
+   * A recorded runlist returns to normal mode upon reset().
+   *
+   * Throws if runlist is executing.
+   */
+  XRT_API_EXPORT
+  void
+  record();
+
   /**
    * reset() - Reset the runlist
    *
@@ -274,6 +299,118 @@ public:
   reset();
 };
 
+/**
+ * class run_template - Run object with a frozen command packet
+ *
+ * A run template freezes the fully encoded command packet of a run
+ * object, including the compute units and all arguments set so far.
+ * Arguments that are declared patchable when the template is created
+ * can be changed between starts.  Changing an argument writes only
+ * the new value at its precomputed offset in the command packet,
+ * setting the same buffer again is a no-op.
+ *
+ * A run template is intended for loops that start the same kernel
+ * repeatedly with only a few changed buffer addresses.  Buffers set
+ * through the template are not validated for compute unit
+ * connectivity, they must be allocated in the same memory bank as
+ * the buffer that was set in the run object when the template was
+ * created.
+ *
+ * The run object used to create the template must not be part of a
+ * runlist.  It is undefined behavior to set arguments directly on the
+ * run object while it is used through a template.
+ */
+class run_template_impl;
+class run_template : public detail::pimpl<run_template_impl>
+{
+public:
+  /**
+   * run_template() - Construct empty run template
+   *
+   * Can be used as lvalue in assignment.
+   */
+  run_template() = default;
+
+  /**
+   * run_template() - Construct a template from a run object
+   *
+   * @param run
+   *  Run object with arguments set for the first start
+   * @param patchable
+   *  Indices of arguments that can be changed through the template
+   *
+   * Throws if an argument index is invalid, if a patchable argument
+   * is neither a buffer nor a scalar, or if the run object is part of
+   * a runlist.
+   */
+  XRT_API_EXPORT
+  run_template(const xrt::run& run, const std::vector<int>& patchable);
+
+  /**
+   * set_arg() - Change a patchable argument
+   *
+   * @param index
+   *  Index of a patchable argument
+   * @param arg
+   *  Argument value, either an xrt::bo or a scalar value
+   *
+   * Throws if the argument is not patchable, if an xrt::bo is set
+   * for a scalar argument or a scalar value for a buffer argument, or
+   * if the size of a scalar value does not match the argument size.
+   * It is undefined
+   * behavior to change an argument while the run is executing.
+   */
+  template <typename ArgType>
+  void
+  set_arg(int index, ArgType&& arg)
+  {
+    using value_type = std::decay_t<ArgType>;
+    if constexpr (std::is_same_v<value_type, xrt::bo>)
+      set_arg_at_index(index, arg);
+    else
+      set_arg_at_index(index, &arg, sizeof(value_type));
+  }
+
+  /**
+   * start() - Start the frozen command
+   *
+   * Kernels with a mailbox or controlled through an ELF module are
+   * started through the regular start of the run object.  Throws if
+   * the run object has been added to a runlist.
+   */
+  XRT_API_EXPORT
+  void
+  start();
+
+  /**
+   * wait() - Wait for the frozen command to complete
+   *
+   * @param timeout
+   *  Timeout in milliseconds, 0 waits for ever
+   * @return
+   *  Command state upon return, same as xrt::run::wait()
+   */
+  XRT_API_EXPORT
+  ert_cmd_state
+  wait(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(0)) const;
+
+  /**
+   * get_run() - Run object used by the template
+   */
+  XRT_API_EXPORT
+  xrt::run
+  get_run() const;
+
+private:
+  XRT_API_EXPORT
+  void
+  set_arg_at_index(int index, const xrt::bo& bo);
+
+  XRT_API_EXPORT
+  void
+  set_arg_at_index(int index, const void* value, size_t bytes);
+};
+
 } // namespace xrt
 
 #endif // __cplusplus
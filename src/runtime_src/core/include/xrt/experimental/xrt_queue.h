@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_QUEUE_H_
 #define XRT_QUEUE_H_
 
@@ -21,8 +21,11 @@ namespace xrt {
  *
  * Used for sequencing operations in order of enqueuing.
  *
- * A queue has exactly one consumer which is a separate thread created
- * when the queue is constructed.
+ * A queue has exactly one consumer.  By default the consumer is a
+ * separate thread created when the queue is constructed.  A queue
+ * constructed with an executor is consumed by the worker threads of
+ * the executor, but tasks of the queue still execute one at a time
+ * in order of enqueuing.
  *
  * When an opeation is enqueued on the queue an event is returned to
  * the caller.  This event can be enqueued in a different queue, which
@@ -30,9 +33,11 @@ namespace xrt {
  * with the event.
  */
 class queue_impl;
+class executor_impl;
 class queue
 {
   friend class queue_impl;
+  friend class executor_impl;
 
   // class task - type-erased callable operation
   //
@@ -165,6 +170,60 @@ public:
     }
   };
 
+  /**
+   * class executor - Pool of worker threads shared by queues
+   *
+   * An executor is a pool of worker threads that execute the tasks
+   * of all queues constructed with the executor.  Tasks of one queue
+   * execute in order of enqueuing and never concurrently, tasks of
+   * different queues execute concurrently on the pool threads.  Idle
+   * worker threads steal work from busy worker threads.
+   *
+   * Use an executor when many queues are needed, for example short
+   * lived queues per request stream, to avoid the cost of a thread
+   * per queue.
+   *
+   * A task that blocks, for example a task that waits for an event
+   * enqueued in another queue, occupies a worker thread while it
+   * waits.  If all worker threads are blocked waiting for tasks of
+   * queues that share the same executor, the queues deadlock.  Use
+   * queues with dedicated threads for such synchronization or size
+   * the executor accordingly.
+   *
+   * The executor is destroyed when the executor object and all
+   * queues constructed with it are destroyed.
+   */
+  class executor
+  {
+  public:
+    /**
+     * executor() - Construct executor with one thread per CPU
+     */
+    XRT_API_EXPORT
+    executor();
+
+    /**
+     * executor() - Construct executor with specified number of threads
+     *
+     * @param num_threads
+     *   Number of worker threads, must be greater than 0
+     */
+    XRT_API_EXPORT
+    explicit
+    executor(unsigned int num_threads);
+
+    /// @cond
+    const std::shared_ptr<executor_impl>&
+    get_handle() const
+    {
+      return m_impl;
+    }
+    /// @endcond
+
+  private:
+    std::shared_ptr<executor_impl> m_impl;
+  };
+
 private:
   // Add task to queue
   XRT_API_EXPORT
@@ -180,6 +239,19 @@ public:
   XRT_API_EXPORT
   queue();
 
+  /**
+   * queue() - Constructor for queue object using an executor
+   *
+   * @param ex
+   *   Executor whose worker threads execute the tasks of the queue
+   *
+   * The queue has no dedicated thread, its tasks are executed in
+   * order of enqueuing by the worker threads of the executor.
+   */
+  XRT_API_EXPORT
+  explicit
+  queue(const executor& ex);
+
   /**
    * enqueue() - Enqueue a callable
    *
@@ -189,8 +261,8 @@ public:
    *   Future result of the function (std::future)
    *
    * A callable is an argument-less lambda function.  The function is
-   * executed asynchronously by the queue consumer (worker thread)
-   * once all previous enqueued operations have completed.
+   * executed asynchronously by the queue consumer (worker thread or
+   * executor) once all previous enqueued operations have completed.
    *
    * Upon completion the returned future becomes valid and will
    * contain the return value of executing the lambda.
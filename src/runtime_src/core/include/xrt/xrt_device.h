@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2020-2022 Xilinx, Inc.  All rights reserved.
-// Copyright (C) 2022-2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_DEVICE_H_
 #define XRT_DEVICE_H_
 
@@ -83,6 +83,10 @@ namespace info {
  *  Information about vmr on the device (std::string)
  * @var aie_mem (deprecated)
  *  AIE memory information of the device (std::string)
+ * @var command_stats
+ *  Latency histograms of kernel commands per kernel and compute unit
+ *  of all hardware contexts on the device, recorded unless disabled
+ *  with xrt.ini Runtime.command_stats (std::string)
  */
 enum class device : unsigned int {
   bdf,
@@ -104,7 +108,8 @@ enum class device : unsigned int {
   aie_shim,
   dynamic_regions,
   vmr,
-  aie_mem
+  aie_mem,
+  command_stats
 };
 
 /// @cond
@@ -131,6 +136,7 @@ XRT_INFO_PARAM_TRAITS(device::aie_shim, std::string);
 XRT_INFO_PARAM_TRAITS(device::aie_mem, std::string);
 XRT_INFO_PARAM_TRAITS(device::dynamic_regions, std::string);
 XRT_INFO_PARAM_TRAITS(device::vmr, std::string);
+XRT_INFO_PARAM_TRAITS(device::command_stats, std::string);
 /// @endcond
 
 } // info
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2022-2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef XRT_HW_CONTEXT_H_
 #define XRT_HW_CONTEXT_H_
 
@@ -22,6 +22,36 @@ class hwctx_handle;
 
 namespace xrt {
 
+namespace info {
+/*!
+ * @enum hw_context
+ *
+ * @brief
+ * Hardware context information parameters
+ *
+ * @details
+ * Use with `xrt::hw_context::get_info()` to retrieve properties of
+ * the hardware context.  The type of the properties is compile time
+ * defined with param traits.
+ *
+ * @var command_stats
+ *  Latency histograms of kernel commands per kernel and compute unit
+ *  executed in the context, recorded unless disabled with xrt.ini
+ *  Runtime.command_stats (std::string)
+ */
+enum class hw_context : unsigned int {
+  command_stats
+};
+
+/// @cond
+/*
+ * Return type for xrt::hw_context::get_info()
+ */
+XRT_INFO_PARAM_TRAITS(hw_context::command_stats, std::string);
+/// @endcond
+
+} // info
+
 /**
  * class hw_context -- manage hw resources
  *
@@ -271,6 +301,27 @@ public:
   std::vector<char>
   get_aie_coredump() const;
 
+#ifndef XRT_NO_STD_ANY
+  /**
+   * get_info() - Retrieve hardware context parameter information
+   *
+   * This function is templated on the enumeration value as defined in
+   * the enumeration xrt::info::hw_context.
+   *
+   * The return type of the parameter is based on the instantiated
+   * param_traits for the given param enumeration supplied as template
+   * argument, see namespace xrt::info
+   */
+  template <info::hw_context param>
+  typename info::param_traits<info::hw_context, param>::return_type
+  get_info() const
+  {
+    return std::any_cast<
+      typename info::param_traits<info::hw_context, param>::return_type
+    >(get_info_std(param, xrt::detail::abi{}));
+  }
+#endif
+
 public:
   /// @cond
   // Undocumented internal access to low level context handle
@@ -278,6 +329,13 @@ public:
   XRT_API_EXPORT
   explicit operator xrt_core::hwctx_handle* () const;
   /// @endcond
+
+private:
+#ifndef XRT_NO_STD_ANY
+  XRT_API_EXPORT
+  std::any
+  get_info_std(info::hw_context param, const xrt::detail::abi&) const;
+#endif
 };
 
 } // namespace xrt
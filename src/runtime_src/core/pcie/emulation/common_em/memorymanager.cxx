@@ -19,10 +19,10 @@
 namespace xclemulation {
   MemoryManager::MemoryManager(uint64_t size, uint64_t start,
       unsigned alignment,std::string& tag ) : mSize(size), mStart(start), mAlignment(alignment), mTag(tag),
-  mCoalesceThreshold(4), mFreeSize(0)
+  mFreeSize(0)
   {
     assert(start % alignment == 0);
-    mFreeBufferList.push_back(std::make_pair(mStart, mSize));
+    insertFree(mStart, mSize);
     mFreeSize = mSize;
   }
 
@@ -80,100 +80,89 @@ namespace xclemulation {
 	    }
     }
 
-    for (PairList::iterator i = mFreeBufferList.begin(), e = mFreeBufferList.end(); i != e; ++i) 
+    // Best fit, smallest free block that fits at lowest address
+    auto fit = mFreeBySize.lower_bound(std::make_pair(static_cast<uint64_t>(size), static_cast<uint64_t>(0)));
+    if (fit == mFreeBySize.end())
+      return result;
+
+    result = fit->second;
+    auto blockSize = fit->first;
+    eraseFree(mFreeByAddr.find(result));
+
+    // Neighbors of the block are busy, so the remainder of the block
+    // cannot be coalesced
+    if (blockSize > size)
     {
-      if (i->second < size)
-        continue;
-      result = i->first;
-      if (i->second > size) 
-      {
-        // Resize the existing entry in freelist
-        i->first += size;
-        i->second -= size;
-      }
-      else 
-      {
-        // remove the exact match found
-        mFreeBufferList.erase(i);
-      }
-      mBusyBufferList.push_back(std::make_pair(result, size));
-      mFreeSize -= size;
-      break;
+      mFreeByAddr.emplace(result + size, blockSize - size);
+      mFreeBySize.emplace(blockSize - size, result + size);
     }
+
+    mBusyBuffers.emplace(result, size);
+    mFreeSize -= size;
     return result;
   }
 
   void MemoryManager::free(uint64_t buf)
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    PairList::iterator i = find(buf);
-    if (i == mBusyBufferList.end())
+    auto i = mBusyBuffers.find(buf);
+    if (i == mBusyBuffers.end())
       return;
     mFreeSize += i->second;
-    mFreeBufferList.push_back(std::make_pair(i->first, i->second));
-    mBusyBufferList.erase(i);
-    if (mFreeBufferList.size() > mCoalesceThreshold) {
-      coalesce();
-    }
+    insertFree(i->first, i->second);
+    mBusyBuffers.erase(i);
   }
 
-
-  void MemoryManager::coalesce()
+  // Insert free block and coalesce with free neighbors
+  void MemoryManager::insertFree(uint64_t addr, uint64_t size)
   {
-    // First sort the free buffers and then attempt to coalesce the neighbors
-    mFreeBufferList.sort();
-
-    PairList::iterator curr = mFreeBufferList.begin();
-    PairList::iterator next = curr;
-    ++next;
-    PairList::iterator last = mFreeBufferList.end();
-    while (next != last) {
-      if ((curr->first + curr->second) != next->first) {
-        // Non contiguous blocks
-        curr = next;
-        ++next;
-        continue;
+    if (size == 0)
+      return;
+
+    auto next = mFreeByAddr.lower_bound(addr);
+    if (next != mFreeByAddr.end() && addr + size == next->first)
+    {
+      size += next->second;
+      auto itr = next++;
+      eraseFree(itr);
+    }
+
+    if (next != mFreeByAddr.begin())
+    {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == addr)
+      {
+        addr = prev->first;
+        size += prev->second;
+        eraseFree(prev);
       }
-      // Coalesce curr and next
-      curr->second += next->second;
-      mFreeBufferList.erase(next);
-      next = curr;
-      ++next;
     }
-  }
 
+    mFreeByAddr.emplace_hint(next, addr, size);
+    mFreeBySize.emplace(size, addr);
+  }
 
-  MemoryManager::PairList::iterator MemoryManager::find(uint64_t buf)
+  void MemoryManager::eraseFree(std::map<uint64_t, uint64_t>::iterator itr)
   {
-#if GCC_VERSION >= 40800
-    PairList::iterator i = std::find_if(mBusyBufferList.begin(), mBusyBufferList.end(), [&] (const PairList::value_type& s)
-        { return s.first == buf; });
-#else
-    PairList::iterator i = mBusyBufferList.begin();
-    PairList::iterator last  = mBusyBufferList.end();
-    while(i != last) {
-      if (i->first == buf)
-        break;
-      ++i;
-    }
-#endif
-    return i;
+    mFreeBySize.erase(std::make_pair(itr->second, itr->first));
+    mFreeByAddr.erase(itr);
   }
 
   void MemoryManager::reset()
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    mFreeBufferList.clear();
-    mBusyBufferList.clear();
-    mFreeBufferList.push_back(std::make_pair(mStart, mSize));
-    mFreeSize = 0;
+    mFreeByAddr.clear();
+    mFreeBySize.clear();
+    mBusyBuffers.clear();
+    insertFree(mStart, mSize);
+    mFreeSize = mSize;
   }
 
   std::pair<uint64_t, uint64_t> MemoryManager::lookup(uint64_t buf)
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    PairList::iterator i = find(buf);
-    if (i != mBusyBufferList.end())
+    auto i = mBusyBuffers.find(buf);
+    if (i != mBusyBuffers.end())
       return *i;
     // Compiler bug -- Some versions of GCC C++11 compiler do not
     // like mNull directly inside std::make_pair, so capture mNull
@@ -181,5 +170,15 @@ namespace xclemulation {
     const uint64_t v = mNull;
     return std::make_pair(v, v);
   }
-}
 
+  MemoryManager::Stats MemoryManager::stats()
+  {
+    std::lock_guard<std::mutex> lock(mMemManagerMutex);
+    Stats s;
+    s.freeSize = mFreeSize;
+    s.largestFree = mFreeBySize.empty() ? 0 : mFreeBySize.rbegin()->first;
+    s.freeBlocks = mFreeByAddr.size();
+    s.busyBlocks = mBusyBuffers.size();
+    return s;
+  }
+}
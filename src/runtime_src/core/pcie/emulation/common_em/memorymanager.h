@@ -20,6 +20,8 @@
 #include <mutex>
 #include <list>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <cassert>
 #include <algorithm>
 
@@ -30,20 +32,44 @@ namespace xclemulation
 {
 static std::map<uint64_t,uint64_t> DEFAULT_MAP;
 static std::string DEFAULT_TAG("");
+    // class MemoryManager - device memory allocator
+    //
+    // Free blocks are indexed by address for coalescing with neighbors
+    // when a block is freed, and by size for best fit allocation with
+    // ties going to the lowest address.  Busy blocks are indexed by
+    // address.  Allocation and free are O(log n) in number of blocks.
+    // Block sizes are multiples of the alignment, so all blocks are
+    // aligned.
     class MemoryManager 
     {
+    public:
+        // Fragmentation statistics
+        struct Stats
+        {
+          uint64_t freeSize = 0;     // total free bytes
+          uint64_t largestFree = 0;  // largest free block
+          size_t freeBlocks = 0;
+          size_t busyBlocks = 0;
+
+          // Fraction of free memory not available to the largest
+          // possible allocation, 0 when free memory is contiguous
+          double fragmentation() const
+          {
+            return freeSize ? 1.0 - static_cast<double>(largestFree) / static_cast<double>(freeSize) : 0.0;
+          }
+        };
+
+    private:
         std::mutex mMemManagerMutex;
-        std::list<std::pair<uint64_t, uint64_t> > mFreeBufferList;
-        std::list<std::pair<uint64_t, uint64_t> > mBusyBufferList;
+        std::map<uint64_t, uint64_t> mFreeByAddr;                // addr -> size
+        std::set<std::pair<uint64_t, uint64_t> > mFreeBySize;    // (size, addr)
+        std::unordered_map<uint64_t, uint64_t> mBusyBuffers;     // addr -> size
         uint64_t mSize;
         uint64_t mStart;
         uint64_t mAlignment;
 	std::string mTag;
-        const unsigned mCoalesceThreshold;
         uint64_t mFreeSize;
 
-        typedef std::list<std::pair<uint64_t, uint64_t> > PairList;
-
     public:
 	static const uint64_t mNull = 0xffffffffffffffffull;
 	std::list<MemoryManager*> mChildMemories;
@@ -62,13 +88,12 @@ static std::string DEFAULT_TAG("");
         static bool isNullAlloc(const std::pair<uint64_t, uint64_t>& buf) { return ((buf.first == mNull) || (buf.second == mNull)); }
 
         std::pair<uint64_t, uint64_t>lookup(uint64_t buf);
+        Stats stats();
 
     private:
-        void coalesce();
-        PairList::iterator find(uint64_t buf);
+        void insertFree(uint64_t addr, uint64_t size);
+        void eraseFree(std::map<uint64_t, uint64_t>::iterator itr);
     };
 }
 
 #endif
-
-
@@ -881,10 +881,15 @@ namespace xclswemuhal2
     }
 
     bool ack = false;
+    // Request file backed device memory for buffers that are not
+    // zero copy when buffer content is transferred through shared
+    // memory.  The buffer is otherwise managed as a regular buffer.
+    bool sharedMemory = !zeroCopy && xclemulation::config::getInstance()->isSharedDeviceMemoryEnabled();
+
     // Memory Manager Has allocated aligned address,
     // size contains alignement + original size requested.
     // We are passing original size to device process for exact stats.
-    xclAllocDeviceBuffer_RPC_CALL(xclAllocDeviceBuffer, result, size, zeroCopy);
+    xclAllocDeviceBuffer_RPC_CALL(xclAllocDeviceBuffer, result, size, zeroCopy || sharedMemory);
 
     if (!ack)
     {
@@ -892,16 +897,92 @@ namespace xclswemuhal2
       return 0;
     }
 
+    if (sharedMemory && !sFileName.empty())
+      mapSharedRegion(result, size, sFileName);
+
     DEBUG_MSGS("%s, %d(ENDED)\n", __func__, __LINE__);
     PRINTENDFUNC;
     return result;
   }
 
+  void SwEmuShim::mapSharedRegion(uint64_t base, uint64_t size, const std::string &fileName)
+  {
+    // Device memory is one file with buffers at their device address,
+    // or one file per buffer if single mmap is disabled
+    bool perBufferFile = std::getenv("VITIS_SW_EMU_DISABLE_SINGLE_MMAP") != nullptr;
+    uint64_t offset = perBufferFile ? 0 : base;
+
+    int fd = open(fileName.c_str(), O_RDWR);
+    if (fd == -1)
+      return;
+
+    if (perBufferFile && ftruncate(fd, size) == -1)
+    {
+      close(fd);
+      return;
+    }
+
+    // Access beyond end of file faults, fall back to the socket if the
+    // device process has not sized the file to cover the buffer
+    struct stat st;
+    void *addr = MAP_FAILED;
+    if (offset % getpagesize() == 0 && fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_size) >= offset + size)
+      addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+    close(fd);
+
+    if (addr == MAP_FAILED)
+    {
+      if (mLogStream.is_open())
+        mLogStream << __func__ << ", failed to map " << fileName << ", buffer content is sent over socket" << std::endl;
+      return;
+    }
+
+    std::lock_guard lk(mSharedRegionsMtx);
+    mSharedRegions[base] = {static_cast<char *>(addr), size};
+  }
+
+  void SwEmuShim::unmapSharedRegion(uint64_t base)
+  {
+    std::lock_guard lk(mSharedRegionsMtx);
+    auto itr = mSharedRegions.find(base);
+    if (itr == mSharedRegions.end())
+      return;
+
+    munmap(itr->second.addr, itr->second.size);
+    mSharedRegions.erase(itr);
+  }
+
+  void SwEmuShim::unmapSharedRegions()
+  {
+    std::lock_guard lk(mSharedRegionsMtx);
+    for (auto &region : mSharedRegions)
+      munmap(region.second.addr, region.second.size);
+    mSharedRegions.clear();
+  }
+
+  // Host address of shared device memory [addr, addr + size) or
+  // nullptr if the range is not within one shared buffer
+  char *SwEmuShim::getSharedRegion(uint64_t addr, size_t size)
+  {
+    std::lock_guard lk(mSharedRegionsMtx);
+    auto itr = mSharedRegions.upper_bound(addr);
+    if (itr == mSharedRegions.begin())
+      return nullptr;
+
+    --itr;
+    if (addr + size > itr->first + itr->second.size)
+      return nullptr;
+
+    return itr->second.addr + (addr - itr->first);
+  }
+
   void SwEmuShim::xclFreeDeviceBuffer(uint64_t offset)
   {
     if (mLogStream.is_open())
       mLogStream << __func__ << ", " << std::this_thread::get_id() << ", " << offset << std::endl;
 
+    unmapSharedRegion(offset);
+
     for (auto i : mDDRMemoryManager)
     {
       if (offset < i->start() + i->size())
@@ -1115,6 +1196,13 @@ namespace xclswemuhal2
     src = (unsigned char *)src + seek;
     dest += seek;
 
+    if (auto shared = getSharedRegion(dest, size))
+    {
+      std::memcpy(shared, src, size);
+      DEBUG_MSGS("%s, %d(ENDED shared memory)\n", __func__, __LINE__);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -1160,6 +1248,14 @@ namespace xclswemuhal2
       launchTempProcess();
 
     src += skip;
+
+    if (auto shared = getSharedRegion(src, size))
+    {
+      std::memcpy(dest, shared, size);
+      DEBUG_MSGS("%s, %d(ENDED shared memory)\n", __func__, __LINE__);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -1249,6 +1345,8 @@ namespace xclswemuhal2
   }
   void SwEmuShim::resetProgram(bool callingFromClose)
   {
+    unmapSharedRegions();
+
     auto isSinglemMapDisabled = std::getenv("VITIS_SW_EMU_DISABLE_SINGLE_MMAP");
     if (isSinglemMapDisabled)
     {
@@ -1371,6 +1469,7 @@ namespace xclswemuhal2
       close(fd);
     }
     mFdToFileNameMap.clear();
+    unmapSharedRegions();
     mIsDeviceProcessStarted = false;
     mCloseAll = true;
     std::string socketName = sock->get_name();
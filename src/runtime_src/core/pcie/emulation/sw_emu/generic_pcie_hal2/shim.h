@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2016-2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef _SW_EMU_SHIM_H_
 #define _SW_EMU_SHIM_H_
 
@@ -824,6 +824,22 @@ namespace xclswemuhal2
     static unsigned int mBufferCount;
     static std::map<int, std::tuple<std::string, uint64_t, void *>> mFdToFileNameMap;
     // HAL2 RELATED member variables end
+
+    // Shared device memory transport (Emulation.shared_device_memory).
+    // Device memory of buffers is backed by files of the device process
+    // and mapped into the shim, so buffer content is copied directly
+    // rather than serialized over the socket.  Keyed by device address.
+    struct SharedRegion
+    {
+      char *addr;
+      uint64_t size;
+    };
+    std::map<uint64_t, SharedRegion> mSharedRegions;
+    std::mutex mSharedRegionsMtx;
+    void mapSharedRegion(uint64_t base, uint64_t size, const std::string &fileName);
+    void unmapSharedRegion(uint64_t base);
+    void unmapSharedRegions();
+    char *getSharedRegion(uint64_t addr, size_t size);
     std::list<std::tuple<uint64_t, void *, std::map<uint64_t, uint64_t>>> mReqList;
     uint64_t mReqCounter;
     FeatureRomHeader mFeatureRom;
@@ -847,6 +847,25 @@ struct mac_addr_list
   }
 };
 
+// Cache of sysfs reads, enabled by tools while producing reports
+struct sysfs_cache_ttl
+{
+  using result_type = query::sysfs_cache_ttl::result_type;
+  using value_type = query::sysfs_cache_ttl::value_type;
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    return get_pcidev(device)->get_sysfs_cache_ttl();
+  }
+
+  static void
+  put(const xrt_core::device* device, key_type, const value_type& ms)
+  {
+    get_pcidev(device)->set_sysfs_cache_ttl(ms);
+  }
+};
+
 /* AIM counter values
  * In PCIe Linux, access the sysfs file for AIM to retrieve the AIM counter values
  */
@@ -1265,6 +1284,25 @@ struct function0_get : virtual QueryRequestType
   }
 };
 
+template <typename QueryRequestType, typename Getter>
+struct function0_getput : virtual QueryRequestType
+{
+  std::any
+  get(const xrt_core::device* device) const
+  {
+    auto k = QueryRequestType::key;
+    return Getter::get(device, k);
+  }
+
+  void
+  put(const xrt_core::device* device, const std::any& any) const
+  {
+    auto k = QueryRequestType::key;
+    auto value = std::any_cast<typename QueryRequestType::value_type>(any);
+    Getter::put(device, k, value);
+  }
+};
+
 template <typename QueryRequestType, typename Getter>
 struct function4_get : virtual QueryRequestType
 {
@@ -1294,6 +1332,14 @@ emplace_func0_request()
   query_tbl.emplace(k, std::make_unique<function0_get<QueryRequestType, Getter>>());
 }
 
+template <typename QueryRequestType, typename Getter>
+static void
+emplace_func0_getput()
+{
+  auto k = QueryRequestType::key;
+  query_tbl.emplace(k, std::make_unique<function0_getput<QueryRequestType, Getter>>());
+}
+
 template <typename QueryRequestType, typename Getter>
 static void
 emplace_func4_request()
@@ -1551,6 +1597,7 @@ initialize_query_table()
   emplace_func4_request<query::host_max_bandwidth_mbps,        host_max_bandwidth_mbps>();
   emplace_func4_request<query::kernel_max_bandwidth_mbps,      kernel_max_bandwidth_mbps>();
   emplace_func4_request<query::read_trace_data,                read_trace_data>();
+  emplace_func0_getput<query::sysfs_cache_ttl,                 sysfs_cache_ttl>();
 }
 
 struct X { X() { initialize_query_table(); }};
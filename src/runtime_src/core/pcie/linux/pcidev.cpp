@@ -3,6 +3,7 @@
 // Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
 #include "pcidev.h"
 #include "pcidrv.h"
+#include "sysfs_cache.h"
 #include "xrt/detail/xclbin.h"
 
 #include "core/common/utils.h"
@@ -30,54 +31,6 @@ namespace {
 
 namespace sfs = std::filesystem;
 
-static std::string
-get_name(const std::string& dir, const std::string& subdir)
-{
-  std::string line;
-  std::ifstream ifs(dir + "/" + subdir + "/name");
-
-  if (ifs.is_open())
-    std::getline(ifs, line);
-
-  return line;
-}
-
-// Helper to find subdevice directory name
-// Assumption: all subdevice's sysfs directory name starts with subdevice name!!
-static int
-get_subdev_dir_name(const std::string& dir, const std::string& subDevName, std::string& subdir)
-{
-  DIR *dp;
-  size_t sub_nm_sz = subDevName.size();
-
-  subdir = "";
-  if (subDevName.empty())
-    return 0;
-
-  int ret = -ENOENT;
-  dp = opendir(dir.c_str());
-  if (dp) {
-    struct dirent *entry;
-    while ((entry = readdir(dp))) {
-      std::string nm = get_name(dir, entry->d_name);
-      if (!nm.empty()) {
-        if (nm != subDevName)
-          continue;
-      } else if(strncmp(entry->d_name, subDevName.c_str(), sub_nm_sz) ||
-                entry->d_name[sub_nm_sz] != '.') {
-        continue;
-      }
-      // found it
-      subdir = entry->d_name;
-      ret = 0;
-      break;
-    }
-    closedir(dp);
-  }
-
-  return ret;
-}
-
 static bool
 is_admin()
 {
@@ -157,95 +110,39 @@ namespace sysfs {
 
 static constexpr const char* dev_root = "/sys/bus/pci/devices/";
 
-static std::string
-get_path(const std::string& name, const std::string& subdev, const std::string& entry)
-{
-  std::string subdir;
-  if (get_subdev_dir_name(dev_root + name, subdev, subdir) != 0)
-    return "";
-
-  std::string path = dev_root;
-  path += name;
-  path += "/";
-  path += subdir;
-  path += "/";
-  path += entry;
-  return path;
-}
-
-static std::fstream
-open_path(const std::string& path, std::string& err, bool write, bool binary)
-{
-  std::fstream fs;
-  std::ios::openmode mode = write ? std::ios::out : std::ios::in;
-
-  if (binary)
-    mode |= std::ios::binary;
-
-  err.clear();
-  fs.open(path, mode);
-  if (!fs.is_open()) {
-    std::stringstream ss;
-    ss << "Failed to open " << path << " for "
-       << (binary ? "binary " : "")
-       << (write ? "writing" : "reading") << ": "
-       << strerror(errno) << std::endl;
-    err = ss.str();
-  }
-  return fs;
-}
-
-static std::fstream
-open(const std::string& name,
-     const std::string& subdev, const std::string& entry,
-     std::string& err, bool write, bool binary)
-{
-  std::fstream fs;
-  auto path = get_path(name, subdev, entry);
-
-  if (path.empty()) {
-    std::stringstream ss;
-    ss << "Failed to find subdirectory for " << subdev
-       << " under " << dev_root + name << std::endl;
-    err = ss.str();
-  } else {
-    fs = open_path(path, err, write, binary);
-  }
-
-  return fs;
-}
-
 static void
-get(const std::string& name,
+get(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, std::vector<std::string>& sv)
 {
-  std::fstream fs = open(name, subdev, entry, err, false, false);
+  std::string data;
+  cache.read(subdev, entry, false, err, data);
   if (!err.empty())
     return;
 
   sv.clear();
+  std::istringstream iss(data);
   std::string line;
-  while (std::getline(fs, line))
+  while (std::getline(iss, line))
     sv.push_back(line);
 }
 
 static void
-get(const std::string& name,
+get(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, std::vector<uint64_t>& iv)
 {
   iv.clear();
 
   std::vector<std::string> sv;
-  get(name, subdev, entry, err, sv);
+  get(cache, subdev, entry, err, sv);
   if (!err.empty())
     return;
 
   for (auto& s : sv) {
     if (s.empty()) {
       std::stringstream ss;
-      ss << "Reading " << get_path(name, subdev, entry) << ", ";
+      ss << "Reading " << cache.get_path(subdev, entry) << ", ";
       ss << "can't convert empty string to integer" << std::endl;
       err = ss.str();
       break;
@@ -254,7 +151,7 @@ get(const std::string& name,
     auto n = std::strtoull(s.c_str(), &end, 0);
     if (*end != '\0') {
       std::stringstream ss;
-      ss << "Reading " << get_path(name, subdev, entry) << ", ";
+      ss << "Reading " << cache.get_path(subdev, entry) << ", ";
       ss << "failed to convert string to integer: " << s << std::endl;
       err = ss.str();
       break;
@@ -264,12 +161,12 @@ get(const std::string& name,
 }
 
 static void
-get(const std::string& name,
+get(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, std::string& s)
 {
   std::vector<std::string> sv;
-  get(name, subdev, entry, err, sv);
+  get(cache, subdev, entry, err, sv);
   if (!sv.empty())
     s = sv[0];
   else
@@ -277,72 +174,40 @@ get(const std::string& name,
 }
 
 static void
-get(const std::string& name,
+get(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, std::vector<char>& buf)
 {
-  std::fstream fs = open(name, subdev, entry, err, false, true);
+  std::string data;
+  cache.read(subdev, entry, true, err, data);
   if (!err.empty())
     return;
 
-  buf.clear();
-  buf.insert(std::end(buf),std::istreambuf_iterator<char>(fs),
-             std::istreambuf_iterator<char>());
+  buf.assign(data.begin(), data.end());
 }
 
 static void
-put(const std::string& name,
+put(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, const std::string& input)
 {
-  std::fstream fs = open(name, subdev, entry, err, true, false);
-  if (!err.empty())
-    return;
-  fs << input;
-  fs.close(); // flush and close, if either fails then stream failbit is set.
-  if (!fs.good()) {
-    std::stringstream ss;
-    ss << "Failed to write " << get_path(name, subdev, entry) << ": "
-       << strerror(errno) << std::endl;
-    err = ss.str();
-  }
+  cache.write(subdev, entry, false, input, err);
 }
 
 static void
-put(const std::string& name,
+put(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, const std::vector<char>& buf)
 {
-  std::fstream fs = open(name, subdev, entry, err, true, true);
-  if (!err.empty())
-    return;
-
-  fs.write(buf.data(), buf.size());
-  fs.close(); // flush and close, if either fails then stream failbit is set.
-  if (!fs.good()) {
-    std::stringstream ss;
-    ss << "Failed to write " << get_path(name, subdev, entry) << ": "
-       << strerror(errno) << std::endl;
-    err = ss.str();
-  }
+  cache.write(subdev, entry, true, std::string(buf.begin(), buf.end()), err);
 }
 
 static void
-put(const std::string& name,
+put(sysfs_cache& cache,
     const std::string& subdev, const std::string& entry,
     std::string& err, const unsigned int& input)
 {
-  std::fstream fs = open(name, subdev, entry, err, true, false);
-  if (!err.empty())
-    return;
-  fs << input;
-  fs.close(); // flush and close, if either fails then stream failbit is set.
-  if (!fs.good()) {
-    std::stringstream ss;
-    ss << "Failed to write " << get_path(name, subdev, entry) << ": "
-       << strerror(errno) << std::endl;
-    err = ss.str();
-  }
+  cache.write(subdev, entry, false, std::to_string(input), err);
 }
 
 } // sysfs
@@ -352,7 +217,7 @@ dev::
 sysfs_get(const std::string& subdev, const std::string& entry,
           std::string& err, std::vector<std::string>& ret)
 {
-  sysfs::get(m_sysfs_name, subdev, entry, err, ret);
+  sysfs::get(*m_sysfs_cache, subdev, entry, err, ret);
 }
 
 void
@@ -360,7 +225,7 @@ dev::
 sysfs_get(const std::string& subdev, const std::string& entry,
           std::string& err, std::vector<uint64_t>& ret)
 {
-  sysfs::get(m_sysfs_name, subdev, entry, err, ret);
+  sysfs::get(*m_sysfs_cache, subdev, entry, err, ret);
 }
 
 void
@@ -368,7 +233,7 @@ dev::
 sysfs_get(const std::string& subdev, const std::string& entry,
           std::string& err, std::vector<char>& ret)
 {
-  sysfs::get(m_sysfs_name, subdev, entry, err, ret);
+  sysfs::get(*m_sysfs_cache, subdev, entry, err, ret);
 }
 
 void
@@ -376,7 +241,7 @@ dev::
 sysfs_get(const std::string& subdev, const std::string& entry,
           std::string& err, std::string& s)
 {
-  sysfs::get(m_sysfs_name, subdev, entry, err, s);
+  sysfs::get(*m_sysfs_cache, subdev, entry, err, s);
 }
 
 void
@@ -384,7 +249,7 @@ dev::
 sysfs_put(const std::string& subdev, const std::string& entry,
           std::string& err, const std::string& input)
 {
-  sysfs::put(m_sysfs_name, subdev, entry, err, input);
+  sysfs::put(*m_sysfs_cache, subdev, entry, err, input);
 }
 
 void
@@ -392,7 +257,7 @@ dev::
 sysfs_put(const std::string& subdev, const std::string& entry,
           std::string& err, const std::vector<char>& buf)
 {
-  sysfs::put(m_sysfs_name, subdev, entry, err, buf);
+  sysfs::put(*m_sysfs_cache, subdev, entry, err, buf);
 }
 
 void
@@ -400,14 +265,28 @@ dev::
 sysfs_put(const std::string& subdev, const std::string& entry,
           std::string& err, const unsigned int& buf)
 {
-  sysfs::put(m_sysfs_name, subdev, entry, err, buf);
+  sysfs::put(*m_sysfs_cache, subdev, entry, err, buf);
 }
 
 std::string
 dev::
 get_sysfs_path(const std::string& subdev, const std::string& entry)
 {
-  return sysfs::get_path(m_sysfs_name, subdev, entry);
+  return m_sysfs_cache->get_path(subdev, entry);
+}
+
+void
+dev::
+set_sysfs_cache_ttl(uint32_t ms)
+{
+  m_sysfs_cache->set_ttl(ms);
+}
+
+uint32_t
+dev::
+get_sysfs_cache_ttl() const
+{
+  return m_sysfs_cache->get_ttl();
 }
 
 std::string
@@ -456,6 +335,7 @@ dev::
 dev(std::shared_ptr<const drv> driver, std::string sysfs)
   : m_sysfs_name(std::move(sysfs))
   , m_driver(std::move(driver))
+  , m_sysfs_cache(std::make_unique<sysfs_cache>(sysfs::dev_root + m_sysfs_name))
 {
   std::string err;
 
@@ -58,6 +58,7 @@ namespace xrt_core { namespace pci {
 
 // Forward declaration
 class drv;
+class sysfs_cache;
 
 // One PCIe function on FPGA or AIE device
 class dev
@@ -131,6 +132,15 @@ public:
   virtual std::string
   get_sysfs_path(const std::string& subdev, const std::string& entry);
 
+  // Cache sysfs reads of this device for ms, 0 disables caching which
+  // is the default.  Meant for tools that issue many queries at once,
+  // see sysfs_cache.h.
+  void
+  set_sysfs_cache_ttl(uint32_t ms);
+
+  uint32_t
+  get_sysfs_cache_ttl() const;
+
   virtual std::string
   get_subdev_path(const std::string& subdev, uint32_t idx) const;
 
@@ -192,6 +202,9 @@ private:
   mutable char *m_user_bar_map = reinterpret_cast<char *>(MAP_FAILED);
 
   std::shared_ptr<const drv> m_driver;
+
+  // Reads sysfs entries, cached if enabled
+  std::unique_ptr<sysfs_cache> m_sysfs_cache;
 };
 
 size_t
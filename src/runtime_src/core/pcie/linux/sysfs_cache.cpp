@@ -0,0 +1,486 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#include "sysfs_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+
+// Kept open file descriptors per device, entries beyond are re-opened
+// on every read
+constexpr size_t max_open_fds = 256;
+
+// Directory prefetch reads at most one page per entry, sysfs attributes
+// are one page or less, larger binary attributes are read on demand
+constexpr size_t prefetch_size = 4096;
+
+static std::string
+get_name(const std::string& dir, const std::string& subdir)
+{
+  std::string line;
+  std::ifstream ifs(dir + "/" + subdir + "/name");
+
+  if (ifs.is_open())
+    std::getline(ifs, line);
+
+  return line;
+}
+
+// Helper to find subdevice directory name
+// Assumption: all subdevice's sysfs directory name starts with subdevice name!!
+static int
+get_subdev_dir_name(const std::string& dir, const std::string& subDevName, std::string& subdir)
+{
+  DIR *dp;
+  size_t sub_nm_sz = subDevName.size();
+
+  subdir = "";
+  if (subDevName.empty())
+    return 0;
+
+  int ret = -ENOENT;
+  dp = opendir(dir.c_str());
+  if (dp) {
+    struct dirent *entry;
+    while ((entry = readdir(dp))) {
+      std::string nm = get_name(dir, entry->d_name);
+      if (!nm.empty()) {
+        if (nm != subDevName)
+          continue;
+      } else if(strncmp(entry->d_name, subDevName.c_str(), sub_nm_sz) ||
+                entry->d_name[sub_nm_sz] != '.') {
+        continue;
+      }
+      // found it
+      subdir = entry->d_name;
+      ret = 0;
+      break;
+    }
+    closedir(dp);
+  }
+
+  return ret;
+}
+
+static std::string
+subdir_error(const std::string& dir, const std::string& subdev)
+{
+  std::stringstream ss;
+  ss << "Failed to find subdirectory for " << subdev
+     << " under " << dir << std::endl;
+  return ss.str();
+}
+
+static std::string
+open_error(const std::string& path, bool binary, bool write, int error)
+{
+  std::stringstream ss;
+  ss << "Failed to open " << path << " for "
+     << (binary ? "binary " : "")
+     << (write ? "writing" : "reading") << ": "
+     << strerror(error) << std::endl;
+  return ss.str();
+}
+
+// Read from offset 0 until end of file or limit, a sysfs attribute is
+// regenerated when read from offset 0.  Returns errno on failure.
+static int
+pread_all(int fd, std::string& data, size_t limit)
+{
+  data.clear();
+  char buf[prefetch_size];
+  while (!limit || data.size() < limit) {
+    auto len = limit ? std::min(sizeof(buf), limit - data.size()) : sizeof(buf);
+    auto ret = ::pread(fd, buf, len, static_cast<off_t>(data.size()));
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      return errno;
+    }
+    if (ret == 0)
+      break;
+    data.append(buf, ret);
+  }
+  return 0;
+}
+
+// Subdevices with sensors, reports read most of their entries
+static bool
+is_bulk(const std::string& subdev)
+{
+  return subdev == "xmc" || subdev == "hwmon_sdm";
+}
+
+} // namespace
+
+namespace xrt_core { namespace pci {
+
+sysfs_cache::policy
+sysfs_cache::
+get_policy(const std::string& subdev, const std::string& entry)
+{
+  struct rule { const char* subdev; const char* entry; policy pol; };
+  static const rule rules[] = {
+    // Identity of the device and board, fixed until the device is reset
+    { "rom", nullptr, policy::once },
+    { "", "vendor", policy::once },
+    { "", "device", policy::once },
+    { "", "subsystem_vendor", policy::once },
+    { "", "subsystem_device", policy::once },
+    { "", "link_speed_max", policy::once },
+    { "", "link_width_max", policy::once },
+    { "", "local_cpulist", policy::once },
+    { "", "instance", policy::once },
+    { "", "userbar", policy::once },
+    { "hwmon_sdm", "serial_num", policy::once },
+    { "hwmon_sdm", "oem_id", policy::once },
+    { "hwmon_sdm", "bd_name", policy::once },
+    { "hwmon_sdm", "mfg_date", policy::once },
+
+    // State the runtime waits on or changes, always read from sysfs
+    { "", "ready", policy::never },
+    { "", "dev_offline", policy::never },
+    { "", "shutdown", policy::never },
+    { "", "rp_program", policy::never },
+    { "", "mig_cache_update", policy::never },
+    { "", "xclbinuuid", policy::never },
+    { "", "kds_numcdmas", policy::never },
+  };
+
+  // Entries of other directories, e.g. dparent/power/...
+  if (entry.find('/') != std::string::npos)
+    return policy::never;
+
+  for (const auto& r : rules)
+    if (subdev == r.subdev && (!r.entry || entry == r.entry))
+      return r.pol;
+
+  return policy::ttl;
+}
+
+sysfs_cache::
+sysfs_cache(std::string dir)
+  : m_dir(std::move(dir))
+{}
+
+sysfs_cache::
+~sysfs_cache()
+{
+  close_fds();
+}
+
+bool
+sysfs_cache::
+fresh(const clock::time_point& stamp, policy pol, clock::time_point now) const
+{
+  return pol == policy::once || now - stamp < std::chrono::milliseconds(m_ttl);
+}
+
+int
+sysfs_cache::
+lookup_subdir(const std::string& subdev, std::string& subdir, clock::time_point now)
+{
+  subdir = "";
+  if (subdev.empty())
+    return 0;
+
+  // Directories found are kept until invalidated, a subdevice that is
+  // not found is looked up again after the ttl
+  auto& sd = m_subdirs[subdev];
+  if (sd.stamp == clock::time_point() || (sd.error && !fresh(sd.stamp, policy::ttl, now))) {
+    sd.error = get_subdev_dir_name(m_dir, subdev, sd.name);
+    sd.stamp = now;
+    ++m_stats.dir_scans;
+  }
+
+  subdir = sd.name;
+  return sd.error;
+}
+
+std::string
+sysfs_cache::
+get_path(const std::string& subdev, const std::string& entry)
+{
+  std::unique_lock<std::mutex> lk(m_mutex);
+  std::string subdir;
+  int ret = 0;
+  if (m_ttl) {
+    ret = lookup_subdir(subdev, subdir, clock::now());
+  }
+  else {
+    if (!subdev.empty())
+      ++m_stats.dir_scans;
+    lk.unlock();
+    ret = get_subdev_dir_name(m_dir, subdev, subdir);
+  }
+
+  if (ret != 0)
+    return "";
+
+  std::string path = m_dir;
+  path += "/";
+  path += subdir;
+  path += "/";
+  path += entry;
+  return path;
+}
+
+void
+sysfs_cache::
+read_entry(entry_type& ent, const std::string& path)
+{
+  ent.data.clear();
+  ent.error = 0;
+
+  // A kept descriptor can be stale if the subdevice was reloaded, in
+  // which case the entry is opened again
+  for (bool kept = ent.fd >= 0; ; kept = false) {
+    if (!kept) {
+      ent.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (ent.fd < 0) {
+        ent.error = errno;
+        return;
+      }
+      ++m_open_fds;
+    }
+
+    auto error = pread_all(ent.fd, ent.data, 0);
+    if (!error && m_open_fds <= max_open_fds)
+      return;
+
+    ::close(ent.fd);
+    ent.fd = -1;
+    --m_open_fds;
+
+    // Failed read of a new descriptor leaves the contents empty, same
+    // as the uncached read
+    if (!error || !kept)
+      return;
+  }
+}
+
+void
+sysfs_cache::
+prefetch(const std::string& subdev, const std::string& subdir, clock::time_point now)
+{
+  auto dirpath = m_dir + "/" + subdir;
+  DIR* dp = opendir(dirpath.c_str());
+  if (!dp)
+    return;
+
+  while (auto dent = readdir(dp)) {
+    if (dent->d_type != DT_REG)
+      continue;
+
+    std::string name = dent->d_name;
+    auto pol = get_policy(subdev, name);
+    if (pol == policy::never)
+      continue;
+
+    auto& ent = m_entries[dirpath + "/" + name];
+    if (ent.valid && fresh(ent.stamp, ent.pol, now))
+      continue;
+
+    // Open and read one page, the descriptor is kept for re-reads.
+    // Write only entries fail to open and are cached as such.
+    if (ent.fd < 0) {
+      ent.fd = ::open((dirpath + "/" + name).c_str(), O_RDONLY | O_CLOEXEC);
+      if (ent.fd < 0) {
+        ent.data.clear();
+        ent.error = errno;
+        ent.pol = pol;
+        ent.stamp = now;
+        ent.valid = true;
+        continue;
+      }
+      ++m_open_fds;
+    }
+
+    // Entries that do not fit in a page or fail to read are left for
+    // read_entry
+    ent.valid = pread_all(ent.fd, ent.data, prefetch_size) == 0 && ent.data.size() < prefetch_size;
+    ent.error = 0;
+    ent.pol = pol;
+    ent.stamp = now;
+    if (ent.valid)
+      ++m_stats.prefetches;
+
+    if (m_open_fds > max_open_fds) {
+      ::close(ent.fd);
+      ent.fd = -1;
+      --m_open_fds;
+    }
+  }
+  closedir(dp);
+}
+
+void
+sysfs_cache::
+read(const std::string& subdev, const std::string& entry,
+     bool binary, std::string& err, std::string& data)
+{
+  err.clear();
+  data.clear();
+
+  auto pol = get_policy(subdev, entry);
+  std::unique_lock<std::mutex> lk(m_mutex);
+  if (m_ttl && pol != policy::never) {
+    auto now = clock::now();
+    for (bool retry = !subdev.empty(); ; retry = false) {
+      std::string subdir;
+      if (lookup_subdir(subdev, subdir, now) != 0) {
+        err = subdir_error(m_dir, subdev);
+        return;
+      }
+
+      auto path = m_dir + "/" + subdir + "/" + entry;
+      auto& ent = m_entries[path];
+      if (ent.valid && fresh(ent.stamp, ent.pol, now)) {
+        ++m_stats.hits;
+      }
+      else {
+        if (is_bulk(subdev))
+          prefetch(subdev, subdir, now);
+
+        if (ent.valid && fresh(ent.stamp, ent.pol, now)) {
+          ++m_stats.hits;
+        }
+        else {
+          read_entry(ent, path);
+          ent.pol = pol;
+          ent.stamp = now;
+          ent.valid = true;
+          ++m_stats.misses;
+        }
+      }
+
+      // Entry of a subdevice that is gone, the subdevice may have been
+      // reloaded under a new directory
+      if (retry && (ent.error == ENOENT || ent.error == ENODEV)) {
+        m_subdirs.erase(subdev);
+        continue;
+      }
+
+      if (ent.error)
+        err = open_error(path, binary, false, ent.error);
+      else
+        data = ent.data;
+      return;
+    }
+  }
+
+  // Uncached, resolve subdevice and read entry on every call
+  ++m_stats.misses;
+  if (!subdev.empty())
+    ++m_stats.dir_scans;
+  lk.unlock();
+
+  std::string subdir;
+  if (get_subdev_dir_name(m_dir, subdev, subdir) != 0) {
+    err = subdir_error(m_dir, subdev);
+    return;
+  }
+
+  auto path = m_dir + "/" + subdir + "/" + entry;
+  std::ifstream ifs(path, binary ? std::ios::in | std::ios::binary : std::ios::in);
+  if (!ifs.is_open()) {
+    err = open_error(path, binary, false, errno);
+    return;
+  }
+
+  data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+void
+sysfs_cache::
+write(const std::string& subdev, const std::string& entry,
+      bool binary, const std::string& data, std::string& err)
+{
+  err.clear();
+  auto path = get_path(subdev, entry);
+  if (path.empty()) {
+    err = subdir_error(m_dir, subdev);
+    return;
+  }
+
+  std::ofstream ofs(path, binary ? std::ios::out | std::ios::binary : std::ios::out);
+  if (!ofs.is_open()) {
+    err = open_error(path, binary, true, errno);
+    return;
+  }
+
+  ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
+  ofs.close(); // flush and close, if either fails then stream failbit is set.
+  if (!ofs.good()) {
+    std::stringstream ss;
+    ss << "Failed to write " << path << ": " << strerror(errno) << std::endl;
+    err = ss.str();
+  }
+
+  // The write may have changed other entries of the device
+  invalidate();
+}
+
+void
+sysfs_cache::
+invalidate()
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_subdirs.clear();
+  for (auto& [path, ent] : m_entries) {
+    if (ent.pol != policy::once)
+      ent.valid = false;
+  }
+}
+
+void
+sysfs_cache::
+close_fds()
+{
+  for (auto& [path, ent] : m_entries) {
+    if (ent.fd >= 0)
+      ::close(ent.fd);
+    ent.fd = -1;
+  }
+  m_open_fds = 0;
+}
+
+void
+sysfs_cache::
+set_ttl(uint32_t ms)
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_ttl = ms;
+  if (m_ttl)
+    return;
+
+  close_fds();
+  m_entries.clear();
+  m_subdirs.clear();
+}
+
+uint32_t
+sysfs_cache::
+get_ttl() const
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_ttl;
+}
+
+sysfs_cache::stats
+sysfs_cache::
+get_stats() const
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_stats;
+}
+
+}} // namespace xrt_core :: pci
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef _XCL_SYSFS_CACHE_H_
+#define _XCL_SYSFS_CACHE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace xrt_core { namespace pci {
+
+// Reads sysfs entries of one PCIe function, optionally cached.
+//
+// Uncached (ttl 0, the default) every read resolves the subdevice
+// directory, then opens, reads and closes the entry, which is the
+// behavior applications see.
+//
+// Cached (ttl > 0) is meant for tools that issue many queries in a
+// short time, e.g. one examine report or one watch mode refresh:
+//
+//  - Entry contents are kept for the ttl, a read within the ttl makes
+//    no system calls.  Subdevice directory lookups are kept until a
+//    write, or until an entry of the subdevice is gone.
+//  - Entries are re-read with pread on a file descriptor that is kept
+//    open while caching is enabled.
+//  - A miss on an entry of a sensor subdevice (xmc, hwmon_sdm) reads
+//    all entries of the subdevice directory, reports read most of them.
+//  - Per entry policy: identity entries (rom, vendor/device ids, ...)
+//    are read once, entries the runtime polls for state changes
+//    (ready, dev_offline, ...) are never cached.
+//  - Any write through the cache drops cached contents.
+//
+// Cached and uncached reads return the same data and error messages.
+class sysfs_cache
+{
+public:
+  struct stats
+  {
+    uint64_t hits = 0;          // reads served from cache
+    uint64_t misses = 0;        // reads of entries from sysfs
+    uint64_t prefetches = 0;    // entries read by directory prefetch
+    uint64_t dir_scans = 0;     // subdevice directory lookups
+  };
+
+  // Directory of the PCIe function, e.g. /sys/bus/pci/devices/<bdf>
+  explicit
+  sysfs_cache(std::string dir);
+
+  ~sysfs_cache();
+
+  sysfs_cache(const sysfs_cache&) = delete;
+  sysfs_cache& operator=(const sysfs_cache&) = delete;
+
+  const std::string&
+  get_dir() const
+  {
+    return m_dir;
+  }
+
+  // Path to entry of subdevice, empty if subdevice is not found
+  std::string
+  get_path(const std::string& subdev, const std::string& entry);
+
+  // Read the raw contents of an entry.  Sets err on failure using the
+  // same messages as the uncached pcidev sysfs accessors.
+  void
+  read(const std::string& subdev, const std::string& entry,
+       bool binary, std::string& err, std::string& data);
+
+  // Write the raw contents of an entry and drop cached contents.  Sets
+  // err on failure using the same messages as reads.
+  void
+  write(const std::string& subdev, const std::string& entry,
+        bool binary, const std::string& data, std::string& err);
+
+  // Drop cached contents and directory lookups, called on write
+  void
+  invalidate();
+
+  // Time to live of cached contents in ms, 0 disables caching and
+  // closes all kept open file descriptors
+  void
+  set_ttl(uint32_t ms);
+
+  uint32_t
+  get_ttl() const;
+
+  stats
+  get_stats() const;
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  enum class policy { ttl, once, never };
+
+  struct entry_type
+  {
+    std::string data;
+    int error = 0;              // errno of failed open
+    int fd = -1;                // kept open for pread re-reads
+    clock::time_point stamp;
+    policy pol = policy::ttl;
+    bool valid = false;
+  };
+
+  struct subdir_type
+  {
+    std::string name;
+    int error = 0;              // -ENOENT if subdevice is not found
+    clock::time_point stamp;
+  };
+
+  static policy
+  get_policy(const std::string& subdev, const std::string& entry);
+
+  bool
+  fresh(const clock::time_point& stamp, policy pol, clock::time_point now) const;
+
+  int
+  lookup_subdir(const std::string& subdev, std::string& subdir, clock::time_point now);
+
+  void
+  read_entry(entry_type& ent, const std::string& path);
+
+  void
+  prefetch(const std::string& subdev, const std::string& subdir, clock::time_point now);
+
+  void
+  close_fds();
+
+  const std::string m_dir;
+  mutable std::mutex m_mutex;
+  uint32_t m_ttl = 0;
+  size_t m_open_fds = 0;
+  std::map<std::string, subdir_type> m_subdirs;   // subdevice to directory
+  std::map<std::string, entry_type> m_entries;    // path to contents
+  stats m_stats;
+};
+
+}} // namespace xrt_core :: pci
+
+#endif
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2021-2022 Xilinx, Inc. All rights reserved.
-// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 // This file implements a dummy (no-op) shim level driver that is
 // used exclusively for debugging user space XRT with HW xclbins
@@ -17,17 +17,24 @@
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "core/common/system.h"
-#include "core/common/task.h"
 #include "core/common/thread.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/hwctx_handle.h"
+#include "core/common/shim/hwqueue_handle.h"
 
 #include "core/common/api/hw_context_int.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <functional>
 #include <mutex>
+#include <queue>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace { // private implementation details
 
@@ -285,72 +292,185 @@ static std::vector<std::shared_ptr<pl::device>> s_devices;
 
 // Simulate asynchronous command completion.
 //
-// Command handles are added to a producer/consumer queue A worker
-// thread pretends to run the command and marks it complete only if
-// the command was enqueue some constant time before now.
+// Commands are completed by a timer thread when their simulated
+// execution time has elapsed.  The execution time is drawn from a
+// distribution with Runtime.noop_completion_delay_us as its mean:
+//   constant:    every command takes the mean time
+//   uniform:     uniformly distributed in [0, 2 * mean]
+//   exponential: exponentially distributed with the mean
+// Commands can complete out of order with non-constant distributions.
+// Threads in exec_wait block until some command completes.
 namespace cmd {
 
+using clock = std::chrono::steady_clock;
+
+enum class distribution_type { constant, uniform, exponential };
+
+struct timer
+{
+  clock::time_point deadline;
+  ert_packet* pkt;
+
+  bool
+  operator>(const timer& rhs) const
+  {
+    return deadline > rhs.deadline;
+  }
+};
+
 static unsigned int completion_delay_us = 0;
-static xrt_core::task::queue running_queue;
+static distribution_type distribution = distribution_type::constant;
+static std::mt19937_64 generator; // default seed, reproducible latencies
+static std::mutex mutex;
+static std::condition_variable timer_work;  // new timer or stop
+static std::condition_variable completion;  // some command completed
+static std::priority_queue<timer, std::vector<timer>, std::greater<>> timers;
+static uint64_t completion_count = 0;
+static bool stopping = false;
 static std::thread completer;
-static std::atomic<uint64_t> completion_count {0};
 
-struct cmd_type
+static distribution_type
+to_distribution(const std::string& str)
 {
-  xclBufferHandle handle;
-  unsigned long queue_time;
-  cmd_type(xclBufferHandle h)
-    : handle(h), queue_time(xrt_core::time_ns())
-  {}
-};
+  if (str == "constant")
+    return distribution_type::constant;
+  if (str == "uniform")
+    return distribution_type::uniform;
+  if (str == "exponential")
+    return distribution_type::exponential;
+
+  xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                          "Unknown noop completion distribution '" + str + "', using constant");
+  return distribution_type::constant;
+}
+
+// Simulated execution time of a command, mutex must be locked
+static clock::duration
+latency()
+{
+  double mean = completion_delay_us;
+  double us = mean;
+  switch (distribution) {
+  case distribution_type::constant:
+    break;
+  case distribution_type::uniform:
+    us = std::uniform_real_distribution<double>(0.0, 2 * mean)(generator);
+    break;
+  case distribution_type::exponential:
+    us = std::exponential_distribution<double>(1.0 / mean)(generator);
+    break;
+  }
+  return std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::micro>(us));
+}
+
+static void
+mark_cmd_complete(ert_packet* pkt)
+{
+  pkt->state = ERT_CMD_STATE_COMPLETED;
+  {
+    std::lock_guard lk(mutex);
+    ++completion_count;
+  }
+  completion.notify_all();
+}
+
+// Complete commands as their timers expire
+static void
+run_timers()
+{
+  std::unique_lock lk(mutex);
+  while (!stopping) {
+    if (timers.empty()) {
+      timer_work.wait(lk);
+      continue;
+    }
+
+    auto deadline = timers.top().deadline;
+    if (clock::now() < deadline) {
+      timer_work.wait_until(lk, deadline);
+      continue;
+    }
+
+    auto pkt = timers.top().pkt;
+    timers.pop();
+    lk.unlock();
+    mark_cmd_complete(pkt);
+    lk.lock();
+  }
+}
 
 static void
 init()
 {
-  if ( (completion_delay_us = xrt_core::config::get_noop_completion_delay_us()) )
-    completer = std::move(xrt_core::thread(xrt_core::task::worker, std::ref(running_queue)));
+  if ( (completion_delay_us = xrt_core::config::get_noop_completion_delay_us()) ) {
+    distribution = to_distribution(xrt_core::config::get_noop_completion_distribution());
+    completer = xrt_core::thread(run_timers);
+  }
 }
 
 static void
 stop()
 {
   if (completion_delay_us) {
-    running_queue.stop();
+    {
+      std::lock_guard lk(mutex);
+      stopping = true;
+    }
+    timer_work.notify_all();
     completer.join();
   }
 }
 
-static void
-wait()
+// Wait for some command to complete.  Return false if no command
+// completed within msec, a value of 0 waits forever.
+static bool
+wait(int msec)
 {
-  while (!completion_count) ;
+  std::unique_lock lk(mutex);
+  auto completed = [] { return completion_count > 0; };
+  if (msec > 0) {
+    if (!completion.wait_for(lk, std::chrono::milliseconds(msec), completed))
+      return false;
+  }
+  else {
+    completion.wait(lk, completed);
+  }
   --completion_count;
+  return true;
 }
 
-static void
-mark_cmd_handle_complete(xclBufferHandle handle)
+// Wait for specified command to complete.  Return false if the
+// command did not complete within msec, a value of 0 waits forever.
+static bool
+wait(ert_packet* pkt, int msec)
 {
-  //XRT_PRINTF("handle(%d) is complete\n", handle);
-  auto hbuf = buffer::map(handle);
-  auto cmd = reinterpret_cast<ert_packet*>(hbuf);
-  cmd->state = ERT_CMD_STATE_COMPLETED;
-  ++completion_count;
-}
+  std::unique_lock lk(mutex);
+  auto completed = [pkt] { return static_cast<volatile ert_packet*>(pkt)->state >= ERT_CMD_STATE_COMPLETED; };
+  if (msec > 0)
+    return completion.wait_for(lk, std::chrono::milliseconds(msec), completed);
 
-static void
-mark_cmd_complete(cmd_type ct)
-{
-  while (xrt_core::time_ns() - ct.queue_time < completion_delay_us * 1000);
-  mark_cmd_handle_complete(ct.handle);
+  completion.wait(lk, completed);
+  return true;
 }
 
 static void
 add(xclBufferHandle handle)
 {
-  if (completion_delay_us)
-    xrt_core::task::createF(running_queue, mark_cmd_complete, cmd_type(handle));
-  else
-    mark_cmd_handle_complete(handle);
+  auto pkt = reinterpret_cast<ert_packet*>(buffer::map(handle));
+  if (!completion_delay_us) {
+    mark_cmd_complete(pkt);
+    return;
+  }
+
+  bool earliest = false;
+  {
+    std::lock_guard lk(mutex);
+    auto deadline = clock::now() + latency();
+    earliest = timers.empty() || deadline < timers.top().deadline;
+    timers.push({deadline, pkt});
+  }
+  if (earliest)
+    timer_work.notify_one();
 }
 
 struct X
@@ -363,6 +483,59 @@ static X x;
 
 } // cmd
 
+// Simulated shim hw queue, enabled with Runtime.noop_hw_queue.
+//
+// Commands complete as with exec_buf.  Chained commands are checked
+// and executed as by drivers with hw queues: the chained commands
+// must be kernel starts, referenced by kernel mode handle, and only
+// the state of the chain is updated.  Invalid commands are rejected.
+namespace queue {
+
+static void
+check_chain(ert_packet* pkt)
+{
+  auto chain_data = get_ert_cmd_chain_data(pkt);
+  if (!chain_data->command_count
+      || pkt->count != (sizeof(ert_cmd_chain_data) + chain_data->command_count * sizeof(uint64_t)) / sizeof(uint32_t))
+    throw xrt_core::system_error(EINVAL, "invalid chained command");
+
+  for (uint32_t idx = 0; idx < chain_data->command_count; ++idx) {
+    auto cmd = reinterpret_cast<const ert_packet*>(buffer::map(static_cast<unsigned int>(chain_data->data[idx])));
+    switch (cmd->opcode) {
+    case ERT_START_CU:
+    case ERT_EXEC_WRITE:
+    case ERT_START_KEY_VAL:
+      break;
+    default:
+      throw xrt_core::system_error(EINVAL, "unsupported chained command: " + std::to_string(cmd->opcode));
+    }
+  }
+}
+
+class hwqueue : public xrt_core::hwqueue_handle
+{
+public:
+  void
+  submit_command(xrt_core::buffer_handle* cmd) override
+  {
+    auto handle = cmd->get_xcl_handle();
+    auto pkt = reinterpret_cast<ert_packet*>(buffer::map(handle));
+    if (pkt->opcode == ERT_CMD_CHAIN)
+      check_chain(pkt);
+
+    cmd::add(handle);
+  }
+
+  int
+  wait_command(xrt_core::buffer_handle* cmd, uint32_t timeout_ms) const override
+  {
+    auto pkt = reinterpret_cast<ert_packet*>(buffer::map(cmd->get_xcl_handle()));
+    return cmd::wait(pkt, static_cast<int>(timeout_ms)) ? 1 : 0;
+  }
+};
+
+} // queue
+
 
 struct shim
 {
@@ -437,6 +610,16 @@ struct shim
       m_shim->sync_bo(m_fd, static_cast<xclBOSyncDirection>(dir), size, offset);
     }
 
+    // One simulated transfer for all ranges
+    void
+    sync_ranges(direction dir, const std::vector<range>& ranges) override
+    {
+      size_t size = 0;
+      for (const auto& r : ranges)
+        size += r.size;
+      m_shim->sync_bo(m_fd, static_cast<xclBOSyncDirection>(dir), size, 0);
+    }
+
     void
     copy(const buffer_handle*, size_t, size_t, size_t) override
     {
@@ -448,7 +631,7 @@ struct shim
     {
       xclBOProperties xprop;
       m_shim->get_bo_properties(m_fd, &xprop);
-      return {xprop.flags, xprop.size, xprop.paddr};
+      return {xprop.flags, xprop.size, xprop.paddr, xprop.handle};
     }
 
     xclBufferHandle
@@ -464,13 +647,14 @@ struct shim
     xrt::uuid m_uuid;
     slot_id m_slotidx;
     bool m_null = false;
+    std::unique_ptr<queue::hwqueue> m_hwqueue;
 
 public:
     hwcontext(shim* shim, slot_id slotidx, xrt::uuid uuid)
       : m_shim(shim)
       , m_uuid(std::move(uuid))
       , m_slotidx(slotidx)
-
+      , m_hwqueue(xrt_core::config::get_noop_hw_queue() ? std::make_unique<queue::hwqueue>() : nullptr)
     {}
 
     ~hwcontext()
@@ -493,7 +677,7 @@ public:
     xrt_core::hwqueue_handle*
     get_hw_queue() override
     {
-      return nullptr;
+      return m_hwqueue.get();
     }
 
     std::unique_ptr<xrt_core::buffer_handle>
@@ -581,9 +765,12 @@ public:
     buffer::free(handle);
   }
 
+  // Simulate DMA time if a sync bandwidth is configured
   int
-  sync_bo(buffer_handle_type, xclBOSyncDirection, size_t, size_t)
+  sync_bo(buffer_handle_type, xclBOSyncDirection, size_t size, size_t)
   {
+    if (auto mbps = xrt_core::config::get_noop_sync_bandwidth_mbps())
+      std::this_thread::sleep_for(std::chrono::microseconds(size / mbps)); // bytes / (MB/s) = us
     return 0;
   }
 
@@ -616,8 +803,7 @@ public:
   int
   exec_wait(int msec)
   {
-    cmd::wait();
-    return 1;
+    return cmd::wait(msec) ? 1 : 0;
   }
 
   int
@@ -4,6 +4,7 @@
 // ------ I N C L U D E   F I L E S -------------------------------------------
 // Local - Include Files
 #include "SmiWatchMode.h"
+#include "XBUtilities.h"
 #include "core/common/query_requests.h"
 #include "core/common/time.h"
 
@@ -115,7 +116,11 @@ run_watch_mode(const xrt_core::device* device,
   signal_handler::setup();
   
   signal_handler::reset_interrupt();
-  
+
+  // Cache sysfs reads for less than the refresh interval, so every
+  // refresh re-reads each entry once on kept open file descriptors
+  XBUtilities::sysfs_cache_scope sysfs_cache(device, 500);
+
   while (signal_handler::active()) {
     try {
       // Generate current report
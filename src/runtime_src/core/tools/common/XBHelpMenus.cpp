@@ -308,6 +308,10 @@ XBUtilities::produce_reports( const std::shared_ptr<xrt_core::device>& device,
   };
 
   if(dev_report()) {
+    // Reports query many of the same sysfs entries, read each at most
+    // once while producing the reports
+    sysfs_cache_scope sysfs_cache(device.get(), 1000);
+
     // -- Process reports that work on a device
     boost::property_tree::ptree ptDevice;
     auto bdf = xrt_core::device_query<xrt_core::query::pcie_bdf>(device);
@@ -990,3 +990,33 @@ isUsingAdvanced(
   }
   return false;
 }
+
+XBUtilities::sysfs_cache_scope::
+sysfs_cache_scope(const xrt_core::device* device, uint32_t ttl_ms)
+  : m_device(device)
+{
+  if (!m_device)
+    return;
+
+  try {
+    m_previous_ttl = xrt_core::device_query<xrt_core::query::sysfs_cache_ttl>(m_device);
+    xrt_core::device_update<xrt_core::query::sysfs_cache_ttl>(m_device, ttl_ms);
+    m_enabled = true;
+  }
+  catch (const xrt_core::query::exception&) {
+    // Device without sysfs, e.g. on Windows
+  }
+}
+
+XBUtilities::sysfs_cache_scope::
+~sysfs_cache_scope()
+{
+  if (!m_enabled)
+    return;
+
+  try {
+    xrt_core::device_update<xrt_core::query::sysfs_cache_ttl>(m_device, m_previous_ttl);
+  }
+  catch (...) {
+  }
+}
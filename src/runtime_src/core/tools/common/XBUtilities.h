@@ -205,6 +205,21 @@ namespace XBUtilities {
       m_device->close_context(m_uuid, std::numeric_limits<unsigned int>::max());
     }
   };
+
+ /*
+  * Cache sysfs reads of the device for ttl ms while in scope, the
+  * previous setting is restored on exit.  No-op for devices that do
+  * not support xrt_core::query::sysfs_cache_ttl.
+  */
+  struct sysfs_cache_scope
+  {
+    const xrt_core::device* m_device;
+    uint32_t m_previous_ttl = 0;
+    bool m_enabled = false;
+
+    sysfs_cache_scope(const xrt_core::device* device, uint32_t ttl_ms);
+    ~sysfs_cache_scope();
+  };
 };
 
 #endif
@@ -23,6 +23,7 @@ usage(const char* cmd) {
   std::cout << "\t-h|--help Print usage" << std::endl;
   std::cout << "\t-v|--verbose turn on printing verbosely" << std::endl;
   std::cout << "\t-o|--out_dir output directory which holds trace output files" << std::endl;
+  std::cout << "\t-z|--compress compress trace output files" << std::endl;
 }
 
 // NOLINTBEGIN(*-avoid-c-arrays)
@@ -38,6 +39,7 @@ parse_args(struct tracer_arg &args, int argc, const char* argv[])
   }
 
   args.verbose = false;
+  args.compress = false;
   bool got_app = false;
   for (int i = 1; i < argc; i++) {
     std::string arg_str = argv[i];
@@ -51,6 +53,9 @@ parse_args(struct tracer_arg &args, int argc, const char* argv[])
     else if ((!got_app) && (arg_str == "-o" || arg_str == "--out_dir")) {
       args.out_dir = argv[++i];
     }
+    else if ((!got_app) && (arg_str == "-z" || arg_str == "--compress")) {
+      args.compress = true;
+    }
     else if (!got_app && argv[i][0] == '-') {
       std::cerr << "ERROR: xbtracer: unsuppocrted argument: " + arg_str << std::endl;
       return -EINVAL;
@@ -110,6 +115,10 @@ init_tracer(const struct tracer_arg &args)
     xbtracer_perror("failed to set tracer output file \"", opath.string(), "\".");
     return -EINVAL;
   }
+  if (args.compress && setenv_os("XBTRACER_COMPRESS", "1")) {
+    xbtracer_perror("failed to set tracer output compression.");
+    return -EINVAL;
+  }
   xbtracer_pinfo("tracer output to directory \"", opath.string(), "\".");
   return 0;
 }
@@ -18,6 +18,7 @@ constexpr const char* WRAPPER_LIB = "libxrt_wrapper.so." STR(XRT_ABI_VERSION);
 namespace xrt::tools::xbtracer {
 struct tracer_arg {
   bool verbose;
+  bool compress;
   std::vector<std::string> target_app;
   std::string out_dir;
 };
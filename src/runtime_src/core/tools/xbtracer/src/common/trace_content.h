@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef trace_content_h
+#define trace_content_h
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace xrt::tools::xbtracer
+{
+  // Minimum size of content to deduplicate
+  constexpr size_t content_dedup_size_min = 256;
+
+  // Max bytes of traced content kept for deduplication, the oldest
+  // content is dropped and is traced again if it recurs
+  constexpr size_t content_size_max = 256 * 1024 * 1024;
+
+  // class content_cache - traced content by hash
+  //
+  // The tracer and the replay keep the same cache.  Content is added
+  // in trace order, and the oldest content is evicted when the cache
+  // exceeds content_size_max, so at any point in the trace both hold
+  // the same content.  Content with the hash of earlier content
+  // replaces the earlier content.
+  //
+  // Lookup is safe from any thread and locks only the shard of the
+  // hash.  Insertion must be serialized by the caller.
+  class content_cache
+  {
+  public:
+    using content = std::shared_ptr<const std::string>;
+
+  private:
+    static constexpr size_t num_shards = 64;
+
+    struct shard
+    {
+      mutable std::mutex mlock;
+      std::unordered_map<uint64_t, content> contents;
+    };
+
+    std::array<shard, num_shards> shards;
+    std::deque<std::pair<uint64_t, content>> order; // content in trace order
+    size_t size = 0;                                // bytes of cached content
+
+    shard&
+    get_shard(uint64_t hash)
+    {
+      return shards[hash % num_shards];
+    }
+
+    const shard&
+    get_shard(uint64_t hash) const
+    {
+      return shards[hash % num_shards];
+    }
+
+  public:
+    // Most recent content with hash, nullptr if none
+    content
+    find(uint64_t hash) const
+    {
+      const auto& sh = get_shard(hash);
+      std::lock_guard<std::mutex> lock(sh.mlock);
+      auto itr = sh.contents.find(hash);
+      return (itr != sh.contents.end()) ? itr->second : nullptr;
+    }
+
+    // Add content and evict the oldest content while over size
+    void
+    insert(uint64_t hash, content data)
+    {
+      {
+        auto& sh = get_shard(hash);
+        std::lock_guard<std::mutex> lock(sh.mlock);
+        auto& entry = sh.contents[hash];
+        if (entry)
+          size -= entry->size();
+        entry = data;
+      }
+      size += data->size();
+      order.emplace_back(hash, std::move(data));
+
+      // Replaced content is no longer counted
+      while (size > content_size_max && !order.empty()) {
+        auto [oldest_hash, oldest] = std::move(order.front());
+        order.pop_front();
+        auto& sh = get_shard(oldest_hash);
+        std::lock_guard<std::mutex> lock(sh.mlock);
+        auto itr = sh.contents.find(oldest_hash);
+        if (itr != sh.contents.end() && itr->second == oldest) {
+          size -= oldest->size();
+          sh.contents.erase(itr);
+        }
+      }
+    }
+  };
+
+} // namespace xrt::tools::xbtracer
+
+#endif // trace_content_h
@@ -42,6 +42,13 @@ getpid_current_os()
   return static_cast<uint32_t>(pid);
 }
 
+uint32_t
+gettid_current_os()
+{
+  DWORD tid = GetCurrentThreadId();
+  return static_cast<uint32_t>(tid);
+}
+
 int
 inject_library(HANDLE hprocess, const char* lib_path)
 {
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
+#include <array>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
@@ -11,6 +12,7 @@
 
 #include <google/protobuf/message.h>
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/util/json_util.h>
 
@@ -83,8 +85,19 @@ xbtracer_coded_protobuf_to_json(std::ifstream& input, std::ostream& output)
   json_options.preserve_proto_field_names = true;
 
 
+  // Compressed capture files are gzip streams
+  std::array<char, 2> magic{};
+  input.read(magic.data(), magic.size());
+  bool compressed = input.gcount() == static_cast<std::streamsize>(magic.size())
+    && static_cast<unsigned char>(magic[0]) == 0x1f && static_cast<unsigned char>(magic[1]) == 0x8b;
+  input.clear();
+  input.seekg(0, std::ios::beg);
+
   google::protobuf::io::IstreamInputStream raw_input(&input);
-  google::protobuf::io::CodedInputStream coded_input(&raw_input);
+  google::protobuf::io::GzipInputStream gzip_input(&raw_input, google::protobuf::io::GzipInputStream::GZIP);
+  google::protobuf::io::CodedInputStream coded_input(compressed
+    ? static_cast<google::protobuf::io::ZeroCopyInputStream*>(&gzip_input)
+    : static_cast<google::protobuf::io::ZeroCopyInputStream*>(&raw_input));
   uint32_t size = 0;
   if (!coded_input.ReadVarint32(&size)) {
     xbtracer_perror("failed to read header protobuf message length.");
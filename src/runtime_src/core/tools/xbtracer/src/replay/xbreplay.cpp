@@ -1,10 +1,16 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <thread>
@@ -13,8 +19,10 @@
 
 #include <google/protobuf/message.h>
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
+#include "common/trace_content.h"
 #include "common/trace_utils.h"
 #include "replay/xbreplay_common.h"
 
@@ -22,6 +30,7 @@ using namespace xrt::tools::xbtracer;
 
 struct cmd_arg {
   std::string in_file;
+  xbreplay_mode mode = xbreplay_mode::throughput;
 };
 
 static void usage(const char* cmd) {
@@ -30,6 +39,8 @@ static void usage(const char* cmd) {
   std::cout << "Required:" << std::endl;
   std::cout << "\t-i|--input <xbtracer_capture_file> file contains what's captured by xbtracer" << std::endl;
   std::cout << "Optinoal:" << std::endl;
+  std::cout << "\t-m|--mode <throughput|faithful> replay calls as fast as possible (default), or" << std::endl;
+  std::cout << "\t  with the captured time between calls." << std::endl;
   std::cout << "\t-h|--help display this helper messsage." << std::endl;
 }
 
@@ -48,6 +59,18 @@ parse_args(struct cmd_arg &args, int argc, const char* argv[])
     else if (arg_str == "-i" || arg_str == "--input") {
       args.in_file = argv[++i];
     }
+    else if (arg_str == "-m" || arg_str == "--mode") {
+      std::string mode_str = (i + 1 < argc) ? argv[++i] : "";
+      if (mode_str == "throughput")
+        args.mode = xbreplay_mode::throughput;
+      else if (mode_str == "faithful")
+        args.mode = xbreplay_mode::faithful;
+      else {
+        xbtracer_perror("invalid replay mode \"", mode_str, "\".");
+        usage(argv[0]);
+        return -EINVAL;
+      }
+    }
   }
 
   if (args.in_file.empty()) {
@@ -60,19 +83,301 @@ parse_args(struct cmd_arg &args, int argc, const char* argv[])
 }
 
 static
-void
-xbreplay_worker(std::shared_ptr<replayer> replayer_sh,
-                std::shared_ptr<xbreplay_msg_queue> queue_sh)
+const char*
+xbreplay_mode_to_str(xbreplay_mode mode)
 {
-  xbreplay_receive_msgs(replayer_sh, queue_sh);
+  return mode == xbreplay_mode::faithful ? "faithful" : "throughput";
 }
 
+// Distributes captured calls to replay lanes, one lane per captured
+// thread and one replayer per captured process.
+//
+// Calls of different lanes are ordered only where they share XRT
+// objects.  Objects are the arguments of type "void" or "void*" which
+// hold the captured object handles.  The object of a member function
+// ("pimpl") is modified by the call, other objects are only used.  A
+// call which modifies an object is replayed after the earlier calls
+// which used or modified it, a call which uses an object is replayed
+// after the earlier call which modified it.
+class xbreplay_dispatcher
+{
+  using lane_key = std::pair<uint32_t, uint32_t>; // pid, tid
+  using lane_count = std::pair<const xbreplay_lane*, uint64_t>;
+
+  struct object_uses
+  {
+    lane_count modified{nullptr, 0};
+    std::map<const xbreplay_lane*, uint64_t> used; // since modified
+  };
+
+  xbreplay_mode mode;
+  std::chrono::steady_clock::time_point start;
+  uint64_t first_ns = 0;
+  uint64_t last_ns = 0;
+  uint64_t num_calls = 0;
+  std::map<uint32_t, std::shared_ptr<replayer>> replayers;
+  std::map<lane_key, std::unique_ptr<xbreplay_lane>> lanes;
+  std::map<lane_key, std::shared_ptr<xbtracer_proto::Func>> entries; // waiting for exit
+  std::map<std::pair<uint32_t, uint64_t>, object_uses> objects;      // pid, impl
+
+  xbreplay_lane&
+  get_lane(const lane_key& key)
+  {
+    auto it = lanes.find(key);
+    if (it != lanes.end())
+      return *it->second;
+
+    auto& replayer_sh = replayers[key.first];
+    if (!replayer_sh)
+      replayer_sh = std::make_shared<replayer>();
+    auto lane = std::make_unique<xbreplay_lane>(key.first, key.second, replayer_sh, mode, start);
+    return *lanes.emplace(key, std::move(lane)).first->second;
+  }
+
+  static void
+  get_objects(const xbtracer_proto::Func& func_msg, std::map<uint64_t, bool>& impls)
+  {
+    for (const auto& arg : func_msg.arg()) {
+      if (arg.type() != "void" && arg.type() != "void*")
+        continue;
+      uint64_t impl = 0;
+      if (arg.value().size() != sizeof(impl))
+        continue;
+      std::memcpy(&impl, arg.value().data(), sizeof(impl));
+      if (impl)
+        impls[impl] |= (arg.name() == "pimpl");
+    }
+  }
+
+  void
+  schedule(const lane_key& key, const std::shared_ptr<xbreplay_call>& call)
+  {
+    auto& lane = get_lane(key);
+    auto entry_ns = xbreplay_get_timestamp_ns(*call->entry);
+    call->offset_ns = entry_ns > first_ns ? entry_ns - first_ns : 0;
+
+    std::map<uint64_t, bool> impls;
+    get_objects(*call->entry, impls);
+    if (call->exit)
+      get_objects(*call->exit, impls);
+
+    std::map<const xbreplay_lane*, uint64_t> deps;
+    auto add_dep = [&lane, &deps](const xbreplay_lane* dep_lane, uint64_t count) {
+      if (!dep_lane || dep_lane == &lane)
+        return;
+      auto& dep_count = deps[dep_lane];
+      dep_count = std::max(dep_count, count);
+    };
+    for (const auto& [impl, modifies] : impls) {
+      const auto& uses = objects[{key.first, impl}];
+      add_dep(uses.modified.first, uses.modified.second);
+      if (modifies) {
+        for (const auto& use : uses.used)
+          add_dep(use.first, use.second);
+      }
+    }
+    call->deps.assign(deps.begin(), deps.end());
+
+    auto count = lane.push(call);
+    ++num_calls;
+    for (const auto& [impl, modifies] : impls) {
+      auto& uses = objects[{key.first, impl}];
+      if (modifies) {
+        uses.modified = {&lane, count};
+        uses.used.clear();
+      }
+      else
+        uses.used[&lane] = count;
+    }
+  }
+
+  // Percentile of durations in us
+  static double
+  percentile(std::vector<uint64_t> values, double pct)
+  {
+    if (values.empty())
+      return 0;
+    auto idx = static_cast<size_t>(pct / 100 * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(idx), values.end());
+    return static_cast<double>(values[idx]) / 1000;
+  }
+
+  static double
+  average(const std::vector<uint64_t>& values)
+  {
+    if (values.empty())
+      return 0;
+    auto sum = std::accumulate(values.begin(), values.end(), 0.0);
+    return sum / static_cast<double>(values.size()) / 1000;
+  }
+
+  static void
+  print_durations(const std::vector<uint64_t>& values)
+  {
+    if (values.empty()) {
+      std::cout << std::setw(27) << "-";
+      return;
+    }
+    std::cout << std::setw(9) << average(values) << std::setw(9) << percentile(values, 50)
+              << std::setw(9) << percentile(values, 99);
+  }
+
+public:
+  explicit
+  xbreplay_dispatcher(xbreplay_mode mode_in)
+    : mode(mode_in)
+  {}
+
+  // Add captured message, calls are queued to their lane when the
+  // exit message of the call is added
+  bool
+  dispatch(const std::shared_ptr<xbtracer_proto::Func>& func_msg)
+  {
+    auto msg_ns = xbreplay_get_timestamp_ns(*func_msg);
+    if (!first_ns) {
+      first_ns = msg_ns;
+      start = std::chrono::steady_clock::now();
+    }
+    last_ns = std::max(last_ns, msg_ns);
+
+    lane_key key{func_msg->pid(), func_msg->tid()};
+    auto it = entries.find(key);
+    std::string json_str;
+    if (func_msg->status() == xbtracer_proto::Func_FuncStatus_FUNC_EXIT) {
+      if (it == entries.end() || it->second->name() != func_msg->name()) {
+        (void)xbreplay_func_proto_to_json(*func_msg, json_str);
+        xbtracer_perror("Invalid sequence, expect function entry, but got function exit for:",
+                        func_msg->name(), ":\n", json_str);
+        return false;
+      }
+      auto call = std::make_shared<xbreplay_call>();
+      call->entry = it->second;
+      call->exit = func_msg;
+      entries.erase(it);
+      schedule(key, call);
+      return true;
+    }
+
+    if (it != entries.end()) {
+      (void)xbreplay_func_proto_to_json(*func_msg, json_str);
+      xbtracer_perror("Invalid sequence, expect function exit of ", it->second->name(),
+                      ", but got:", func_msg->name(), ":\n", json_str);
+      return false;
+    }
+    if (func_msg->status() == xbtracer_proto::Func_FuncStatus_FUNC_ENTRY) {
+      entries.emplace(key, func_msg);
+      return true;
+    }
+    auto call = std::make_shared<xbreplay_call>();
+    call->entry = func_msg;
+    schedule(key, call);
+    return true;
+  }
+
+  // Wait for lanes to replay all calls, and release replayed objects
+  void
+  finish()
+  {
+    for (const auto& entry : entries)
+      xbtracer_pinfo("No exit message for ", entry.second->name(), ", pid: ", entry.first.first,
+                     ", tid: ", entry.first.second, ", not replayed.");
+    for (auto& lane : lanes)
+      lane.second->join();
+    for (auto& replayer_sh : replayers)
+      replayer_sh.second->untrack_all();
+  }
+
+  // Captured and replayed latency per function, valid after finish()
+  void
+  report() const
+  {
+    std::chrono::duration<double> replayed = std::chrono::steady_clock::now() - start;
+    std::map<std::string, xbreplay_func_stats> stats;
+    for (const auto& lane : lanes) {
+      for (const auto& [name, lane_stats] : lane.second->get_stats()) {
+        auto& func_stats = stats[name];
+        func_stats.captured_ns.insert(func_stats.captured_ns.end(), lane_stats.captured_ns.begin(),
+                                      lane_stats.captured_ns.end());
+        func_stats.replayed_ns.insert(func_stats.replayed_ns.end(), lane_stats.replayed_ns.begin(),
+                                      lane_stats.replayed_ns.end());
+      }
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Replayed " << num_calls << " calls of " << replayers.size() << " processes in "
+              << lanes.size() << " lanes, mode: " << xbreplay_mode_to_str(mode)
+              << ", captured: " << static_cast<double>(last_ns - first_ns) / 1e9
+              << " s, replayed: " << replayed.count() << " s.\n"
+              << "   calls          captured (us)             replayed (us)  function\n"
+              << "              avg      p50      p99      avg      p50      p99\n"
+              << std::setprecision(1);
+    for (const auto& [name, func_stats] : stats) {
+      std::cout << std::setw(8) << std::max(func_stats.captured_ns.size(), func_stats.replayed_ns.size());
+      print_durations(func_stats.captured_ns);
+      print_durations(func_stats.replayed_ns);
+      std::cout << "  " << name << '\n';
+    }
+  }
+};
+
+// Restore deduplicated argument content.  The tracer omits content
+// that has already been traced and references the most recent
+// content with the same hash and size.  Content is cached in trace
+// order with the same eviction as in the tracer, content evicted by
+// the tracer is traced again.
 static
 bool
-xbreplay_coded_get_sequence_from_file(std::ifstream& input)
+xbreplay_restore_content(xbtracer_proto::Func& func_msg, xrt::tools::xbtracer::content_cache& contents)
 {
+  for (auto& arg : *func_msg.mutable_arg()) {
+    if (!arg.content_hash())
+      continue;
+
+    if (!arg.content_ref()) {
+      contents.insert(arg.content_hash(), std::make_shared<const std::string>(arg.value()));
+      continue;
+    }
+
+    auto content = contents.find(arg.content_hash());
+    if (!content || content->size() != arg.size()) {
+      xbtracer_perror(func_msg.name(), ", no content for argument \"", arg.name(), "\".");
+      return false;
+    }
+    arg.set_value(*content);
+  }
+  return true;
+}
+
+// Compressed capture files are gzip streams
+static
+bool
+xbreplay_is_compressed(std::ifstream& input)
+{
+  constexpr unsigned char gzip_magic0 = 0x1f;
+  constexpr unsigned char gzip_magic1 = 0x8b;
+  std::array<char, 2> magic{};
+  input.read(magic.data(), magic.size());
+  bool compressed = input.gcount() == static_cast<std::streamsize>(magic.size())
+    && static_cast<unsigned char>(magic[0]) == gzip_magic0
+    && static_cast<unsigned char>(magic[1]) == gzip_magic1;
+  input.clear();
+  input.seekg(0, std::ios::beg);
+  return compressed;
+}
+
+static
+bool
+xbreplay_coded_get_sequence_from_file(std::ifstream& input, xbreplay_mode mode)
+{
+  bool compressed = xbreplay_is_compressed(input);
   google::protobuf::io::IstreamInputStream raw_input(&input);
-  google::protobuf::io::CodedInputStream coded_input(&raw_input);
+  google::protobuf::io::GzipInputStream gzip_input(&raw_input, google::protobuf::io::GzipInputStream::GZIP);
+  google::protobuf::io::ZeroCopyInputStream* zero_copy_input = &raw_input;
+  if (compressed) {
+    xbtracer_pinfo("reading compressed capture.");
+    zero_copy_input = &gzip_input;
+  }
+  google::protobuf::io::CodedInputStream coded_input(zero_copy_input);
   uint32_t size = 0;
   if (!coded_input.ReadVarint32(&size)) {
     xbtracer_perror("failed to read header protobuf message length.");
@@ -87,15 +392,14 @@ xbreplay_coded_get_sequence_from_file(std::ifstream& input)
   coded_input.PopLimit(limit);
   xbtracer_pinfo("APIs sequence captured for XRT version: ", header_msg.version(), ".");
 
-  // We only have one queue at the moment
-  std::shared_ptr<xbreplay_msg_queue> queue_sh = std::make_shared<xbreplay_msg_queue>();
-  std::shared_ptr<replayer> replayer_sh = std::make_shared<replayer>();
-  std::thread replayer_t(xbreplay_worker, replayer_sh, queue_sh);
+  // Calls are replayed in lanes of captured processes and threads
+  xbreplay_dispatcher dispatcher(mode);
 
   // The version of protobuf we have doesn't have IsAtEnd() or PeekTag() method which can be
   // used to check if it is the end of stream. And thus, we read the 32bit for size. If we
   // fail to read the 32bit size, it means it reaches the end of stream.
   xbtracer_pinfo("reading XRT APIs...");
+  xrt::tools::xbtracer::content_cache contents;
   while (coded_input.ReadVarint32(&size)) {
     limit = coded_input.PushLimit(static_cast<int>(size));
     std::shared_ptr<xbtracer_proto::Func> sh_func_msg = std::make_shared<xbtracer_proto::Func>();
@@ -104,12 +408,15 @@ xbreplay_coded_get_sequence_from_file(std::ifstream& input)
       return false;
     }
     coded_input.PopLimit(limit);
-    queue_sh->push(sh_func_msg);
+    if (!xbreplay_restore_content(*sh_func_msg, contents))
+      return false;
+    if (!dispatcher.dispatch(sh_func_msg))
+      return false;
   }
   xbtracer_pinfo("Done reading XRT APIs...");
-  queue_sh->end_queue();
 
-  replayer_t.join();
+  dispatcher.finish();
+  dispatcher.report();
   google::protobuf::ShutdownProtobufLibrary();
   return true;
 }
@@ -142,7 +449,7 @@ main(int argc, const char* argv[])
   }
 
   xbtracer_pinfo("Replaying \"", args.in_file, "\".");
-  if (!xbreplay_coded_get_sequence_from_file(in_file)) {
+  if (!xbreplay_coded_get_sequence_from_file(in_file, args.mode)) {
     xbtracer_perror("Failed to replay \"", args.in_file, "\".");
     return -EINVAL;
   }
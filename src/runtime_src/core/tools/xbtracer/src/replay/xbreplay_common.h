@@ -1,15 +1,20 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #ifndef xbreplay_common_h
 #define xbreplay_common_h
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <tuple>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 #include <condition_variable>
 
 #include <xrt.h>
@@ -39,19 +44,40 @@
 
 namespace xrt::tools::xbtracer
 {
+enum class xbreplay_mode
+{
+  throughput, // replay calls as fast as the order of calls allows
+  faithful,   // reproduce the captured time of calls
+};
+
+class xbreplay_lane;
+
+// Captured call to replay, the entry and exit messages of a traced
+// function, or an injected message which has no exit message.
+struct xbreplay_call
+{
+  std::shared_ptr<xbtracer_proto::Func> entry;
+  std::shared_ptr<xbtracer_proto::Func> exit;
+  // Calls of other lanes which have to be replayed first, each is a
+  // lane and the number of its calls which have to be completed.
+  std::vector<std::pair<const xbreplay_lane*, uint64_t>> deps;
+  // Entry time relative to the first captured message
+  uint64_t offset_ns = 0;
+};
+
 class xbreplay_msg_queue
 {
 public:
   xbreplay_msg_queue();
 
   void
-  push(const std::shared_ptr<xbtracer_proto::Func>& value);
+  push(const std::shared_ptr<xbreplay_call>& value);
 
   bool
-  try_pop(std::shared_ptr<xbtracer_proto::Func>& result);
+  try_pop(std::shared_ptr<xbreplay_call>& result);
 
   void
-  wait_and_pop(std::shared_ptr<xbtracer_proto::Func>& result);
+  wait_and_pop(std::shared_ptr<xbreplay_call>& result);
 
   bool
   empty();
@@ -60,12 +86,19 @@ public:
   end_queue();
 
 private:
-  std::queue<std::shared_ptr<xbtracer_proto::Func>> queue{};
+  std::queue<std::shared_ptr<xbreplay_call>> queue{};
   std::mutex mlock;
   std::condition_variable cond;
   uint32_t ended;
 };
 
+// Captured and replayed durations of the calls of one function
+struct xbreplay_func_stats
+{
+  std::vector<uint64_t> captured_ns;
+  std::vector<uint64_t> replayed_ns;
+};
+
 
 class replayer
 {
@@ -75,6 +108,10 @@ public:
   int
   replay(const xbtracer_proto::Func* entry_msg, const xbtracer_proto::Func* exit_msg);
 
+  // Whether there is a replay function for the function signature
+  bool
+  can_replay(const std::string& func_s) const;
+
   int
   track(std::shared_ptr<xrt::bo>& obj, uint64_t impl);
 
@@ -261,9 +298,82 @@ copy_data_from_proto_arg(const xbtracer_proto::Func& func_msg, uint32_t arg_id,
 const void*
 get_data_from_proto_arg(const xbtracer_proto::Func& func_msg, uint32_t arg_id, size_t& size);
 
-void
-xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
-                      std::shared_ptr<xbreplay_msg_queue>& queue);
+bool
+xbreplay_func_proto_to_json(const xbtracer_proto::Func& func_msg, std::string& json_str);
+
+uint64_t
+xbreplay_get_timestamp_ns(const xbtracer_proto::Func& func_msg);
+
+// Replay lane of one captured thread
+//
+// Calls of a lane are replayed in captured order by the worker thread
+// of the lane.  Lanes of the same process share the replayer and thus
+// the replayed XRT objects.  A call waits for the calls of other lanes
+// it depends on, and in faithful mode until its captured entry time
+// relative to the start of the replay.
+class xbreplay_lane
+{
+public:
+  xbreplay_lane(uint32_t pid, uint32_t tid, std::shared_ptr<replayer> replayer_sh,
+                xbreplay_mode mode, std::chrono::steady_clock::time_point start);
+
+  xbreplay_lane(const xbreplay_lane&) = delete;
+  xbreplay_lane& operator=(const xbreplay_lane&) = delete;
+
+  ~xbreplay_lane();
+
+  // Queue call for replay, returns the number of calls queued to
+  // the lane so far.  Called by the reader thread only.
+  uint64_t
+  push(const std::shared_ptr<xbreplay_call>& call);
+
+  // End of captured calls, wait for lane to replay queued calls
+  void
+  join();
+
+  // Wait until count calls of the lane are replayed
+  void
+  wait_completed(uint64_t count) const;
+
+  uint32_t
+  get_pid() const
+  {
+    return pid;
+  }
+
+  uint32_t
+  get_tid() const
+  {
+    return tid;
+  }
+
+  // Valid after join()
+  const std::map<std::string, xbreplay_func_stats>&
+  get_stats() const
+  {
+    return stats;
+  }
+
+private:
+  void
+  receive_calls();
+
+  void
+  replay_call(const xbreplay_call& call);
+
+  uint32_t pid;
+  uint32_t tid;
+  std::shared_ptr<replayer> replayer_sh;
+  xbreplay_mode mode;
+  std::chrono::steady_clock::time_point start;
+  xbreplay_msg_queue queue;
+  uint64_t pushed = 0;
+  std::atomic<uint64_t> completed{0};
+  mutable std::mutex completed_mlock;
+  mutable std::condition_variable completed_cond;
+  std::map<std::string, xbreplay_func_stats> stats{};
+  std::thread worker;
+};
 
 } // namespace xrt::tools::xbtracer
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #include <cstring>
 #include <iostream>
@@ -13,7 +13,7 @@ xbreplay_msg_queue(): ended(0) {}
 
 void
 xbreplay_msg_queue::
-push(const std::shared_ptr<xbtracer_proto::Func>& value)
+push(const std::shared_ptr<xbreplay_call>& value)
 {
   {
     std::lock_guard<std::mutex> lock(mlock);
@@ -24,7 +24,7 @@ push(const std::shared_ptr<xbtracer_proto::Func>& value)
 
 bool
 xbreplay_msg_queue::
-try_pop(std::shared_ptr<xbtracer_proto::Func>& result)
+try_pop(std::shared_ptr<xbreplay_call>& result)
 {
   std::lock_guard<std::mutex> lock(mlock);
   if (queue.empty())
@@ -36,7 +36,7 @@ try_pop(std::shared_ptr<xbtracer_proto::Func>& result)
 
 void
 xbreplay_msg_queue::
-wait_and_pop(std::shared_ptr<xbtracer_proto::Func>& result)
+wait_and_pop(std::shared_ptr<xbreplay_call>& result)
 {
   std::unique_lock<std::mutex> lock(mlock);
   cond.wait(lock, [this]{ return !queue.empty() || ended; });
@@ -58,8 +58,11 @@ void
 xbreplay_msg_queue::
 end_queue()
 {
-  std::lock_guard<std::mutex> lock(mlock);
-  ended = 1;
+  {
+    std::lock_guard<std::mutex> lock(mlock);
+    ended = 1;
+  }
+  cond.notify_all();
 }
 
 } // namespace xrt::tools::xbtracer
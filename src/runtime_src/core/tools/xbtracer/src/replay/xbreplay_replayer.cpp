@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #include <cstring>
 #include <iostream>
@@ -44,6 +44,13 @@ replay(const xbtracer_proto::Func* entry_msg, const xbtracer_proto::Func* exit_m
   return func(entry_msg, exit_msg);
 }
 
+bool
+replayer::
+can_replay(const std::string& func_s) const
+{
+  return xbreplay_funcs_map.find(func_s) != xbreplay_funcs_map.end();
+}
+
 int
 replayer::
 track(std::shared_ptr<xrt::bo>& obj, uint64_t impl)
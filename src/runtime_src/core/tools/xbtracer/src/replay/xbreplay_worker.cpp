@@ -1,7 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
+#include <chrono>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 #include "replay/xbreplay_common.h"
 #include <google/protobuf/util/json_util.h>
@@ -10,7 +13,6 @@
 namespace xrt::tools::xbtracer
 {
 
-static
 bool
 xbreplay_func_proto_to_json(const xbtracer_proto::Func& func_msg, std::string& json_str)
 {
@@ -33,48 +35,105 @@ xbreplay_func_proto_to_json(const xbtracer_proto::Func& func_msg, std::string& j
 #endif
 }
 
+uint64_t
+xbreplay_get_timestamp_ns(const xbtracer_proto::Func& func_msg)
+{
+  constexpr uint64_t s_to_ns = 1000000000;
+  const auto& ts = func_msg.timestamp();
+  return static_cast<uint64_t>(ts.seconds()) * s_to_ns + static_cast<uint64_t>(ts.nanos());
+}
+
+xbreplay_lane::
+xbreplay_lane(uint32_t pid_in, uint32_t tid_in, std::shared_ptr<replayer> replayer_in,
+              xbreplay_mode mode_in, std::chrono::steady_clock::time_point start_in)
+  : pid(pid_in), tid(tid_in), replayer_sh(std::move(replayer_in)), mode(mode_in), start(start_in),
+    worker(&xbreplay_lane::receive_calls, this)
+{}
+
+xbreplay_lane::
+~xbreplay_lane()
+{
+  join();
+}
+
+uint64_t
+xbreplay_lane::
+push(const std::shared_ptr<xbreplay_call>& call)
+{
+  queue.push(call);
+  return ++pushed;
+}
+
+void
+xbreplay_lane::
+join()
+{
+  if (!worker.joinable())
+    return;
+  queue.end_queue();
+  worker.join();
+}
+
+void
+xbreplay_lane::
+wait_completed(uint64_t count) const
+{
+  if (completed.load(std::memory_order_acquire) >= count)
+    return;
+  std::unique_lock<std::mutex> lock(completed_mlock);
+  completed_cond.wait(lock, [this, count]{ return completed.load() >= count; });
+}
+
+void
+xbreplay_lane::
+replay_call(const xbreplay_call& call)
+{
+  for (const auto& dep : call.deps)
+    dep.first->wait_completed(dep.second);
+
+  if (mode == xbreplay_mode::faithful)
+    std::this_thread::sleep_until(start + std::chrono::nanoseconds(call.offset_ns));
+
+  const auto& func_entry = call.entry;
+  auto replay_start = std::chrono::steady_clock::now();
+  if (replayer_sh->replay(func_entry.get(), call.exit.get())) {
+    std::string json_str;
+    (void)xbreplay_func_proto_to_json(call.exit ? *call.exit : *func_entry, json_str);
+    xbtracer_pcritical("Failed to replay ", func_entry->name(), ".\n", json_str);
+  }
+  auto replay_end = std::chrono::steady_clock::now();
+
+  auto& func_stats = stats[func_entry->name()];
+  if (call.exit) {
+    auto entry_ns = xbreplay_get_timestamp_ns(*func_entry);
+    auto exit_ns = xbreplay_get_timestamp_ns(*call.exit);
+    func_stats.captured_ns.push_back(exit_ns > entry_ns ? exit_ns - entry_ns : 0);
+  }
+  // functions without replay implementation are only counted as captured
+  if (replayer_sh->can_replay(func_entry->name())) {
+    auto replay_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(replay_end - replay_start);
+    func_stats.replayed_ns.push_back(static_cast<uint64_t>(replay_ns.count()));
+  }
+}
+
 void
-xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
-                      std::shared_ptr<xbreplay_msg_queue>& queue)
+xbreplay_lane::
+receive_calls()
 {
-  xbtracer_pinfo("Replay worker waiting for messages...");
-  std::shared_ptr<xbtracer_proto::Func> func_entry;
-  bool wait_exit_n_entry = false;
-  std::string json_str;
-  while(true) {
-    std::shared_ptr<xbtracer_proto::Func> sh_func_msg;
-    queue->wait_and_pop(sh_func_msg);
-    if (!sh_func_msg) {
-      xbtracer_pinfo("No more XRT function messages provided by main thread.");
-      replayer_sh->untrack_all();
+  xbtracer_pinfo("Replay worker of pid: ", pid, ", tid: ", tid, " waiting for messages...");
+  while (true) {
+    std::shared_ptr<xbreplay_call> call;
+    queue.wait_and_pop(call);
+    if (!call) {
+      xbtracer_pinfo("No more XRT function messages for pid: ", pid, ", tid: ", tid, ".");
       return;
     }
-    if (!wait_exit_n_entry) {
-      if ((sh_func_msg->status() != xbtracer_proto::Func_FuncStatus_FUNC_ENTRY) &&
-          (sh_func_msg->status() != xbtracer_proto::Func_FuncStatus_FUNC_INJECT)) {
-        json_str.clear();
-        (void)xbreplay_func_proto_to_json(*sh_func_msg, json_str);
-        xbtracer_pcritical("Invalid sequence, expect function entry, but got function exit for:",
-                           sh_func_msg->name(), ":\n",  json_str);
-      }
-      func_entry = sh_func_msg;
-      if (sh_func_msg->status() == xbtracer_proto::Func_FuncStatus_FUNC_INJECT) {
-        if (replayer_sh->replay(func_entry.get(), nullptr)) {
-          json_str.clear();
-          (void)xbreplay_func_proto_to_json(*sh_func_msg, json_str);
-          xbtracer_pcritical("Failed to replay ", func_entry->name(), ".\n", json_str);
-        }
-        continue;
-      }
-      wait_exit_n_entry = true;
-    } else {
-      wait_exit_n_entry = false;
-      if (replayer_sh->replay(func_entry.get(), sh_func_msg.get())) {
-        json_str.clear();
-        (void)xbreplay_func_proto_to_json(*sh_func_msg, json_str);
-        xbtracer_pcritical("Failed to replay ", func_entry->name(), ".\n", json_str);
-      }
+    replay_call(*call);
+    {
+      std::lock_guard<std::mutex> lock(completed_mlock);
+      completed.fetch_add(1, std::memory_order_release);
     }
+    completed_cond.notify_all();
   }
 }
 
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
+#include <algorithm>
 #include <array>
 #include <cerrno>
 #include <cstdlib>
@@ -11,6 +12,10 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <string_view>
+#include <tuple>
+
+#include <google/protobuf/io/gzip_stream.h>
 
 #include "xrt/detail/version-git.h"
 #include "wrapper/tracer.h"
@@ -23,9 +28,13 @@
 
 namespace xrt::tools::xbtracer
 {
-  tracer::tracer(const std::string& outf, tracer::level tl) :
+  // Interval at which the writer thread drains thread trace buffers
+  constexpr std::chrono::milliseconds writer_interval{100};
+
+  tracer::tracer(const std::string& outf, tracer::level tl, bool compress) :
 	 tracer_ofile(outf, std::ios::out | std::ios::binary | std::ios::trunc),
-         tlevel(tl)
+         tlevel(tl),
+         compress_output(compress)
   {
     if (!tracer_ofile || !tracer_ofile.is_open())
       throw std::runtime_error("xbtracer failed to open output file: \"" + std::string(outf) + "\".");
@@ -58,10 +67,20 @@ namespace xrt::tools::xbtracer
     std::get<0>(xrt_xclbin_mem_ref_tracker) = "xrt::xclbin::mem::~mem()";
     std::get<0>(xrt_xclbin_repo_ref_tracker) = "xrt::xclbin_repository::~xclbin_repository()";
     std::get<0>(xrt_xclbin_repo_iter_ref_tracker) = "xrt::xclbin_repository::iterator::~iterator()";
+    writer_thread = std::thread(&tracer::writer_loop, this);
   }
 
   tracer::~tracer()
   {
+    {
+      std::lock_guard<std::mutex> lock(writer_mlock);
+      writer_stop = true;
+    }
+    writer_cv.notify_one();
+    if (writer_thread.joinable())
+      writer_thread.join();
+    drain(true);
+
     if (coreutil_lib_h)
       close_library_os(coreutil_lib_h);
     if (tracer_ofile.is_open())
@@ -74,6 +93,218 @@ namespace xrt::tools::xbtracer
     return get_proc_addr_os(coreutil_lib_h, symbol);
   }
 
+  tracer::thread_buffer&
+  tracer::get_thread_buffer()
+  {
+    // The buffer is shared with the tracer such that messages of a
+    // thread that has exited are still written.
+    static thread_local std::shared_ptr<thread_buffer> tbuf;
+    if (!tbuf) {
+      tbuf = std::make_shared<thread_buffer>();
+      std::lock_guard<std::mutex> lock(buffers_mlock);
+      thread_buffers.push_back(tbuf);
+    }
+    return *tbuf;
+  }
+
+  void
+  tracer::writer_loop()
+  {
+    std::unique_lock<std::mutex> lock(writer_mlock);
+    while (!writer_stop) {
+      writer_cv.wait_for(lock, writer_interval);
+      lock.unlock();
+      drain(false);
+      lock.lock();
+    }
+  }
+
+  // Write trace messages from all thread buffers to the output file.
+  //
+  // Messages must be written in sequence number order.  A thread
+  // takes a sequence number and adds the message with its buffer
+  // locked, so when all buffers have been drained, every message
+  // with a sequence number less than the sequence number read before
+  // draining has been collected.  Messages with larger sequence
+  // numbers are held back until next drain unless this is the final
+  // drain.
+  void
+  tracer::drain(bool final)
+  {
+    uint64_t watermark = trace_seq.load();
+
+    std::vector<std::shared_ptr<thread_buffer>> tbufs;
+    {
+      std::lock_guard<std::mutex> lock(buffers_mlock);
+      // remove drained buffers of threads that have exited
+      thread_buffers.erase
+        (std::remove_if(thread_buffers.begin(), thread_buffers.end(),
+                        [](const auto& tbuf) { return tbuf.use_count() == 1 && tbuf->records.empty(); }),
+         thread_buffers.end());
+      tbufs = thread_buffers;
+    }
+
+    std::vector<thread_buffer> drained(tbufs.size());
+    for (size_t idx = 0; idx < tbufs.size(); ++idx) {
+      std::lock_guard<std::mutex> lock(tbufs[idx]->mlock);
+      std::swap(drained[idx].data, tbufs[idx]->data);
+      std::swap(drained[idx].records, tbufs[idx]->records);
+    }
+
+    // sequence number, message data, message size
+    std::vector<std::tuple<uint64_t, const char*, size_t>> msgs;
+    for (const auto& [seq, data] : pending_records)
+      msgs.emplace_back(seq, data.data(), data.size());
+    for (const auto& tbuf : drained) {
+      for (size_t idx = 0; idx < tbuf.records.size(); ++idx) {
+        auto [seq, offset] = tbuf.records[idx];
+        auto end = (idx + 1 < tbuf.records.size()) ? tbuf.records[idx + 1].second : tbuf.data.size();
+        msgs.emplace_back(seq, tbuf.data.data() + offset, end - offset);
+      }
+    }
+    if (msgs.empty())
+      return;
+
+    std::sort(msgs.begin(), msgs.end(),
+              [](const auto& m1, const auto& m2) { return std::get<0>(m1) < std::get<0>(m2); });
+
+    // Hold back messages that may be preceded by messages not yet drained
+    auto end = final
+      ? msgs.end()
+      : std::find_if(msgs.begin(), msgs.end(), [watermark](const auto& m) { return std::get<0>(m) >= watermark; });
+    std::vector<std::pair<uint64_t, std::string>> held;
+    for (auto itr = end; itr != msgs.end(); ++itr)
+      held.emplace_back(std::get<0>(*itr), std::string(std::get<1>(*itr), std::get<2>(*itr)));
+
+    // Compressed output is written as one gzip member per drain, such
+    // that the output file is valid up to last drain.
+    if (compress_output) {
+      std::string compressed;
+      {
+        google::protobuf::io::StringOutputStream string_output(&compressed);
+        google::protobuf::io::GzipOutputStream::Options options;
+        options.format = google::protobuf::io::GzipOutputStream::GZIP;
+        google::protobuf::io::GzipOutputStream gzip_output(&string_output, options);
+        {
+          google::protobuf::io::CodedOutputStream coded_output(&gzip_output);
+          for (auto itr = msgs.begin(); itr != end; ++itr)
+            coded_output.WriteRaw(std::get<1>(*itr), static_cast<int>(std::get<2>(*itr)));
+        }
+        if (!gzip_output.Close())
+          xbtracer_perror("failed to compress trace messages, ", gzip_output.ZlibErrorMessage(), ".");
+      }
+      tracer_ofile.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    }
+    else {
+      for (auto itr = msgs.begin(); itr != end; ++itr)
+        tracer_ofile.write(std::get<1>(*itr), static_cast<std::streamsize>(std::get<2>(*itr)));
+    }
+    tracer_ofile.flush();
+
+    pending_records = std::move(held);
+  }
+
+  // Content is added to the cache and the message takes its sequence
+  // number with content_mlock held.  A message that references content
+  // is therefore always sequenced after the message that carries it,
+  // and the cache holds the content of the trace up to the message.
+  // The content is copied for the cache and the message is serialized
+  // without content_mlock held.
+  bool
+  tracer::write_protobuf_msg(xbtracer_proto::Func& msg)
+  {
+    auto& tbuf = get_thread_buffer();
+    std::lock_guard<std::mutex> lock(tbuf.mlock);
+    auto has_content = std::any_of(msg.arg().begin(), msg.arg().end(),
+                                   [](const auto& arg) { return arg.content_hash() != 0; });
+    if (!has_content)
+      return add_msg_nolock(tbuf, msg);
+
+    // content of each argument with content, carried or referenced
+    std::vector<content_cache::content> arg_contents;
+    for (const auto& arg : msg.arg()) {
+      if (!arg.content_hash())
+        continue;
+      if (!arg.content_ref()) {
+        arg_contents.push_back(std::make_shared<const std::string>(arg.value()));
+        continue;
+      }
+      arg_contents.push_back(take_content_pin_nolock(tbuf, arg.content_hash()));
+      if (!arg_contents.back()) {
+        xbtracer_perror(msg.name(), ", no content for argument \"", arg.name(), "\".");
+        return false;
+      }
+    }
+
+    uint64_t seq = 0;
+    {
+      std::lock_guard<std::mutex> content_lock(content_mlock);
+      auto content_itr = arg_contents.begin();
+      for (auto& arg : *msg.mutable_arg()) {
+        auto hash = arg.content_hash();
+        if (!hash)
+          continue;
+
+        auto content = std::move(*content_itr++);
+        if (!arg.content_ref()) {
+          contents.insert(hash, std::move(content));
+          continue;
+        }
+
+        // Referenced content that has been evicted or replaced since
+        // it was found is traced again
+        if (contents.find(hash) != content) {
+          arg.set_value(*content);
+          arg.set_content_ref(false);
+          contents.insert(hash, std::move(content));
+        }
+      }
+      seq = trace_seq++;
+    }
+    return add_msg_nolock(tbuf, msg, seq);
+  }
+
+  // Content matches if hash, size, and bytes are equal.  The content
+  // is hashed and compared in place, and is copied to the argument
+  // only if not cached.
+  void
+  tracer::trace_content(xbtracer_proto::Arg& arg, const char* data, size_t size)
+  {
+    arg.set_size(static_cast<uint32_t>(size));
+    if (size < content_dedup_size_min) {
+      arg.set_value(data, size);
+      return;
+    }
+
+    // 0 is reserved for content that is not deduplicated
+    auto hash = std::hash<std::string_view>{}(std::string_view{data, size}) | 1;
+    arg.set_content_hash(hash);
+
+    auto cached = contents.find(hash);
+    if (cached && cached->size() == size && std::memcmp(cached->data(), data, size) == 0) {
+      auto& tbuf = get_thread_buffer();
+      std::lock_guard<std::mutex> lock(tbuf.mlock);
+      tbuf.content_pins.emplace_back(hash, std::move(cached));
+      arg.set_content_ref(true);
+      return;
+    }
+
+    arg.set_value(data, size);
+  }
+
+  content_cache::content
+  tracer::take_content_pin_nolock(thread_buffer& tbuf, uint64_t hash)
+  {
+    auto itr = std::find_if(tbuf.content_pins.begin(), tbuf.content_pins.end(),
+                            [hash](const auto& pin) { return pin.first == hash; });
+    if (itr == tbuf.content_pins.end())
+      return nullptr;
+
+    auto pin = std::move(itr->second);
+    tbuf.content_pins.erase(itr);
+    return pin;
+  }
+
   bool
   tracer::trace_pid(uint32_t pid)
   {
@@ -117,8 +348,10 @@ namespace xrt::tools::xbtracer
       // Get environment variable to get the path and the tracing level
       std::string tlevel(tracer_tlevel_str_len_max, '\0');
       std::string odir(tracer_dir_str_len_max, '\0');
+      std::string compress(tracer_tlevel_str_len_max, '\0');
       getenv_os("XBTRACER_OUT_DIR", odir.data(), odir.capacity());
       getenv_os("XBRACER_TRACE_LEVEL", tlevel.data(), tlevel.capacity());
+      getenv_os("XBTRACER_COMPRESS", compress.data(), compress.capacity());
       tracer::level l = tracer::level::DEFAULT;
 
       if (strlen(tlevel.c_str())) {
@@ -139,7 +372,8 @@ namespace xrt::tools::xbtracer
       opath.append(std::string("trace_protobuf" + std::to_string(pid) + ".bin"));
       // convert path to string first before converting it to c string to
       // make it work for both Linux and Windows.
-      instance = std::unique_ptr<tracer>(new tracer(opath.string(), l));
+      bool compress_output = (std::string(compress.c_str()) == "1");
+      instance = std::unique_ptr<tracer>(new tracer(opath.string(), l, compress_output));
 
       // Log XRT version
       GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -424,6 +658,21 @@ xbtrace_untrace_current_func()
   xrt::tools::xbtracer::tracer::get_instance().remove_trace_pid(pid);
 }
 
+// Add content of an argument to function message.  Content that is
+// large enough is deduplicated, if the same content has already been
+// traced, only its hash is written and the replay restores the
+// content from the earlier message.
+static void
+xbtracer_trace_content(const char* data, size_t size, uint32_t arg_id,
+                       const std::string& arg_name, xbtracer_proto::Func& func_msg)
+{
+  xbtracer_proto::Arg* arg = func_msg.add_arg();
+  arg->set_name(arg_name);
+  arg->set_index(arg_id);
+  arg->set_type("byes");
+  xrt::tools::xbtracer::tracer::get_instance().trace_content(*arg, data, size);
+}
+
 bool
 xbtracer_trace_file_content(const std::string& fname, uint32_t arg_id,
                             const std::string& arg_name, xbtracer_proto::Func& func_msg)
@@ -444,12 +693,7 @@ xbtracer_trace_file_content(const std::string& fname, uint32_t arg_id,
   }
   ifile.close();
 
-  xbtracer_proto::Arg* arg = func_msg.add_arg();
-  arg->set_name(arg_name);
-  arg->set_index(arg_id);
-  arg->set_type("byes");
-  arg->set_size(static_cast<uint32_t>(size));
-  arg->set_value(buf);
+  xbtracer_trace_content(buf.data(), buf.size(), arg_id, arg_name, func_msg);
   return true;
 }
 
@@ -457,11 +701,6 @@ bool
 xbtracer_trace_mem_dump(const void* data, size_t size, uint32_t arg_id,
                         const std::string& arg_name, xbtracer_proto::Func& func_msg)
 {
-  xbtracer_proto::Arg* arg = func_msg.add_arg();
-  arg->set_name(arg_name);
-  arg->set_index(arg_id);
-  arg->set_type("byes");
-  arg->set_size(static_cast<uint32_t>(size));
-  arg->set_value(std::string(reinterpret_cast<const char*>(data), size));
+  xbtracer_trace_content(reinterpret_cast<const char*>(data), size, arg_id, arg_name, func_msg);
   return true;
 }
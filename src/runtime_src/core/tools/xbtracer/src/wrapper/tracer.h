@@ -1,15 +1,23 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #ifndef tracer_h
 #define tracer_h
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <xrt.h>
@@ -35,6 +43,7 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/timestamp.pb.h>
 #include <func.pb.h>
+#include <common/trace_content.h>
 #include <common/trace_utils.h>
 
 template <typename PFUNC>
@@ -119,6 +128,7 @@ xbrtracer_init_func_proto_msg(PFUNC& func_msg, const char* func_name, PFUNC_TRAC
 
   uint32_t pid = getpid_current_os();
   func_msg.set_pid(pid);
+  func_msg.set_tid(gettid_current_os());
   func_msg.set_status(func_trace_type);
 }
 
@@ -132,7 +142,7 @@ class tracer
   };
 
 public:
-  tracer(const std::string& outf, level tl);
+  tracer(const std::string& outf, level tl, bool compress);
 
   // we always need to output tracing to a file
   tracer() = delete;
@@ -148,22 +158,30 @@ public:
   proc_addr_type
   get_proc_addr(const char* symbol);
 
+  // Serialize message to the trace buffer of calling thread.  The
+  // buffers are drained and written to the output file in batches
+  // by the writer thread.  Messages are written in the order they
+  // were added to the trace buffers.
   template <typename protobuf_msg>
   bool
   write_protobuf_msg(const protobuf_msg& msg)
   {
-    auto msg_size = static_cast<uint32_t>(msg.ByteSizeLong());
-
-    std::lock_guard<std::mutex> lock(trace_mlock);
-    google::protobuf::io::OstreamOutputStream zero_copy_output(&tracer_ofile);
-    google::protobuf::io::CodedOutputStream coded_output(&zero_copy_output);
+    auto& tbuf = get_thread_buffer();
+    std::lock_guard<std::mutex> lock(tbuf.mlock);
+    return add_msg_nolock(tbuf, msg);
+  }
 
-    coded_output.WriteVarint32(msg_size);
-    msg.SerializeToCodedStream(&coded_output);
+  // Write function message with argument content.  Content that has
+  // already been traced is replaced by a reference to the earlier
+  // message, see trace_content().
+  bool
+  write_protobuf_msg(xbtracer_proto::Func& msg);
 
-    tracer_ofile.flush();
-    return !coded_output.HadError();
-  }
+  // Set content of argument.  Content that is in the content cache is
+  // not copied to the argument, the argument references the cached
+  // content instead.
+  void
+  trace_content(xbtracer_proto::Arg& arg, const char* data, size_t size);
 
   bool
   trace_pid(uint32_t pid);
@@ -198,6 +216,68 @@ public:
   check_impl_refs();
 
 private:
+  // Trace messages serialized by one thread, each record is the
+  // sequence number of the message and its offset in data.  Cached
+  // content referenced by messages not yet written is pinned, such
+  // that the message can carry the content if it has been evicted
+  // from the cache when the message is written.
+  struct thread_buffer
+  {
+    std::mutex mlock;
+    std::string data;
+    std::vector<std::pair<uint64_t, size_t>> records;
+    std::vector<std::pair<uint64_t, content_cache::content>> content_pins;
+  };
+
+  // Size of thread buffer at which writer thread is woken up
+  static constexpr size_t thread_buffer_drain_size = 4 * 1024 * 1024;
+
+  thread_buffer&
+  get_thread_buffer();
+
+  // Serialize message to trace buffer and take its sequence number
+  template <typename protobuf_msg>
+  bool
+  add_msg_nolock(thread_buffer& tbuf, const protobuf_msg& msg)
+  {
+    return add_msg_nolock(tbuf, msg, trace_seq++);
+  }
+
+  // Serialize message to trace buffer with sequence number taken with
+  // the buffer locked, see drain()
+  template <typename protobuf_msg>
+  bool
+  add_msg_nolock(thread_buffer& tbuf, const protobuf_msg& msg, uint64_t seq)
+  {
+    using coded_output = google::protobuf::io::CodedOutputStream;
+    auto msg_size = static_cast<uint32_t>(msg.ByteSizeLong());
+
+    auto offset = tbuf.data.size();
+    tbuf.data.resize(offset + coded_output::VarintSize32(msg_size) + msg_size);
+    auto ptr = reinterpret_cast<uint8_t*>(tbuf.data.data() + offset);
+    ptr = coded_output::WriteVarint32ToArray(msg_size, ptr);
+    if (!msg.SerializeToArray(ptr, static_cast<int>(msg_size))) {
+      tbuf.data.resize(offset);
+      return false;
+    }
+
+    tbuf.records.emplace_back(seq, offset);
+    if (tbuf.data.size() >= thread_buffer_drain_size)
+      writer_cv.notify_one();
+    return true;
+  }
+
+  // Remove pinned content of a referencing argument from the thread
+  // buffer, called with the buffer locked
+  content_cache::content
+  take_content_pin_nolock(thread_buffer& tbuf, uint64_t hash);
+
+  void
+  writer_loop();
+
+  void
+  drain(bool final);
+
   bool
   find_add_impl_ref_nolock(const std::shared_ptr<xrt_core::device>& sh_impl, bool add);
 
@@ -302,11 +382,21 @@ private:
   static std::once_flag init_instance_flag;
   std::fstream tracer_ofile;
   level tlevel;
+  bool compress_output;
   lib_handle_type coreutil_lib_h;
   std::vector<uint32_t> trace_pids{};
   std::mutex pids_mlock; // track PIDs lock
   std::mutex refs_mlock; // track references lock
-  std::mutex trace_mlock; // writing messages for functions APIs lock
+  std::atomic<uint64_t> trace_seq{0}; // sequence number of next trace message
+  std::mutex buffers_mlock; // thread trace buffers lock
+  std::vector<std::shared_ptr<thread_buffer>> thread_buffers;
+  std::vector<std::pair<uint64_t, std::string>> pending_records; // drained, not yet written
+  std::mutex writer_mlock;
+  std::condition_variable writer_cv;
+  bool writer_stop = false;
+  std::thread writer_thread;
+  std::mutex content_mlock; // orders content insertion with message sequence numbers
+  content_cache contents;   // traced content by hash
   std::tuple<std::string, std::vector<std::shared_ptr<xrt_core::device>>> xrt_dev_ref_tracker{};
   std::tuple<std::string, std::vector<std::shared_ptr<xrt::kernel_impl>>> xrt_kernel_ref_tracker{};
   std::tuple<std::string, std::vector<std::shared_ptr<xrt::bo_impl>>> xrt_bo_ref_tracker{};
@@ -362,6 +452,15 @@ xbtracer_write_protobuf_msg(const protobuf_msg& msg, bool need_trace)
   return xrt::tools::xbtracer::tracer::get_instance().write_protobuf_msg(msg);
 }
 
+// Function message with argument content is deduplicated when written
+inline bool
+xbtracer_write_protobuf_msg(xbtracer_proto::Func& msg, bool need_trace)
+{
+  if (!need_trace)
+    return true;
+  return xrt::tools::xbtracer::tracer::get_instance().write_protobuf_msg(msg);
+}
+
 proc_addr_type
 xbtracer_get_original_func_addr(const char* symbol);
 
@@ -0,0 +1,812 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#include "ert_sim.h"
+#include "core/include/xrt/detail/ert.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+// Firmware entry points, scheduler.cpp built with ERT_HW_EMU
+extern "C" void scheduler_loop();
+extern "C" void cu_interrupt_handler();
+
+namespace {
+
+using cycles_type = uint64_t;
+constexpr cycles_type never = std::numeric_limits<cycles_type>::max();
+constexpr size_t no_index = std::numeric_limits<size_t>::max();
+
+// HLS AXI-lite control register bits
+constexpr uint32_t AP_START = 0x1;
+constexpr uint32_t AP_DONE  = 0x2;
+constexpr uint32_t AP_IDLE  = 0x4;
+
+// Simulated CU address map, CUs are 64KB apart
+constexpr uint32_t cu_base_address = 0x1000000;
+constexpr uint32_t cu_offset = 16;
+constexpr uint32_t cu_ier_offset = 0x8;
+constexpr uint32_t cu_arg_offset = 0x10;  // first argument carries command tag
+constexpr unsigned int max_cus = 64;      // width of command cu_mask
+
+// ERT configure command features
+constexpr uint32_t feature_ert = 0x1;
+constexpr uint32_t feature_cudma = 0x4;
+constexpr uint32_t feature_cuisr = 0x8;
+constexpr uint32_t feature_cq_intr = 0x10;
+
+// Interrupt controller bits
+constexpr uint32_t intc_cq = 0x1;
+constexpr uint32_t intc_cu = 0x2;
+
+// Thrown from the firmware scheduler loop when all commands completed
+struct stop_simulation {};
+
+struct cu_state
+{
+  bool running = false;
+  bool interrupt = false;             // CU interrupt enabled by firmware
+  uint32_t tag = 0;                   // First argument, command index + 1
+  size_t cmd = no_index;              // Command executing on CU
+  cycles_type done_at = never;
+  size_t outstanding = 0;             // Commands assigned by host and not completed
+};
+
+struct cmd_state
+{
+  size_t deps = 0;                    // Dependencies not completed
+  std::vector<size_t> dependants;
+  uint64_t cu_mask = 0;
+  cycles_type exec = 0;
+  cycles_type ready_at = never;
+  cycles_type submit_at = never;
+  cycles_type start_at = never;
+  cycles_type done_at = never;
+  cycles_type notify_at = never;
+  cycles_type complete_at = never;
+  unsigned int cu = 0;
+  size_t slot = no_index;
+};
+
+// Command queue slot as seen by host
+struct slot_state
+{
+  size_t cmd = no_index;
+  uint32_t header = 0;                // Header written by host not yet visible
+  cycles_type header_at = never;      // Time when header becomes visible
+};
+
+struct arrival
+{
+  cycles_type at;
+  size_t cmd;
+  bool operator> (const arrival& rhs) const
+  {
+    return std::tie(at, cmd) > std::tie(rhs.at, rhs.cmd);
+  }
+};
+
+class simulator;
+simulator* s_simulator = nullptr;
+
+class simulator
+{
+  const ert_sim::config& m_cfg;
+  const ert_sim::cost_model& m_cost;
+  size_t m_num_cmds;
+  bool m_ert;
+
+  cycles_type m_now = 0;
+  cycles_type m_host_free_at = 0;
+  cycles_type m_last_progress = 0;
+  cycles_type m_stall_cycles = 0;
+  cycles_type m_next_event = never;
+
+  std::vector<cmd_state> m_cmds;
+  std::deque<size_t> m_ready;
+  std::priority_queue<arrival, std::vector<arrival>, std::greater<>> m_completions;
+  size_t m_completed = 0;
+  std::vector<cu_state> m_cus;
+  unsigned int m_last_cu = 0;
+
+  // ERT device state
+  size_t m_num_slots = 0;
+  std::vector<uint32_t> m_cq;
+  std::vector<slot_state> m_slots;
+  bool m_configured = false;
+  uint32_t m_cu_status[4] = {0};
+  uint32_t m_cq_status[4] = {0};
+  uint32_t m_intc_ier = 0;
+  uint32_t m_intc_mer = 0;
+  bool m_mb_interrupts = false;
+  std::unordered_map<uint32_t, uint32_t> m_regs;
+
+  uint64_t m_loop_iterations = 0;
+  uint64_t m_reads = 0;
+  uint64_t m_writes = 0;
+
+  cycles_type
+  ns_to_cycles(uint64_t ns) const
+  {
+    return static_cast<cycles_type>(ns * m_cost.clock_mhz / 1000 + 0.5);
+  }
+
+  static bool
+  in_range(uint32_t addr, uint32_t base, uint32_t size)
+  {
+    return addr >= base && addr - base < size;
+  }
+
+  static uint32_t
+  cu_address(unsigned int cu)
+  {
+    return cu_base_address + (cu << cu_offset);
+  }
+
+  uint32_t
+  slot_word(size_t slot) const
+  {
+    return static_cast<uint32_t>(slot * m_cfg.slot_size / sizeof(uint32_t));
+  }
+
+  void
+  progress()
+  {
+    m_last_progress = m_now;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Compute units
+  ////////////////////////////////////////////////////////////////
+  void
+  start_cu(unsigned int cu, size_t cmd, cycles_type at)
+  {
+    auto& c = m_cus.at(cu);
+    if (c.running)
+      throw std::runtime_error("CU " + std::to_string(cu) + " started while running");
+    if (cmd >= m_num_cmds)
+      throw std::runtime_error("CU " + std::to_string(cu) + " started with bad command tag");
+    auto& command = m_cmds[cmd];
+    if (command.cu != cu)
+      throw std::runtime_error("command " + std::to_string(cmd) + " started on wrong CU");
+    c.running = true;
+    c.cmd = cmd;
+    c.done_at = at + command.exec;
+    command.start_at = at;
+    if (c.interrupt)
+      m_next_event = std::min(m_next_event, c.done_at);
+    progress();
+  }
+
+  void
+  finish_cu(unsigned int cu)
+  {
+    auto& c = m_cus[cu];
+    c.running = false;
+    m_cmds[c.cmd].done_at = c.done_at;
+  }
+
+  uint32_t
+  read_cu_ctrl(unsigned int cu)
+  {
+    auto& c = m_cus[cu];
+    if (!c.running)
+      return AP_IDLE;
+    if (m_now < c.done_at)
+      return 0;
+    // AP_DONE is clear on read
+    finish_cu(cu);
+    return AP_DONE | AP_IDLE;
+  }
+
+  // CU DMA copies the register map of a command slot to the CU
+  // identified in the slot and starts the CU
+  void
+  cudma(size_t slot)
+  {
+    auto word = slot_word(slot);
+    auto header = m_cq[word];
+    auto count = (header >> 12) & 0x7FF;
+    auto masks = 1 + ((header >> 10) & 0x3);
+    auto regmap = word + 1 + masks;
+    auto cu = ((m_cq[word + 1] << 2) - cu_base_address) >> cu_offset;
+    if (cu >= m_cus.size())
+      throw std::runtime_error("CU DMA for slot " + std::to_string(slot) + " with bad CU address");
+    auto tag = m_cq[regmap + cu_arg_offset / sizeof(uint32_t)];
+    start_cu(cu, tag - 1, m_now + (count - masks) * m_cost.cudma_word_cycles);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Command queue
+  ////////////////////////////////////////////////////////////////
+  void
+  apply_header(size_t slot)
+  {
+    auto& s = m_slots[slot];
+    m_cq[slot_word(slot)] = s.header;
+    s.header_at = never;
+    if (m_regs[ERT_CQ_STATUS_ENABLE_ADDR])
+      m_cq_status[slot >> 5] |= 1u << (slot & 0x1F);
+  }
+
+  // Firmware wrote host status register, command in slot is complete
+  void
+  notify(size_t slot)
+  {
+    auto irq = ns_to_cycles(m_cost.host_irq_ns);
+    if (!m_configured) {
+      m_configured = true;
+      m_host_free_at = std::max(m_host_free_at, m_now + irq);
+      m_slots[slot].cmd = no_index;
+      progress();
+      return;
+    }
+    auto cmd = m_slots.at(slot).cmd;
+    if (cmd == no_index || m_cmds[cmd].notify_at != never)
+      throw std::runtime_error("notification for idle slot " + std::to_string(slot));
+    m_cmds[cmd].notify_at = m_now;
+    m_completions.push({m_now + irq, cmd});
+  }
+
+  // Device events that happen without firmware register access
+  void
+  update_device()
+  {
+    if (m_now < m_next_event)
+      return;
+
+    m_next_event = never;
+    bool cuisr = m_regs[ERT_CU_ISR_HANDLER_ENABLE_ADDR];
+    for (unsigned int cu = 0; cu < m_cus.size(); ++cu) {
+      auto& c = m_cus[cu];
+      if (!c.running || !c.interrupt || !cuisr)
+        continue;
+      if (c.done_at <= m_now) {
+        finish_cu(cu);
+        m_cu_status[cu >> 5] |= 1u << (cu & 0x1F);
+        continue;
+      }
+      m_next_event = std::min(m_next_event, c.done_at);
+    }
+
+    for (size_t slot = 0; slot < m_slots.size(); ++slot) {
+      auto at = m_slots[slot].header_at;
+      if (at <= m_now)
+        apply_header(slot);
+      else
+        m_next_event = std::min(m_next_event, at);
+    }
+  }
+
+  uint32_t
+  pending_interrupts() const
+  {
+    uint32_t ipr = 0;
+    for (size_t w = 0; w < 4; ++w) {
+      if (m_cq_status[w])
+        ipr |= intc_cq;
+      if (m_cu_status[w])
+        ipr |= intc_cu;
+    }
+    return ipr;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Host
+  ////////////////////////////////////////////////////////////////
+  unsigned int
+  select_cu(size_t cmd, bool idle_only) const
+  {
+    auto mask = m_cmds[cmd].cu_mask;
+    auto num_cus = static_cast<unsigned int>(m_cus.size());
+    auto candidate = [&](unsigned int cu) {
+      return ((uint64_t(1) << cu) & mask) && (!idle_only || !m_cus[cu].outstanding);
+    };
+
+    unsigned int selected = num_cus;
+    switch (m_cfg.policy) {
+    case ert_sim::cu_policy::least:
+      for (unsigned int cu = 0; cu < num_cus; ++cu)
+        if (candidate(cu) && (selected == num_cus || m_cus[cu].outstanding < m_cus[selected].outstanding))
+          selected = cu;
+      break;
+    case ert_sim::cu_policy::first:
+      for (unsigned int cu = 0; cu < num_cus && selected == num_cus; ++cu)
+        if (candidate(cu) && !m_cus[cu].outstanding)
+          selected = cu;
+      for (unsigned int cu = 0; cu < num_cus && selected == num_cus; ++cu)
+        if (candidate(cu))
+          selected = cu;
+      break;
+    case ert_sim::cu_policy::round_robin:
+      for (unsigned int i = 1; i <= num_cus && selected == num_cus; ++i)
+        if (candidate((m_last_cu + i) % num_cus))
+          selected = (m_last_cu + i) % num_cus;
+      break;
+    }
+    return selected;
+  }
+
+  void
+  complete(size_t cmd, cycles_type at)
+  {
+    auto& c = m_cmds[cmd];
+    c.complete_at = at;
+    --m_cus[c.cu].outstanding;
+    if (c.slot != no_index)
+      m_slots[c.slot].cmd = no_index;
+    for (auto d : c.dependants) {
+      if (--m_cmds[d].deps == 0) {
+        m_cmds[d].ready_at = at;
+        m_ready.push_back(d);
+      }
+    }
+    ++m_completed;
+    progress();
+  }
+
+  void
+  submit_configure()
+  {
+    auto num_cus = static_cast<uint32_t>(m_cus.size());
+    uint32_t features = feature_ert;
+    if (m_cfg.mode == ert_sim::mode::ert_cudma || m_cfg.mode == ert_sim::mode::ert_intr)
+      features |= feature_cudma;
+    if (m_cfg.mode == ert_sim::mode::ert_intr)
+      features |= feature_cuisr | feature_cq_intr;
+
+    std::vector<uint32_t> payload {m_cfg.slot_size, num_cus, cu_offset, cu_base_address, features};
+    for (unsigned int cu = 0; cu < num_cus; ++cu)
+      payload.push_back(cu_address(cu));
+    std::copy(payload.begin(), payload.end(), m_cq.begin() + 1);
+
+    auto& s = m_slots[0];
+    s.header = ERT_CMD_STATE_NEW | (static_cast<uint32_t>(payload.size()) << 12) | (ERT_CONFIGURE << 23) | (ERT_CTRL << 28);
+    s.header_at = ns_to_cycles(m_cost.host_submit_ns + (payload.size() + 1) * m_cost.host_write_ns);
+    s.cmd = no_index;
+    m_host_free_at = s.header_at;
+    m_next_event = s.header_at;
+  }
+
+  // Write command to free slot, the header becomes visible to the
+  // firmware once the host has written the command
+  bool
+  submit_ert(size_t cmd)
+  {
+    auto slot = std::find_if(m_slots.begin(), m_slots.end(), [](const auto& s) { return s.cmd == no_index; });
+    if (slot == m_slots.end())
+      return false;
+    auto slot_idx = static_cast<size_t>(slot - m_slots.begin());
+
+    auto& c = m_cmds[cmd];
+    auto cu = select_cu(cmd, false);
+    c.cu = cu;
+    c.slot = slot_idx;
+    c.submit_at = m_now;
+    ++m_cus[cu].outstanding;
+    m_last_cu = cu;
+
+    // cu index, 4 control words, arguments with tag in first argument
+    auto word = slot_word(slot_idx);
+    auto count = 1 + 4 + m_cfg.num_args;
+    std::fill(m_cq.begin() + word + 1, m_cq.begin() + word + 1 + count, 0);
+    m_cq[word + 1] = cu;
+    m_cq[word + 2 + cu_arg_offset / sizeof(uint32_t)] = static_cast<uint32_t>(cmd + 1);
+
+    slot->cmd = cmd;
+    slot->header = ERT_CMD_STATE_NEW | (count << 12) | (ERT_START_CU << 23) | (ERT_CU << 28);
+    slot->header_at = m_now + ns_to_cycles(m_cost.host_submit_ns + (count + 1) * m_cost.host_write_ns);
+    m_host_free_at = slot->header_at;
+    m_next_event = std::min(m_next_event, slot->header_at);
+    return true;
+  }
+
+  // Write CU register map and start CU, CU interrupts the host when done
+  bool
+  submit_kds(size_t cmd)
+  {
+    auto cu = select_cu(cmd, true);
+    if (cu == m_cus.size())
+      return false;
+
+    auto& c = m_cmds[cmd];
+    c.cu = cu;
+    c.submit_at = m_now;
+    ++m_cus[cu].outstanding;
+    m_last_cu = cu;
+
+    m_host_free_at = m_now + ns_to_cycles(m_cost.host_submit_ns + (m_cfg.num_args + 1) * m_cost.host_write_ns);
+    start_cu(cu, cmd, m_host_free_at);
+    m_completions.push({m_cus[cu].done_at + ns_to_cycles(m_cost.host_irq_ns), cmd});
+    return true;
+  }
+
+  // Host thread processes one completion or submits one command if
+  // idle, returns true if host did something
+  bool
+  host_step()
+  {
+    if (m_now < m_host_free_at)
+      return false;
+
+    if (!m_completions.empty() && m_completions.top().at <= m_now) {
+      auto cmd = m_completions.top().cmd;
+      m_completions.pop();
+      // read status register, in KDS mode also acknowledge CU
+      auto cost = m_cost.host_read_ns + (m_ert ? 0 : m_cost.host_write_ns);
+      m_host_free_at = m_now + ns_to_cycles(cost);
+      if (!m_ert)
+        finish_cu(m_cmds[cmd].cu);
+      complete(cmd, m_host_free_at);
+      return true;
+    }
+
+    if (m_ert && !m_configured)
+      return false;
+
+    if (m_ert) {
+      if (m_ready.empty() || !submit_ert(m_ready.front()))
+        return false;
+      m_ready.pop_front();
+      return true;
+    }
+
+    // first ready command with an idle CU
+    uint64_t idle = 0;
+    for (unsigned int cu = 0; cu < m_cus.size(); ++cu)
+      if (!m_cus[cu].outstanding)
+        idle |= uint64_t(1) << cu;
+    if (!idle)
+      return false;
+    for (auto itr = m_ready.begin(); itr != m_ready.end(); ++itr) {
+      if ((m_cmds[*itr].cu_mask & idle) && submit_kds(*itr)) {
+        m_ready.erase(itr);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void
+  init(const std::vector<ert_sim::command>& commands)
+  {
+    auto num_cus = m_cfg.num_cus;
+    if (!num_cus || num_cus > max_cus)
+      throw std::runtime_error("number of CUs must be 1 to " + std::to_string(max_cus));
+    auto valid = num_cus == max_cus ? ~uint64_t(0) : (uint64_t(1) << num_cus) - 1;
+    m_cus.resize(num_cus);
+
+    cycles_type max_exec = 0;
+    m_cmds.resize(m_num_cmds);
+    for (size_t i = 0; i < m_num_cmds; ++i) {
+      auto& c = m_cmds[i];
+      const auto& command = commands[i];
+      if (!(command.cu_mask & valid))
+        throw std::runtime_error("command " + std::to_string(i) + " has no CU in cu_mask");
+      c.cu_mask = command.cu_mask & valid;
+      c.exec = std::max<cycles_type>(1, ns_to_cycles(command.exec_ns));
+      max_exec = std::max(max_exec, c.exec);
+      c.deps = command.deps.size();
+      for (auto d : command.deps) {
+        if (d >= i)
+          throw std::runtime_error("command " + std::to_string(i) + " depends on later command");
+        m_cmds[d].dependants.push_back(i);
+      }
+      if (!c.deps) {
+        c.ready_at = 0;
+        m_ready.push_back(i);
+      }
+    }
+
+    // no progress for one simulated second beyond the longest command
+    m_stall_cycles = ns_to_cycles(1000000000) + max_exec;
+
+    if (!m_ert)
+      return;
+
+    auto count = 1 + 4 + m_cfg.num_args;
+    auto slot_size = m_cfg.slot_size;
+    if (!slot_size || (slot_size & (slot_size - 1)) || ERT_CQ_SIZE / slot_size > 128 || slot_size > ERT_CQ_SIZE)
+      throw std::runtime_error("slot size must be a power of 2 from "
+                               + std::to_string(ERT_CQ_SIZE / 128) + " to " + std::to_string(ERT_CQ_SIZE));
+    if ((count + 1) * sizeof(uint32_t) > slot_size || (6 + num_cus) * sizeof(uint32_t) > slot_size)
+      throw std::runtime_error("commands do not fit slot size " + std::to_string(slot_size));
+
+    m_num_slots = ERT_CQ_SIZE / slot_size;
+    m_cq.assign(ERT_CQ_SIZE / sizeof(uint32_t), 0);
+    m_slots.resize(m_num_slots);
+    submit_configure();
+  }
+
+  ert_sim::result
+  collect() const
+  {
+    ert_sim::result r;
+    r.commands = m_num_cmds;
+    r.num_slots = m_num_slots;
+    r.loop_iterations = m_loop_iterations;
+    r.reg_reads = m_reads;
+    r.reg_writes = m_writes;
+
+    std::vector<std::pair<cycles_type, int>> occupancy;
+    cycles_type busy = 0;
+    for (const auto& c : m_cmds) {
+      r.cycles = std::max(r.cycles, c.complete_at);
+      r.dispatch.push_back(c.start_at - c.submit_at);
+      r.notify.push_back(c.complete_at - c.done_at);
+      r.latency.push_back(c.complete_at - c.ready_at);
+      busy += c.done_at - c.start_at;
+      occupancy.emplace_back(c.submit_at, 1);
+      occupancy.emplace_back(c.complete_at, -1);
+    }
+    if (!r.cycles)
+      return r;
+
+    // releases before submits at same time
+    std::sort(occupancy.begin(), occupancy.end());
+    int current = 0;
+    cycles_type last = 0;
+    double area = 0;
+    for (auto [at, delta] : occupancy) {
+      area += static_cast<double>(current) * (at - last);
+      last = at;
+      current += delta;
+      r.max_slots = std::max(r.max_slots, static_cast<size_t>(current));
+    }
+    r.avg_slots = area / r.cycles;
+    r.cu_utilization = static_cast<double>(busy) / (static_cast<double>(r.cycles) * m_cus.size());
+    return r;
+  }
+
+public:
+  simulator(const ert_sim::config& cfg, const std::vector<ert_sim::command>& commands)
+    : m_cfg(cfg)
+    , m_cost(cfg.cost)
+    , m_num_cmds(commands.size())
+    , m_ert(cfg.mode != ert_sim::mode::kds)
+  {
+    init(commands);
+  }
+
+  ert_sim::result
+  run()
+  {
+    if (m_ert) {
+      try {
+        scheduler_loop();
+      }
+      catch (const stop_simulation&) {
+      }
+      return collect();
+    }
+
+    while (m_completed < m_num_cmds) {
+      if (host_step()) {
+        m_now = std::max(m_now, m_host_free_at);
+        continue;
+      }
+      if (m_completions.empty())
+        throw std::runtime_error("simulation stalled with no command running");
+      m_now = std::max(m_now, m_completions.top().at);
+    }
+    return collect();
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Firmware register backend
+  ////////////////////////////////////////////////////////////////
+  uint32_t
+  read_reg(uint32_t addr)
+  {
+    ++m_reads;
+    if (in_range(addr, ERT_CQ_BASE_ADDR, ERT_CQ_SIZE)) {
+      m_now += m_cost.cq_read_cycles;
+      auto word = (addr - ERT_CQ_BASE_ADDR) / sizeof(uint32_t);
+      auto slot = word * sizeof(uint32_t) / m_cfg.slot_size;
+      if (word == slot_word(slot) && m_slots[slot].header_at <= m_now)
+        apply_header(slot);
+      return m_cq[word];
+    }
+
+    if (in_range(addr, cu_base_address, static_cast<uint32_t>(m_cus.size()) << cu_offset)) {
+      m_now += m_cost.cu_read_cycles;
+      auto cu = (addr - cu_base_address) >> cu_offset;
+      return (addr & ((1 << cu_offset) - 1)) ? 0 : read_cu_ctrl(cu);
+    }
+
+    m_now += m_cost.csr_read_cycles;
+    for (size_t w = 0; w < 4; ++w) {
+      if (addr == ERT_STATUS_REGISTER_ADDR + w * 4)
+        return 0;  // clear on read by host
+      if (addr == ERT_CU_STATUS_REGISTER_ADDR + w * 4)
+        return std::exchange(m_cu_status[w], 0);
+      if (addr == ERT_CQ_STATUS_REGISTER_ADDR + w * 4)
+        return std::exchange(m_cq_status[w], 0);
+    }
+    switch (addr) {
+    case ERT_INTC_IPR_ADDR:
+      return pending_interrupts();
+    case ERT_INTC_IER_ADDR:
+      return m_intc_ier;
+    case ERT_INTC_MER_ADDR:
+      return m_intc_mer;
+    case ERT_CUDMA_STATE:
+    case ERT_CUISR_STATE:
+      return ERT_HLS_MODULE_IDLE;
+    default:
+      return m_regs[addr];
+    }
+  }
+
+  void
+  write_reg(uint32_t addr, uint32_t val)
+  {
+    ++m_writes;
+    if (in_range(addr, ERT_CQ_BASE_ADDR, ERT_CQ_SIZE)) {
+      m_now += m_cost.cq_write_cycles;
+      m_cq[(addr - ERT_CQ_BASE_ADDR) / sizeof(uint32_t)] = val;
+      return;
+    }
+
+    if (in_range(addr, cu_base_address, static_cast<uint32_t>(m_cus.size()) << cu_offset)) {
+      m_now += m_cost.cu_write_cycles;
+      auto cu = (addr - cu_base_address) >> cu_offset;
+      auto offset = addr & ((1 << cu_offset) - 1);
+      if (offset == 0 && (val & AP_START))
+        start_cu(cu, m_cus[cu].tag - 1, m_now);
+      else if (offset == cu_ier_offset)
+        m_cus[cu].interrupt = val;
+      else if (offset == cu_arg_offset)
+        m_cus[cu].tag = val;
+      return;
+    }
+
+    m_now += m_cost.csr_write_cycles;
+    for (size_t w = 0; w < 4; ++w) {
+      if (addr == ERT_STATUS_REGISTER_ADDR + w * 4) {
+        for (size_t bit = 0; bit < 32; ++bit)
+          if (val & (1u << bit))
+            notify(w * 32 + bit);
+        return;
+      }
+      if (addr == ERT_CU_DMA_REGISTER_ADDR + w * 4) {
+        for (size_t bit = 0; bit < 32; ++bit)
+          if (val & (1u << bit))
+            cudma(w * 32 + bit);
+        return;
+      }
+    }
+    switch (addr) {
+    case ERT_INTC_IER_ADDR:
+      m_intc_ier = val;
+      return;
+    case ERT_INTC_MER_ADDR:
+      m_intc_mer = val;
+      return;
+    case ERT_INTC_IAR_ADDR:
+      return;  // pending interrupts derive from status registers
+    default:
+      m_regs[addr] = val;
+    }
+  }
+
+  void
+  enable_interrupts(bool enable)
+  {
+    m_mb_interrupts = enable;
+  }
+
+  // Called by firmware for every slot visit of the scheduler loop
+  void
+  tick()
+  {
+    ++m_loop_iterations;
+    m_now += m_cost.loop_cycles;
+    update_device();
+    host_step();
+
+    if (m_completed == m_num_cmds)
+      throw stop_simulation{};
+    if (m_now - m_last_progress > m_stall_cycles)
+      throw std::runtime_error("simulation stalled at cycle " + std::to_string(m_now)
+                               + " with " + std::to_string(m_completed) + " of "
+                               + std::to_string(m_num_cmds) + " commands completed");
+
+    if (m_mb_interrupts && (m_intc_mer & 0x3) == 0x3 && (pending_interrupts() & m_intc_ier))
+      cu_interrupt_handler();
+  }
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////
+// Register access functions required by firmware built with ERT_HW_EMU
+////////////////////////////////////////////////////////////////
+uint32_t
+read_reg(uint32_t addr)
+{
+  return s_simulator->read_reg(addr);
+}
+
+void
+write_reg(uint32_t addr, uint32_t val)
+{
+  s_simulator->write_reg(addr, val);
+}
+
+void
+microblaze_enable_interrupts()
+{
+  s_simulator->enable_interrupts(true);
+}
+
+void
+microblaze_disable_interrupts()
+{
+  s_simulator->enable_interrupts(false);
+}
+
+void
+reg_access_wait()
+{
+  s_simulator->tick();
+}
+
+namespace ert_sim {
+
+result
+simulate(const config& cfg, const std::vector<command>& commands)
+{
+  if (s_simulator)
+    throw std::runtime_error("simulation already running");
+
+  simulator sim(cfg, commands);
+  s_simulator = &sim;
+  try {
+    auto r = sim.run();
+    s_simulator = nullptr;
+    return r;
+  }
+  catch (...) {
+    s_simulator = nullptr;
+    throw;
+  }
+}
+
+std::string
+to_string(mode m)
+{
+  switch (m) {
+  case mode::kds:
+    return "kds";
+  case mode::ert:
+    return "ert";
+  case mode::ert_cudma:
+    return "ert-cudma";
+  case mode::ert_intr:
+    return "ert-intr";
+  }
+  return "unknown";
+}
+
+std::string
+to_string(cu_policy p)
+{
+  switch (p) {
+  case cu_policy::least:
+    return "least";
+  case cu_policy::first:
+    return "first";
+  case cu_policy::round_robin:
+    return "rr";
+  }
+  return "unknown";
+}
+
+} // ert_sim
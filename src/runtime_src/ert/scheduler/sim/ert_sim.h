@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef ert_sim_h_
+#define ert_sim_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Host side simulator of the embedded runtime scheduler
+//
+// Runs the ERT firmware scheduler loop (scheduler.cpp built with
+// ERT_HW_EMU) against a simulated register backend that models the
+// command queue, the ERT CSRs, the interrupt controller, CU DMA, CU
+// ISR, and the compute units.  The host side is modeled as one KDS
+// thread that submits commands to command queue slots and processes
+// completions.
+//
+// Time is counted in MicroBlaze cycles.  Every register access of the
+// firmware and every iteration of its scheduler loop is charged per a
+// cost model.  Host side costs are specified in ns and converted.
+// The simulation is deterministic, the same command stream and cost
+// model always produce the same result.
+//
+// In KDS mode the firmware is not used, the host thread writes the CU
+// register map and starts the CU directly, and processes CU
+// interrupts.
+//
+// The firmware keeps its state in globals, so one simulation can run
+// at a time per process.
+namespace ert_sim {
+
+// Command of a command stream
+struct command
+{
+  uint64_t cu_mask = 1;       // CUs the command may run on
+  uint64_t exec_ns = 0;       // CU execution time
+  std::vector<size_t> deps;   // Earlier commands that must complete first
+};
+
+enum class mode
+{
+  kds,          // host starts CUs directly
+  ert,          // ERT polls command queue and CUs
+  ert_cudma,    // ERT with CU DMA configuring CUs
+  ert_intr,     // ERT with CU DMA, CU interrupts, and command queue interrupts
+};
+
+// How the host assigns a CU from the command CU mask
+enum class cu_policy
+{
+  least,        // CU with fewest outstanding commands
+  first,        // first idle CU, else first CU
+  round_robin,  // next CU after the last assigned CU
+};
+
+struct cost_model
+{
+  double clock_mhz = 250;                 // MicroBlaze clock
+  unsigned int loop_cycles = 12;          // Scheduler loop overhead per slot
+  unsigned int cq_read_cycles = 6;        // Command queue BRAM access
+  unsigned int cq_write_cycles = 2;
+  unsigned int csr_read_cycles = 8;       // ERT CSR and interrupt controller access
+  unsigned int csr_write_cycles = 2;
+  unsigned int cu_read_cycles = 30;       // CU AXI-lite access
+  unsigned int cu_write_cycles = 4;
+  unsigned int cudma_word_cycles = 2;     // CU DMA per register map word
+  unsigned int host_submit_ns = 1000;     // Driver overhead per command
+  unsigned int host_write_ns = 50;        // Host write of one word over PCIe
+  unsigned int host_read_ns = 1000;       // Host read of one word over PCIe
+  unsigned int host_irq_ns = 5000;        // Interrupt to driver completion handling
+};
+
+struct config
+{
+  enum mode mode = mode::ert;
+  cu_policy policy = cu_policy::least;
+  unsigned int num_cus = 4;
+  unsigned int slot_size = 0x1000;        // Command queue slot size in bytes
+  unsigned int num_args = 8;              // CU arguments per command
+  cost_model cost;
+};
+
+struct result
+{
+  size_t commands = 0;
+  uint64_t cycles = 0;                    // Simulated time until last completion
+  std::vector<uint64_t> dispatch;         // Per command, host submit to CU start
+  std::vector<uint64_t> notify;           // Per command, CU done to host notified
+  std::vector<uint64_t> latency;          // Per command, ready to completed by host
+  double avg_slots = 0;                   // Average occupied command slots
+  size_t max_slots = 0;
+  size_t num_slots = 0;
+  double cu_utilization = 0;              // Fraction of CU time executing
+  uint64_t loop_iterations = 0;           // Firmware scheduler loop slot visits
+  uint64_t reg_reads = 0;                 // Firmware register accesses
+  uint64_t reg_writes = 0;
+};
+
+// Simulate command stream, throws on invalid stream or configuration,
+// or if the simulation stops making progress.
+result
+simulate(const config& cfg, const std::vector<command>& commands);
+
+std::string
+to_string(mode m);
+
+std::string
+to_string(cu_policy p);
+
+} // ert_sim
+
+#endif
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Benchmark driver for the ERT scheduler simulator
+//
+// Replays a command stream through the ERT firmware scheduler loop
+// with a simulated register backend, and through the host driven KDS
+// model, and reports throughput, dispatch latency, and command queue
+// slot occupancy per scheduling mode.
+//
+// Command streams are generated or read from a file:
+//  uniform:  all commands may run on any CU
+//  mixed:    random CU masks and execution times from 0.5x to 1.5x
+//  chain:    -k independent chains, each command depends on the
+//            previous command in its chain
+//  file:     one command per line '<cu mask> <exec ns> [<dep> ...]'
+//            where <dep> is the 0 based line number of an earlier
+//            command, '#' starts a comment
+//
+// Dispatch is the time from when the host starts submitting a command
+// to when its CU starts.  Notify is the time from when the CU is done
+// to when the host completes the command.  Latency is the time from
+// when the command is ready to when the host completes it.
+//
+// % ert_sim_bench [-w <uniform|mixed|chain>] [-f <file>] [-n <commands>]
+//                 [-c <cus>] [-e <exec ns>] [-k <chains>] [-a <args>]
+//                 [-s <slot size>] [-p <least|first|rr>]
+//                 [-m <kds|ert|ert-cudma|ert-intr>]...
+
+#include "ert_sim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ert_sim;
+
+static void
+usage()
+{
+  std::cout << "usage: ert_sim_bench [-w <uniform|mixed|chain>] [-f <file>] [-n <commands>]\n"
+            << "                     [-c <cus>] [-e <exec ns>] [-k <chains>] [-a <args>]\n"
+            << "                     [-s <slot size>] [-p <least|first|rr>]\n"
+            << "                     [-m <kds|ert|ert-cudma|ert-intr>]...\n";
+}
+
+static std::vector<command>
+generate(const std::string& workload, size_t count, unsigned int cus, uint64_t exec_ns, size_t chains)
+{
+  std::mt19937_64 gen(1);
+  uint64_t all = cus == 64 ? ~uint64_t(0) : (uint64_t(1) << cus) - 1;
+  std::vector<command> commands(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto& cmd = commands[i];
+    cmd.cu_mask = all;
+    cmd.exec_ns = exec_ns;
+    if (workload == "mixed") {
+      while (!(cmd.cu_mask = gen() & all))
+        ;
+      cmd.exec_ns = exec_ns / 2 + gen() % (exec_ns + 1);
+    }
+    else if (workload == "chain") {
+      if (i >= chains)
+        cmd.deps.push_back(i - chains);
+    }
+    else if (workload != "uniform")
+      throw std::runtime_error("Unknown workload " + workload);
+  }
+  return commands;
+}
+
+static std::vector<command>
+read_stream(const std::string& file)
+{
+  std::ifstream istr(file);
+  if (!istr)
+    throw std::runtime_error("Failed to open " + file);
+
+  std::vector<command> commands;
+  std::string line;
+  for (size_t lineno = 1; std::getline(istr, line); ++lineno) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream sstr(line);
+    command cmd;
+    if (!(sstr >> std::hex >> cmd.cu_mask))
+      continue;
+    if (!(sstr >> std::dec >> cmd.exec_ns))
+      throw std::runtime_error(file + ":" + std::to_string(lineno) + ": missing exec ns");
+    for (size_t dep; sstr >> dep;)
+      cmd.deps.push_back(dep);
+    if (!sstr.eof())
+      throw std::runtime_error(file + ":" + std::to_string(lineno) + ": bad dependency");
+    commands.push_back(std::move(cmd));
+  }
+  return commands;
+}
+
+static mode
+to_mode(const std::string& str)
+{
+  for (auto m : {mode::kds, mode::ert, mode::ert_cudma, mode::ert_intr})
+    if (to_string(m) == str)
+      return m;
+  throw std::runtime_error("Unknown mode " + str);
+}
+
+static cu_policy
+to_policy(const std::string& str)
+{
+  for (auto p : {cu_policy::least, cu_policy::first, cu_policy::round_robin})
+    if (to_string(p) == str)
+      return p;
+  throw std::runtime_error("Unknown policy " + str);
+}
+
+// Percentile of values in us
+static double
+percentile(std::vector<uint64_t> values, double pct, double clock_mhz)
+{
+  if (values.empty())
+    return 0;
+  auto idx = static_cast<size_t>(pct / 100 * (values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + idx, values.end());
+  return values[idx] / clock_mhz;
+}
+
+static double
+average(const std::vector<uint64_t>& values, double clock_mhz)
+{
+  if (values.empty())
+    return 0;
+  return std::accumulate(values.begin(), values.end(), 0.0) / values.size() / clock_mhz;
+}
+
+static void
+report(const config& cfg, const result& r, double wall_seconds)
+{
+  auto mhz = cfg.cost.clock_mhz;
+  auto seconds = r.cycles / (mhz * 1e6);
+  std::cout << std::fixed << std::setprecision(2)
+            << std::setw(10) << to_string(cfg.mode)
+            << std::setw(12) << std::setprecision(0) << (seconds ? r.commands / seconds : 0)
+            << std::setprecision(2)
+            << std::setw(9) << average(r.dispatch, mhz)
+            << std::setw(9) << percentile(r.dispatch, 99, mhz)
+            << std::setw(9) << average(r.notify, mhz)
+            << std::setw(9) << average(r.latency, mhz)
+            << std::setw(9) << percentile(r.latency, 99, mhz)
+            << std::setw(7) << r.avg_slots << '/' << std::left << std::setw(4) << r.max_slots << std::right
+            << std::setw(6) << std::setprecision(0) << r.cu_utilization * 100 << '%'
+            << std::setw(8) << std::setprecision(0) << (r.commands ? double(r.cycles) / r.commands : 0)
+            << std::setw(8) << std::setprecision(2) << wall_seconds << '\n';
+
+  if (cfg.mode != mode::kds)
+    std::cout << std::setw(10) << "" << "  firmware: " << r.num_slots << " slots, "
+              << r.loop_iterations << " slot visits, " << r.reg_reads << " reads, "
+              << r.reg_writes << " writes, " << std::setprecision(1)
+              << (r.commands ? double(r.reg_reads + r.reg_writes) / r.commands : 0)
+              << " accesses/cmd\n";
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::string workload = "uniform";
+  std::string file;
+  size_t count = 10000;
+  uint64_t exec_ns = 10000;
+  size_t chains = 4;
+  std::vector<mode> modes;
+  config cfg;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      usage();
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-w")
+      workload = args[++i];
+    else if (args[i] == "-f")
+      file = args[++i];
+    else if (args[i] == "-n")
+      count = std::stoul(args[++i]);
+    else if (args[i] == "-c")
+      cfg.num_cus = std::stoul(args[++i]);
+    else if (args[i] == "-e")
+      exec_ns = std::stoul(args[++i]);
+    else if (args[i] == "-k")
+      chains = std::stoul(args[++i]);
+    else if (args[i] == "-a")
+      cfg.num_args = std::stoul(args[++i]);
+    else if (args[i] == "-s")
+      cfg.slot_size = std::stoul(args[++i], nullptr, 0);
+    else if (args[i] == "-p")
+      cfg.policy = to_policy(args[++i]);
+    else if (args[i] == "-m")
+      modes.push_back(to_mode(args[++i]));
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!chains)
+    throw std::runtime_error("-k <chains> must be greater than 0");
+  if (!cfg.num_args)
+    throw std::runtime_error("-a <args> must be greater than 0, first argument tags commands");
+  if (!cfg.num_cus || cfg.num_cus > 64)
+    throw std::runtime_error("-c <cus> must be from 1 to 64");
+
+  auto commands = file.empty()
+    ? generate(workload, count, cfg.num_cus, exec_ns, chains)
+    : read_stream(file);
+  if (modes.empty())
+    modes = {mode::kds, mode::ert, mode::ert_cudma, mode::ert_intr};
+
+  std::cout << "commands: " << commands.size() << " cus: " << cfg.num_cus
+            << " workload: " << (file.empty() ? workload : file)
+            << " policy: " << to_string(cfg.policy)
+            << " slot size: " << cfg.slot_size << " args: " << cfg.num_args << '\n'
+            << "      mode    cmds/s  dispatch(us)     notify  latency(us)     slots      cu"
+            << "   cyc/cmd  wall(s)\n"
+            << "                          avg      p99      avg      avg      p99  avg/max    util\n";
+
+  for (auto m : modes) {
+    cfg.mode = m;
+    auto start = std::chrono::steady_clock::now();
+    auto r = simulate(cfg, commands);
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    report(cfg, r, wall.count());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -104,28 +104,21 @@ hip_graph_add_memset_node(hipGraph_t g, const hipGraphNode_t *pDependencies,
   throw_invalid_value_if(total_size % element_size != 0, "Invalid size.");
 
   std::shared_ptr<command> hip_cmd;
-  auto element_count = total_size / element_size;
 
   // Create appropriate command based on element size
   switch (element_size) {
-    case 1: {
-      std::vector<std::uint8_t> host_vec(element_count, static_cast<std::uint8_t>(pMemsetParams->value));
-      hip_cmd = std::make_shared<copy_from_host_buffer_command<std::uint8_t>>(
-        hip_mem_dst, std::move(host_vec), total_size, offset);
+    case 1:
+      hip_cmd = std::make_shared<memset_command>(
+        hip_mem_dst, static_cast<std::uint8_t>(pMemsetParams->value), total_size, offset);
       break;
-    }
-    case 2: {
-      std::vector<std::uint16_t> host_vec(element_count, static_cast<std::uint16_t>(pMemsetParams->value));
-      hip_cmd = std::make_shared<copy_from_host_buffer_command<std::uint16_t>>(
-        hip_mem_dst, std::move(host_vec), total_size, offset);
+    case 2:
+      hip_cmd = std::make_shared<memset_command>(
+        hip_mem_dst, static_cast<std::uint16_t>(pMemsetParams->value), total_size, offset);
       break;
-    }
-    case 4: {
-      std::vector<std::uint32_t> host_vec(element_count, static_cast<std::uint32_t>(pMemsetParams->value));
-      hip_cmd = std::make_shared<copy_from_host_buffer_command<std::uint32_t>>(
-        hip_mem_dst, std::move(host_vec), total_size, offset);
+    case 4:
+      hip_cmd = std::make_shared<memset_command>(
+        hip_mem_dst, static_cast<std::uint32_t>(pMemsetParams->value), total_size, offset);
       break;
-    }
     default:
       throw_invalid_value_if(true, "Unsupported element size.");
   }
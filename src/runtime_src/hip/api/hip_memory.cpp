@@ -3,7 +3,6 @@
 
 #include <string>
 #include "core/common/error.h"
-#include "core/common/memalign.h"
 #include "core/common/unistd.h"
 #include "core/common/utils.h"
 #include "hip/config.h"
@@ -240,10 +239,8 @@ namespace xrt::core::hip
                            "memory type is invalid for memset.");
     throw_invalid_value_if(offset + size > hip_mem_dst->get_size(), "dst out of bound.");
 
-    auto host_src = xrt_core::aligned_alloc(xrt_core::getpagesize(), size);
-    memset(host_src.get(), value, size);
-
-    hip_mem_dst->write(host_src.get(), size, 0, offset);
+    auto pattern = static_cast<unsigned char>(value);
+    hip_mem_dst->fill(&pattern, sizeof(pattern), size, offset);
   }
 
   static void
@@ -283,16 +280,13 @@ namespace xrt::core::hip
     throw_invalid_value_if((element_size != 1 && element_size != 2 && element_size != 4), "Invalid element type.");
     throw_invalid_value_if(size % element_size != 0, "Invalid size.");
 
-    auto element_count = size / element_size;
-    std::vector<T> host_vec(element_count, value);
-
     auto hip_stream = get_stream(stream);
     throw_invalid_value_if(!hip_stream, "Invalid stream handle.");
 
     // ptr to a xrt::core::hip::command object could be shared between global command_cache and stream::m_top_event::m_chain_of_commands of a stream object
     auto s_hdl = hip_stream.get();
     auto cmd_hdl = insert_in_map(command_cache,
-                                 std::make_shared<copy_from_host_buffer_command<T>>(hip_mem_dst, std::move(host_vec), size, offset));
+                                 std::make_shared<memset_command>(hip_mem_dst, value, size, offset));
     s_hdl->enqueue(command_cache.get(cmd_hdl));
   }
 
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrthip_address_range_index_h
+#define xrthip_address_range_index_h
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace xrt::core::hip {
+
+// address_range_index - concurrent lookup of objects by address
+//
+// Maps non-overlapping address ranges to objects.  Lookups of an
+// address within a range return the object and the offset of the
+// address in the range.
+//
+// Ranges are indexed by the 2MB granules of the address space that
+// they overlap, so that a lookup is a hash of the granule number and
+// a scan of the few ranges in the granule rather than a descent of a
+// tree with a cache miss per level.  The index is behind a shared
+// mutex so that lookups from many threads do not serialize.
+//
+// Each thread caches the ranges of its last few lookups, which are
+// validated by a generation number that changes with every insert
+// and remove.  A lookup that hits the cache takes no lock.
+//
+// Cached objects are referenced weakly, the index does not extend the
+// lifetime of removed objects.
+template <typename ObjectType>
+class address_range_index
+{
+public:
+  using object_ptr = std::shared_ptr<ObjectType>;
+
+private:
+  struct range
+  {
+    uint64_t address;
+    size_t size;
+    object_ptr object;
+  };
+
+  struct cache_entry
+  {
+    const address_range_index* owner = nullptr;
+    uint64_t generation = 0;
+    uint64_t address = 0;
+    size_t size = 0;
+    std::weak_ptr<ObjectType> object;
+  };
+
+  static constexpr size_t cache_size = 4;
+
+  struct thread_cache
+  {
+    std::array<cache_entry, cache_size> entries;
+    size_t next = 0; // round robin replacement
+  };
+
+  // Generations are unique across instances, so a cache entry of a
+  // destroyed index never matches a new index at the same address.
+  inline static std::atomic<uint64_t> s_generation {0};
+
+  static constexpr unsigned int granule_shift = 21;
+
+  std::map<uint64_t, range> m_ranges; // keyed by last address of range
+  std::unordered_map<uint64_t, std::vector<const range*>> m_granules;
+  mutable std::shared_mutex m_mutex;
+  std::atomic<uint64_t> m_generation {++s_generation};
+
+  static thread_cache&
+  get_thread_cache()
+  {
+    static thread_local thread_cache cache;
+    return cache;
+  }
+
+  static bool
+  contains(uint64_t start, size_t size, uint64_t addr)
+  {
+    return addr >= start && (addr == start || addr - start < size);
+  }
+
+  static uint64_t
+  last_address(uint64_t addr, size_t size)
+  {
+    return size ? addr + size - 1 : addr;
+  }
+
+  // Range containing addr, caller must hold lock
+  const range*
+  find_range(uint64_t addr) const
+  {
+    auto itr = m_granules.find(addr >> granule_shift);
+    if (itr == m_granules.end())
+      return nullptr;
+    for (auto r : itr->second)
+      if (contains(r->address, r->size, addr))
+        return r;
+    return nullptr;
+  }
+
+  // Caller must hold exclusive lock
+  void
+  invalidate()
+  {
+    m_generation.store(++s_generation, std::memory_order_release);
+  }
+
+public:
+  address_range_index() = default;
+  address_range_index(const address_range_index&) = delete;
+  address_range_index& operator=(const address_range_index&) = delete;
+
+  // Insert range [addr, addr + size), no-op if a range ends at the
+  // same address.  Ranges must not overlap.
+  void
+  insert(uint64_t addr, size_t size, object_ptr object)
+  {
+    auto last = last_address(addr, size);
+    std::unique_lock lk(m_mutex);
+    auto [itr, inserted] = m_ranges.emplace(last, range{addr, size, std::move(object)});
+    if (!inserted)
+      return;
+    for (auto granule = addr >> granule_shift; granule <= last >> granule_shift; ++granule)
+      m_granules[granule].push_back(&itr->second);
+    invalidate();
+  }
+
+  // Remove the range containing addr if any
+  void
+  remove(uint64_t addr)
+  {
+    std::unique_lock lk(m_mutex);
+    auto r = find_range(addr);
+    if (!r)
+      return;
+    auto last = last_address(r->address, r->size);
+    for (auto granule = r->address >> granule_shift; granule <= last >> granule_shift; ++granule) {
+      auto& ranges = m_granules[granule];
+      ranges.erase(std::find(ranges.begin(), ranges.end(), r));
+      if (ranges.empty())
+        m_granules.erase(granule);
+    }
+    m_ranges.erase(last);
+    invalidate();
+  }
+
+  void
+  clear()
+  {
+    std::unique_lock lk(m_mutex);
+    m_granules.clear();
+    m_ranges.clear();
+    invalidate();
+  }
+
+  // Object of the range containing addr and offset of addr in the
+  // range, or nullptr if no range contains addr
+  std::pair<object_ptr, size_t>
+  find(uint64_t addr) const
+  {
+    auto& cache = get_thread_cache();
+    auto generation = m_generation.load(std::memory_order_acquire);
+    for (const auto& entry : cache.entries) {
+      if (entry.owner != this || entry.generation != generation || !contains(entry.address, entry.size, addr))
+        continue;
+      if (auto object = entry.object.lock())
+        return {std::move(object), addr - entry.address};
+    }
+
+    std::shared_lock lk(m_mutex);
+    auto r = find_range(addr);
+    if (!r)
+      return {nullptr, 0};
+
+    // generation read under lock matches the ranges
+    auto& entry = cache.entries[cache.next];
+    cache.next = (cache.next + 1) % cache_size;
+    entry.owner = this;
+    entry.generation = m_generation.load(std::memory_order_relaxed);
+    entry.address = r->address;
+    entry.size = r->size;
+    entry.object = r->object;
+    return {r->object, addr - r->address};
+  }
+};
+
+} // xrt::core::hip
+
+#endif
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2024-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #include <iostream>
 
@@ -375,12 +375,25 @@ bool kernel_start::wait()
 bool memcpy_command::submit()
 {
   m_handle = std::async(std::launch::async, &hipMemcpy, m_dst, m_src, m_size, m_kind);
+  set_state(state::running);
   return true;
 }
 
 bool memcpy_command::wait()
 {
-  m_handle.wait();
+  state memcpy_state = get_state();
+  if (memcpy_state == state::completed)
+    return true;
+
+  // not submitted, there is no copy to wait for
+  if (memcpy_state != state::running)
+    return false;
+
+  auto err = m_handle.get();
+  if (err != hipSuccess) {
+    set_state(state::error);
+    throw_hip_error(err, "memcpy failed");
+  }
   set_state(state::completed);
   return true;
 }
@@ -12,6 +12,7 @@
 #include "core/common/api/kernel_int.h"
 
 #include <condition_variable>
+#include <cstring>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -167,40 +168,60 @@ protected:
   const void* m_src; 
   size_t m_size;
   hipMemcpyKind m_kind;
-  std::future<hipError_t> m_handle;
+  std::shared_future<hipError_t> m_handle;
 };
 
-// copy command for copying data from a source only host buffer of type std::vector<uint8|uint16|uint32>
-template<class T>
-class copy_from_host_buffer_command : public command
+// memset command for hipMemsetAsync, fills device memory with a
+// repeated 1, 2, or 4 byte value directly in the host backing of the
+// device buffer
+class memset_command : public command
 {
 public:
-  copy_from_host_buffer_command(std::shared_ptr<memory> buf, std::vector<T>&& vec, size_t size, size_t offset)
-    : command(command::type::mem_cpy), buffer(std::move(buf)), host_vec(std::move(vec)), copy_size(size), dev_offset(offset)
+  template <typename T>
+  memset_command(std::shared_ptr<memory> buf, T value, size_t size, size_t offset)
+    : command(command::type::mem_cpy), buffer(std::move(buf)), pattern_size(sizeof(T)), fill_size(size), dev_offset(offset)
   {
+    static_assert(sizeof(T) <= sizeof(pattern), "unsupported memset element size");
+    std::memcpy(pattern, &value, sizeof(T));
   }
 
   bool
   submit() override
   {
-    handle = std::async(std::launch::async, &memory::write, buffer, host_vec.data(), copy_size, 0, dev_offset);
+    handle = std::async(std::launch::async, &memory::fill, buffer, pattern, pattern_size, fill_size, dev_offset);
+    set_state(state::running);
     return true;
   }
 
   bool
   wait() override
   {
-    handle.wait();
+    auto memset_state = get_state();
+    if (memset_state == state::completed)
+      return true;
+
+    // not submitted, there is no fill to wait for
+    if (memset_state != state::running)
+      return false;
+
+    try {
+      handle.get();
+    }
+    catch (const std::exception& ex) {
+      set_state(state::error);
+      throw_hip_error(hipErrorLaunchFailure, ex.what());
+    }
     set_state(state::completed);
     return true;
   }
 
 private:
   std::shared_ptr<memory> buffer; // device buffer
-  std::vector<T> host_vec; // host buffer (source only, not valid as destination)
-  size_t copy_size;
+  unsigned char pattern[sizeof(uint32_t)];
+  size_t pattern_size;
+  size_t fill_size;
   size_t dev_offset; // offset for device memory
-  std::future<void> handle;
+  std::shared_future<void> handle;
 };
 
 class empty_command : public command
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #include "hip/config.h"
 #include "hip/hip_runtime_api.h"
@@ -9,8 +9,13 @@
 
 #include <algorithm>
 #include <iostream>
-#include <unordered_set>
 #include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace xrt::core::hip {
 // Add a node to the graph and return its handle.
@@ -57,12 +62,13 @@ get_ordered_nodes() const
   return result;
 }
 
+using node_map = std::unordered_map<std::shared_ptr<graph_node>, std::shared_ptr<graph_node>>;
+
 static
 std::vector<std::shared_ptr<graph_node>>
-init(const std::shared_ptr<graph>& graph)
+init(const std::shared_ptr<graph>& graph, node_map& kernel_to_list_map)
 {
   std::vector<std::shared_ptr<graph_node>> node_list;
-  std::unordered_map<std::shared_ptr<graph_node>, std::shared_ptr<graph_node>> kernel_to_list_map;
 
   for (const auto& node : graph->get_ordered_nodes()) {
     auto cmd_ptr = node->get_cmd();
@@ -133,38 +139,199 @@ init(const std::shared_ptr<graph>& graph)
 
 graph_exec::
 graph_exec(const std::shared_ptr<graph>& graph)
-  : m_node_exec_list(init(graph))
-{}
+{
+  node_map kernel_to_list_map;
+  auto node_list = init(graph, kernel_to_list_map);
+
+  std::unordered_map<graph_node*, size_t> index;
+  for (size_t idx = 0; idx < node_list.size(); ++idx)
+    index[node_list[idx].get()] = idx;
+
+  // Resolve dependencies to indices of executed nodes.  Dependencies
+  // on kernel nodes resolve to the kernel_list_start node of the kernel.
+  m_nodes.resize(node_list.size());
+  for (size_t idx = 0; idx < node_list.size(); ++idx) {
+    m_nodes[idx].cmd = node_list[idx]->get_cmd();
+    std::vector<size_t> deps;
+    for (const auto& dep : node_list[idx]->get_deps_list()) {
+      auto kl = kernel_to_list_map.find(dep);
+      auto itr = index.find(kl != kernel_to_list_map.end() ? kl->second.get() : dep.get());
+      if (itr != index.end() && itr->second != idx)
+        deps.push_back(itr->second);
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    m_nodes[idx].num_deps = deps.size();
+    for (auto dep : deps)
+      m_nodes[dep].children.push_back(idx);
+  }
+}
 
 void
 graph_exec::
 execute(std::shared_ptr<stream> s)
 {
-  auto future = std::async(std::launch::async, [this, s]() {
-    for (auto& node : m_node_exec_list) {
-      auto cmd = node->get_cmd();
-      const auto cmd_type = cmd->get_type();
-
-      if (cmd_type == command::type::event_record)
-        std::static_pointer_cast<event_record_command>(cmd)->set_stream(s);
-      else if (cmd_type == command::type::event_wait)
-        std::static_pointer_cast<event_wait_command>(cmd)->set_stream(s);
-
-      // Wait for all dependencies to complete before enqueuing this node
-      for (const auto& dep : node->get_deps_list())
-        dep->get_cmd()->wait();
-
-      cmd->set_state(command::state::init);
-      if (cmd_type == command::type::event_record ||
-          cmd_type == command::type::event_wait)
-        cmd->submit();
-      else
-        s->enqueue(std::move(cmd));
+  auto executor = s->get_graph_executor();
+  executor->enqueue(shared_from_this(), std::move(s));
+}
+
+void
+graph_exec::
+run(const std::shared_ptr<stream>& s, std::vector<size_t>& pending, std::vector<size_t>& order)
+{
+  auto count = m_nodes.size();
+  pending.resize(count);
+  order.resize(count);
+  for (size_t idx = 0; idx < count; ++idx)
+    pending[idx] = m_nodes[idx].num_deps;
+
+  // submitted nodes in order of submission
+  size_t submitted = 0;
+  auto submit = [&](size_t idx) {
+    const auto& cmd = m_nodes[idx].cmd;
+    const auto cmd_type = cmd->get_type();
+
+    if (cmd_type == command::type::event_record)
+      std::static_pointer_cast<event_record_command>(cmd)->set_stream(s);
+    else if (cmd_type == command::type::event_wait)
+      std::static_pointer_cast<event_wait_command>(cmd)->set_stream(s);
+
+    cmd->set_state(command::state::init);
+    if (cmd_type == command::type::event_record ||
+        cmd_type == command::type::event_wait)
+      cmd->submit();
+    else {
+      // a command enqueued behind a pending stream event is chained
+      // to the event rather than submitted
+      s->await_top_event();
+      s->enqueue(cmd);
+    }
+    order[submitted++] = idx;
+  };
+
+  // Submit all ready nodes, then wait for submitted nodes in order
+  // of submission and submit children that became ready.  Once a
+  // node fails, no more nodes are submitted.  All submitted nodes
+  // complete before the launch completes, so that a following launch
+  // can reuse the commands.
+  std::exception_ptr error;
+  auto submit_or_fail = [&](size_t idx) {
+    if (error)
+      return;
+    try {
+      submit(idx);
+    }
+    catch (...) {
+      error = std::current_exception();
     }
-  });
+  };
 
-  // Store the future in the stream so synchronize() can wait for it
-  s->set_graph_exec_future(std::move(future));
+  for (size_t idx = 0; idx < count; ++idx)
+    if (!pending[idx])
+      submit_or_fail(idx);
+
+  for (size_t next = 0; next < submitted; ++next) {
+    const auto& node = m_nodes[order[next]];
+    try {
+      if (!node.cmd->wait() || node.cmd->get_state() != command::state::completed)
+        throw std::runtime_error("graph node " + std::to_string(order[next]) + ": "
+                                 + get_unmangled_type_name(*node.cmd) + ": execution failed");
+    }
+    catch (...) {
+      if (!error)
+        error = std::current_exception();
+    }
+    for (auto child : node.children)
+      if (--pending[child] == 0)
+        submit_or_fail(child);
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+graph_executor::
+graph_executor()
+  : m_worker([this] { run(); })
+{}
+
+graph_executor::
+~graph_executor()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_stop = true;
+    m_work.notify_one();
+  }
+
+  // The worker destroys the executor when it releases the last
+  // reference to the stream of a launch, it cannot join itself
+  if (m_worker.get_id() == std::this_thread::get_id()) {
+    *m_destroyed = true;
+    m_worker.detach();
+    return;
+  }
+  m_worker.join();
+}
+
+void
+graph_executor::
+run()
+{
+  bool destroyed = false;
+  m_destroyed = &destroyed;
+
+  while (true) {
+    launch l;
+    {
+      std::unique_lock lk(m_mutex);
+      m_work.wait(lk, [this] { return m_stop || !m_launches.empty(); });
+      if (m_launches.empty())
+        return;
+      l = std::move(m_launches.front());
+      m_launches.pop();
+      m_busy = true;
+    }
+
+    std::exception_ptr error;
+    try {
+      l.exec->run(l.strm, m_pending, m_order);
+    }
+    catch (...) {
+      error = std::current_exception();
+    }
+
+    // Release launch without lock, may destroy the stream and with
+    // it this executor, in which case the worker must exit without
+    // touching the executor
+    l = {};
+    if (destroyed)
+      return;
+
+    std::lock_guard lk(m_mutex);
+    if (error && !m_error)
+      m_error = std::move(error);
+    m_busy = false;
+    m_done.notify_all();
+  }
+}
+
+void
+graph_executor::
+enqueue(std::shared_ptr<graph_exec> exec, std::shared_ptr<stream> s)
+{
+  std::lock_guard lk(m_mutex);
+  m_launches.push({std::move(exec), std::move(s)});
+  m_work.notify_one();
+}
+
+std::exception_ptr
+graph_executor::
+wait()
+{
+  std::unique_lock lk(m_mutex);
+  m_done.wait(lk, [this] { return !m_busy && m_launches.empty(); });
+  return std::exchange(m_error, nullptr);
 }
 
 // Global map of graph
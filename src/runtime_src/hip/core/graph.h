@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2025-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #ifndef xrthip_graph_h
 #define xrthip_graph_h
@@ -8,6 +8,13 @@
 #include "module.h"
 #include "stream.h"
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
 namespace xrt::core::hip {
 
 // node_handle - opaque graph node handle
@@ -103,16 +110,86 @@ private:
 };
 
 // Represents an executable instance of a HIP graph.
-class graph_exec
+//
+// Nodes and their dependencies are resolved once when the graph is
+// instantiated, kernel nodes are grouped into runlists that are
+// reused by every launch.
+class graph_exec : public std::enable_shared_from_this<graph_exec>
 {
 private:
-  std::vector<std::shared_ptr<graph_node>> m_node_exec_list;
+  struct exec_node
+  {
+    std::shared_ptr<command> cmd;
+    size_t num_deps = 0;          // dependencies within the graph_exec
+    std::vector<size_t> children; // indices of dependent nodes
+  };
+
+  std::vector<exec_node> m_nodes; // in topological order
 
 public:
   graph_exec() = default;
   explicit graph_exec(const std::shared_ptr<graph>& graph);
 
+  // Enqueue a launch of the graph on the graph executor of the stream
   void execute(std::shared_ptr<stream> s);
+
+  // Execute a launch of the graph on stream and wait for completion.
+  // Nodes are submitted as soon as all their dependencies have
+  // completed.  Throws if a node fails, after all submitted nodes
+  // have completed.  The pending and order vectors are scratch space.
+  void run(const std::shared_ptr<stream>& s, std::vector<size_t>& pending, std::vector<size_t>& order);
+};
+
+// Persistent executor of graph launches on a stream.
+//
+// Launches are executed in order of enqueue by a worker thread owned
+// by the executor, which lives as long as the stream.  The worker is
+// joined when the executor is destroyed, except when the worker
+// itself releases the last reference to the stream of a launch, then
+// the worker exits as soon as the release returns.
+class graph_executor
+{
+  struct launch
+  {
+    std::shared_ptr<graph_exec> exec;
+    std::shared_ptr<stream> strm;
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_work; // launch enqueued or stopped
+  std::condition_variable m_done; // launch completed
+  std::queue<launch> m_launches;
+  bool m_busy = false;
+  bool m_stop = false;
+  std::exception_ptr m_error;     // first error since last wait
+
+  // scratch for executing launches, used by worker thread only
+  std::vector<size_t> m_pending;
+  std::vector<size_t> m_order;
+  bool* m_destroyed = nullptr;    // set if destroyed by worker thread
+
+  std::thread m_worker;
+
+  void
+  run();
+
+public:
+  // Start worker thread
+  graph_executor();
+
+  // Stop worker thread once enqueued launches have completed
+  ~graph_executor();
+
+  graph_executor(const graph_executor&) = delete;
+  graph_executor& operator=(const graph_executor&) = delete;
+
+  void
+  enqueue(std::shared_ptr<graph_exec> exec, std::shared_ptr<stream> s);
+
+  // Wait for all enqueued launches to complete, return first error
+  // of a launch since previous wait if any
+  std::exception_ptr
+  wait();
 };
 
 // Global map of graph
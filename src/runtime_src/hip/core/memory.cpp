@@ -9,6 +9,7 @@
 #endif
 
 #include "common.h"
+#include "core/common/fill.h"
 #include "device.h"
 #include "hip/config.h"
 #include "hip/hip_runtime_api.h"
@@ -121,6 +122,16 @@ namespace xrt::core::hip
     }
   }
 
+  void
+  memory::fill(const void* pattern, size_t pattern_size, size_t size, size_t offset)
+  {
+    throw_invalid_value_if(!m_bo, "memory fill, empty bo.");
+    // fill host backing of bo in place, no staging buffer
+    auto dst = static_cast<char*>(m_bo.map()) + offset;
+    xrt_core::fill(dst, size, pattern, pattern_size);
+    m_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
+  }
+
   void
   memory::sync(xclBOSyncDirection direction)
   {
@@ -161,7 +172,6 @@ namespace xrt::core::hip
   }
 
   memory_database::memory_database()
-      : m_addr_map(), m_mutex()
   {
     throw_invalid_value_if(m_memory_database != nullptr,
         "Multiple instances of hip memory_database detected, only one\n"
@@ -171,52 +181,31 @@ namespace xrt::core::hip
 
   memory_database::~memory_database()
   {
-    m_addr_map.clear();
+    m_index.clear();
   }
 
   void
   memory_database::insert(uint64_t addr, size_t size, std::shared_ptr<xrt::core::hip::memory> hip_mem)
   {
-    std::lock_guard lock(m_mutex);
-    m_addr_map.insert({address_range_key(addr, size), hip_mem});
+    m_index.insert(addr, size, std::move(hip_mem));
   }
 
   void
   memory_database::remove(uint64_t addr)
   {
-    std::lock_guard lock(m_mutex);
-
-    m_addr_map.erase(address_range_key(addr, 0));
+    m_index.remove(addr);
   }
 
   std::pair<std::shared_ptr<xrt::core::hip::memory>, size_t>
   memory_database::get_hip_mem_from_addr(void *addr)
   {
-    std::lock_guard lock(m_mutex);
-
-    auto itr = m_addr_map.find(address_range_key(reinterpret_cast<uint64_t>(addr), 0));
-    if (itr == m_addr_map.end()) {
-      return std::pair(nullptr, 0);
-    }
-    else {
-      auto offset = reinterpret_cast<uint64_t>(addr) - itr->first.address;
-      return {itr->second, offset};
-    }
+    return m_index.find(reinterpret_cast<uint64_t>(addr));
   }
 
   std::pair<std::shared_ptr<xrt::core::hip::memory>, size_t>
   memory_database::get_hip_mem_from_addr(const void *addr)
   {
-    std::lock_guard lock(m_mutex);
-
-    auto itr = m_addr_map.find(address_range_key(reinterpret_cast<uint64_t>(addr), 0));
-    if (itr == m_addr_map.end()) {
-      return std::pair(nullptr, 0);
-    }
-    else {
-      auto offset = reinterpret_cast<uint64_t>(addr) - itr->first.address;
-      return {itr->second, offset};
-    }
+    return m_index.find(reinterpret_cast<uint64_t>(addr));
   }
 
 } // namespace xrt::core::hip
@@ -5,6 +5,7 @@
 
 #include "core/common/device.h"
 #include "core/common/unistd.h"
+#include "address_range_index.h"
 #include "device.h"
 #include "core/include/xrt/xrt_bo.h"
 #include "core/include/xrt/experimental/xrt_ext.h"
@@ -61,6 +62,10 @@ namespace xrt::core::hip
 
     void
     read(void *dst, size_t size, size_t dst_offset = 0, size_t offset = 0); 
+
+    // fill size bytes at offset with repeated pattern and sync to device
+    void
+    fill(const void* pattern, size_t pattern_size, size_t size, size_t offset = 0);
     
     void
     sync(xclBOSyncDirection);
@@ -108,42 +113,10 @@ namespace xrt::core::hip
     init_xrt_bo();
   };
 
-  // address_range_key is used for look up hip memory objects via an offseted address
-  class address_range_key
-  {
-  public:
-    address_range_key() : address(0), size(0) {}
-    address_range_key(uint64_t addr, size_t sz) : address(addr), size(sz) {}
-
-    uint64_t    address;
-    size_t      size;
-  };
-
-  struct address_sz_key_compare
-  {
-    bool operator() (const address_range_key& lhs, const address_range_key& rhs) const
-    {
-      // The keys a and b are equivalent by definition when neither a < b nor b < a is true
-      if (lhs.address == rhs.address)
-        return false;
-      
-      // Example to explain why "-1" is mandatory in below calculation
-      // if address is 0x4000 and size is 0x100 . If another address is 0x4100
-      // a < b retruns false because 0x4000+0x100 < 0x4100
-      // b < a returns false because 0x4100+0x100 < 0x4000
-      // if we add "-1" then a<b returns true.
-      return (lhs.address + lhs.size < 1) || (lhs.address + lhs.size - 1  < rhs.address);
-    }
-  };
-  
-  ////////////////////////////////////////////////////////////////////////////////////////////////
-  using addr_map = std::map<address_range_key, std::shared_ptr<memory>, address_sz_key_compare>;
-  
   class memory_database
   {
   private:
-    addr_map m_addr_map; // address lookup for regular xrt::bo
-    std::mutex m_mutex;
+    address_range_index<memory> m_index; // address lookup for regular xrt::bo
 
   protected:
     memory_database();
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2024-2026 Advanced Micro Devices, Inc. All rights reserved.
 
 #include <typeinfo>
 
@@ -8,6 +8,7 @@
 
 #include "common.h"
 #include "event.h"
+#include "graph.h"
 #include "stream.h"
 
 namespace xrt::core::hip {
@@ -154,11 +155,21 @@ synchronize()
   // synchronize among streams in this ctx
   synchronize_streams();
 
-  if (m_graph_exec_future.valid())
-    m_graph_exec_future.wait();
+  // wait for graph launches to enqueue all their commands
+  std::shared_ptr<graph_executor> executor;
+  {
+    std::lock_guard<std::mutex> lk(m_graph_executor_lock);
+    executor = m_graph_executor;
+  }
+  std::exception_ptr graph_error;
+  if (executor)
+    graph_error = executor->wait();
 
   // complete commands in this stream
   await_completion();
+
+  if (graph_error)
+    std::rethrow_exception(graph_error);
 }
 
 void
@@ -175,11 +186,14 @@ record_top_event(std::shared_ptr<event> ev)
   m_top_event = std::move(ev);
 }
 
-void
+std::shared_ptr<graph_executor>
 stream::
-set_graph_exec_future(std::future<void> future)
+get_graph_executor()
 {
-  m_graph_exec_future = std::move(future);
+  std::lock_guard<std::mutex> lk(m_graph_executor_lock);
+  if (!m_graph_executor)
+    m_graph_executor = std::make_shared<graph_executor>();
+  return m_graph_executor;
 }
 
 void
@@ -190,6 +204,27 @@ clear_top_event()
   m_top_event = nullptr;
 }
 
+void
+stream::
+await_top_event()
+{
+  std::shared_ptr<event> ev;
+  {
+    std::lock_guard<std::mutex> lk(m_cmd_lock);
+    ev = m_top_event;
+  }
+  if (!ev)
+    return;
+
+  // completing the event submits the commands chained to it
+  if (!ev->wait())
+    throw_hip_error(hipErrorLaunchFailure, "stream event is not recorded");
+
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  if (m_top_event == ev)
+    m_top_event = nullptr;
+}
+
 std::shared_ptr<stream>
 get_stream(hipStream_t stream)
 {
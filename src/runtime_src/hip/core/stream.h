@@ -1,18 +1,20 @@
 // SPDX-License-Identifier: Apache-2.0
-// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2024-2026 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef xrthip_stream_h
 #define xrthip_stream_h
 
 #include "context.h"
 
 #include <list>
-#include <future>
+#include <memory>
+#include <mutex>
 
 namespace xrt::core::hip {
 
 // forward declarations
 class event;
 class command;
+class graph_executor;
 
 class stream
 {
@@ -23,7 +25,8 @@ class stream
   std::list<std::shared_ptr<command>> m_cmd_queue;
   std::mutex m_cmd_lock;
   std::shared_ptr<event> m_top_event;
-  std::future<void> m_graph_exec_future;
+  std::shared_ptr<graph_executor> m_graph_executor; // created by first graph launch
+  std::mutex m_graph_executor_lock;
 
 public:
   stream() = default;
@@ -76,8 +79,13 @@ public:
   void
   clear_top_event();
 
+  // Wait for top event of stream to complete and clear it, so that
+  // commands enqueued after it are submitted immediately
   void
-  set_graph_exec_future(std::future<void> future);
+  await_top_event();
+
+  std::shared_ptr<graph_executor>
+  get_graph_executor();
 };
 
 // Global map of streams
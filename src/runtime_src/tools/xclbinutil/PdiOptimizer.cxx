@@ -0,0 +1,647 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#include "PdiOptimizer.h"
+
+#include "load_pdi.h"
+
+#include <boost/format.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+namespace XUtil = XclBinUtilities;
+
+namespace {
+
+// Offset of the CDO in a PDI with one image and one partition
+constexpr size_t cdoOffset = PDI_IMAGE_HDR_TABLE_OFFSET + sizeof(XilPdi_ImgHdrTbl)
+                             + sizeof(XilPdi_ImgHdr) + sizeof(XilPdi_PrtnHdr);
+constexpr size_t cdoHeaderWords = XCDO_CDO_HDR_LEN;
+constexpr size_t wordSize = sizeof(uint32_t);
+
+// DMA block write data is aligned to 16 bytes in the PDI
+constexpr size_t blockAlignWords = 4;
+
+struct Command {
+  enum class Kind { write, maskWrite, blockWrite, nop, other };
+  Kind kind = Kind::other;
+  bool wide = false;              // 64 bit address form of write and mask write
+  uint64_t address = 0;
+  uint32_t mask = 0xffffffff;
+  std::vector<uint32_t> data;     // values written, raw command words of other
+
+  bool isFullWrite() const { return kind == Kind::write || kind == Kind::blockWrite; }
+  bool isWrite() const { return isFullWrite() || kind == Kind::maskWrite; }
+  uint64_t endAddress() const { return address + data.size() * wordSize; }
+};
+
+// Value of a word after a sequence of writes, only the bits in mask
+// are written
+struct Word {
+  uint32_t mask = 0;
+  uint32_t value = 0;
+
+  void write(uint32_t writeMask, uint32_t writeValue)
+  {
+    value = (value & ~writeMask) | (writeValue & writeMask);
+    mask |= writeMask;
+  }
+
+  bool operator==(const Word& rhs) const { return mask == rhs.mask && value == rhs.value; }
+};
+
+using WordMap = std::map<uint64_t, Word>;
+
+void
+applyWrite(const Command& cmd, WordMap& words)
+{
+  for (size_t i = 0; i < cmd.data.size(); ++i)
+    words[cmd.address + i * wordSize].write(cmd.mask, cmd.data[i]);
+}
+
+// Address is in a memory window of a tile other than a shim tile
+bool
+isMemory(uint64_t addr, const XUtil::PdiOptimizeOptions& options)
+{
+  uint64_t tileMask = (uint64_t(1) << options.rowShift) - 1;
+  if (((addr >> options.rowShift) & options.rowMask) == 0)
+    return false;
+  auto offset = addr & tileMask;
+  return std::any_of(options.memoryWindows.begin(), options.memoryWindows.end(),
+                     [offset](const auto& window) { return offset >= window.begin && offset < window.end; });
+}
+
+uint32_t
+readWord(const std::vector<char>& image, size_t offset)
+{
+  uint32_t word;
+  std::memcpy(&word, image.data() + offset, sizeof(word));
+  return word;
+}
+
+void
+writeWord(std::vector<char>& image, size_t offset, uint32_t word)
+{
+  std::memcpy(image.data() + offset, &word, sizeof(word));
+}
+
+// Decode the CDO commands, throws on commands that exceed the CDO
+std::vector<Command>
+decodeCommands(const std::vector<uint32_t>& words)
+{
+  std::vector<Command> commands;
+  size_t index = 0;
+  while (index < words.size()) {
+    uint32_t header = words[index];
+    size_t headerLen = XCDO_SHORT_CMD_HDR_LEN;
+    size_t len = (header & XCDO_CMD_LEN_MASK) >> XCDO_CMD_LEN_SHIFT;
+    if (len == XCDO_MAX_SHORT_CMD_LEN) {
+      if (index + 1 >= words.size())
+        throw std::runtime_error(boost::str(boost::format("ERROR: CDO command at word %d is truncated") % index));
+      len = words[index + 1];
+      headerLen = XCDO_LONG_CMD_HDR_LEN;
+    }
+    if (len > words.size() - index - headerLen)
+      throw std::runtime_error(boost::str(boost::format("ERROR: CDO command at word %d exceeds the CDO length") % index));
+
+    const uint32_t* payload = words.data() + index + headerLen;
+    bool plm = (header & XCDO_CMD_HNDLR_MASK) == XCDO_CMD_HNDLR_PLM_VAL;
+    uint32_t api = header & XCDO_CMD_API_ID_MASK;
+
+    Command cmd;
+    if (plm && api == XCDO_CMD_NOP)
+      cmd.kind = Command::Kind::nop;
+    else if (plm && api == XCDO_CMD_WRITE && len == 2) {
+      cmd.kind = Command::Kind::write;
+      cmd.address = payload[0];
+      cmd.data = {payload[1]};
+    }
+    else if (plm && api == XCDO_CMD_WRITE64 && len == 3) {
+      cmd.kind = Command::Kind::write;
+      cmd.wide = true;
+      cmd.address = (uint64_t(payload[0]) << 32) | payload[1];
+      cmd.data = {payload[2]};
+    }
+    else if (plm && api == XCDO_CMD_MASK_WRITE && len == 3) {
+      cmd.kind = Command::Kind::maskWrite;
+      cmd.address = payload[0];
+      cmd.mask = payload[1];
+      cmd.data = {payload[2]};
+    }
+    else if (plm && api == XCDO_CMD_MASKWRITE64 && len == 4) {
+      cmd.kind = Command::Kind::maskWrite;
+      cmd.wide = true;
+      cmd.address = (uint64_t(payload[0]) << 32) | payload[1];
+      cmd.mask = payload[2];
+      cmd.data = {payload[3]};
+    }
+    else if (plm && api == XCDO_CMD_DMAWRITE && len >= 2) {
+      cmd.kind = Command::Kind::blockWrite;
+      cmd.address = (uint64_t(payload[0]) << 32) | payload[1];
+      cmd.data.assign(payload + 2, payload + len);
+    }
+
+    // Unaligned writes are not optimized
+    if (cmd.kind == Command::Kind::other || (cmd.isWrite() && (cmd.address % wordSize))) {
+      cmd.kind = Command::Kind::other;
+      cmd.data.assign(words.begin() + index, words.begin() + index + headerLen + len);
+    }
+
+    commands.push_back(std::move(cmd));
+    index += headerLen + len;
+  }
+  return commands;
+}
+
+class Encoder {
+  std::vector<uint32_t> m_words;
+  size_t m_base;                  // Word offset of the commands in the PDI
+  XUtil::PdiOptimizeReport& m_report;
+  uint32_t m_maxBlockWords;
+
+  void
+  header(uint32_t api, size_t len)
+  {
+    uint32_t header = XCDO_CMD_HNDLR_PLM_VAL | api;
+    if (len < XCDO_MAX_SHORT_CMD_LEN)
+      m_words.push_back(header | static_cast<uint32_t>(len << XCDO_CMD_LEN_SHIFT));
+    else {
+      m_words.push_back(header | (XCDO_MAX_SHORT_CMD_LEN << XCDO_CMD_LEN_SHIFT));
+      m_words.push_back(static_cast<uint32_t>(len));
+    }
+    ++m_report.commandsAfter;
+  }
+
+  // Pad with a NOP so that the data of a block write of len payload
+  // words starts at an aligned offset
+  void
+  alignBlock(size_t len)
+  {
+    size_t headerLen = len < XCDO_MAX_SHORT_CMD_LEN ? XCDO_SHORT_CMD_HDR_LEN : XCDO_LONG_CMD_HDR_LEN;
+    size_t dataOffset = m_base + m_words.size() + headerLen + 2;
+    size_t pad = (blockAlignWords - dataOffset % blockAlignWords) % blockAlignWords;
+    if (!pad)
+      return;
+    header(XCDO_CMD_NOP, pad - 1);
+    m_words.insert(m_words.end(), pad - 1, 0);
+    ++m_report.nopsAfter;
+  }
+
+  void
+  address(uint64_t addr)
+  {
+    m_words.push_back(static_cast<uint32_t>(addr >> 32));
+    m_words.push_back(static_cast<uint32_t>(addr));
+  }
+
+public:
+  Encoder(size_t base, XUtil::PdiOptimizeReport& report, uint32_t maxBlockWords)
+    : m_base(base), m_report(report), m_maxBlockWords(maxBlockWords)
+  {}
+
+  void
+  encode(const Command& cmd)
+  {
+    switch (cmd.kind) {
+    case Command::Kind::write:
+      ++m_report.writesAfter;
+      if (cmd.wide) {
+        header(XCDO_CMD_WRITE64, 3);
+        address(cmd.address);
+      }
+      else {
+        header(XCDO_CMD_WRITE, 2);
+        m_words.push_back(static_cast<uint32_t>(cmd.address));
+      }
+      m_words.push_back(cmd.data[0]);
+      break;
+    case Command::Kind::maskWrite:
+      ++m_report.maskWritesAfter;
+      if (cmd.wide) {
+        header(XCDO_CMD_MASKWRITE64, 4);
+        address(cmd.address);
+      }
+      else {
+        header(XCDO_CMD_MASK_WRITE, 3);
+        m_words.push_back(static_cast<uint32_t>(cmd.address));
+      }
+      m_words.push_back(cmd.mask);
+      m_words.push_back(cmd.data[0]);
+      break;
+    case Command::Kind::blockWrite:
+      for (size_t offset = 0; offset < cmd.data.size(); offset += m_maxBlockWords) {
+        auto count = std::min<size_t>(m_maxBlockWords, cmd.data.size() - offset);
+        alignBlock(count + 2);
+        ++m_report.blockWritesAfter;
+        header(XCDO_CMD_DMAWRITE, count + 2);
+        address(cmd.address + offset * wordSize);
+        m_words.insert(m_words.end(), cmd.data.begin() + offset, cmd.data.begin() + offset + count);
+      }
+      break;
+    case Command::Kind::other:
+      m_words.insert(m_words.end(), cmd.data.begin(), cmd.data.end());
+      ++m_report.commandsAfter;
+      break;
+    case Command::Kind::nop:
+      break;
+    }
+  }
+
+  std::vector<uint32_t>&
+  words()
+  {
+    return m_words;
+  }
+};
+
+class Optimizer {
+  const XUtil::PdiOptimizeOptions& m_options;
+  XUtil::PdiOptimizeReport& m_report;
+  std::vector<Command> m_result;
+
+  // All words of the write are in the same memory window of one tile
+  bool
+  isMemoryWrite(const Command& cmd) const
+  {
+    if (!cmd.isWrite() || !isMemory(cmd.address, m_options))
+      return false;
+    auto last = cmd.endAddress() - wordSize;
+    if ((last >> m_options.rowShift) != (cmd.address >> m_options.rowShift))
+      return false;
+    uint64_t tileMask = (uint64_t(1) << m_options.rowShift) - 1;
+    auto begin = cmd.address & tileMask;
+    auto end = last & tileMask;
+    return std::any_of(m_options.memoryWindows.begin(), m_options.memoryWindows.end(),
+                       [begin, end](const auto& window) { return begin >= window.begin && end < window.end; });
+  }
+
+  // Full writes that continue the previous full write are merged into
+  // one block write if the merged write has at least minBlockWords
+  // words, or if one of the writes is a block write already.
+  void
+  addFullWrites(std::vector<Command>::const_iterator begin, std::vector<Command>::const_iterator end)
+  {
+    size_t words = 0;
+    bool block = false;
+    for (auto itr = begin; itr != end; ++itr) {
+      words += itr->data.size();
+      block = block || itr->kind == Command::Kind::blockWrite;
+    }
+
+    auto count = static_cast<size_t>(end - begin);
+    if (count == 1 || (!block && words < m_options.minBlockWords)) {
+      m_result.insert(m_result.end(), begin, end);
+      return;
+    }
+
+    Command merged;
+    merged.kind = Command::Kind::blockWrite;
+    merged.address = begin->address;
+    for (auto itr = begin; itr != end; ++itr)
+      merged.data.insert(merged.data.end(), itr->data.begin(), itr->data.end());
+    m_result.push_back(std::move(merged));
+  }
+
+  // Register writes are kept in order.  Full writes to consecutive
+  // addresses are merged into block writes, and adjacent mask writes
+  // of disjoint fields of one register are merged.
+  void
+  addRegisterWrites(std::vector<Command>::const_iterator begin, std::vector<Command>::const_iterator end)
+  {
+    auto itr = begin;
+    while (itr != end) {
+      if (itr->kind == Command::Kind::maskWrite) {
+        auto last = m_result.empty() ? nullptr : &m_result.back();
+        if (itr != begin && last && last->kind == Command::Kind::maskWrite
+            && last->address == itr->address && !(last->mask & itr->mask)) {
+          last->data[0] = (last->data[0] & last->mask) | (itr->data[0] & itr->mask);
+          last->mask |= itr->mask;
+          ++m_report.maskWritesCoalesced;
+        }
+        else
+          m_result.push_back(*itr);
+        ++itr;
+        continue;
+      }
+
+      auto next = itr + 1;
+      while (next != end && next->isFullWrite() && next->address == (next - 1)->endAddress())
+        ++next;
+      addFullWrites(itr, next);
+      itr = next;
+    }
+  }
+
+  // Memory writes between two other commands are not observed until
+  // the second command, so only the final value of each word is
+  // written, in address order.
+  void
+  addMemoryWrites(std::vector<Command>::const_iterator begin, std::vector<Command>::const_iterator end)
+  {
+    WordMap words;
+    uint64_t writes = 0;
+    bool ordered = true;
+    uint64_t lastAddress = 0;
+    for (auto itr = begin; itr != end; ++itr) {
+      applyWrite(*itr, words);
+      writes += itr->data.size();
+      ordered = ordered && (itr == begin || itr->address >= lastAddress);
+      lastAddress = itr->endAddress();
+    }
+    m_report.deadWords += writes - words.size();
+    if (!ordered)
+      ++m_report.memoryRuns;
+
+    auto itr = words.begin();
+    while (itr != words.end()) {
+      Command cmd;
+      cmd.address = itr->first;
+      cmd.wide = cmd.address > 0xffffffff;
+      if (itr->second.mask != 0xffffffff) {
+        cmd.kind = Command::Kind::maskWrite;
+        cmd.mask = itr->second.mask;
+        cmd.data = {itr->second.value};
+        m_result.push_back(std::move(cmd));
+        ++itr;
+        continue;
+      }
+
+      // Run of full words at consecutive addresses
+      cmd.kind = Command::Kind::blockWrite;
+      auto next = itr;
+      do {
+        cmd.data.push_back(next->second.value);
+        ++next;
+      } while (next != words.end() && next->second.mask == 0xffffffff
+               && next->first == cmd.endAddress());
+
+      if (cmd.data.size() >= m_options.minBlockWords)
+        m_result.push_back(std::move(cmd));
+      else {
+        for (; itr != next; ++itr) {
+          Command write;
+          write.kind = Command::Kind::write;
+          write.address = itr->first;
+          write.wide = write.address > 0xffffffff;
+          write.data = {itr->second.value};
+          m_result.push_back(std::move(write));
+        }
+      }
+      itr = next;
+    }
+  }
+
+public:
+  Optimizer(const XUtil::PdiOptimizeOptions& options, XUtil::PdiOptimizeReport& report)
+    : m_options(options), m_report(report)
+  {}
+
+  // Split the commands into runs of memory writes, runs of register
+  // writes, and other commands.  NOPs are dropped.
+  std::vector<Command>
+  optimize(const std::vector<Command>& input)
+  {
+    std::vector<Command> commands;
+    for (const auto& cmd : input) {
+      if (cmd.kind == Command::Kind::nop)
+        ++m_report.nopsBefore;
+      else
+        commands.push_back(cmd);
+      m_report.writesBefore += cmd.kind == Command::Kind::write;
+      m_report.maskWritesBefore += cmd.kind == Command::Kind::maskWrite;
+      m_report.blockWritesBefore += cmd.kind == Command::Kind::blockWrite;
+    }
+    m_report.commandsBefore += input.size();
+
+    auto itr = commands.cbegin();
+    while (itr != commands.cend()) {
+      if (!itr->isWrite()) {
+        m_result.push_back(*itr++);
+        continue;
+      }
+
+      bool memory = isMemoryWrite(*itr);
+      auto next = itr + 1;
+      while (next != commands.cend() && next->isWrite() && isMemoryWrite(*next) == memory)
+        ++next;
+      if (memory)
+        addMemoryWrites(itr, next);
+      else
+        addRegisterWrites(itr, next);
+      itr = next;
+    }
+    return std::move(m_result);
+  }
+};
+
+// Observable effect of a CDO.  Each register word write and each
+// other command is an event, in order, with the final value of the
+// memory words written since the previous event.  Besides merging
+// writes into block writes, the one change of register writes the
+// optimizer makes is to coalesce adjacent mask writes of disjoint
+// fields of a register, so such writes with no memory write between
+// them are one event.
+struct Event {
+  std::vector<uint64_t> words;  // address, mask, masked value of register write, or raw command
+  WordMap memory;               // memory written since previous event
+
+  bool operator==(const Event& rhs) const { return words == rhs.words && memory == rhs.memory; }
+};
+
+std::vector<Event>
+observe(const std::vector<Command>& commands, const XUtil::PdiOptimizeOptions& options)
+{
+  std::vector<Event> events;
+  WordMap memory;
+  bool lastRegisterWrite = false;
+
+  auto write = [&](uint64_t addr, uint32_t mask, uint32_t value) {
+    if (isMemory(addr, options)) {
+      memory[addr].write(mask, value);
+      return;
+    }
+
+    if (lastRegisterWrite && memory.empty()) {
+      auto& last = events.back().words;
+      if (last[0] == addr && !(last[1] & mask)) {
+        last[1] |= mask;
+        last[2] |= value & mask;
+        return;
+      }
+    }
+    events.push_back({{addr, mask, value & mask}, std::move(memory)});
+    memory.clear();
+    lastRegisterWrite = true;
+  };
+
+  for (const auto& cmd : commands) {
+    if (cmd.isWrite()) {
+      for (size_t i = 0; i < cmd.data.size(); ++i)
+        write(cmd.address + i * wordSize, cmd.mask, cmd.data[i]);
+    }
+    else if (cmd.kind == Command::Kind::other) {
+      events.push_back({{cmd.data.begin(), cmd.data.end()}, std::move(memory)});
+      memory.clear();
+      lastRegisterWrite = false;
+    }
+  }
+  events.push_back({{}, std::move(memory)});
+  return events;
+}
+
+// Register writes and other commands must happen in the same order
+// and see the same memory before and after optimization
+void
+checkEquivalent(const std::vector<Command>& before, const std::vector<Command>& after,
+                const XUtil::PdiOptimizeOptions& options)
+{
+  if (observe(before, options) != observe(after, options))
+    throw std::runtime_error("ERROR: Optimized CDO is not equivalent to the original CDO");
+}
+
+uint32_t
+checksum(const std::vector<char>& image, size_t offset, size_t words)
+{
+  uint32_t sum = 0;
+  for (size_t i = 0; i < words; ++i)
+    sum += readWord(image, offset + i * wordSize);
+  return ~sum;
+}
+
+} // namespace
+
+bool
+XclBinUtilities::optimizePdiImage(std::vector<char>& image, PdiOptimizeReport& report, std::string& reason,
+                                  const PdiOptimizeOptions& options)
+{
+  if (options.minBlockWords == 0 || options.maxBlockWords == 0)
+    throw std::runtime_error("ERROR: PDI optimizer block write sizes must be greater than 0");
+
+  if (image.size() < cdoOffset + cdoHeaderWords * wordSize)
+    throw std::runtime_error("ERROR: PDI is too small to hold a partition");
+
+  XilPdi_ImgHdrTbl imgHdrTbl;
+  XilPdi_PrtnHdr prtnHdr;
+  constexpr size_t prtnHdrOffset = PDI_IMAGE_HDR_TABLE_OFFSET + sizeof(XilPdi_ImgHdrTbl) + sizeof(XilPdi_ImgHdr);
+  std::memcpy(&imgHdrTbl, image.data() + PDI_IMAGE_HDR_TABLE_OFFSET, sizeof(imgHdrTbl));
+  std::memcpy(&prtnHdr, image.data() + prtnHdrOffset, sizeof(prtnHdr));
+
+  if (imgHdrTbl.NoOfImgs != 1 || imgHdrTbl.NoOfPrtns != 1) {
+    reason = "PDI has more than one image or partition";
+    return false;
+  }
+
+  XPdiLoad pdiLoad = {nullptr, static_cast<uint32_t>(image.size()), image.data()};
+  if (XPdi_Header_Transform_Type(&pdiLoad, nullptr) != NOTRANFORM) {
+    reason = "PDI is transformed";
+    return false;
+  }
+
+  if (prtnHdr.DataWordOfst * wordSize != cdoOffset) {
+    reason = "partition data does not follow the partition header";
+    return false;
+  }
+
+  if (prtnHdr.EncStatus || prtnHdr.AuthCertificateOfst || prtnHdr.EncDataWordLen != prtnHdr.TotalDataWordLen) {
+    reason = "PDI is encrypted or authenticated";
+    return false;
+  }
+
+  if (cdoOffset + uint64_t(prtnHdr.TotalDataWordLen) * wordSize != image.size()) {
+    reason = "PDI has data beyond the partition";
+    return false;
+  }
+
+  if (readWord(image, cdoOffset + wordSize) != XCDO_CDO_HDR_IDN_WRD) {
+    reason = "partition is not a CDO";
+    return false;
+  }
+
+  uint32_t cdoWords = readWord(image, cdoOffset + 3 * wordSize);
+  if (cdoHeaderWords + cdoWords != prtnHdr.UnEncDataWordLen || prtnHdr.UnEncDataWordLen > prtnHdr.TotalDataWordLen)
+    throw std::runtime_error("ERROR: CDO length does not match the partition length");
+
+  std::vector<uint32_t> words(cdoWords);
+  std::memcpy(words.data(), image.data() + cdoOffset + cdoHeaderWords * wordSize, cdoWords * wordSize);
+  auto input = decodeCommands(words);
+
+  PdiOptimizeReport pdiReport;
+  auto commands = Optimizer(options, pdiReport).optimize(input);
+
+  Encoder encoder(cdoOffset / wordSize + cdoHeaderWords, pdiReport, options.maxBlockWords);
+  for (const auto& cmd : commands)
+    encoder.encode(cmd);
+  auto& optimized = encoder.words();
+
+  checkEquivalent(input, decodeCommands(optimized), options);
+
+  // Partition data is a multiple of 16 bytes
+  auto dataWords = static_cast<uint32_t>(cdoHeaderWords + optimized.size());
+  auto totalWords = (dataWords + XIH_PRTN_WORD_LEN - 1) / XIH_PRTN_WORD_LEN * XIH_PRTN_WORD_LEN;
+
+  std::vector<char> result(cdoOffset + size_t(totalWords) * wordSize, 0);
+  std::memcpy(result.data(), image.data(), cdoOffset + cdoHeaderWords * wordSize);
+  std::memcpy(result.data() + cdoOffset + cdoHeaderWords * wordSize, optimized.data(), optimized.size() * wordSize);
+
+  writeWord(result, cdoOffset + 3 * wordSize, static_cast<uint32_t>(optimized.size()));
+  writeWord(result, cdoOffset + 4 * wordSize, checksum(result, cdoOffset, cdoHeaderWords - 1));
+
+  prtnHdr.EncDataWordLen = totalWords;
+  prtnHdr.UnEncDataWordLen = dataWords;
+  prtnHdr.TotalDataWordLen = totalWords;
+  std::memcpy(result.data() + prtnHdrOffset, &prtnHdr, sizeof(prtnHdr));
+  constexpr size_t prtnHdrWords = sizeof(XilPdi_PrtnHdr) / wordSize;
+  writeWord(result, prtnHdrOffset + (prtnHdrWords - 1) * wordSize, checksum(result, prtnHdrOffset, prtnHdrWords - 1));
+
+  pdiReport.bytesBefore = image.size();
+  pdiReport.bytesAfter = result.size();
+  report = pdiReport;
+  image = std::move(result);
+  return true;
+}
+
+bool
+XclBinUtilities::optimizePdiFile(const std::string& fileName, PdiOptimizeReport& report, std::string& reason,
+                                 const PdiOptimizeOptions& options)
+{
+  std::vector<char> image;
+  {
+    std::ifstream ifs(fileName, std::ifstream::in | std::ifstream::binary);
+    if (!ifs.is_open())
+      throw std::runtime_error("ERROR: Unable to open the file for reading: " + fileName);
+    image.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+
+  if (!optimizePdiImage(image, report, reason, options))
+    return false;
+
+  std::ofstream ofs(fileName, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  if (!ofs.is_open())
+    throw std::runtime_error("ERROR: Unable to open the file for writing: " + fileName);
+  ofs.write(image.data(), image.size());
+  return true;
+}
+
+std::string
+XclBinUtilities::formatPdiOptimizeReport(const std::string& name, const PdiOptimizeReport& report)
+{
+  auto percent = [](uint64_t before, uint64_t after) {
+    return before ? (double(after) - double(before)) * 100 / double(before) : 0.0;
+  };
+
+  return boost::str(boost::format("PDI optimized: %s\n"
+                                  "  Commands : %8d -> %8d (%+.1f%%)\n"
+                                  "  Bytes    : %8d -> %8d (%+.1f%%)\n"
+                                  "  Writes: %d -> %d, mask writes: %d -> %d, block writes: %d -> %d, NOPs: %d -> %d\n"
+                                  "  Memory words overwritten: %d, mask writes coalesced: %d, memory runs reordered: %d")
+                    % name
+                    % report.commandsBefore % report.commandsAfter % percent(report.commandsBefore, report.commandsAfter)
+                    % report.bytesBefore % report.bytesAfter % percent(report.bytesBefore, report.bytesAfter)
+                    % report.writesBefore % report.writesAfter
+                    % report.maskWritesBefore % report.maskWritesAfter
+                    % report.blockWritesBefore % report.blockWritesAfter
+                    % report.nopsBefore % report.nopsAfter
+                    % report.deadWords % report.maskWritesCoalesced % report.memoryRuns);
+}
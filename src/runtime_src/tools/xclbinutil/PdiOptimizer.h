@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef __PdiOptimizer_h_
+#define __PdiOptimizer_h_
+
+// Please keep the include files to a minimum
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// PDI optimizer
+//
+// Rewrites the CDO commands of an AIE partition PDI into an equivalent
+// and shorter command stream:
+//
+//  - Writes to tile data memory that are overwritten before the memory
+//    can be observed are removed.  Memory is observed by any command
+//    that is not a write to tile data memory, e.g. a register write
+//    that enables a core or a DMA.
+//  - Between two such commands, the writes to tile data memory are
+//    independent and are re-emitted in address order, which groups them
+//    by tile and turns runs of words into DMA block writes.
+//  - Runs of register writes to consecutive addresses are merged into
+//    DMA block writes, the same form the CDO generator uses for buffer
+//    descriptors.
+//  - Adjacent mask writes to the same register that update disjoint
+//    fields are merged into one mask write.
+//
+// Register writes may have side effects, e.g. a reset pulse is two
+// writes of the same field, so register writes are never removed or
+// reordered.  Commands other than writes are copied unchanged.
+//
+// Only unencrypted PDIs with one partition that holds one CDO are
+// optimized, other PDIs are reported as not supported and left as is.
+namespace XclBinUtilities {
+
+struct PdiOptimizeOptions {
+  // Tile data memory is the address window [begin, end) within a tile
+  // of rows other than the shim row.  Tile addresses are partition
+  // relative, column << 25 | row << 20 | offset.
+  struct MemoryWindow {
+    uint32_t begin;
+    uint32_t end;
+  };
+  std::vector<MemoryWindow> memoryWindows = {{0x0, 0x10000}};
+  unsigned int rowShift = 20;
+  unsigned int rowMask = 0x1f;
+
+  // Consecutive words written as one DMA block write, fewer words are
+  // written individually.  The maximum keeps block writes within what
+  // the PDI transform supports.
+  uint32_t minBlockWords = 3;
+  uint32_t maxBlockWords = 0x8000;
+};
+
+struct PdiOptimizeReport {
+  uint64_t commandsBefore = 0;
+  uint64_t commandsAfter = 0;
+  uint64_t bytesBefore = 0;            // Size of the PDI
+  uint64_t bytesAfter = 0;
+  uint64_t writesBefore = 0;           // Commands by kind
+  uint64_t writesAfter = 0;
+  uint64_t maskWritesBefore = 0;
+  uint64_t maskWritesAfter = 0;
+  uint64_t blockWritesBefore = 0;
+  uint64_t blockWritesAfter = 0;
+  uint64_t nopsBefore = 0;
+  uint64_t nopsAfter = 0;
+  uint64_t deadWords = 0;              // Memory word writes overwritten or merged
+  uint64_t maskWritesCoalesced = 0;    // Register mask writes merged into another
+  uint64_t memoryRuns = 0;             // Runs of memory writes reordered
+};
+
+// Optimize the PDI image in place.  Returns false and leaves the image
+// unchanged if the PDI is not supported, in which case reason is set.
+// Throws on malformed PDI.
+bool optimizePdiImage(std::vector<char>& image, PdiOptimizeReport& report, std::string& reason,
+                      const PdiOptimizeOptions& options = PdiOptimizeOptions());
+
+// Optimize the PDI file in place, see optimizePdiImage.
+bool optimizePdiFile(const std::string& fileName, PdiOptimizeReport& report, std::string& reason,
+                     const PdiOptimizeOptions& options = PdiOptimizeOptions());
+
+std::string formatPdiOptimizeReport(const std::string& name, const PdiOptimizeReport& report);
+};
+
+#endif
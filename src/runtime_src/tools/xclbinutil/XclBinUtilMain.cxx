@@ -196,6 +196,7 @@ int main_(int argc, const char** argv) {
   bool bSignatureDebug = false;
   bool bSkipBankGrouping = false;
   bool bSkipUUIDInsertion = false;
+  bool bOptimizePdi = false;
   bool bTrace = false;
   bool bTransformPdi = false;
   boost::program_options::options_description hidden("Hidden options");
@@ -209,6 +210,7 @@ int main_(int argc, const char** argv) {
     ("append-section", boost::program_options::value<decltype(sectionsToAppend)>(&sectionsToAppend)->multitoken(), "Section to append to.")
     ("BAD-DATA", boost::program_options::value<decltype(badOptions)>(&badOptions)->multitoken(), "Dummy Data." )
     ("dump-signature", boost::program_options::value<decltype(sSignatureOutputFile)>(&sSignatureOutputFile), "Dumps a sign xclbin image's signature.")
+    ("optimize-pdi", boost::program_options::bool_switch(&bOptimizePdi), "Optimize the CDO commands of the PDIs in AIE_PARTITION and report the reduction")
     ("reset-bank-grouping", boost::program_options::bool_switch(&bResetBankGrouping), "Resets the memory bank grouping section(s).")
     ("signature-debug", boost::program_options::bool_switch(&bSignatureDebug), "Dump section debug data.")
     ("skip-bank-grouping", boost::program_options::bool_switch(&bSkipBankGrouping), "Disables creating the memory bank grouping section(s).")
@@ -532,6 +534,11 @@ int main_(int argc, const char** argv) {
       (xclBin.findSection(MEM_TOPOLOGY) != nullptr))
     XUtil::createMemoryBankGrouping(xclBin);
 
+  // optimize the PDIs before they are transformed, the optimizer
+  // does not support transformed PDIs
+  if (bOptimizePdi)
+    XUtil::optimizeAiePartitionPDIs(xclBin);
+
   // add support for transform-pdi
   // transform the PDIs in AIE_PARTITION sections before writing out the output xclbin
   if (bTransformPdi)
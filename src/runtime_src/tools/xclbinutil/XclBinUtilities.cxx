@@ -4,6 +4,7 @@
 
 #include "XclBinUtilities.h"
 
+#include "PdiOptimizer.h"
 #include "Section.h"                           // TODO: REMOVE SECTION INCLUDE
 #include "XclBinClass.h"
 
@@ -12,6 +13,7 @@
 #include <boost/uuid/uuid.hpp>          // for uuid
 #include <boost/uuid/uuid_io.hpp>       // for to_string
 #include <boost/version.hpp>
+#include <functional>
 #include <future>
 #include <set>
 
@@ -1058,8 +1060,10 @@ int transform_PDI_file(std::string fileName)
   return ret;
 }
 
-void
-XclBinUtilities::transformAiePartitionPDIs(XclBin & xclbin)
+// Apply updatePdi to each PDI file of the AIE_PARTITION sections and
+// replace the sections with the updated PDIs
+static void
+updateAiePartitionPDIs(XclBin & xclbin, const std::function<void(const fs::path&)>& updatePdi)
 {
   // find all sections with type "AIE_PARTITION" in xclbin
   // create a temp empty folder on disk, e.g. "ap_temp"
@@ -1147,10 +1151,7 @@ XclBinUtilities::transformAiePartitionPDIs(XclBin & xclbin)
         continue;
 
       // std::cout << "pdi file found: " << entry.path() << std::endl;
-      // if pdi_transform fails, transform_PDI_file throws, so no need to
-      // check the return value
-      transform_PDI_file(entry.path().string());
-      XUtil::TRACE("pdi file transformed: " + entry.path().string());
+      updatePdi(entry.path());
     }
 
     // construct the PSD for addSection
@@ -1175,6 +1176,31 @@ XclBinUtilities::transformAiePartitionPDIs(XclBin & xclbin)
   fs::remove_all(tempDir);
 }
 
+void
+XclBinUtilities::transformAiePartitionPDIs(XclBin & xclbin)
+{
+  updateAiePartitionPDIs(xclbin, [](const fs::path& pdiFile) {
+    // if pdi_transform fails, transform_PDI_file throws, so no need to
+    // check the return value
+    transform_PDI_file(pdiFile.string());
+    XUtil::TRACE("pdi file transformed: " + pdiFile.string());
+  });
+}
+
+void
+XclBinUtilities::optimizeAiePartitionPDIs(XclBin & xclbin)
+{
+  updateAiePartitionPDIs(xclbin, [](const fs::path& pdiFile) {
+    PdiOptimizeReport report;
+    std::string reason;
+    if (!optimizePdiFile(pdiFile.string(), report, reason)) {
+      XUtil::QUIET("Info: PDI not optimized: " + pdiFile.filename().string() + ", " + reason);
+      return;
+    }
+    XUtil::QUIET(formatPdiOptimizeReport(pdiFile.filename().string(), report));
+  });
+}
+
 
 #if (BOOST_VERSION >= 106400)
 int
@@ -170,6 +170,9 @@ void createMemoryBankGrouping(XclBin & xclbin);
 
 // temporary for 2024.1, https://jira.xilinx.com/browse/SDXFLO-6890
 void transformAiePartitionPDIs(XclBin & xclbin);
+
+// Optimize the CDO commands of the PDIs in AIE_PARTITION, see PdiOptimizer.h
+void optimizeAiePartitionPDIs(XclBin & xclbin);
 };
 
 #endif
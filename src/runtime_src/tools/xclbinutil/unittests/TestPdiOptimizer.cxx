@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+#include <gtest/gtest.h>
+#include "PdiOptimizer.h"
+#include "load_pdi.h"
+#include "globals.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+
+namespace XUtil = XclBinUtilities;
+
+namespace {
+
+constexpr size_t prtnHdrOffset = PDI_IMAGE_HDR_TABLE_OFFSET + sizeof(XilPdi_ImgHdrTbl) + sizeof(XilPdi_ImgHdr);
+constexpr size_t cdoOffset = prtnHdrOffset + sizeof(XilPdi_PrtnHdr);
+
+uint32_t
+checksum(const uint32_t* words, size_t count)
+{
+  uint32_t sum = 0;
+  for (size_t i = 0; i < count; ++i)
+    sum += words[i];
+  return ~sum;
+}
+
+// PDI with one image and one partition holding the CDO commands
+std::vector<char>
+createPdi(const std::vector<uint32_t>& commands)
+{
+  std::vector<uint32_t> cdo = {XCDO_CDO_HDR_LEN - 1, XCDO_CDO_HDR_IDN_WRD, 0x200, static_cast<uint32_t>(commands.size()), 0};
+  cdo[4] = checksum(cdo.data(), 4);
+  cdo.insert(cdo.end(), commands.begin(), commands.end());
+  auto dataWords = static_cast<uint32_t>(cdo.size());
+  cdo.resize((cdo.size() + 3) / 4 * 4, 0);
+
+  XilPdi_ImgHdrTbl imgHdrTbl = {};
+  imgHdrTbl.NoOfImgs = 1;
+  imgHdrTbl.NoOfPrtns = 1;
+  imgHdrTbl.ImgHdrAddr = (PDI_IMAGE_HDR_TABLE_OFFSET + sizeof(XilPdi_ImgHdrTbl)) / 4;
+  imgHdrTbl.PrtnHdrAddr = prtnHdrOffset / 4;
+
+  XilPdi_PrtnHdr prtnHdr = {};
+  prtnHdr.EncDataWordLen = static_cast<uint32_t>(cdo.size());
+  prtnHdr.UnEncDataWordLen = dataWords;
+  prtnHdr.TotalDataWordLen = static_cast<uint32_t>(cdo.size());
+  prtnHdr.DataWordOfst = cdoOffset / 4;
+  prtnHdr.Checksum = checksum(reinterpret_cast<const uint32_t*>(&prtnHdr), sizeof(prtnHdr) / 4 - 1);
+
+  std::vector<char> image(cdoOffset + cdo.size() * 4, 0);
+  std::memcpy(image.data() + PDI_IMAGE_HDR_TABLE_OFFSET, &imgHdrTbl, sizeof(imgHdrTbl));
+  std::memcpy(image.data() + prtnHdrOffset, &prtnHdr, sizeof(prtnHdr));
+  std::memcpy(image.data() + cdoOffset, cdo.data(), cdo.size() * 4);
+  return image;
+}
+
+std::vector<char>
+readHexPdi(const std::filesystem::path& path)
+{
+  std::ifstream ifs(path);
+  std::string hex((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  hex.erase(std::remove_if(hex.begin(), hex.end(), ::isspace), hex.end());
+  std::vector<char> image;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2)
+    image.push_back(static_cast<char>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+  return image;
+}
+
+// Reference model of a CDO.  Register writes and other commands are
+// events that must happen in the same order and see the same tile
+// memory before and after optimization.  Adjacent register mask writes
+// of disjoint fields are one event.
+class CdoModel {
+  struct Event {
+    bool registerWrite;
+    std::vector<uint64_t> words;  // address, mask, value or raw command
+    size_t memoryHash;
+
+    bool operator==(const Event& rhs) const { return words == rhs.words && memoryHash == rhs.memoryHash; }
+  };
+
+  std::map<uint64_t, std::pair<uint32_t, uint32_t>> m_memory;  // address to mask, value
+  std::vector<Event> m_events;
+
+  static bool
+  isMemory(uint64_t addr)
+  {
+    return ((addr >> 20) & 0x1f) != 0 && (addr & 0xfffff) < 0x10000;
+  }
+
+  size_t
+  memoryHash() const
+  {
+    size_t hash = 0;
+    for (const auto& [addr, word] : m_memory)
+      hash = hash * 31 + std::hash<uint64_t>()(addr ^ (uint64_t(word.first) << 32) ^ word.second);
+    return hash;
+  }
+
+  void
+  write(uint64_t addr, uint32_t mask, uint32_t value)
+  {
+    if (isMemory(addr)) {
+      auto& word = m_memory[addr];
+      word.second = (word.second & ~mask) | (value & mask);
+      word.first |= mask;
+      return;
+    }
+
+    auto hash = memoryHash();
+    if (!m_events.empty()) {
+      auto& last = m_events.back();
+      if (last.registerWrite && last.words[0] == addr && last.memoryHash == hash && !(last.words[1] & mask)) {
+        last.words[2] = (last.words[2] & last.words[1]) | (value & mask);
+        last.words[1] |= mask;
+        return;
+      }
+    }
+    m_events.push_back({true, {addr, mask, value}, hash});
+  }
+
+public:
+  explicit CdoModel(const std::vector<char>& image)
+  {
+    uint32_t cdoWords;
+    std::memcpy(&cdoWords, image.data() + cdoOffset + 12, 4);
+    std::vector<uint32_t> words(cdoWords);
+    std::memcpy(words.data(), image.data() + cdoOffset + XCDO_CDO_HDR_LEN * 4, cdoWords * 4);
+
+    for (size_t i = 0; i < words.size();) {
+      uint32_t header = words[i++];
+      uint32_t len = (header >> 16) & 0xff;
+      if (len == 0xff)
+        len = words[i++];
+      const uint32_t* p = words.data() + i;
+      switch (header & 0xffff) {
+      case 0x102: write(p[0], p[1], p[2]); break;
+      case 0x103: write(p[0], 0xffffffff, p[1]); break;
+      case 0x107: write((uint64_t(p[0]) << 32) | p[1], p[2], p[3]); break;
+      case 0x108: write((uint64_t(p[0]) << 32) | p[1], 0xffffffff, p[2]); break;
+      case 0x105:
+        for (uint32_t k = 2; k < len; ++k)
+          write(((uint64_t(p[0]) << 32) | p[1]) + (k - 2) * 4, 0xffffffff, p[k]);
+        break;
+      case 0x111: break;
+      default: {
+        Event event{false, {header}, memoryHash()};
+        event.words.insert(event.words.end(), p, p + len);
+        m_events.push_back(event);
+      }
+      }
+      i += len;
+    }
+    m_events.push_back({false, {}, memoryHash()});
+  }
+
+  bool operator==(const CdoModel& rhs) const { return m_events == rhs.m_events; }
+};
+
+void
+checkPdiHeaders(const std::vector<char>& image)
+{
+  XilPdi_PrtnHdr prtnHdr;
+  std::memcpy(&prtnHdr, image.data() + prtnHdrOffset, sizeof(prtnHdr));
+  EXPECT_EQ(prtnHdr.Checksum, checksum(reinterpret_cast<const uint32_t*>(&prtnHdr), sizeof(prtnHdr) / 4 - 1));
+  EXPECT_EQ(cdoOffset + prtnHdr.TotalDataWordLen * 4, image.size());
+
+  uint32_t cdoHeader[XCDO_CDO_HDR_LEN];
+  std::memcpy(cdoHeader, image.data() + cdoOffset, sizeof(cdoHeader));
+  EXPECT_EQ(cdoHeader[4], checksum(cdoHeader, 4));
+  EXPECT_EQ(prtnHdr.UnEncDataWordLen, XCDO_CDO_HDR_LEN + cdoHeader[3]);
+
+  // Data of block writes is 16 byte aligned
+  for (size_t i = cdoOffset + XCDO_CDO_HDR_LEN * 4; i < cdoOffset + prtnHdr.UnEncDataWordLen * 4;) {
+    uint32_t header;
+    std::memcpy(&header, image.data() + i, 4);
+    size_t len = (header >> 16) & 0xff;
+    size_t headerLen = 1;
+    if (len == 0xff) {
+      uint32_t longLen;
+      std::memcpy(&longLen, image.data() + i + 4, 4);
+      len = longLen;
+      headerLen = 2;
+    }
+    if ((header & 0xffff) == 0x105) {
+      EXPECT_EQ((i + (headerLen + 2) * 4) % 16, 0U);
+    }
+    i += (headerLen + len) * 4;
+  }
+}
+
+// Commands of a corpus file and the expected report values
+void
+readCorpus(const std::filesystem::path& path, std::vector<uint32_t>& commands, std::map<std::string, uint64_t>& expected)
+{
+  static const std::map<std::string, uint32_t> opcodes = {
+    {"mask_write", 0x102}, {"write", 0x103}, {"dma_write", 0x105},
+    {"mask_write64", 0x107}, {"write64", 0x108}, {"nop", 0x111}
+  };
+
+  std::ifstream ifs(path);
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line.substr(0, line.find('#')));
+    std::string op;
+    if (!(iss >> op))
+      continue;
+
+    if (op == "expect") {
+      std::string key;
+      uint64_t value;
+      iss >> key >> value;
+      expected[key] = value;
+      continue;
+    }
+
+    std::vector<uint64_t> args;
+    std::string arg;
+    while (iss >> arg)
+      args.push_back(std::stoull(arg, nullptr, 0));
+    if (op == "other") {
+      commands.insert(commands.end(), args.begin(), args.end());
+      continue;
+    }
+
+    auto opcode = opcodes.at(op);
+    if (op == "nop")
+      args.assign(args.empty() ? 0 : args[0], 0);
+    std::vector<uint32_t> payload;
+    for (size_t i = 0; i < args.size(); ++i) {
+      // Address of 64 bit commands is high, low
+      if (i == 0 && (op == "dma_write" || op == "write64" || op == "mask_write64"))
+        payload.push_back(static_cast<uint32_t>(args[i] >> 32));
+      payload.push_back(static_cast<uint32_t>(args[i]));
+    }
+    commands.push_back(static_cast<uint32_t>(payload.size() << 16) | opcode);
+    commands.insert(commands.end(), payload.begin(), payload.end());
+  }
+}
+
+uint64_t
+reportValue(const XUtil::PdiOptimizeReport& report, const std::string& key)
+{
+  static const std::map<std::string, uint64_t XUtil::PdiOptimizeReport::*> fields = {
+    {"writes", &XUtil::PdiOptimizeReport::writesAfter},
+    {"mask_writes", &XUtil::PdiOptimizeReport::maskWritesAfter},
+    {"block_writes", &XUtil::PdiOptimizeReport::blockWritesAfter},
+    {"dead_words", &XUtil::PdiOptimizeReport::deadWords},
+    {"mask_writes_coalesced", &XUtil::PdiOptimizeReport::maskWritesCoalesced},
+    {"memory_runs", &XUtil::PdiOptimizeReport::memoryRuns},
+  };
+  return report.*fields.at(key);
+}
+
+} // namespace
+
+TEST(PdiOptimizer, Corpus) {
+  std::filesystem::path corpusDir(TestUtilities::getResourceDir());
+  corpusDir /= "pdi_optimizer";
+
+  std::vector<std::filesystem::path> files;
+  for (const auto& entry : std::filesystem::directory_iterator(corpusDir))
+    if (entry.path().extension() == ".cdo")
+      files.push_back(entry.path());
+  std::sort(files.begin(), files.end());
+  ASSERT_FALSE(files.empty());
+
+  for (const auto& file : files) {
+    SCOPED_TRACE(file.filename().string());
+    std::vector<uint32_t> commands;
+    std::map<std::string, uint64_t> expected;
+    readCorpus(file, commands, expected);
+
+    auto image = createPdi(commands);
+    auto optimized = image;
+    XUtil::PdiOptimizeReport report;
+    std::string reason;
+    ASSERT_TRUE(XUtil::optimizePdiImage(optimized, report, reason)) << reason;
+
+    checkPdiHeaders(optimized);
+    EXPECT_TRUE(CdoModel(image) == CdoModel(optimized));
+    EXPECT_LE(report.bytesAfter, report.bytesBefore);
+    for (const auto& [key, value] : expected)
+      EXPECT_EQ(reportValue(report, key), value) << key;
+  }
+}
+
+TEST(PdiOptimizer, AiePartitionPdis) {
+  for (const auto& name : {"2220.hex", "2221.hex"}) {
+    SCOPED_TRACE(name);
+    std::filesystem::path hexFile(TestUtilities::getResourceDir());
+    hexFile = hexFile.parent_path() / "AIEPartition" / name;
+
+    auto image = readHexPdi(hexFile);
+    ASSERT_FALSE(image.empty());
+    auto optimized = image;
+    XUtil::PdiOptimizeReport report;
+    std::string reason;
+    ASSERT_TRUE(XUtil::optimizePdiImage(optimized, report, reason)) << reason;
+
+    checkPdiHeaders(optimized);
+    EXPECT_TRUE(CdoModel(image) == CdoModel(optimized));
+    EXPECT_LT(report.commandsAfter, report.commandsBefore);
+    EXPECT_LT(report.bytesAfter, report.bytesBefore);
+    EXPECT_EQ(report.bytesAfter, optimized.size());
+
+    // Optimizing again changes nothing
+    auto again = optimized;
+    XUtil::PdiOptimizeReport againReport;
+    ASSERT_TRUE(XUtil::optimizePdiImage(again, againReport, reason)) << reason;
+    EXPECT_EQ(again, optimized);
+  }
+}
+
+TEST(PdiOptimizer, UnsupportedPdi) {
+  auto image = createPdi({0x00020103, 0x00200000, 0x1});
+
+  // Transformed PDI is left as is
+  auto transformed = image;
+  XPdiLoad pdiLoad = {nullptr, static_cast<uint32_t>(transformed.size()), transformed.data()};
+  XPdi_Header_Set_Transform_Type(&pdiLoad, CMDDATASPERATE, 3);
+  auto original = transformed;
+  XUtil::PdiOptimizeReport report;
+  std::string reason;
+  EXPECT_FALSE(XUtil::optimizePdiImage(transformed, report, reason));
+  EXPECT_FALSE(reason.empty());
+  EXPECT_EQ(transformed, original);
+
+  // Command beyond the end of the CDO
+  auto truncated = createPdi({0x00030103, 0x00200000, 0x1});
+  EXPECT_THROW(XUtil::optimizePdiImage(truncated, report, reason), std::runtime_error);
+}
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+// Microbenchmark for address translation of the HIP memory database
+//
+// Inserts address ranges for a number of allocations and looks up
+// addresses within the ranges from many threads, with and without a
+// concurrent thread that allocates and frees.  Compares the address
+// range index used by memory_database against a map with a range
+// comparator behind one mutex as used by earlier versions.  Verifies
+// every lookup.
+//
+// Lookups are either random over all allocations, or repeated on a
+// small working set of buffers per thread, as is typical for
+// hipMemcpy and kernel argument translation.
+//
+// % memory_database [-a <allocations>] [-t <threads>] [-n <lookups per thread>]
+
+#include "hip/core/address_range_index.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct buffer
+{
+  uint64_t address;
+  size_t size;
+};
+
+// Map with range comparator and one mutex, as used by earlier
+// versions of memory_database.  Used as baseline.
+class locked_map
+{
+  struct key
+  {
+    uint64_t address;
+    size_t size;
+  };
+
+  struct compare
+  {
+    bool operator() (const key& lhs, const key& rhs) const
+    {
+      if (lhs.address == rhs.address)
+        return false;
+      return (lhs.address + lhs.size < 1) || (lhs.address + lhs.size - 1 < rhs.address);
+    }
+  };
+
+  std::map<key, std::shared_ptr<buffer>, compare> m_map;
+  std::mutex m_mutex;
+
+public:
+  void
+  insert(uint64_t addr, size_t size, std::shared_ptr<buffer> buf)
+  {
+    std::lock_guard lk(m_mutex);
+    m_map.insert({key{addr, size}, std::move(buf)});
+  }
+
+  void
+  remove(uint64_t addr)
+  {
+    std::lock_guard lk(m_mutex);
+    m_map.erase(key{addr, 0});
+  }
+
+  std::pair<std::shared_ptr<buffer>, size_t>
+  find(uint64_t addr)
+  {
+    std::lock_guard lk(m_mutex);
+    auto itr = m_map.find(key{addr, 0});
+    if (itr == m_map.end())
+      return {nullptr, 0};
+    return {itr->second, addr - itr->first.address};
+  }
+};
+
+using address_index = xrt::core::hip::address_range_index<buffer>;
+
+// Page aligned allocations from 4KB to 1MB with gaps
+std::vector<std::shared_ptr<buffer>>
+create_buffers(size_t count)
+{
+  std::mt19937_64 gen(1);
+  std::vector<std::shared_ptr<buffer>> buffers;
+  uint64_t address = 0x100000000;
+  for (size_t i = 0; i < count; ++i) {
+    size_t size = (1 + gen() % 256) * 4096;
+    buffers.push_back(std::make_shared<buffer>(buffer{address, size}));
+    address += size + 4096 * (gen() % 2);
+  }
+  return buffers;
+}
+
+// Lookups per second over all threads
+template <typename Index>
+double
+run_lookups(Index& index, const std::vector<std::shared_ptr<buffer>>& buffers,
+            unsigned int threads, size_t lookups, bool working_set, bool churn)
+{
+  std::atomic<bool> start {false};
+  std::atomic<bool> done {false};
+  std::atomic<size_t> errors {0};
+
+  // Allocates and frees buffers beyond the looked up buffers
+  std::thread churner;
+  if (churn) {
+    churner = std::thread([&] {
+      auto base = buffers.back()->address + buffers.back()->size + 0x100000;
+      auto buf = std::make_shared<buffer>(buffer{base, 4096});
+      while (!start)
+        std::this_thread::yield();
+      while (!done) {
+        index.insert(buf->address, buf->size, buf);
+        index.remove(buf->address);
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+      }
+    });
+  }
+
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937_64 gen(t + 1);
+      std::vector<size_t> set;
+      for (size_t i = 0; i < 4; ++i)
+        set.push_back(gen() % buffers.size());
+      while (!start)
+        std::this_thread::yield();
+      for (size_t i = 0; i < lookups; ++i) {
+        const auto& buf = buffers[working_set ? set[i % set.size()] : gen() % buffers.size()];
+        auto offset = gen() % buf->size;
+        auto [found, found_offset] = index.find(buf->address + offset);
+        if (found != buf || found_offset != offset)
+          ++errors;
+      }
+    });
+  }
+
+  auto begin = std::chrono::high_resolution_clock::now();
+  start = true;
+  for (auto& w : workers)
+    w.join();
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - begin;
+  done = true;
+  if (churner.joinable())
+    churner.join();
+
+  if (errors)
+    throw std::runtime_error(std::to_string(errors) + " lookups returned wrong buffer or offset");
+
+  return static_cast<double>(lookups) * threads / elapsed.count();
+}
+
+// Verify lookups outside of ranges and after remove
+void
+verify(address_index& index, const std::vector<std::shared_ptr<buffer>>& buffers)
+{
+  auto last = buffers.back();
+  if (index.find(last->address + last->size).first)
+    throw std::runtime_error("lookup past end of last range succeeded");
+  if (index.find(buffers.front()->address - 1).first)
+    throw std::runtime_error("lookup before first range succeeded");
+
+  // lookup to populate thread cache, remove, lookup again
+  auto buf = buffers[buffers.size() / 2];
+  if (index.find(buf->address + 1).first != buf)
+    throw std::runtime_error("lookup of inserted range failed");
+  index.remove(buf->address + 1);
+  if (index.find(buf->address + 1).first)
+    throw std::runtime_error("lookup of removed range succeeded");
+  index.insert(buf->address, buf->size, buf);
+}
+
+template <typename Index>
+void
+report(const std::string& name, Index& index, const std::vector<std::shared_ptr<buffer>>& buffers,
+       unsigned int threads, size_t lookups)
+{
+  std::cout << std::setw(12) << name << std::fixed << std::setprecision(0);
+  for (bool churn : {false, true})
+    for (bool working_set : {false, true})
+      std::cout << std::setw(14) << run_lookups(index, buffers, threads, lookups, working_set, churn);
+  std::cout << '\n';
+}
+
+void
+run(int argc, char* argv[])
+{
+  size_t allocations = 100000;
+  unsigned int threads = 32;
+  size_t lookups = 1000000;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-h") {
+      std::cout << "usage: memory_database [-a <allocations>] [-t <threads>] [-n <lookups per thread>]\n";
+      return;
+    }
+    if (i + 1 == args.size())
+      throw std::runtime_error("Missing value for option " + args[i]);
+    if (args[i] == "-a")
+      allocations = std::stoul(args[++i]);
+    else if (args[i] == "-t")
+      threads = std::stoul(args[++i]);
+    else if (args[i] == "-n")
+      lookups = std::stoul(args[++i]);
+    else
+      throw std::runtime_error("Unknown option " + args[i]);
+  }
+
+  if (!allocations || !threads)
+    throw std::runtime_error("-a <allocations> and -t <threads> must be greater than 0");
+
+  auto buffers = create_buffers(allocations);
+
+  address_index index;
+  locked_map map;
+  for (const auto& buf : buffers) {
+    index.insert(buf->address, buf->size, buf);
+    map.insert(buf->address, buf->size, buf);
+  }
+  verify(index, buffers);
+
+  std::cout << "allocations: " << allocations << " threads: " << threads
+            << " lookups per thread: " << lookups << '\n'
+            << "lookups/s:       random   working set  random+churn   set+churn\n";
+  report("range index", index, buffers, threads, lookups);
+  report("locked map", map, buffers, threads, lookups);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+  return 1;
+}
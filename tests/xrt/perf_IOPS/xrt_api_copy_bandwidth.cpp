@@ -0,0 +1,138 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Bandwidth of xrt::bo::copy() when the copy goes through host memory
+// versus the sequential sync from device, host copy, sync to device
+// done by the copy without pipelining.  Reports achieved overlap as
+// the fraction of the ideal time saving, where ideal is the time of
+// the slowest stage alone.
+//
+// The noop shim simulates sync bandwidth without hardware:
+//   [Runtime]
+//   noop_sync_bandwidth_mbps = 8000
+//   copy_through_host_chunk_kb = 4096
+//
+// % XCL_EMULATION_MODE=noop ./xrt_api_copy_bandwidth -k verify.xclbin
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+#ifdef _WIN32
+# pragma warning( disable : 4244 )
+#endif
+
+static void usage()
+{
+  std::cout << "Usage: test -k <xclbin> [-s <size in MB>] [-n <iterations>]\n";
+}
+
+using clk = std::chrono::high_resolution_clock;
+
+static double
+to_ms(clk::duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static int
+_main(int argc, char* argv[])
+{
+  std::string xclbin_fn;
+  size_t size_mb = 256;
+  unsigned int iterations = 5;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i + 1 < args.size(); i += 2) {
+    if (args[i] == "-k")
+      xclbin_fn = args[i + 1];
+    else if (args[i] == "-s")
+      size_mb = std::stoul(args[i + 1]);
+    else if (args[i] == "-n")
+      iterations = std::stoi(args[i + 1]);
+  }
+
+  if (xclbin_fn.empty() || !size_mb || !iterations) {
+    usage();
+    return 1;
+  }
+
+  auto device = xrt::device(0);
+  auto uuid = device.load_xclbin(xclbin_fn);
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+
+  size_t size = size_mb * 1024 * 1024;
+  auto src = xrt::bo(device, size, hello.group_id(0));
+  auto dst = xrt::bo(device, size, hello.group_id(0));
+  auto src_data = src.map<char*>();
+  auto dst_data = dst.map<char*>();
+  for (size_t i = 0; i < size; ++i)
+    src_data[i] = static_cast<char>(i * 13);
+  src.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+  // Sequential stages as done by an unpipelined copy through host
+  double sync_from_ms = 0, memcpy_ms = 0, sync_to_ms = 0;
+  for (unsigned int i = 0; i < iterations; ++i) {
+    auto t0 = clk::now();
+    src.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+    auto t1 = clk::now();
+    std::memcpy(dst_data, src_data, size);
+    auto t2 = clk::now();
+    dst.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    auto t3 = clk::now();
+    sync_from_ms += to_ms(t1 - t0);
+    memcpy_ms += to_ms(t2 - t1);
+    sync_to_ms += to_ms(t3 - t2);
+  }
+  sync_from_ms /= iterations;
+  memcpy_ms /= iterations;
+  sync_to_ms /= iterations;
+  auto serial_ms = sync_from_ms + memcpy_ms + sync_to_ms;
+
+  std::memset(dst_data, 0, size);
+  auto start = clk::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    dst.copy(src);
+  auto copy_ms = to_ms(clk::now() - start) / iterations;
+
+  if (std::memcmp(dst_data, src_data, size))
+    throw std::runtime_error("copied data mismatch");
+
+  auto slowest_ms = std::max({sync_from_ms, memcpy_ms, sync_to_ms});
+  auto overlap = (serial_ms > slowest_ms) ? (serial_ms - copy_ms) / (serial_ms - slowest_ms) : 0.0;
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "size(MB): " << size_mb << '\n'
+            << "stages(ms): sync from " << sync_from_ms << " memcpy " << memcpy_ms << " sync to " << sync_to_ms << '\n'
+            << "sequential(ms): " << serial_ms << " MB/s: " << size_mb * 1000 / serial_ms << '\n'
+            << "bo::copy(ms):   " << copy_ms << " MB/s: " << size_mb * 1000 / copy_ms << '\n'
+            << "overlap: " << std::setprecision(1) << 100.0 * overlap << "% of ideal" << std::endl;
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
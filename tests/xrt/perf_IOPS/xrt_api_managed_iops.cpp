@@ -0,0 +1,156 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Managed command throughput.  Each submitting thread starts runs that
+// have a completion callback, which routes the runs through the
+// hw_queue command manager (monitor thread) rather than through
+// unmanaged execution.
+//
+// % XCL_EMULATION_MODE=noop ./xrt_api_managed_iops -k verify.xclbin
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+#ifdef _WIN32
+# pragma warning( disable : 4244 )
+#endif
+
+static void usage()
+{
+  std::cout << "Usage: test -k <xclbin> [-t <max threads>] [-n <cmds per thread>]\n";
+}
+
+static std::atomic<unsigned int> callbacks {0};
+
+static void
+callback(const void*, ert_cmd_state, void*)
+{
+  callbacks.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Run 'total' commands using the argument runs as a ring of
+// outstanding commands.
+static void
+runThread(std::vector<xrt::run>& cmds, unsigned int total)
+{
+  size_t i = 0;
+  unsigned int issued = 0, completed = 0;
+
+  for (auto& cmd : cmds) {
+    cmd.start();
+    if (++issued == total)
+      break;
+  }
+
+  while (completed < total) {
+    cmds[i].wait();
+
+    completed++;
+    if (issued < total) {
+      cmds[i].start();
+      issued++;
+    }
+
+    if (++i == cmds.size())
+      i = 0;
+  }
+}
+
+static void
+testMultiThread(const xrt::device& device, const xrt::uuid& uuid, unsigned int max_threads, unsigned int cmds_per_thread)
+{
+  constexpr unsigned int queue_depth = 16;
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+
+  double base_iops = 0;
+  for (unsigned int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    std::vector<std::vector<xrt::run>> cmds(num_threads);
+    for (auto& thread_cmds : cmds) {
+      for (unsigned int i = 0; i < queue_depth; ++i) {
+        auto run = xrt::run(hello);
+        run.set_arg(0, xrt::bo(device, 20, hello.group_id(0)));
+        run.add_callback(ERT_CMD_STATE_COMPLETED, callback, nullptr);
+        thread_cmds.push_back(std::move(run));
+      }
+    }
+
+    callbacks = 0;
+    std::vector<std::thread> threads;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& thread_cmds : cmds)
+      threads.emplace_back(runThread, std::ref(thread_cmds), cmds_per_thread);
+    for (auto& t : threads)
+      t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double duration = (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+    auto total = num_threads * cmds_per_thread;
+    auto iops = total * 1000.0 * 1000.0 / duration;
+    if (num_threads == 1)
+      base_iops = iops;
+
+    std::cout << "Threads: " << std::setw(3) << num_threads
+              << " Commands: " << std::setw(8) << total
+              << " Callbacks: " << std::setw(8) << callbacks
+              << " iops: " << std::setw(10) << std::fixed << std::setprecision(0) << iops
+              << " scaling: " << std::setprecision(2) << (iops / base_iops)
+              << std::endl;
+  }
+}
+
+static int
+_main(int argc, char* argv[])
+{
+  std::string xclbin_fn;
+  unsigned int max_threads = 32;
+  unsigned int cmds_per_thread = 50000;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i + 1 < args.size(); i += 2) {
+    if (args[i] == "-k")
+      xclbin_fn = args[i + 1];
+    else if (args[i] == "-t")
+      max_threads = std::stoi(args[i + 1]);
+    else if (args[i] == "-n")
+      cmds_per_thread = std::stoi(args[i + 1]);
+  }
+
+  if (xclbin_fn.empty()) {
+    usage();
+    return 1;
+  }
+
+  auto device = xrt::device(0);
+  auto uuid = device.load_xclbin(xclbin_fn);
+
+  testMultiThread(device, uuid, std::max(1u, max_threads), cmds_per_thread);
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
@@ -0,0 +1,113 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Host to device and device to host buffer sync bandwidth for buffer
+// sizes from 4KB up to a maximum size.  Buffer content is verified
+// after a round trip.
+//
+// Compare sw_emu buffer content over the device process socket with
+// shared device memory enabled in xrt.ini:
+//   [Emulation]
+//   shared_device_memory=true
+//
+// % XCL_EMULATION_MODE=sw_emu ./xrt_api_sync_bandwidth -k verify.xclbin
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+#ifdef _WIN32
+# pragma warning( disable : 4244 )
+#endif
+
+static void usage()
+{
+  std::cout << "Usage: test -k <xclbin> [-s <max size in MB>] [-n <iterations>]\n";
+}
+
+// MB/s of 'iterations' syncs of 'bo' in direction 'dir'
+static double
+runTest(xrt::bo& bo, xclBOSyncDirection dir, unsigned int iterations)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    bo.sync(dir);
+  auto end = std::chrono::high_resolution_clock::now();
+
+  double us = (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+  return (static_cast<double>(bo.size()) * iterations) / us;  // bytes/us == MB/s
+}
+
+static int
+_main(int argc, char* argv[])
+{
+  std::string xclbin_fn;
+  size_t max_size_mb = 256;
+  unsigned int iterations = 10;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i + 1 < args.size(); i += 2) {
+    if (args[i] == "-k")
+      xclbin_fn = args[i + 1];
+    else if (args[i] == "-s")
+      max_size_mb = std::stoul(args[i + 1]);
+    else if (args[i] == "-n")
+      iterations = std::stoi(args[i + 1]);
+  }
+
+  if (xclbin_fn.empty() || !iterations) {
+    usage();
+    return 1;
+  }
+
+  auto device = xrt::device(0);
+  auto uuid = device.load_xclbin(xclbin_fn);
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+
+  for (size_t size = 4096; size <= max_size_mb * 1024 * 1024; size *= 4) {
+    auto bo = xrt::bo(device, size, hello.group_id(0));
+    auto data = bo.map<char*>();
+    for (size_t i = 0; i < size; ++i)
+      data[i] = static_cast<char>(i * 7);
+
+    auto h2d = runTest(bo, XCL_BO_SYNC_BO_TO_DEVICE, iterations);
+    std::memset(data, 0, size);
+    auto d2h = runTest(bo, XCL_BO_SYNC_BO_FROM_DEVICE, iterations);
+
+    for (size_t i = 0; i < size; ++i)
+      if (data[i] != static_cast<char>(i * 7))
+        throw std::runtime_error("data mismatch at offset " + std::to_string(i) + " for size " + std::to_string(size));
+
+    std::cout << "size(KB): " << std::setw(8) << size / 1024
+              << " h2d(MB/s): " << std::setw(10) << std::fixed << std::setprecision(1) << h2d
+              << " d2h(MB/s): " << std::setw(10) << d2h
+              << std::endl;
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
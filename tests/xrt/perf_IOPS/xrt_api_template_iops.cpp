@@ -0,0 +1,129 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Per-start host CPU time of xrt::run::start() versus
+// xrt::run_template::start() when only a buffer argument changes
+// between starts.
+//
+// % ./xrt_api_template_iops -k verify.xclbin
+// % XCL_EMULATION_MODE=noop ./xrt_api_template_iops -k verify.xclbin
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_kernel.h"
+
+#ifdef _WIN32
+# pragma warning( disable : 4244 )
+#endif
+
+static void usage()
+{
+  std::cout << "Usage: test -k <xclbin> [-n <iterations>]\n";
+}
+
+struct result
+{
+  double cpu_us;   // host CPU time per start
+  double wall_us;  // wall time per start
+};
+
+static void
+report(const std::string& name, const result& r)
+{
+  std::cout << std::setw(10) << name
+            << " cpu/start(us): " << std::setw(8) << std::fixed << std::setprecision(3) << r.cpu_us
+            << " wall/start(us): " << std::setw(8) << r.wall_us
+            << std::endl;
+}
+
+// Time 'iterations' of set_arg + start + wait where each iteration
+// alternates between the argument buffers.
+template <typename RunType>
+static result
+runTest(RunType& run, const std::vector<xrt::bo>& bos, unsigned int iterations)
+{
+  auto cpu_start = std::clock();
+  auto wall_start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int i = 0; i < iterations; ++i) {
+    run.set_arg(0, bos[i % bos.size()]);
+    run.start();
+    run.wait();
+  }
+
+  auto wall_end = std::chrono::high_resolution_clock::now();
+  auto cpu_end = std::clock();
+
+  double cpu = 1000.0 * 1000.0 * (cpu_end - cpu_start) / CLOCKS_PER_SEC;
+  double wall = (std::chrono::duration_cast<std::chrono::microseconds>(wall_end - wall_start)).count();
+  return {cpu / iterations, wall / iterations};
+}
+
+static int
+_main(int argc, char* argv[])
+{
+  std::string xclbin_fn;
+  unsigned int iterations = 100000;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i + 1 < args.size(); i += 2) {
+    if (args[i] == "-k")
+      xclbin_fn = args[i + 1];
+    else if (args[i] == "-n")
+      iterations = std::stoi(args[i + 1]);
+  }
+
+  if (xclbin_fn.empty()) {
+    usage();
+    return 1;
+  }
+
+  auto device = xrt::device(0);
+  auto uuid = device.load_xclbin(xclbin_fn);
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+
+  std::vector<xrt::bo> bos;
+  for (int i = 0; i < 2; ++i)
+    bos.emplace_back(device, 20, hello.group_id(0));
+
+  auto run = xrt::run(hello);
+  run.set_arg(0, bos[0]);
+  auto r1 = runTest(run, bos, iterations);
+  report("run", r1);
+
+  auto trun = xrt::run(hello);
+  trun.set_arg(0, bos[0]);
+  auto tmpl = xrt::run_template(trun, {0});
+  auto r2 = runTest(tmpl, bos, iterations);
+  report("template", r2);
+
+  std::cout << "cpu time reduction: " << std::setprecision(1)
+            << (100.0 * (r1.cpu_us - r2.cpu_us) / r1.cpu_us) << "%" << std::endl;
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}